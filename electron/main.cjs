@@ -241,8 +241,9 @@ async function createWindow() {
   // Confirmación de cierre (Alt+F4, botón X de ventana)
   // Si el usuario no ha confirmado vía menú, mostrar diálogo de confirmación
   // ───────────────────────────────────────────────────────────────────────────
+  let closeConfirmed = false;
   mainWindow.on('close', async (e) => {
-    if (isQuitConfirmed()) return; // Ya confirmado desde el menú
+    if (isQuitConfirmed() || closeConfirmed) return; // Ya confirmado
     e.preventDefault();
     const { dialog } = require('electron');
     const { response } = await dialog.showMessageBox(mainWindow, {
@@ -258,7 +259,10 @@ async function createWindow() {
     });
     if (response === 0) {
       resetQuitConfirmed(); // Limpiar para futuro uso
-      mainWindow.destroy();
+      // close() y no destroy(): destroy() no emite beforeunload y el renderer
+      // perdería el guardado al salir y la captura de enlaces PipeWire
+      closeConfirmed = true;
+      mainWindow.close();
     }
   });
 
@@ -0,0 +1,270 @@
+/**
+ * Benchmark: kernels de transporte y DSP (audio_kernels.h) y acondicionador
+ * de entrada, versión compilada (NEON en aarch64) frente a la escalar.
+ *
+ * Mide 10 minutos de audio @ 48kHz en bloques de 128 frames con 12 canales
+ * (el caso multicanal) y comprueba para varias combinaciones de canales y
+ * longitudes (restos de grupos de 4 y colas de menos de 4 frames) que los
+ * resultados coinciden con la referencia escalar: exactos en los kernels de
+ * copia, con tolerancia de redondeo en los aritméticos (mul+add frente a FMA).
+ *
+ * Al final mide un decaimiento exponencial hacia subnormales (cola de un
+ * filtro, persistencia del fósforo) sin y con FTZ/DAZ (denormals.h), y
+ * comprueba el detector: con FTZ activo no debe quedar ningún subnormal.
+ *
+ * Compilar y ejecutar (no necesita PipeWire):
+ *   npm run bench:kernels
+ * En x86, para ARM con qemu-user (aarch64-linux-gnu-g++ + qemu-aarch64):
+ *   npm run bench:arm64
+ * Bajo emulación los tiempos no son representativos; vale la verificación.
+ */
+
+#include "../src/audio_kernels.h"
+#include "../src/denormals.h"
+#include "../src/input_conditioner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr int CHANNELS = 12;
+constexpr size_t BLOCK = 128;
+constexpr size_t TOTAL_FRAMES = 48000 * 600;  // 10 minutos @ 48kHz
+constexpr int SAMPLE_RATE = 48000;
+
+uint32_t rngState = 1;
+float noise() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return static_cast<float>(static_cast<int32_t>(rngState)) / 2147483648.0f;
+}
+
+void fill(std::vector<float>& v) {
+    for (float& x : v) x = noise();
+}
+
+bool close(float a, float b) {
+    return std::fabs(a - b) <= 1e-6f * std::max(1.0f, std::fabs(a));
+}
+
+template <typename Fn>
+double timeBlocks(Fn&& fn) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t done = 0; done < TOTAL_FRAMES; done += BLOCK) fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Misma fórmula que InputConditioner::process, canal a canal
+struct ReferenceConditioner {
+    float x1[CHANNELS] = {}, y1[CHANNELS] = {}, gain[CHANNELS];
+    ReferenceConditioner() { std::fill(gain, gain + CHANNELS, 1.0f); }
+    void process(const float* src, float* dst, size_t frames, int channels, float R,
+                 float k, const float* target, float threshold, float* peak, uint32_t* clips) {
+        for (size_t i = 0; i < frames; i++) {
+            for (int ch = 0; ch < channels; ch++) {
+                const float x = src[i * channels + ch];
+                clips[ch] += std::fabs(x) >= threshold ? 1u : 0u;
+                const float y = x - x1[ch] + R * y1[ch];
+                x1[ch] = x;
+                y1[ch] = y;
+                gain[ch] += (target[ch] - gain[ch]) * k;
+                const float v = y * gain[ch];
+                dst[i * channels + ch] = v;
+                peak[ch] = std::max(peak[ch], std::fabs(v));
+            }
+        }
+    }
+};
+
+bool verifyKernels() {
+    bool ok = true;
+    const int channelCounts[] = { 1, 2, 3, 4, 8, 12, 14 };
+    const size_t lengths[] = { 0, 1, 3, 4, 61, 127, 128 };
+    for (int ch : channelCounts) {
+        for (size_t n : lengths) {
+            const size_t stride = BLOCK;
+            std::vector<float> inter(BLOCK * ch), planar(stride * ch);
+            std::vector<float> planarRef(stride * ch, 0.0f), planarOut(stride * ch, 0.0f);
+            std::vector<float> interRef(BLOCK * ch, 0.0f), interOut(BLOCK * ch, 0.0f);
+            fill(inter);
+            fill(planar);
+            AudioKernels::scalar::deinterleave(inter.data(), ch, planarRef.data(), stride, n);
+            AudioKernels::deinterleave(inter.data(), ch, planarOut.data(), stride, n);
+            AudioKernels::scalar::interleave(planar.data(), stride, ch, interRef.data(), n);
+            AudioKernels::interleave(planar.data(), stride, ch, interOut.data(), n);
+            if (planarRef != planarOut || interRef != interOut) {
+                std::printf("  MISMATCH (de)interleave: %d ch, %zu frames\n", ch, n);
+                ok = false;
+            }
+        }
+    }
+
+    for (size_t n : lengths) {
+        std::vector<float> x(n), t(n), d(n), a(n);
+        fill(x); fill(t); fill(d); fill(a);
+        std::vector<float> accRef = a, accOut = a, lerpRef(n), lerpOut(n);
+        AudioKernels::scalar::mulAdd(accRef.data(), x.data(), 0.37f, n);
+        AudioKernels::mulAdd(accOut.data(), x.data(), 0.37f, n);
+        AudioKernels::scalar::lerp(lerpRef.data(), a.data(), t.data(), d.data(), n);
+        AudioKernels::lerp(lerpOut.data(), a.data(), t.data(), d.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            if (!close(accRef[i], accOut[i]) || !close(lerpRef[i], lerpOut[i])) {
+                std::printf("  MISMATCH mulAdd/lerp: %zu frames, index %zu\n", n, i);
+                ok = false;
+                break;
+            }
+        }
+    }
+    return ok;
+}
+
+bool verifyConditioner(int channels) {
+    InputConditioner cond;
+    cond.prepare(channels, SAMPLE_RATE);
+    cond.setDcCutoff(20.0f);
+    cond.setClipThreshold(0.9f);
+    for (int ch = 0; ch < channels; ch++) cond.setGain(ch, 0.5f + 0.1f * ch);
+
+    ReferenceConditioner ref;
+    const float R = 1.0f - 2.0f * static_cast<float>(M_PI) * 20.0f / SAMPLE_RATE;
+    const float samples = 20.0f * SAMPLE_RATE / 1000.0f;
+    const float k = 1.0f - std::exp(-1.0f / samples);
+    float target[CHANNELS];
+    for (int ch = 0; ch < channels; ch++) target[ch] = 0.5f + 0.1f * ch;
+
+    std::vector<float> in(BLOCK * channels), out(BLOCK * channels), outRef(BLOCK * channels);
+    float peakRef[CHANNELS] = {};
+    uint32_t clipsRef[CHANNELS] = {};
+    bool ok = true;
+    for (int block = 0; block < 200 && ok; block++) {
+        fill(in);
+        cond.process(in.data(), out.data(), BLOCK);
+        ref.process(in.data(), outRef.data(), BLOCK, channels, R, k, target, 0.9f, peakRef, clipsRef);
+        for (size_t i = 0; i < out.size(); i++) {
+            if (!close(out[i], outRef[i])) {
+                std::printf("  MISMATCH conditioner: %d ch, block %d, sample %zu\n", channels, block, i);
+                ok = false;
+                break;
+            }
+        }
+    }
+    for (int ch = 0; ch < channels && ok; ch++) {
+        const InputConditioner::ChannelStats stats = cond.takeStats(ch);
+        if (stats.clips != clipsRef[ch] || !close(stats.peak, peakRef[ch])) {
+            std::printf("  MISMATCH conditioner stats: %d ch, channel %d\n", channels, ch);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Cola de decaimiento: CHANNELS canales × BLOCK frames multiplicados por
+// `decay` cada bloque; tras unos cientos de bloques todo es subnormal
+double timeDecay(std::vector<float>& state, size_t* subnormals) {
+    const float decay = 0.9f;
+    std::fill(state.begin(), state.end(), 1.0f);
+    *subnormals = 0;
+    const double ms = timeBlocks([&] {
+        for (float& v : state) v *= decay;
+    });
+    *subnormals = Denormals::countSubnormals(state.data(), state.size());
+    return ms;
+}
+
+bool verifyCountSubnormals() {
+    const float values[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, std::numeric_limits<float>::min(),
+        std::numeric_limits<float>::denorm_min(), -std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::min() / 2.0f, std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(),
+    };
+    const size_t found = Denormals::countSubnormals(values, sizeof(values) / sizeof(values[0]));
+    if (found != 3) {
+        std::printf("  MISMATCH countSubnormals: %zu (expected 3)\n", found);
+        return false;
+    }
+    return true;
+}
+
+void report(const char* name, double ms) {
+    const double audioMs = TOTAL_FRAMES * 1000.0 / SAMPLE_RATE;
+    std::printf("%-30s %9.2f ms  (%7.0fx realtime)\n", name, ms, audioMs / ms);
+}
+
+} // namespace
+
+int main() {
+    std::printf("=== Audio kernels benchmark (%s, %d ch, %zu-frame blocks, %zu s @ 48kHz) ===\n\n",
+                AudioKernels::isa(), CHANNELS, BLOCK, TOTAL_FRAMES / SAMPLE_RATE);
+
+    std::vector<float> inter(BLOCK * CHANNELS), planar(BLOCK * CHANNELS), out(BLOCK * CHANNELS);
+    fill(inter);
+    fill(planar);
+
+    report("deinterleave scalar", timeBlocks([&] {
+        AudioKernels::scalar::deinterleave(inter.data(), CHANNELS, planar.data(), BLOCK, BLOCK);
+    }));
+    report("deinterleave", timeBlocks([&] {
+        AudioKernels::deinterleave(inter.data(), CHANNELS, planar.data(), BLOCK, BLOCK);
+    }));
+    report("interleave scalar", timeBlocks([&] {
+        AudioKernels::scalar::interleave(planar.data(), BLOCK, CHANNELS, inter.data(), BLOCK);
+    }));
+    report("interleave", timeBlocks([&] {
+        AudioKernels::interleave(planar.data(), BLOCK, CHANNELS, inter.data(), BLOCK);
+    }));
+
+    // Mezcla: una fila de la matriz del morph hacia 12 destinos
+    std::vector<float> acc(BLOCK * CHANNELS, 0.0f);
+    report("mulAdd x12 scalar", timeBlocks([&] {
+        for (int ch = 0; ch < CHANNELS; ch++) {
+            AudioKernels::scalar::mulAdd(&acc[ch * BLOCK], &planar[ch * BLOCK], 0.25f, BLOCK);
+        }
+    }));
+    report("mulAdd x12", timeBlocks([&] {
+        for (int ch = 0; ch < CHANNELS; ch++) {
+            AudioKernels::mulAdd(&acc[ch * BLOCK], &planar[ch * BLOCK], 0.25f, BLOCK);
+        }
+    }));
+
+    // Medidor/acondicionador de la captura
+    InputConditioner cond;
+    cond.prepare(CHANNELS, SAMPLE_RATE);
+    cond.setDcCutoff(20.0f);
+    ReferenceConditioner ref;
+    float target[CHANNELS], peak[CHANNELS] = {};
+    uint32_t clips[CHANNELS] = {};
+    std::fill(target, target + CHANNELS, 1.0f);
+    const float R = 1.0f - 2.0f * static_cast<float>(M_PI) * 20.0f / SAMPLE_RATE;
+    report("conditioner scalar reference", timeBlocks([&] {
+        ref.process(inter.data(), out.data(), BLOCK, CHANNELS, R, 0.001f, target, 0.999f, peak, clips);
+    }));
+    report("conditioner", timeBlocks([&] {
+        cond.process(inter.data(), out.data(), BLOCK);
+    }));
+
+    bool ok = verifyKernels();
+    for (int ch : { 1, 2, 4, 6, 12 }) {
+        ok = verifyConditioner(ch) && ok;
+    }
+    ok = verifyCountSubnormals() && ok;
+
+    // Último: enableFlush() cambia el modo de este hilo para el resto del proceso
+    std::vector<float> state(BLOCK * CHANNELS);
+    size_t subnormals = 0;
+    report("decay to subnormals", timeDecay(state, &subnormals));
+    std::printf("%-30s %zu of %zu samples\n", "  subnormals left", subnormals, state.size());
+    const bool flushed = Denormals::enableFlush();
+    report(flushed ? "decay with FTZ/DAZ" : "decay (FTZ unsupported)", timeDecay(state, &subnormals));
+    std::printf("%-30s %zu of %zu samples\n", "  subnormals left", subnormals, state.size());
+    if (flushed && subnormals != 0) {
+        std::printf("  MISMATCH: subnormals with FTZ/DAZ enabled\n");
+        ok = false;
+    }
+    std::printf("\nOutput match: %s\n", ok ? "OK" : "MISMATCH");
+    return ok ? 0 : 1;
+}
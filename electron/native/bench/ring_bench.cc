@@ -0,0 +1,132 @@
+/**
+ * Benchmark: ring buffer espejado (MirroredRing) frente a los bucles con
+ * `% size` por muestra que usaba PwStream y frente a la copia en dos tramos.
+ *
+ * Simula el camino de salida: el productor escribe bloques de 128 frames
+ * (render quantum) y el consumidor lee quanta de PipeWire de 256 frames,
+ * con 12 canales interleaved y un ring de 4096 frames. Verifica además que
+ * las tres variantes producen exactamente la misma secuencia.
+ *
+ * Compilar y ejecutar (no necesita PipeWire):
+ *   npm run bench:ring
+ */
+
+#include "../src/mirrored_ring.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr int CHANNELS = 12;
+constexpr size_t RING_FRAMES = 4096;
+constexpr size_t WRITE_FRAMES = 128;
+constexpr size_t READ_FRAMES = 256;
+constexpr size_t TOTAL_FRAMES = 48000 * 600;  // 10 minutos @ 48kHz
+
+// Bucle original: `% size` por muestra, un frame de guarda
+struct ModuloRing {
+    std::vector<float> buf;
+    size_t w = 0, r = 0;
+    explicit ModuloRing(size_t samples) : buf(samples, 0.0f) {}
+    size_t used() const { return w >= r ? w - r : buf.size() - r + w; }
+    size_t write(const float* src, size_t n) {
+        n = std::min(n, buf.size() - used() - CHANNELS);
+        for (size_t i = 0; i < n; i++) { buf[w] = src[i]; w = (w + 1) % buf.size(); }
+        return n;
+    }
+    size_t read(float* dst, size_t n) {
+        n = std::min(n, used());
+        for (size_t i = 0; i < n; i++) { dst[i] = buf[r]; r = (r + 1) % buf.size(); }
+        return n;
+    }
+};
+
+// Copia en dos tramos (lo que se hace sobre el SAB, que no se puede espejar)
+struct SplitRing {
+    std::vector<float> buf;
+    size_t w = 0, r = 0, fill = 0;
+    explicit SplitRing(size_t samples) : buf(samples, 0.0f) {}
+    size_t write(const float* src, size_t n) {
+        n = std::min(n, buf.size() - fill);
+        const size_t first = std::min(n, buf.size() - w);
+        std::memcpy(&buf[w], src, first * sizeof(float));
+        std::memcpy(&buf[0], src + first, (n - first) * sizeof(float));
+        w = (w + n) % buf.size();
+        fill += n;
+        return n;
+    }
+    size_t read(float* dst, size_t n) {
+        n = std::min(n, fill);
+        const size_t first = std::min(n, buf.size() - r);
+        std::memcpy(dst, &buf[r], first * sizeof(float));
+        std::memcpy(dst + first, &buf[0], (n - first) * sizeof(float));
+        r = (r + n) % buf.size();
+        fill -= n;
+        return n;
+    }
+};
+
+template <typename Ring>
+double run(Ring& ring, std::vector<float>& out) {
+    std::vector<float> block(WRITE_FRAMES * CHANNELS);
+    std::vector<float> quantum(READ_FRAMES * CHANNELS);
+    size_t produced = 0, consumed = 0;
+    float next = 0.0f;
+    out.clear();
+
+    // Solo se cronometran write()/read(), no la generación de la señal
+    std::chrono::steady_clock::duration elapsed{0};
+    while (consumed < TOTAL_FRAMES) {
+        // Dos quanta de Web Audio por quantum de PipeWire
+        for (int k = 0; k < 2 && produced < TOTAL_FRAMES; k++) {
+            for (float& s : block) { s = next; next += 1.0f; if (next > 1e6f) next = 0.0f; }
+            const auto t0 = std::chrono::steady_clock::now();
+            produced += ring.write(block.data(), block.size()) / CHANNELS;
+            elapsed += std::chrono::steady_clock::now() - t0;
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        const size_t got = ring.read(quantum.data(), quantum.size()) / CHANNELS;
+        elapsed += std::chrono::steady_clock::now() - t0;
+        consumed += got;
+        // Muestreo de la salida para comprobar que las variantes coinciden
+        if (got > 0 && out.size() < 4096) out.push_back(quantum[(got * CHANNELS) / 2]);
+    }
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+} // namespace
+
+int main() {
+    std::vector<float> refOut, splitOut, mirrorOut;
+
+    ModuloRing modulo(RING_FRAMES * CHANNELS);
+    SplitRing split(RING_FRAMES * CHANNELS);
+    MirroredRing mirrored;
+    mirrored.allocate(RING_FRAMES * CHANNELS);
+
+    std::printf("=== Ring buffer benchmark (%d ch, %zu→%zu frames, %zu s @ 48kHz) ===\n",
+                CHANNELS, WRITE_FRAMES, READ_FRAMES, TOTAL_FRAMES / 48000);
+    std::printf("MirroredRing: %s, capacity %zu samples\n\n",
+                mirrored.isMirrored() ? "memfd mirror" : "software mirror", mirrored.capacity());
+
+    // Calentamiento + medida
+    run(modulo, refOut);
+    const double tModulo = run(modulo, refOut);
+    run(split, splitOut);
+    const double tSplit = run(split, splitOut);
+    run(mirrored, mirrorOut);
+    const double tMirror = run(mirrored, mirrorOut);
+
+    const double audioMs = TOTAL_FRAMES * 1000.0 / 48000.0;
+    std::printf("%-22s %9.2f ms  (%7.0fx realtime)\n", "modulo per sample", tModulo, audioMs / tModulo);
+    std::printf("%-22s %9.2f ms  (%7.0fx realtime)\n", "two-span memcpy", tSplit, audioMs / tSplit);
+    std::printf("%-22s %9.2f ms  (%7.0fx realtime)\n", "mirrored (1 span)", tMirror, audioMs / tMirror);
+
+    const bool same = refOut == splitOut && refOut == mirrorOut;
+    std::printf("\nOutput match: %s\n", same ? "OK" : "MISMATCH");
+    return same ? 0 : 1;
+}
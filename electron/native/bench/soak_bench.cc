@@ -0,0 +1,401 @@
+/**
+ * Soak acelerado: PwStream (salida con SAB empaquetado) durante semanas de
+ * audio sobre un reloj virtual, sin PipeWire ni tiempo real.
+ *
+ * Un productor simulado escribe bloques de 128 frames en el SAB igual que
+ * multichannelCapture.worklet.js (índices Int32 con frame de guarda,
+ * descriptor antes de writeIndex, bloque entero descartado si no cabe) y el
+ * consumidor llama a processOutput() con el quantum de PipeWire. Cada
+ * escenario fija la deriva entre ambos relojes (ppm), pausas del productor
+ * (GC del hilo de Web Audio), ráfagas del consumidor y quantum variable.
+ *
+ * Cada frame lleva su número (canal 0: 20 bits bajos, canal 1: resto) y se
+ * comprueba en todo el recorrido:
+ *   - sin corrupción de índices: números estrictamente crecientes y todos
+ *     los frames cuadran (entregados + perdidos por el productor +
+ *     descartados por catch-up + en vuelo = producidos)
+ *   - latencia acotada por el catch-up (y nunca más que ring + SAB)
+ *   - RSS plano: sin crecimiento tras la primera hora simulada
+ * La secuencia de bloques y packetCount arrancan junto al límite de Int32 y
+ * de uint32 para cruzar sus vueltas en los primeros minutos.
+ *
+ * Los escenarios de render-ahead ejecutan el hilo productor sin hilo
+ * (renderAheadStep() cada vez que llega un bloque o se libera margen) con un
+ * passthrough que tarda más que su bloque de vez en cuando, y comprueban
+ * además que el margen renderizado nunca pasa de renderAheadFrames ni baja
+ * de un quantum con el mismo reloj, que cada bloque lento cuenta como pico
+ * y que el catch-up descarta del SAB cuando el AudioContext va rápido.
+ *
+ * Compilar y ejecutar (necesita las cabeceras y la librería de PipeWire
+ * para enlazar, pero no el daemon; nunca se llama a start()):
+ *   npm run bench:soak            # 3 días de audio por escenario (~16 min)
+ *   npm run bench:soak -- 14      # 2 semanas por escenario
+ */
+
+#include "../src/audio_health.h"
+#include "../src/native_processor.h"
+#include "../src/pw_stream.h"
+#include "../src/sab_packets.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr int CHANNELS = 2;
+constexpr size_t BLOCK_FRAMES = 128;          // Render quantum de Web Audio
+constexpr size_t SAB_FRAMES = 8192;           // SHARED_BUFFER_FRAMES de audioSetup.js
+constexpr size_t PACKET_SLOTS = 2 * SAB_FRAMES / BLOCK_FRAMES;
+constexpr size_t PREBUFFER_FRAMES = 2048;
+constexpr size_t RING_FRAMES = 4096;
+constexpr uint32_t QUANTUM = 256;
+constexpr uint32_t LOW_BITS = 20;             // Frames por canal exactos en float32
+constexpr double WARMUP_SECONDS = 3600.0;     // RSS de referencia tras 1 h simulada
+constexpr long RSS_GROWTH_LIMIT = 1 << 20;
+constexpr size_t RENDER_AHEAD_BLOCKS = 8;     // 1024 frames de margen
+constexpr uint64_t SLOW_BLOCK_EVERY = 65536;  // Un bloque lento cada ~3 min
+
+// Pausas periódicas: durante `duration` s de cada `period` s el lado no
+// avanza y al acabar atiende de golpe lo acumulado
+struct Stall {
+    double period = 0;
+    double duration = 0;
+    double phase = 0;
+
+    double release(double t) const {
+        if (period <= 0) return t;
+        const double into = std::fmod(t + phase, period);
+        return into < duration ? t - into + duration : t;
+    }
+};
+
+struct Scenario {
+    const char* name;
+    double skewPpm;      // > 0: el AudioContext va más rápido que el grafo
+    Stall producer;
+    Stall consumer;
+    bool jitter;         // Quantum de PipeWire 255..257 (ajuste de tasa)
+    bool renderAhead;
+};
+
+const Scenario SCENARIOS[] = {
+    { "same clock",                    0, {},               {},               false, false },
+    { "+500 ppm (JS fast)",          500, {},               {},               false, false },
+    { "-500 ppm (JS slow)",         -500, {},               {},               false, false },
+    { "+100 ppm, GC 60ms/30s",       100, { 30, 0.060, 7 }, {},               false, false },
+    { "-100 ppm, PW bursts 25ms/10s", -100, {},             { 10, 0.025, 3 }, true,  false },
+    { "render-ahead, same clock",      0, {},               {},               false, true  },
+    { "render-ahead, +500 ppm",      500, {},               {},               false, true  },
+};
+
+// Passthrough que tarda más que su bloque (2.67 ms) cada SLOW_BLOCK_EVERY
+class SlowPassthrough : public NativeProcessor {
+public:
+    explicit SlowPassthrough(int channels) : channels_(channels) {}
+    const char* type() const override { return "slow-passthrough"; }
+
+    void process(const float* const* in, float* const* out, int frames) override {
+        for (int ch = 0; ch < channels_; ch++) {
+            std::memcpy(out[ch], in[ch], frames * sizeof(float));
+        }
+        if (++blocks_ % SLOW_BLOCK_EVERY == 0) {
+            const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(4);
+            while (std::chrono::steady_clock::now() < until) {}
+            slowBlocks++;
+        }
+    }
+
+    uint64_t slowBlocks = 0;
+
+private:
+    int channels_;
+    uint64_t blocks_ = 0;
+};
+
+long residentBytes() {
+    long pages = 0, resident = 0;
+    if (FILE* f = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+        std::fclose(f);
+    }
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+// Productor: mismo protocolo que writeToSharedBuffer/writePacket del worklet
+struct Producer {
+    std::atomic<int32_t>* control;   // [0] writeIndex, [1] readIndex
+    float* audio;
+    std::atomic<int32_t>* packetHeader;
+    uint8_t* packetSlots;
+
+    int32_t blockSeq = INT32_MAX - 1000;
+    uint64_t contextFrame = 0;       // currentFrame del AudioContext
+    uint64_t droppedFrames = 0;
+    float block[BLOCK_FRAMES * CHANNELS];
+
+    void writePacket(int32_t seq) {
+        const uint32_t count = static_cast<uint32_t>(packetHeader[0].load(std::memory_order_relaxed));
+        uint8_t* slot = packetSlots + (count % PACKET_SLOTS) * SabPackets::SLOT_BYTES;
+        const int32_t frames = BLOCK_FRAMES;
+        const double frame = static_cast<double>(contextFrame);
+        const double time = frame / SAMPLE_RATE;
+        std::memcpy(slot, &seq, sizeof(seq));
+        std::memcpy(slot + 4, &frames, sizeof(frames));
+        std::memcpy(slot + 16, &frame, sizeof(frame));
+        std::memcpy(slot + 24, &time, sizeof(time));
+        packetHeader[0].store(static_cast<int32_t>(count + 1), std::memory_order_release);
+    }
+
+    void process() {
+        const int32_t seq = blockSeq;
+        blockSeq = static_cast<int32_t>(static_cast<uint32_t>(blockSeq) + 1);
+
+        // Número de frame + 1: el 0 queda para el silencio
+        for (size_t i = 0; i < BLOCK_FRAMES; i++) {
+            const uint64_t n = contextFrame + i + 1;
+            block[i * CHANNELS] = static_cast<float>(n & ((1u << LOW_BITS) - 1));
+            block[i * CHANNELS + 1] = static_cast<float>(n >> LOW_BITS);
+        }
+
+        const int32_t writeIndex = control[0].load(std::memory_order_relaxed);
+        const int32_t readIndex = control[1].load(std::memory_order_acquire);
+        const int32_t available = writeIndex >= readIndex
+            ? static_cast<int32_t>(SAB_FRAMES) - (writeIndex - readIndex) - 1
+            : readIndex - writeIndex - 1;
+
+        if (static_cast<int32_t>(BLOCK_FRAMES) > available) {
+            droppedFrames += BLOCK_FRAMES;
+        } else {
+            const size_t first = std::min(BLOCK_FRAMES, SAB_FRAMES - static_cast<size_t>(writeIndex));
+            std::memcpy(&audio[static_cast<size_t>(writeIndex) * CHANNELS], block,
+                        first * CHANNELS * sizeof(float));
+            std::memcpy(audio, block + first * CHANNELS,
+                        (BLOCK_FRAMES - first) * CHANNELS * sizeof(float));
+            writePacket(seq);
+            control[0].store(static_cast<int32_t>((writeIndex + BLOCK_FRAMES) % SAB_FRAMES),
+                             std::memory_order_release);
+        }
+        contextFrame += BLOCK_FRAMES;
+    }
+
+    size_t fill() const {
+        const int32_t w = control[0].load(std::memory_order_acquire);
+        const int32_t r = control[1].load(std::memory_order_acquire);
+        return w >= r ? static_cast<size_t>(w - r) : SAB_FRAMES - static_cast<size_t>(r - w);
+    }
+};
+
+struct Result {
+    bool ok = true;
+    double wallSeconds = 0;
+    uint64_t delivered = 0;
+    uint64_t maxLatency = 0;
+    size_t minMargin = SIZE_MAX;     // Render-ahead: renderizado antes de cada ciclo
+    double finalLatency = 0;         // Media de la última hora simulada
+    long rssGrowth = 0;
+};
+
+bool fail(Result& r, const char* what, uint64_t a, uint64_t b) {
+    std::printf("  FAIL: %s (%llu vs %llu)\n", what,
+                static_cast<unsigned long long>(a), static_cast<unsigned long long>(b));
+    r.ok = false;
+    return false;
+}
+
+Result runScenario(const Scenario& sc, double seconds) {
+    Result r;
+    AudioHealth::output().reset();
+
+    // SAB con el layout de audioSetup.js (alineado a 8 para la tabla)
+    const size_t packetOffset = SabPackets::regionOffset(SAB_FRAMES, CHANNELS);
+    const size_t sabBytes = packetOffset + SabPackets::regionBytes(PACKET_SLOTS);
+    std::vector<uint64_t> sab((sabBytes + 7) / 8, 0);
+    uint8_t* base = reinterpret_cast<uint8_t*>(sab.data());
+
+    Producer prod;
+    prod.control = reinterpret_cast<std::atomic<int32_t>*>(base);
+    prod.audio = reinterpret_cast<float*>(base + 8);
+    prod.packetHeader = reinterpret_cast<std::atomic<int32_t>*>(base + packetOffset);
+    prod.packetSlots = base + packetOffset + SabPackets::HEADER_BYTES;
+    // packetCount cruza 2^31 (Int32) y luego 2^32 (uint32 del lector)
+    prod.packetHeader[0].store(static_cast<int32_t>(UINT32_MAX - 20000u));
+
+    PwStream stream("soak", CHANNELS, SAMPLE_RATE, QUANTUM, StreamDirection::OUTPUT);
+    stream.setLatency(PREBUFFER_FRAMES, RING_FRAMES);
+    stream.setCatchUp(true);  // Opcional en la app; aquí se ejercita
+    if (!stream.attachSharedBuffer(base, sabBytes, SAB_FRAMES, PACKET_SLOTS)) {
+        fail(r, "attachSharedBuffer", 0, 0);
+        return r;
+    }
+    SlowPassthrough* slow = nullptr;
+    if (sc.renderAhead) {
+        auto processor = std::make_unique<SlowPassthrough>(CHANNELS);
+        slow = processor.get();
+        if (!stream.setRenderAhead(std::move(processor), RENDER_AHEAD_BLOCKS) ||
+            !stream.prepareRenderAhead()) {
+            fail(r, "render-ahead setup", 0, 0);
+            return r;
+        }
+    }
+    const size_t ringFrames = stream.getRingBufferFrames();
+    const uint64_t latencyCap = ringFrames + SAB_FRAMES;
+    const size_t aheadFrames = stream.getRenderAheadFrames();
+    bool started = false;            // Render-ahead: margen lleno una vez
+
+    std::vector<float> out(static_cast<size_t>(QUANTUM + 1) * CHANNELS);
+    const double producerRate = SAMPLE_RATE * (1.0 + sc.skewPpm * 1e-6);
+    uint64_t blocks = 0;
+    uint64_t graphFrames = 0;        // Reloj del grafo (frames pedidos)
+    uint64_t lastFrame = 0;          // Último número entregado
+    uint32_t lcg = 12345;
+    long rssWarm = 0;
+    double finalSum = 0;
+    uint64_t finalCycles = 0;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    while (r.ok) {
+        const double tConsumer = static_cast<double>(graphFrames) / SAMPLE_RATE;
+        if (tConsumer >= seconds) break;
+        const double tProducer = static_cast<double>(blocks * BLOCK_FRAMES) / producerRate;
+
+        if (sc.producer.release(tProducer) <= sc.consumer.release(tConsumer)) {
+            prod.process();
+            blocks++;
+            if (sc.renderAhead) stream.renderAheadStep();
+            continue;
+        }
+
+        uint32_t frames = QUANTUM;
+        if (sc.jitter) {
+            lcg = lcg * 1664525u + 1013904223u;
+            frames = QUANTUM - 1 + (lcg >> 30) % 3;
+        }
+        if (sc.renderAhead) {
+            stream.renderAheadStep();
+            const size_t margin = stream.getBufferedFrames();
+            if (margin > aheadFrames) fail(r, "render-ahead margin above limit", margin, aheadFrames);
+            started = started || margin >= aheadFrames;
+            if (started) r.minMargin = std::min(r.minMargin, margin);
+        }
+        stream.processOutput(out.data(), frames);
+        graphFrames += frames;
+
+        // Numeración: silencio entero o frames crecientes sin canales mezclados
+        for (uint32_t i = 0; i < frames; i++) {
+            const float lo = out[i * CHANNELS];
+            const float hi = out[i * CHANNELS + 1];
+            if (lo == 0.0f && hi == 0.0f) continue;
+            const uint64_t n = (static_cast<uint64_t>(hi) << LOW_BITS) | static_cast<uint64_t>(lo);
+            if (n <= lastFrame || n > prod.contextFrame) {
+                fail(r, "frame out of order", n, lastFrame);
+                break;
+            }
+            lastFrame = n;
+            r.delivered++;
+        }
+
+        // Latencia: lo producido que aún no ha sonado (reloj del AudioContext)
+        if (lastFrame > 0) {
+            const uint64_t latency = prod.contextFrame - lastFrame;
+            r.maxLatency = std::max(r.maxLatency, latency);
+            if (latency > latencyCap) fail(r, "latency beyond ring + SAB", latency, latencyCap);
+            if (tConsumer >= seconds - 3600.0) {
+                finalSum += static_cast<double>(latency);
+                finalCycles++;
+            }
+        }
+
+        if (rssWarm == 0 && tConsumer >= WARMUP_SECONDS) rssWarm = residentBytes();
+    }
+    r.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    r.finalLatency = finalCycles ? finalSum / static_cast<double>(finalCycles) : 0;
+    r.rssGrowth = rssWarm ? residentBytes() - rssWarm : 0;
+
+    // Contabilidad: cada frame producido está en exactamente un sitio
+    const AudioHealth::Snapshot health = AudioHealth::output().snapshot();
+    const uint64_t inFlight = stream.getBufferedFrames() + prod.fill();
+    const uint64_t accounted = r.delivered + prod.droppedFrames + health.catchUpFrames + inFlight;
+    if (r.ok && accounted != prod.contextFrame) {
+        fail(r, "frames lost or duplicated", accounted, prod.contextFrame);
+    }
+    // Tras el último catch-up la latencia vuelve por debajo del ring
+    if (r.ok && r.finalLatency > static_cast<double>(ringFrames + QUANTUM + BLOCK_FRAMES)) {
+        fail(r, "steady-state latency above ring", static_cast<uint64_t>(r.finalLatency), ringFrames);
+    }
+    if (r.ok && r.rssGrowth > RSS_GROWTH_LIMIT) {
+        fail(r, "RSS growth", static_cast<uint64_t>(r.rssGrowth), RSS_GROWTH_LIMIT);
+    }
+    if (r.ok && stream.packets().getDiscontinuities() > 0) {
+        fail(r, "packet table discontinuity", stream.packets().getDiscontinuities(), 0);
+    }
+    if (sc.renderAhead && r.ok) {
+        // Con el mismo reloj el margen cubre siempre el quantum
+        if (sc.skewPpm == 0 && r.minMargin < QUANTUM) {
+            fail(r, "render-ahead margin below one quantum", r.minMargin, QUANTUM);
+        } else if (sc.skewPpm == 0 && health.underflows > 0) {
+            fail(r, "underflows with render-ahead", health.underflows, 0);
+        } else if (stream.getRenderSpikes() < slow->slowBlocks) {
+            fail(r, "slow blocks not counted as spikes", stream.getRenderSpikes(), slow->slowBlocks);
+        } else if (sc.skewPpm > 0 && health.catchUps == 0) {
+            fail(r, "no catch-up with a fast producer", 0, 1);
+        }
+    }
+
+    std::printf("  underflows %llu, catch-ups %llu (%llu frames), dropped blocks %zu\n",
+                static_cast<unsigned long long>(health.underflows),
+                static_cast<unsigned long long>(health.catchUps),
+                static_cast<unsigned long long>(health.catchUpFrames),
+                stream.packets().getDroppedBlocks());
+    std::printf("  latency max %llu frames, last hour %.0f frames, drift %+.1f ppm, RSS %+ld KiB\n",
+                static_cast<unsigned long long>(r.maxLatency), r.finalLatency,
+                stream.packets().getDriftPpm(), r.rssGrowth / 1024);
+    if (sc.renderAhead) {
+        std::printf("  render-ahead %zu frames, min margin %zu, spikes %zu (slow blocks %llu), max %.0f us\n",
+                    aheadFrames, r.minMargin == SIZE_MAX ? 0 : r.minMargin, stream.getRenderSpikes(),
+                    static_cast<unsigned long long>(slow->slowBlocks), stream.getMaxRenderUs());
+    }
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double days = argc > 1 ? std::atof(argv[1]) : 3.0;
+    if (days <= 0) {
+        std::fprintf(stderr, "usage: soak_bench [days per scenario]\n");
+        return 2;
+    }
+    // Al menos dos horas: la de calentamiento y la última medida
+    const double seconds = std::max(days * 86400.0, 2 * WARMUP_SECONDS);
+
+    std::printf("=== PwStream soak (%d ch, SAB %zu, ring %zu, prebuffer %zu, %.1f days/scenario) ===\n",
+                CHANNELS, SAB_FRAMES, RING_FRAMES, PREBUFFER_FRAMES, seconds / 86400.0);
+
+    bool ok = true;
+    double wall = 0, audio = 0;
+    for (const Scenario& sc : SCENARIOS) {
+        std::printf("\n%s\n", sc.name);
+        const Result r = runScenario(sc, seconds);
+        const double framesPerSec = static_cast<double>(r.delivered) / r.wallSeconds;
+        std::printf("  %.1f s wall, %.1f Mframes/s (%.0fx realtime): %s\n", r.wallSeconds,
+                    framesPerSec / 1e6, seconds / r.wallSeconds, r.ok ? "OK" : "FAIL");
+        ok = ok && r.ok;
+        wall += r.wallSeconds;
+        audio += seconds;
+    }
+
+    std::printf("\n%.1f days of audio in %.1f s (%.0fx realtime): %s\n",
+                audio / 86400.0, wall, audio / wall, ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -4,7 +4,19 @@
       "target_name": "pipewire_audio",
       "sources": [
         "src/pipewire_audio.cc",
-        "src/pw_stream.cc"
+        "src/pw_stream.cc",
+        "src/link_manager.cc",
+        "src/sab_notifier.cc",
+        "src/sab_packets.cc",
+        "src/shm_bridge.cc",
+        "src/mirrored_ring.cc",
+        "src/audio_health.cc",
+        "src/audio_kernels.cc",
+        "src/input_conditioner.cc",
+        "src/native_processor.cc",
+        "src/automation_lane.cc",
+        "src/processor_bridge.cc",
+        "src/phosphor_scope.cc"
       ],
       "include_dirs": [
         "<!(node -p \"require('node-addon-api').include_dir\")"
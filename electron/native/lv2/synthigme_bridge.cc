@@ -0,0 +1,212 @@
+/**
+ * synthigme-bridge.lv2 - Envío/retorno con una instancia de SynthiGME
+ *
+ * Plugin LV2 estéreo que intercambia audio con la app a través de los rings
+ * en memoria compartida de ShmBridge (src/shm_bridge.h), sin pasar por el
+ * grafo PipeWire:
+ *
+ *   in_l/in_r   → ring de envío   → se suma a la captura de SynthiGME
+ *   out_l/out_r ← ring de retorno ← copia de la salida de SynthiGME
+ *
+ * Procesa en el callback del DAW y publica en el puerto `latency`
+ * (lv2:reportsLatency) la ida y vuelta que declara la app, para que el host
+ * compense. Sin la app en marcha (o con otra frecuencia de muestreo) la
+ * salida es silencio y `connected` vale 0.
+ *
+ * La conexión (shm_open/mmap) no es apta para el hilo de audio: se hace en
+ * activate() y, si el host ofrece work:schedule, se reintenta desde el hilo
+ * worker una vez por segundo mientras no haya app.
+ */
+
+#include "shm_bridge.h"
+
+#include <lv2/core/lv2.h>
+#include <lv2/worker/worker.h>
+
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#define BRIDGE_URI "https://github.com/mesjetiu/SynthiGME-web/lv2/bridge"
+
+namespace {
+
+enum Port {
+    PORT_IN_L = 0,
+    PORT_IN_R,
+    PORT_OUT_L,
+    PORT_OUT_R,
+    PORT_LATENCY,
+    PORT_CONNECTED,
+    PORT_COUNT
+};
+
+struct Bridge {
+    double sampleRate = 0;
+    const float* in[2] = { nullptr, nullptr };
+    float* out[2] = { nullptr, nullptr };
+    float* latency = nullptr;
+    float* connected = nullptr;
+
+    // Dos segmentos: el hilo de audio usa bridges[active]; el worker abre y
+    // cierra siempre el otro, y work_response() los intercambia
+    ShmBridge bridges[2];
+    int active = 0;
+    bool linked = false;              // bridges[active] conectado y válido
+    bool workPending = false;
+    uint32_t retryFrames = 0;
+    LV2_Worker_Schedule* schedule = nullptr;
+};
+
+// Abre el segmento de la app en `bridge` si es compatible con el host
+bool connectBridge(ShmBridge& bridge, double sampleRate) {
+    if (!bridge.open(ShmBridge::DEFAULT_NAME)) {
+        return false;
+    }
+    if (std::lround(sampleRate) != bridge.sampleRate()) {
+        bridge.close();
+        return false;
+    }
+    return true;
+}
+
+LV2_Handle instantiate(const LV2_Descriptor*, double rate, const char*,
+                       const LV2_Feature* const* features) {
+    Bridge* self = new (std::nothrow) Bridge();
+    if (!self) {
+        return nullptr;
+    }
+    self->sampleRate = rate;
+    for (int i = 0; features && features[i]; i++) {
+        if (!std::strcmp(features[i]->URI, LV2_WORKER__schedule)) {
+            self->schedule = static_cast<LV2_Worker_Schedule*>(features[i]->data);
+        }
+    }
+    return self;
+}
+
+void connectPort(LV2_Handle instance, uint32_t port, void* data) {
+    Bridge* self = static_cast<Bridge*>(instance);
+    switch (port) {
+        case PORT_IN_L:      self->in[0] = static_cast<const float*>(data); break;
+        case PORT_IN_R:      self->in[1] = static_cast<const float*>(data); break;
+        case PORT_OUT_L:     self->out[0] = static_cast<float*>(data); break;
+        case PORT_OUT_R:     self->out[1] = static_cast<float*>(data); break;
+        case PORT_LATENCY:   self->latency = static_cast<float*>(data); break;
+        case PORT_CONNECTED: self->connected = static_cast<float*>(data); break;
+        default: break;
+    }
+}
+
+void activate(LV2_Handle instance) {
+    Bridge* self = static_cast<Bridge*>(instance);
+    self->linked = connectBridge(self->bridges[self->active], self->sampleRate);
+    self->retryFrames = 0;
+}
+
+void run(LV2_Handle instance, uint32_t frames) {
+    Bridge* self = static_cast<Bridge*>(instance);
+    ShmBridge& bridge = self->bridges[self->active];
+
+    // La app cerró o recreó el puente: dejar de usarlo y buscar otro
+    if (self->linked && !bridge.hasPeer()) {
+        self->linked = false;
+    }
+
+    if (!self->linked) {
+        for (float* out : self->out) {
+            if (out) {
+                std::memset(out, 0, frames * sizeof(float));
+            }
+        }
+        self->retryFrames += frames;
+        if (self->schedule && !self->workPending && self->retryFrames >= self->sampleRate) {
+            self->retryFrames = 0;
+            self->workPending = self->schedule->schedule_work(self->schedule->handle, 0, nullptr) ==
+                                LV2_WORKER_SUCCESS;
+        }
+    } else {
+        // Hasta MAX_CHANNELS canales en el ring: los que no son puertos, a 0
+        const float* send[ShmBridge::MAX_CHANNELS] = { self->in[0], self->in[1] };
+        float* ret[ShmBridge::MAX_CHANNELS] = { self->out[0], self->out[1] };
+        bridge.writePlanar(ShmBridge::SEND, send, frames);
+        bridge.readPlanar(ShmBridge::RETURN, ret, frames);
+
+        // Retorno mono: mismo canal en ambas salidas
+        if (bridge.channels(ShmBridge::RETURN) == 1 && self->out[0] && self->out[1]) {
+            std::memcpy(self->out[1], self->out[0], frames * sizeof(float));
+        }
+    }
+
+    if (self->latency) {
+        *self->latency = self->linked ? static_cast<float>(bridge.header()->reportedLatency.load()) : 0.0f;
+    }
+    if (self->connected) {
+        *self->connected = self->linked ? 1.0f : 0.0f;
+    }
+}
+
+void deactivate(LV2_Handle instance) {
+    Bridge* self = static_cast<Bridge*>(instance);
+    self->linked = false;
+    self->bridges[self->active].close();
+}
+
+void cleanup(LV2_Handle instance) {
+    delete static_cast<Bridge*>(instance);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Worker - conexión fuera del hilo de audio
+// ═══════════════════════════════════════════════════════════════════════════
+
+LV2_Worker_Status work(LV2_Handle instance, LV2_Worker_Respond_Function respond,
+                       LV2_Worker_Respond_Handle handle, uint32_t, const void*) {
+    Bridge* self = static_cast<Bridge*>(instance);
+    // Solo hay un trabajo en curso y run() no cambia `active` mientras tanto
+    const int standby = 1 - self->active;
+    ShmBridge& bridge = self->bridges[standby];
+    bridge.close();  // Segmento anterior, ya sin uso
+    const int32_t result = connectBridge(bridge, self->sampleRate) ? standby : -1;
+    return respond(handle, sizeof(result), &result);
+}
+
+LV2_Worker_Status workResponse(LV2_Handle instance, uint32_t size, const void* body) {
+    Bridge* self = static_cast<Bridge*>(instance);
+    self->workPending = false;
+    if (size != sizeof(int32_t)) {
+        return LV2_WORKER_ERR_UNKNOWN;
+    }
+    int32_t result;
+    std::memcpy(&result, body, sizeof(result));
+    if (result >= 0) {
+        self->active = result;
+        self->linked = true;
+    }
+    return LV2_WORKER_SUCCESS;
+}
+
+const void* extensionData(const char* uri) {
+    static const LV2_Worker_Interface worker = { work, workResponse, nullptr };
+    if (!std::strcmp(uri, LV2_WORKER__interface)) {
+        return &worker;
+    }
+    return nullptr;
+}
+
+const LV2_Descriptor descriptor = {
+    BRIDGE_URI,
+    instantiate,
+    connectPort,
+    activate,
+    run,
+    deactivate,
+    cleanup,
+    extensionData
+};
+
+}  // namespace
+
+extern "C" LV2_SYMBOL_EXPORT const LV2_Descriptor* lv2_descriptor(uint32_t index) {
+    return index == 0 ? &descriptor : nullptr;
+}
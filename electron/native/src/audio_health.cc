@@ -0,0 +1,149 @@
+/**
+ * AudioHealth implementation
+ */
+
+#include "audio_health.h"
+#include <algorithm>
+
+AudioHealth& AudioHealth::output() {
+    static AudioHealth instance;
+    return instance;
+}
+
+AudioHealth& AudioHealth::input() {
+    static AudioHealth instance;
+    return instance;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Registro
+// ═══════════════════════════════════════════════════════════════════════════
+
+void AudioHealth::onStreamStart(int sampleRate, size_t prebufferFrames, bool driverMode) {
+    if (sampleRate > 0) {
+        sampleRate_.store(sampleRate, std::memory_order_relaxed);
+        prebufferMs_.store(static_cast<uint32_t>(prebufferFrames * 1000 / sampleRate),
+                           std::memory_order_relaxed);
+    }
+    driverMode_.store(driverMode, std::memory_order_relaxed);
+    streams_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioHealth::onFormat(uint32_t rate, uint32_t channels, const char* formatName) {
+    rate_.store(rate, std::memory_order_relaxed);
+    channels_.store(channels, std::memory_order_relaxed);
+    format_.store(formatName, std::memory_order_relaxed);
+    if (rate > 0) {
+        sampleRate_.store(static_cast<int>(rate), std::memory_order_relaxed);
+    }
+}
+
+void AudioHealth::onCycle(uint32_t frames, size_t latencyFrames, uint64_t callbackNs) {
+    if (frames == 0) return;
+    const uint64_t rate = static_cast<uint64_t>(sampleRate_.load(std::memory_order_relaxed));
+
+    const uint64_t latencyMs = latencyFrames * 1000 / rate;
+    latencyHist_[std::min<uint64_t>(latencyMs, LATENCY_BINS - 1)]
+        .fetch_add(1, std::memory_order_relaxed);
+
+    // Carga: duración del callback respecto al tiempo que representa el quantum
+    const uint64_t quantumNs = static_cast<uint64_t>(frames) * 1000000000ULL / rate;
+    const uint64_t loadPct = quantumNs > 0 ? callbackNs * 100 / quantumNs : 0;
+    loadHist_[std::min<uint64_t>(loadPct, LOAD_BINS - 1)]
+        .fetch_add(1, std::memory_order_relaxed);
+
+    quantum_.store(frames, std::memory_order_relaxed);
+    uint32_t lo = quantumMin_.load(std::memory_order_relaxed);
+    while ((lo == 0 || frames < lo) &&
+           !quantumMin_.compare_exchange_weak(lo, frames, std::memory_order_relaxed)) {}
+    uint32_t hi = quantumMax_.load(std::memory_order_relaxed);
+    while (frames > hi &&
+           !quantumMax_.compare_exchange_weak(hi, frames, std::memory_order_relaxed)) {}
+
+    cycles_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioHealth::onCatchUp(size_t droppedFrames) {
+    catchUps_.fetch_add(1, std::memory_order_relaxed);
+    catchUpFrames_.fetch_add(droppedFrames, std::memory_order_relaxed);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Lectura
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <size_t N>
+AudioHealth::Percentiles AudioHealth::percentiles(const std::atomic<uint32_t> (&hist)[N]) {
+    uint64_t counts[N];
+    uint64_t total = 0;
+    for (size_t i = 0; i < N; i++) {
+        counts[i] = hist[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    Percentiles p;
+    if (total == 0) return p;
+
+    // Primer bin cuyo acumulado alcanza cada percentil
+    const uint64_t t50 = (total * 50 + 99) / 100;
+    const uint64_t t95 = (total * 95 + 99) / 100;
+    const uint64_t t99 = (total * 99 + 99) / 100;
+    uint64_t acc = 0;
+    bool has50 = false, has95 = false, has99 = false;
+    for (size_t i = 0; i < N; i++) {
+        if (counts[i] == 0) continue;
+        acc += counts[i];
+        if (!has50 && acc >= t50) { p.p50 = static_cast<uint32_t>(i); has50 = true; }
+        if (!has95 && acc >= t95) { p.p95 = static_cast<uint32_t>(i); has95 = true; }
+        if (!has99 && acc >= t99) { p.p99 = static_cast<uint32_t>(i); has99 = true; }
+        p.max = static_cast<uint32_t>(i);
+    }
+    return p;
+}
+
+AudioHealth::Snapshot AudioHealth::snapshot() const {
+    Snapshot s;
+    s.streams = streams_.load(std::memory_order_relaxed);
+    s.cycles = cycles_.load(std::memory_order_relaxed);
+    s.underflows = underflows_.load(std::memory_order_relaxed);
+    s.overflows = overflows_.load(std::memory_order_relaxed);
+    s.catchUps = catchUps_.load(std::memory_order_relaxed);
+    s.catchUpFrames = catchUpFrames_.load(std::memory_order_relaxed);
+    s.latencyOverruns = latencyOverruns_.load(std::memory_order_relaxed);
+    s.latencyMs = percentiles(latencyHist_);
+    s.loadPct = percentiles(loadHist_);
+    s.quantum = quantum_.load(std::memory_order_relaxed);
+    s.quantumMin = quantumMin_.load(std::memory_order_relaxed);
+    s.quantumMax = quantumMax_.load(std::memory_order_relaxed);
+    s.rate = rate_.load(std::memory_order_relaxed);
+    s.channels = channels_.load(std::memory_order_relaxed);
+    const char* format = format_.load(std::memory_order_relaxed);
+    s.format = format ? format : "";
+    s.prebufferMs = prebufferMs_.load(std::memory_order_relaxed);
+    s.driverMode = driverMode_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void AudioHealth::reset() {
+    for (auto& bin : latencyHist_) bin.store(0, std::memory_order_relaxed);
+    for (auto& bin : loadHist_) bin.store(0, std::memory_order_relaxed);
+    streams_.store(0);
+    cycles_.store(0);
+    underflows_.store(0);
+    overflows_.store(0);
+    catchUps_.store(0);
+    catchUpFrames_.store(0);
+    latencyOverruns_.store(0);
+    quantum_.store(0);
+    quantumMin_.store(0);
+    quantumMax_.store(0);
+    // La descripción del stream también: un snapshot tras reset no mezcla
+    // contadores nuevos con el formato/latencia de la sesión anterior.
+    // onStreamStart/onFormat la rellenan de nuevo (sampleRate_ se conserva:
+    // solo convierte frames → ms).
+    rate_.store(0, std::memory_order_relaxed);
+    channels_.store(0, std::memory_order_relaxed);
+    format_.store(nullptr, std::memory_order_relaxed);
+    prebufferMs_.store(0, std::memory_order_relaxed);
+    driverMode_.store(false, std::memory_order_relaxed);
+}
@@ -0,0 +1,111 @@
+/**
+ * AudioHealth - Agregados de salud del audio nativo por sesión
+ *
+ * Acumula, para todo el proceso y por dirección (salida/entrada), lo que
+ * necesita la telemetría para saber con qué ajustes de latencia se producen
+ * cortes: underflows/overflows, catch-ups, percentiles de latencia y de carga
+ * del callback, y el formato/quantum negociado con PipeWire.
+ *
+ * Sobrevive a cierres y reaperturas de streams (cambio de modo de salida,
+ * de latencia, etc.): cada PwStream informa a la instancia de su dirección.
+ *
+ * Registro desde el hilo de audio: solo atomics relajados sobre histogramas
+ * de tamaño fijo (sin reservas ni locks). snapshot() calcula los percentiles
+ * desde el histograma en el hilo JS.
+ */
+
+#ifndef AUDIO_HEALTH_H
+#define AUDIO_HEALTH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class AudioHealth {
+public:
+    // Histogramas: latencia en ms (1 ms por bin) y carga en % del quantum
+    static constexpr size_t LATENCY_BINS = 256;  // Último bin: ≥ 255 ms
+    static constexpr size_t LOAD_BINS = 101;     // Último bin: ≥ 100 %
+
+    struct Percentiles {
+        uint32_t p50 = 0;
+        uint32_t p95 = 0;
+        uint32_t p99 = 0;
+        uint32_t max = 0;
+    };
+
+    struct Snapshot {
+        uint64_t streams = 0;        // Streams arrancados en la sesión
+        uint64_t cycles = 0;         // Callbacks process() registrados
+        uint64_t underflows = 0;     // Ciclos con silencio por falta de datos
+        uint64_t overflows = 0;      // Ciclos con datos descartados
+        uint64_t catchUps = 0;       // Recortes de latencia acumulada
+        uint64_t catchUpFrames = 0;  // Frames descartados por catch-up
+        uint64_t latencyOverruns = 0; // Latencia por encima del ring sin catch-up
+        Percentiles latencyMs;
+        Percentiles loadPct;
+        uint32_t quantum = 0;        // Último quantum observado (frames)
+        uint32_t quantumMin = 0;
+        uint32_t quantumMax = 0;
+        uint32_t rate = 0;           // Formato negociado (0 = sin negociar)
+        uint32_t channels = 0;
+        std::string format;
+        uint32_t prebufferMs = 0;    // Latencia configurada del último stream
+        bool driverMode = false;
+    };
+
+    static AudioHealth& output();
+    static AudioHealth& input();
+
+    AudioHealth() = default;
+    AudioHealth(const AudioHealth&) = delete;
+    AudioHealth& operator=(const AudioHealth&) = delete;
+
+    // Hilo JS, al arrancar un stream
+    void onStreamStart(int sampleRate, size_t prebufferFrames, bool driverMode);
+    // Hilo del loop PipeWire, al negociar formato. formatName debe ser un
+    // literal (se guarda el puntero).
+    void onFormat(uint32_t rate, uint32_t channels, const char* formatName);
+
+    // Hilo de audio
+    void onCycle(uint32_t frames, size_t latencyFrames, uint64_t callbackNs);
+    void onUnderflow() { underflows_.fetch_add(1, std::memory_order_relaxed); }
+    void onOverflow() { overflows_.fetch_add(1, std::memory_order_relaxed); }
+    void onCatchUp(size_t droppedFrames);
+    void onLatencyOverrun() { latencyOverruns_.fetch_add(1, std::memory_order_relaxed); }
+
+    Snapshot snapshot() const;
+    // Pone a cero contadores, histogramas y la descripción del stream
+    // (rate, canales, formato, prebuffer, modo driver) hasta el próximo
+    // onStreamStart/onFormat.
+    void reset();
+
+private:
+    template <size_t N>
+    static Percentiles percentiles(const std::atomic<uint32_t> (&hist)[N]);
+
+    std::atomic<uint32_t> latencyHist_[LATENCY_BINS] = {};
+    std::atomic<uint32_t> loadHist_[LOAD_BINS] = {};
+
+    std::atomic<uint64_t> streams_{0};
+    std::atomic<uint64_t> cycles_{0};
+    std::atomic<uint64_t> underflows_{0};
+    std::atomic<uint64_t> overflows_{0};
+    std::atomic<uint64_t> catchUps_{0};
+    std::atomic<uint64_t> catchUpFrames_{0};
+    std::atomic<uint64_t> latencyOverruns_{0};
+
+    std::atomic<uint32_t> quantum_{0};
+    std::atomic<uint32_t> quantumMin_{0};
+    std::atomic<uint32_t> quantumMax_{0};
+
+    std::atomic<int> sampleRate_{48000};     // Para convertir frames → ms
+    std::atomic<uint32_t> rate_{0};
+    std::atomic<uint32_t> channels_{0};
+    std::atomic<const char*> format_{nullptr};
+    std::atomic<uint32_t> prebufferMs_{0};
+    std::atomic<bool> driverMode_{false};
+};
+
+#endif // AUDIO_HEALTH_H
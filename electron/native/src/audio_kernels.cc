@@ -0,0 +1,203 @@
+/**
+ * AudioKernels implementation
+ */
+
+#include "audio_kernels.h"
+
+#include <cstring>
+
+#if AUDIO_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace AudioKernels {
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Escalar (referencia y fallback)
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace scalar {
+
+void deinterleave(const float* src, int channels, float* dst, size_t stride, size_t frames) {
+    for (size_t i = 0; i < frames; i++) {
+        const float* frame = src + i * channels;
+        for (int ch = 0; ch < channels; ch++) {
+            dst[static_cast<size_t>(ch) * stride + i] = frame[ch];
+        }
+    }
+}
+
+void interleave(const float* src, size_t stride, int channels, float* dst, size_t frames) {
+    for (size_t i = 0; i < frames; i++) {
+        float* frame = dst + i * channels;
+        for (int ch = 0; ch < channels; ch++) {
+            frame[ch] = src[static_cast<size_t>(ch) * stride + i];
+        }
+    }
+}
+
+void mulAdd(float* acc, const float* x, float gain, size_t n) {
+    for (size_t i = 0; i < n; i++) acc[i] += x[i] * gain;
+}
+
+void lerp(float* dst, const float* a, const float* t, const float* d, size_t n) {
+    for (size_t i = 0; i < n; i++) dst[i] = a[i] + t[i] * d[i];
+}
+
+}  // namespace scalar
+
+#if AUDIO_KERNELS_NEON
+
+// ═══════════════════════════════════════════════════════════════════════════
+// NEON (aarch64)
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+// 4 filas de 4 floats → 4 columnas (su propia inversa)
+inline void transpose4(float32x4_t& r0, float32x4_t& r1, float32x4_t& r2, float32x4_t& r3) {
+    const float32x4_t t0 = vtrn1q_f32(r0, r1);  // r0[0] r1[0] r0[2] r1[2]
+    const float32x4_t t1 = vtrn2q_f32(r0, r1);  // r0[1] r1[1] r0[3] r1[3]
+    const float32x4_t t2 = vtrn1q_f32(r2, r3);
+    const float32x4_t t3 = vtrn2q_f32(r2, r3);
+    r0 = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+    r1 = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+    r2 = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+    r3 = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+}
+
+}  // namespace
+
+const char* isa() { return "neon"; }
+
+void deinterleave(const float* src, int channels, float* dst, size_t stride, size_t frames) {
+    if (channels == 1) {
+        std::memcpy(dst, src, frames * sizeof(float));
+        return;
+    }
+    const size_t vecFrames = frames & ~static_cast<size_t>(3);
+    if (channels == 2) {
+        float* left = dst;
+        float* right = dst + stride;
+        for (size_t i = 0; i < vecFrames; i += 4) {
+            const float32x4x2_t lr = vld2q_f32(src + i * 2);
+            vst1q_f32(left + i, lr.val[0]);
+            vst1q_f32(right + i, lr.val[1]);
+        }
+    } else {
+        // Bloques de 4 frames × 4 canales; los canales sobrantes, escalares
+        const int vecChannels = channels & ~3;
+        for (size_t i = 0; i < vecFrames; i += 4) {
+            const float* frame = src + i * channels;
+            for (int ch = 0; ch < vecChannels; ch += 4) {
+                float32x4_t r0 = vld1q_f32(frame + ch);
+                float32x4_t r1 = vld1q_f32(frame + channels + ch);
+                float32x4_t r2 = vld1q_f32(frame + 2 * channels + ch);
+                float32x4_t r3 = vld1q_f32(frame + 3 * channels + ch);
+                transpose4(r0, r1, r2, r3);
+                float* out = dst + static_cast<size_t>(ch) * stride + i;
+                vst1q_f32(out, r0);
+                vst1q_f32(out + stride, r1);
+                vst1q_f32(out + 2 * stride, r2);
+                vst1q_f32(out + 3 * stride, r3);
+            }
+            for (int ch = vecChannels; ch < channels; ch++) {
+                for (size_t k = 0; k < 4; k++) {
+                    dst[static_cast<size_t>(ch) * stride + i + k] = frame[k * channels + ch];
+                }
+            }
+        }
+    }
+    // Cola de menos de 4 frames
+    for (size_t i = vecFrames; i < frames; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            dst[static_cast<size_t>(ch) * stride + i] = src[i * channels + ch];
+        }
+    }
+}
+
+void interleave(const float* src, size_t stride, int channels, float* dst, size_t frames) {
+    if (channels == 1) {
+        std::memcpy(dst, src, frames * sizeof(float));
+        return;
+    }
+    const size_t vecFrames = frames & ~static_cast<size_t>(3);
+    if (channels == 2) {
+        const float* left = src;
+        const float* right = src + stride;
+        for (size_t i = 0; i < vecFrames; i += 4) {
+            float32x4x2_t lr;
+            lr.val[0] = vld1q_f32(left + i);
+            lr.val[1] = vld1q_f32(right + i);
+            vst2q_f32(dst + i * 2, lr);
+        }
+    } else {
+        const int vecChannels = channels & ~3;
+        for (size_t i = 0; i < vecFrames; i += 4) {
+            float* frame = dst + i * channels;
+            for (int ch = 0; ch < vecChannels; ch += 4) {
+                const float* in = src + static_cast<size_t>(ch) * stride + i;
+                float32x4_t r0 = vld1q_f32(in);
+                float32x4_t r1 = vld1q_f32(in + stride);
+                float32x4_t r2 = vld1q_f32(in + 2 * stride);
+                float32x4_t r3 = vld1q_f32(in + 3 * stride);
+                transpose4(r0, r1, r2, r3);
+                vst1q_f32(frame + ch, r0);
+                vst1q_f32(frame + channels + ch, r1);
+                vst1q_f32(frame + 2 * channels + ch, r2);
+                vst1q_f32(frame + 3 * channels + ch, r3);
+            }
+            for (int ch = vecChannels; ch < channels; ch++) {
+                for (size_t k = 0; k < 4; k++) {
+                    frame[k * channels + ch] = src[static_cast<size_t>(ch) * stride + i + k];
+                }
+            }
+        }
+    }
+    for (size_t i = vecFrames; i < frames; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            dst[i * channels + ch] = src[static_cast<size_t>(ch) * stride + i];
+        }
+    }
+}
+
+void mulAdd(float* acc, const float* x, float gain, size_t n) {
+    const float32x4_t g = vdupq_n_f32(gain);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(acc + i, vmlaq_f32(vld1q_f32(acc + i), vld1q_f32(x + i), g));
+    }
+    for (; i < n; i++) acc[i] += x[i] * gain;
+}
+
+void lerp(float* dst, const float* a, const float* t, const float* d, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(a + i), vld1q_f32(t + i), vld1q_f32(d + i)));
+    }
+    for (; i < n; i++) dst[i] = a[i] + t[i] * d[i];
+}
+
+#else
+
+const char* isa() { return "scalar"; }
+
+void deinterleave(const float* src, int channels, float* dst, size_t stride, size_t frames) {
+    scalar::deinterleave(src, channels, dst, stride, frames);
+}
+
+void interleave(const float* src, size_t stride, int channels, float* dst, size_t frames) {
+    scalar::interleave(src, stride, channels, dst, frames);
+}
+
+void mulAdd(float* acc, const float* x, float gain, size_t n) {
+    scalar::mulAdd(acc, x, gain, n);
+}
+
+void lerp(float* dst, const float* a, const float* t, const float* d, size_t n) {
+    scalar::lerp(dst, a, t, d, n);
+}
+
+#endif
+
+}  // namespace AudioKernels
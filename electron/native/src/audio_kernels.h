@@ -0,0 +1,55 @@
+/**
+ * AudioKernels - Bucles de transporte y DSP comunes del addon
+ *
+ * Intercalado ↔ planar (SAB/ring ↔ NativeProcessor) y acumulación de la
+ * matriz del morph. Implementación elegida al compilar:
+ *
+ *   aarch64 + NEON → intrínsecos (transposición 4×4 por grupo de 4 canales,
+ *                    vld2/vst2 en estéreo)
+ *   resto          → bucles escalares que el compilador vectoriza (SSE/AVX)
+ *
+ * AUDIO_KERNELS_NEON=0 fuerza la versión escalar en ARM (comparativas).
+ * Las versiones escalares quedan siempre disponibles en AudioKernels::scalar
+ * como referencia (bench/kernels_bench.cc comprueba que coinciden).
+ *
+ * Las copias lineales siguen siendo memcpy: glibc ya elige su variante
+ * NEON/SVE en ARM.
+ */
+
+#ifndef AUDIO_KERNELS_H
+#define AUDIO_KERNELS_H
+
+#include <cstddef>
+
+#ifndef AUDIO_KERNELS_NEON
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define AUDIO_KERNELS_NEON 1
+#else
+#define AUDIO_KERNELS_NEON 0
+#endif
+#endif
+
+namespace AudioKernels {
+
+// "neon" o "scalar" (lo que se compiló)
+const char* isa();
+
+// Intercalado (frames × channels) → planar dst[ch * stride + i]
+void deinterleave(const float* src, int channels, float* dst, size_t stride, size_t frames);
+// Planar src[ch * stride + i] → intercalado (frames × channels)
+void interleave(const float* src, size_t stride, int channels, float* dst, size_t frames);
+// acc[i] += x[i] · gain
+void mulAdd(float* acc, const float* x, float gain, size_t n);
+// dst[i] = a[i] + t[i] · d[i]
+void lerp(float* dst, const float* a, const float* t, const float* d, size_t n);
+
+namespace scalar {
+void deinterleave(const float* src, int channels, float* dst, size_t stride, size_t frames);
+void interleave(const float* src, size_t stride, int channels, float* dst, size_t frames);
+void mulAdd(float* acc, const float* x, float gain, size_t n);
+void lerp(float* dst, const float* a, const float* t, const float* d, size_t n);
+}  // namespace scalar
+
+}  // namespace AudioKernels
+
+#endif // AUDIO_KERNELS_H
@@ -0,0 +1,102 @@
+/**
+ * AutomationLane implementation
+ */
+
+#include "automation_lane.h"
+#include <cstring>
+
+namespace {
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+bool getVarint(const uint8_t* data, size_t size, size_t& pos, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && pos < size; shift += 7) {
+        const uint8_t byte = data[pos++];
+        v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void AutomationLane::reset(size_t capacityBytes, uint32_t startFrame) {
+    bytes_.clear();
+    bytes_.reserve(capacityBytes);
+    startFrame_ = startFrame;
+    lastFrame_ = startFrame;
+    lastId_ = -1;
+    events_ = 0;
+    dropped_ = 0;
+}
+
+void AutomationLane::assign(const uint8_t* data, size_t size) {
+    bytes_.assign(data, data + size);
+    events_ = 0;
+    dropped_ = 0;
+}
+
+bool AutomationLane::append(uint32_t frame, int32_t id, float value, bool ramp) {
+    // Sin reservas en el hilo de audio: solo dentro de la capacidad
+    if (bytes_.size() + MAX_EVENT_BYTES > bytes_.capacity()) {
+        dropped_++;
+        return false;
+    }
+
+    // Frames monótonos: un evento atrasado cuenta como delta 0
+    const int32_t delta = static_cast<int32_t>(frame - lastFrame_);
+    const uint64_t deltaFrames = delta > 0 ? static_cast<uint64_t>(delta) : 0;
+    const bool idChanged = id != lastId_;
+
+    putVarint(bytes_, deltaFrames << 2 | (ramp ? 2u : 0u) | (idChanged ? 1u : 0u));
+    if (idChanged) putVarint(bytes_, static_cast<uint32_t>(id));
+    uint8_t raw[4];
+    std::memcpy(raw, &value, sizeof(raw));  // x86/ARM little-endian
+    bytes_.insert(bytes_.end(), raw, raw + 4);
+
+    lastFrame_ += static_cast<uint32_t>(deltaFrames);
+    lastId_ = id;
+    events_++;
+    return true;
+}
+
+AutomationLane::Cursor AutomationLane::begin(uint32_t startFrame) const {
+    Cursor cursor;
+    cursor.frame = startFrame;
+    cursor.id = -1;
+    return cursor;
+}
+
+bool AutomationLane::next(Cursor& cursor, Event& event) const {
+    const uint8_t* data = bytes_.data();
+    const size_t size = bytes_.size();
+    size_t pos = cursor.pos;
+
+    uint64_t head = 0;
+    if (!getVarint(data, size, pos, head)) return false;
+    int32_t id = cursor.id;
+    if (head & 1) {
+        uint64_t rawId = 0;
+        if (!getVarint(data, size, pos, rawId)) return false;
+        id = static_cast<int32_t>(rawId);
+    }
+    if (pos + 4 > size) return false;
+
+    std::memcpy(&event.value, data + pos, sizeof(float));
+    pos += 4;
+
+    cursor.pos = pos;
+    cursor.frame += static_cast<uint32_t>(head >> 2);
+    cursor.id = id;
+    event.frame = cursor.frame;
+    event.id = id;
+    event.ramp = (head & 2) != 0;
+    return true;
+}
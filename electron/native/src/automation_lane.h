@@ -0,0 +1,75 @@
+/**
+ * AutomationLane - Registro compacto de eventos de parámetros
+ *
+ * Guarda eventos (frame, id de parámetro, valor) con marca de muestra en un
+ * buffer de bytes codificado en deltas, para grabar y reproducir
+ * exactamente la automatización de un ProcessorBridge.
+ *
+ * Formato por evento (el mismo que decodifica core/automationLane.js):
+ *   varint  cabecera = delta_frames << 2 | rampa << 1 | cambia_id
+ *   varint  id de parámetro (solo si cambia_id)
+ *   float32 valor (little-endian)
+ * delta_frames es relativo al evento anterior (el primero, a startFrame).
+ * Un evento típico (mismo parámetro, delta < 32 frames) ocupa 5 bytes.
+ *
+ * rampa = 1: el valor llegó por setParam (rampa de un bloque hasta el
+ * objetivo); 0: salto exacto en el frame (scheduleParam).
+ *
+ * append() se llama desde el hilo de audio: no reserva memoria. Si el
+ * buffer se llena, el evento se descarta y se cuenta.
+ */
+
+#ifndef AUTOMATION_LANE_H
+#define AUTOMATION_LANE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AutomationLane {
+public:
+    // Bytes máximos de un evento: cabecera (5) + id (5) + valor (4)
+    static constexpr size_t MAX_EVENT_BYTES = 14;
+
+    struct Event {
+        uint32_t frame;
+        int32_t id;
+        float value;
+        bool ramp;
+    };
+
+    // Lectura secuencial (reproducción)
+    struct Cursor {
+        size_t pos = 0;
+        uint32_t frame = 0;
+        int32_t id = 0;
+    };
+
+    // Hilo JS: vacía y reserva capacidad para grabar
+    void reset(size_t capacityBytes, uint32_t startFrame);
+    // Hilo JS: carga un registro ya codificado (para reproducir)
+    void assign(const uint8_t* data, size_t size);
+
+    // Hilo de audio. false si no cabe (se cuenta en dropped())
+    bool append(uint32_t frame, int32_t id, float value, bool ramp);
+
+    Cursor begin(uint32_t startFrame) const;
+    // false al final del registro (o si está truncado)
+    bool next(Cursor& cursor, Event& event) const;
+
+    const uint8_t* data() const { return bytes_.data(); }
+    size_t size() const { return bytes_.size(); }
+    uint32_t startFrame() const { return startFrame_; }
+    size_t events() const { return events_; }
+    size_t dropped() const { return dropped_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    uint32_t startFrame_ = 0;
+    uint32_t lastFrame_ = 0;
+    int32_t lastId_ = -1;
+    size_t events_ = 0;
+    size_t dropped_ = 0;
+};
+
+#endif // AUTOMATION_LANE_H
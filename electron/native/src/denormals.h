@@ -0,0 +1,96 @@
+/**
+ * Denormals - Flush-to-zero en los hilos de tiempo real y detector de subnormales
+ *
+ * Un float subnormal (exponente 0, mantisa ≠ 0) cuesta decenas o cientos de
+ * ciclos por operación en x86 y en muchos núcleos ARM. Aparecen solos en
+ * colas de decaimiento (filtros, persistencia, rampas que tienden a 0) y
+ * convierten un bloque barato en un xrun.
+ *
+ * enableFlush() activa en el hilo que la llama:
+ *   x86    → MXCSR FTZ (bit 15) + DAZ (bit 6)
+ *   ARMv8  → FPCR.FZ (bit 24): resultados y entradas subnormales a 0
+ *   ARMv7  → FPSCR.FZ (bit 24)
+ * El modo es por hilo: cada hilo de tiempo real del addon lo activa al
+ * entrar (data loop de PipeWire, hilo del ProcessorBridge, render-ahead,
+ * fósforo). Nunca se llama desde el hilo de JS: V8 comparte ese hilo.
+ *
+ * countSubnormals() sirve para comprobar que el modo está activo de verdad:
+ * con FTZ/DAZ ningún cálculo produce subnormales, así que si aparecen en la
+ * salida de un procesador vienen de una plataforma sin FTZ o de copias de
+ * bits sin aritmética (entrada ya subnormal).
+ */
+
+#ifndef DENORMALS_H
+#define DENORMALS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define DENORMALS_X86 1
+#endif
+
+namespace Denormals {
+
+// Bloques entre muestreos del detector (1 de cada 16: ~43 ms de 128 frames @ 48kHz)
+constexpr size_t SAMPLE_BLOCKS = 16;
+
+// true si el addon sabe activar FTZ en esta arquitectura
+constexpr bool supported() {
+#if defined(DENORMALS_X86) || defined(__aarch64__) || (defined(__arm__) && defined(__ARM_FP))
+    return true;
+#else
+    return false;
+#endif
+}
+
+// true si FTZ está activo en el hilo actual
+inline bool isFlushEnabled() {
+#if defined(DENORMALS_X86)
+    return (_mm_getcsr() & 0x8040u) == 0x8040u;
+#elif defined(__aarch64__)
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    return (fpcr & (1ull << 24)) != 0;
+#elif defined(__arm__) && defined(__ARM_FP)
+    uint32_t fpscr;
+    __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
+    return (fpscr & (1u << 24)) != 0;
+#else
+    return false;
+#endif
+}
+
+// Activa FTZ/DAZ en el hilo actual. Devuelve si quedó activo.
+inline bool enableFlush() {
+#if defined(DENORMALS_X86)
+    _mm_setcsr(_mm_getcsr() | 0x8040u);
+#elif defined(__aarch64__)
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (1ull << 24)));
+#elif defined(__arm__) && defined(__ARM_FP)
+    uint32_t fpscr;
+    __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
+    __asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr | (1u << 24)));
+#endif
+    return isFlushEnabled();
+}
+
+// Subnormales en x[0..n) (comparación de bits: no depende de DAZ)
+inline size_t countSubnormals(const float* x, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t bits;
+        std::memcpy(&bits, &x[i], sizeof(bits));
+        // Exponente 0 y mantisa ≠ 0 ⇔ (|bits| − 1) < 0x007FFFFF
+        count += ((bits & 0x7FFFFFFFu) - 1u) < 0x007FFFFFu ? 1u : 0u;
+    }
+    return count;
+}
+
+}  // namespace Denormals
+
+#endif // DENORMALS_H
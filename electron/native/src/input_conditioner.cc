@@ -0,0 +1,158 @@
+/**
+ * InputConditioner implementation
+ */
+
+#include "input_conditioner.h"
+#include "audio_kernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if AUDIO_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+void InputConditioner::prepare(int channels, int sampleRate) {
+    channels_ = std::min(std::max(channels, 0), MAX_CHANNELS);
+    sampleRate_ = sampleRate > 0 ? sampleRate : 48000;
+    for (int ch = 0; ch < MAX_CHANNELS; ch++) {
+        targetGain_[ch].store(1.0f, std::memory_order_relaxed);
+        peak_[ch].store(0.0f, std::memory_order_relaxed);
+        clips_[ch].store(0, std::memory_order_relaxed);
+        x1_[ch] = 0.0f;
+        y1_[ch] = 0.0f;
+        gain_[ch] = 1.0f;
+    }
+    lastCutoffHz_ = -1.0f;
+    lastSmoothingMs_ = -1.0f;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Ajustes
+// ═══════════════════════════════════════════════════════════════════════════
+
+void InputConditioner::setDcCutoff(float hz) {
+    // Por debajo de fs/100 el filtro de 1er orden sigue siendo transparente
+    dcCutoffHz_.store(std::min(std::max(hz, 0.0f), sampleRate_ / 100.0f),
+                      std::memory_order_relaxed);
+}
+
+void InputConditioner::setGain(int channel, float gain) {
+    gain = std::max(gain, 0.0f);
+    if (channel < 0) {
+        for (int ch = 0; ch < MAX_CHANNELS; ch++) {
+            targetGain_[ch].store(gain, std::memory_order_relaxed);
+        }
+    } else if (channel < MAX_CHANNELS) {
+        targetGain_[channel].store(gain, std::memory_order_relaxed);
+    }
+}
+
+void InputConditioner::setClipThreshold(float threshold) {
+    clipThreshold_.store(std::min(std::max(threshold, 0.0f), 1.0f), std::memory_order_relaxed);
+}
+
+void InputConditioner::setGainSmoothing(float ms) {
+    gainSmoothingMs_.store(std::max(ms, 0.0f), std::memory_order_relaxed);
+}
+
+InputConditioner::ChannelStats InputConditioner::takeStats(int channel) {
+    ChannelStats stats;
+    if (channel < 0 || channel >= channels_) return stats;
+    stats.peak = peak_[channel].exchange(0.0f, std::memory_order_relaxed);
+    stats.clips = clips_[channel].load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Hilo de audio
+// ═══════════════════════════════════════════════════════════════════════════
+
+void InputConditioner::process(const float* src, float* dst, size_t frames) {
+    const int channels = channels_;
+
+    // Coeficientes: solo se recalculan si cambia el ajuste
+    const float cutoff = dcCutoffHz_.load(std::memory_order_relaxed);
+    if (cutoff != lastCutoffHz_) {
+        dcCoef_ = cutoff > 0.0f ? 1.0f - 2.0f * static_cast<float>(M_PI) * cutoff / sampleRate_ : 0.0f;
+        lastCutoffHz_ = cutoff;
+    }
+    const float smoothing = gainSmoothingMs_.load(std::memory_order_relaxed);
+    if (smoothing != lastSmoothingMs_) {
+        const float samples = smoothing * sampleRate_ / 1000.0f;
+        smoothCoef_ = samples > 1.0f ? 1.0f - std::exp(-1.0f / samples) : 1.0f;
+        lastSmoothingMs_ = smoothing;
+    }
+
+    const bool dc = cutoff > 0.0f;
+    const float R = dcCoef_;
+    const float k = smoothCoef_;
+    const float threshold = clipThreshold_.load(std::memory_order_relaxed);
+
+    // Estado en locales: el bucle por canal no depende de memoria compartida
+    float target[MAX_CHANNELS];
+    float peak[MAX_CHANNELS];
+    uint32_t clips[MAX_CHANNELS];
+    for (int ch = 0; ch < channels; ch++) {
+        target[ch] = targetGain_[ch].load(std::memory_order_relaxed);
+        peak[ch] = 0.0f;
+        clips[ch] = 0;
+    }
+
+    // NEON: grupos de 4 canales con el estado en registros, recorriendo los
+    // frames del grupo; los canales sobrantes siguen en el bucle escalar
+    int first = 0;
+#if AUDIO_KERNELS_NEON
+    first = channels & ~3;
+    const float32x4_t thresholdV = vdupq_n_f32(threshold);
+    const float32x4_t RV = vdupq_n_f32(R);
+    const float32x4_t kV = vdupq_n_f32(k);
+    for (int ch = 0; ch < first; ch += 4) {
+        float32x4_t x1V = vld1q_f32(x1_ + ch);
+        float32x4_t y1V = vld1q_f32(y1_ + ch);
+        float32x4_t gainV = vld1q_f32(gain_ + ch);
+        const float32x4_t targetV = vld1q_f32(target + ch);
+        float32x4_t peakV = vdupq_n_f32(0.0f);
+        uint32x4_t clipsV = vdupq_n_u32(0);
+        for (size_t i = 0; i < frames; i++) {
+            const float32x4_t x = vld1q_f32(src + i * channels + ch);
+            // Máscara de comparación = 0xFFFFFFFF: restarla suma 1
+            clipsV = vsubq_u32(clipsV, vcageq_f32(x, thresholdV));
+            const float32x4_t y = dc ? vmlaq_f32(vsubq_f32(x, x1V), RV, y1V) : x;
+            x1V = x;
+            y1V = y;
+            gainV = vmlaq_f32(gainV, vsubq_f32(targetV, gainV), kV);
+            const float32x4_t v = vmulq_f32(y, gainV);
+            vst1q_f32(dst + i * channels + ch, v);
+            peakV = vmaxq_f32(peakV, vabsq_f32(v));
+        }
+        vst1q_f32(x1_ + ch, x1V);
+        vst1q_f32(y1_ + ch, y1V);
+        vst1q_f32(gain_ + ch, gainV);
+        vst1q_f32(peak + ch, peakV);
+        vst1q_u32(clips + ch, clipsV);
+    }
+#endif
+
+    for (size_t i = 0; i < frames && first < channels; i++) {
+        const float* in = src + i * channels;
+        float* out = dst + i * channels;
+        for (int ch = first; ch < channels; ch++) {
+            const float x = in[ch];
+            clips[ch] += std::fabs(x) >= threshold ? 1u : 0u;
+            const float y = dc ? x - x1_[ch] + R * y1_[ch] : x;
+            x1_[ch] = x;
+            y1_[ch] = y;
+            gain_[ch] += (target[ch] - gain_[ch]) * k;
+            const float v = y * gain_[ch];
+            out[ch] = v;
+            peak[ch] = std::max(peak[ch], std::fabs(v));
+        }
+    }
+
+    for (int ch = 0; ch < channels; ch++) {
+        if (clips[ch]) clips_[ch].fetch_add(clips[ch], std::memory_order_relaxed);
+        float prev = peak_[ch].load(std::memory_order_relaxed);
+        while (peak[ch] > prev &&
+               !peak_[ch].compare_exchange_weak(prev, peak[ch], std::memory_order_relaxed)) {}
+    }
+}
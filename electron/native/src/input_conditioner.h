@@ -0,0 +1,80 @@
+/**
+ * InputConditioner - Acondicionamiento de la captura por canal
+ *
+ * Etapa nativa entre PipeWire y el SharedArrayBuffer de entrada: elimina el
+ * offset DC, aplica una ganancia suavizada por canal y detecta picos y
+ * recortes. Se ejecuta en la misma pasada que escribe el SAB (lee el buffer
+ * de PipeWire y escribe el destino), sin recorrer la memoria dos veces.
+ *
+ *   y[n] = x[n] − x[n−1] + R·y[n−1]     R = 1 − 2π·fc/fs  (fc = 0: sin filtro)
+ *   out  = y · g,  g → objetivo con un polo de gainSmoothingMs
+ *
+ * - clips: muestras de entrada en fondo de escala (|x| ≥ clipThreshold),
+ *   antes de la ganancia: recorte del conversor o de la fuente.
+ * - peak: pico de la salida acondicionada desde la última lectura (lo que
+ *   llega a los Input Amplifiers).
+ *
+ * El bucle interno recorre los canales de un frame intercalado con estado
+ * independiente por canal, de modo que el compilador lo vectoriza (8 canales
+ * = un registro AVX). En aarch64 los grupos de 4 canales van con NEON
+ * explícito (ver audio_kernels.h) y el estado no sale de los registros.
+ *
+ * Ajustes desde el hilo JS en cualquier momento (atomics relajados); el
+ * estado del filtro y de la ganancia solo lo toca el hilo de audio.
+ */
+
+#ifndef INPUT_CONDITIONER_H
+#define INPUT_CONDITIONER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class InputConditioner {
+public:
+    static constexpr int MAX_CHANNELS = 64;
+
+    struct ChannelStats {
+        float peak = 0.0f;
+        uint64_t clips = 0;
+    };
+
+    // Hilo JS, antes de arrancar el stream. Reinicia el estado.
+    void prepare(int channels, int sampleRate);
+
+    // Hilo JS
+    void setDcCutoff(float hz);              // 0 = sin filtro DC
+    void setGain(int channel, float gain);   // Lineal; channel < 0 = todos
+    void setClipThreshold(float threshold);
+    void setGainSmoothing(float ms);
+
+    // Pico desde la última lectura (se reinicia) y recortes acumulados
+    ChannelStats takeStats(int channel);
+    int getChannels() const { return channels_; }
+
+    // Hilo de audio: src y dst intercalados, frames × channels
+    void process(const float* src, float* dst, size_t frames);
+
+private:
+    int channels_ = 0;
+    int sampleRate_ = 48000;
+
+    std::atomic<float> dcCutoffHz_{0.0f};
+    std::atomic<float> clipThreshold_{0.999f};
+    std::atomic<float> gainSmoothingMs_{20.0f};
+    std::atomic<float> targetGain_[MAX_CHANNELS];
+
+    // Estado del hilo de audio
+    float x1_[MAX_CHANNELS] = {};
+    float y1_[MAX_CHANNELS] = {};
+    float gain_[MAX_CHANNELS] = {};
+    float lastCutoffHz_ = -1.0f;
+    float dcCoef_ = 0.0f;
+    float lastSmoothingMs_ = -1.0f;
+    float smoothCoef_ = 1.0f;
+
+    std::atomic<float> peak_[MAX_CHANNELS];
+    std::atomic<uint64_t> clips_[MAX_CHANNELS];
+};
+
+#endif // INPUT_CONDITIONER_H
@@ -0,0 +1,379 @@
+/**
+ * LinkManager - Implementación
+ */
+
+#include "link_manager.h"
+#include <fnmatch.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+LinkManager::~LinkManager() {
+    stop();
+}
+
+bool LinkManager::start() {
+    if (loop_) {
+        return true;
+    }
+
+    pw_init(nullptr, nullptr);
+
+    loop_ = pw_thread_loop_new("synthigme-links", nullptr);
+    if (!loop_) {
+        std::cerr << "[LinkManager] Failed to create thread loop" << std::endl;
+        pw_deinit();
+        return false;
+    }
+
+    context_ = pw_context_new(pw_thread_loop_get_loop(loop_), nullptr, 0);
+    if (!context_) {
+        std::cerr << "[LinkManager] Failed to create context" << std::endl;
+        pw_thread_loop_destroy(loop_);
+        loop_ = nullptr;
+        pw_deinit();
+        return false;
+    }
+
+    pw_thread_loop_lock(loop_);
+
+    core_ = pw_context_connect(context_, nullptr, 0);
+    if (!core_) {
+        pw_thread_loop_unlock(loop_);
+        std::cerr << "[LinkManager] Failed to connect to PipeWire" << std::endl;
+        pw_context_destroy(context_);
+        pw_thread_loop_destroy(loop_);
+        context_ = nullptr;
+        loop_ = nullptr;
+        pw_deinit();
+        return false;
+    }
+
+    nodes_.clear();
+    ports_.clear();
+    links_.clear();
+    requested_.clear();
+    created_ = 0;
+    failed_ = 0;
+    lastLinkMs_ = 0;
+    startTime_ = std::chrono::steady_clock::now();
+    connected_.store(true);
+
+    std::memset(&coreEvents_, 0, sizeof(coreEvents_));
+    coreEvents_.version = PW_VERSION_CORE_EVENTS;
+    coreEvents_.error = on_core_error;
+    std::memset(&coreListener_, 0, sizeof(coreListener_));
+    pw_core_add_listener(core_, &coreListener_, &coreEvents_, this);
+
+    // El registry anuncia primero todos los globals existentes y luego los nuevos
+    std::memset(&registryEvents_, 0, sizeof(registryEvents_));
+    registryEvents_.version = PW_VERSION_REGISTRY_EVENTS;
+    registryEvents_.global = on_global;
+    registryEvents_.global_remove = on_global_remove;
+    registry_ = pw_core_get_registry(core_, PW_VERSION_REGISTRY, 0);
+
+    std::memset(&requestEvents_, 0, sizeof(requestEvents_));
+    requestEvents_.version = PW_VERSION_PROXY_EVENTS;
+    requestEvents_.removed = on_request_removed;
+    requestEvents_.error = on_request_error;
+    std::memset(&registryListener_, 0, sizeof(registryListener_));
+    pw_registry_add_listener(registry_, &registryListener_, &registryEvents_, this);
+
+    pw_thread_loop_unlock(loop_);
+    pw_thread_loop_start(loop_);
+
+    std::cout << "[LinkManager] Started (" << rules_.size() << " rules)" << std::endl;
+    return true;
+}
+
+void LinkManager::stop() {
+    if (!loop_) {
+        return;
+    }
+
+    pw_thread_loop_stop(loop_);
+
+    // Los enlaces creados tienen object.linger: destruir el proxy no los borra
+    for (auto& request : requests_) {
+        spa_hook_remove(&request->listener);
+        pw_proxy_destroy(request->proxy);
+    }
+    requests_.clear();
+
+    if (registry_) {
+        spa_hook_remove(&registryListener_);
+        pw_proxy_destroy(reinterpret_cast<struct pw_proxy*>(registry_));
+        registry_ = nullptr;
+    }
+    if (core_) {
+        spa_hook_remove(&coreListener_);
+        pw_core_disconnect(core_);
+        core_ = nullptr;
+    }
+    pw_context_destroy(context_);
+    context_ = nullptr;
+    pw_thread_loop_destroy(loop_);
+    loop_ = nullptr;
+    connected_.store(false);
+
+    pw_deinit();
+
+    std::cout << "[LinkManager] Stopped. Links created: " << created_
+              << ", failed: " << failed_ << std::endl;
+}
+
+void LinkManager::setRules(std::vector<Rule> rules) {
+    if (!loop_) {
+        rules_ = std::move(rules);
+        return;
+    }
+    pw_thread_loop_lock(loop_);
+    rules_ = std::move(rules);
+    evaluate();
+    pw_thread_loop_unlock(loop_);
+}
+
+std::vector<LinkManager::LinkInfo> LinkManager::snapshot(const std::string& nodePattern) {
+    std::vector<LinkInfo> result;
+    if (!loop_) {
+        return result;
+    }
+
+    pw_thread_loop_lock(loop_);
+    for (const auto& entry : links_) {
+        auto out = ports_.find(entry.second.first);
+        auto in = ports_.find(entry.second.second);
+        if (out == ports_.end() || in == ports_.end()) {
+            continue;
+        }
+        auto outNode = nodes_.find(out->second.node);
+        auto inNode = nodes_.find(in->second.node);
+        bool relevant =
+            (outNode != nodes_.end() && matches(nodePattern, outNode->second)) ||
+            (inNode != nodes_.end() && matches(nodePattern, inNode->second));
+        if (relevant) {
+            result.push_back({ fullName(out->second), fullName(in->second) });
+        }
+    }
+    pw_thread_loop_unlock(loop_);
+    return result;
+}
+
+std::vector<std::string> LinkManager::ports(const std::string& nodePattern) {
+    std::vector<std::string> result;
+    if (!loop_) {
+        return result;
+    }
+
+    pw_thread_loop_lock(loop_);
+    for (const auto& entry : ports_) {
+        auto node = nodes_.find(entry.second.node);
+        if (node != nodes_.end() && matches(nodePattern, node->second)) {
+            result.push_back(fullName(entry.second));
+        }
+    }
+    pw_thread_loop_unlock(loop_);
+    return result;
+}
+
+LinkManager::Stats LinkManager::getStats() {
+    Stats stats;
+    stats.connected = connected_.load();
+    if (!loop_) {
+        return stats;
+    }
+
+    pw_thread_loop_lock(loop_);
+    stats.nodes = nodes_.size();
+    stats.ports = ports_.size();
+    stats.links = links_.size();
+    stats.created = created_;
+    stats.failed = failed_;
+    stats.pending = requested_.size();
+    stats.lastLinkMs = lastLinkMs_;
+    pw_thread_loop_unlock(loop_);
+    return stats;
+}
+
+bool LinkManager::matches(const std::string& pattern, const std::string& name) {
+    return fnmatch(pattern.c_str(), name.c_str(), 0) == 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Registry (hilo del loop)
+// ═══════════════════════════════════════════════════════════════════════════
+
+void LinkManager::on_global(void* data, uint32_t id, uint32_t permissions, const char* type,
+                            uint32_t version, const struct spa_dict* props) {
+    auto* self = static_cast<LinkManager*>(data);
+    (void)permissions;
+    (void)version;
+    if (!type || !props) {
+        return;
+    }
+
+    if (std::strcmp(type, PW_TYPE_INTERFACE_Node) == 0) {
+        const char* name = spa_dict_lookup(props, PW_KEY_NODE_NAME);
+        if (name) {
+            self->nodes_[id] = name;
+            self->evaluate(id, ANY);
+        }
+    } else if (std::strcmp(type, PW_TYPE_INTERFACE_Port) == 0) {
+        const char* node = spa_dict_lookup(props, PW_KEY_NODE_ID);
+        const char* name = spa_dict_lookup(props, PW_KEY_PORT_NAME);
+        const char* dir = spa_dict_lookup(props, PW_KEY_PORT_DIRECTION);
+        if (node && name && dir) {
+            Port port;
+            port.node = static_cast<uint32_t>(std::strtoul(node, nullptr, 10));
+            port.name = name;
+            port.output = std::strcmp(dir, "out") == 0;
+            self->ports_[id] = std::move(port);
+            self->evaluate(ANY, id);
+        }
+    } else if (std::strcmp(type, PW_TYPE_INTERFACE_Link) == 0) {
+        const char* out = spa_dict_lookup(props, PW_KEY_LINK_OUTPUT_PORT);
+        const char* in = spa_dict_lookup(props, PW_KEY_LINK_INPUT_PORT);
+        if (out && in) {
+            auto pair = std::make_pair(static_cast<uint32_t>(std::strtoul(out, nullptr, 10)),
+                                       static_cast<uint32_t>(std::strtoul(in, nullptr, 10)));
+            self->links_[id] = pair;
+            self->requested_.erase(pair);
+        }
+    }
+}
+
+void LinkManager::on_global_remove(void* data, uint32_t id) {
+    auto* self = static_cast<LinkManager*>(data);
+
+    if (self->nodes_.erase(id) || self->links_.erase(id)) {
+        return;
+    }
+    if (self->ports_.erase(id)) {
+        // Un enlace pedido a un puerto que desaparece ya no llegará
+        for (auto it = self->requested_.begin(); it != self->requested_.end();) {
+            if (it->first == id || it->second == id) {
+                it = self->requested_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void LinkManager::on_core_error(void* data, uint32_t id, int seq, int res, const char* message) {
+    auto* self = static_cast<LinkManager*>(data);
+    (void)seq;
+
+    std::cerr << "[LinkManager] Core error (id " << id << ", " << res << "): "
+              << (message ? message : "") << std::endl;
+
+    // EPIPE: daemon perdido. JS reinicia el manager cuando los streams se recuperan.
+    if (id == PW_ID_CORE && res == -EPIPE) {
+        self->connected_.store(false);
+    }
+}
+
+void LinkManager::on_request_removed(void* data) {
+    auto* request = static_cast<Request*>(data);
+    // Enlace borrado o nunca anunciado: deja de contar como pendiente
+    request->self->requested_.erase(request->ports);
+}
+
+void LinkManager::on_request_error(void* data, int seq, int res, const char* message) {
+    auto* request = static_cast<Request*>(data);
+    (void)seq;
+    std::cerr << "[LinkManager] Link " << request->ports.first << " -> " << request->ports.second
+              << " failed (" << res << "): " << (message ? message : "") << std::endl;
+    request->self->requested_.erase(request->ports);
+    request->self->failed_++;
+}
+
+std::string LinkManager::fullName(const Port& port) const {
+    auto node = nodes_.find(port.node);
+    return (node != nodes_.end() ? node->second : std::string()) + ":" + port.name;
+}
+
+bool LinkManager::hasLink(uint32_t outPort, uint32_t inPort) const {
+    if (requested_.count({ outPort, inPort })) {
+        return true;
+    }
+    for (const auto& entry : links_) {
+        if (entry.second.first == outPort && entry.second.second == inPort) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LinkManager::ruled(const Port& out, const Port& in) const {
+    const std::string outName = fullName(out);
+    const std::string inName = fullName(in);
+    for (const auto& rule : rules_) {
+        if (matches(rule.output, outName) && matches(rule.input, inName)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LinkManager::evaluate(uint32_t node, uint32_t port) {
+    if (rules_.empty() || !connected_.load()) {
+        return;
+    }
+
+    const bool all = node == ANY && port == ANY;
+    auto involved = [&](const std::pair<const uint32_t, Port>& entry) {
+        return all || entry.first == port || entry.second.node == node;
+    };
+
+    // Pocos cientos de puertos: el recorrido completo por global es despreciable
+    for (const auto& out : ports_) {
+        if (!out.second.output || !nodes_.count(out.second.node)) {
+            continue;
+        }
+        for (const auto& in : ports_) {
+            if (in.second.output || !nodes_.count(in.second.node) ||
+                !(involved(out) || involved(in))) {
+                continue;
+            }
+            if (!hasLink(out.first, in.first) && ruled(out.second, in.second)) {
+                createLink(out.first, in.first);
+            }
+        }
+    }
+}
+
+void LinkManager::createLink(uint32_t outPort, uint32_t inPort) {
+    const std::string out = std::to_string(outPort);
+    const std::string in = std::to_string(inPort);
+    struct spa_dict_item items[] = {
+        SPA_DICT_ITEM_INIT(PW_KEY_LINK_OUTPUT_PORT, out.c_str()),
+        SPA_DICT_ITEM_INIT(PW_KEY_LINK_INPUT_PORT, in.c_str()),
+        SPA_DICT_ITEM_INIT(PW_KEY_OBJECT_LINGER, "true"),
+    };
+    struct spa_dict dict = SPA_DICT_INIT_ARRAY(items);
+
+    auto* proxy = static_cast<struct pw_proxy*>(pw_core_create_object(
+        core_, "link-factory", PW_TYPE_INTERFACE_Link, PW_VERSION_LINK, &dict, 0));
+    if (!proxy) {
+        failed_++;
+        std::cerr << "[LinkManager] Failed to create link " << out << " -> " << in << std::endl;
+        return;
+    }
+
+    auto request = std::make_unique<Request>();
+    request->self = this;
+    request->proxy = proxy;
+    request->ports = { outPort, inPort };
+    std::memset(&request->listener, 0, sizeof(request->listener));
+    pw_proxy_add_listener(proxy, &request->listener, &requestEvents_, request.get());
+    requests_.push_back(std::move(request));
+    requested_.insert({ outPort, inPort });
+    created_++;
+    lastLinkMs_ = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime_).count();
+
+    std::cout << "[LinkManager] Link " << fullName(ports_[outPort]) << " -> "
+              << fullName(ports_[inPort]) << std::endl;
+}
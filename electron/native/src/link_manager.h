@@ -0,0 +1,147 @@
+/**
+ * LinkManager - Restaura los enlaces de puertos PipeWire al arrancar
+ *
+ * Conexión propia al daemon (thread loop + context + core) que escucha el
+ * registry: mantiene los nodos, puertos y enlaces existentes y, en cuanto
+ * aparece un puerto que casa con una regla, crea el enlace que falte. Los 12
+ * puertos de salida y los 8 de entrada quedan conectados en el mismo
+ * arranque, sin qpwgraph ni esperar al session manager.
+ *
+ * Es restauración al aparecer, no un vigilante: cada nodo o puerto nuevo
+ * solo evalúa los pares en los que participa, así que un enlace que el
+ * usuario borra a mitad de sesión no vuelve cuando aparece otro cliente.
+ * setRules() sí evalúa todos los pares (reglas nuevas). Un enlace pedido
+ * cuyo proxy falla o es eliminado sale de los pendientes y puede reintentarse.
+ *
+ * Reglas: pares de patrones "nodo:puerto" (node.name:port.name, fnmatch),
+ * p. ej. "SynthiGME:Out_*" → "alsa_output.usb-*:playback_AUX0". Cada puerto
+ * de salida que casa con `output` se enlaza con cada puerto de entrada que
+ * casa con `input`. Los enlaces se crean con object.linger: sobreviven al
+ * manager. JS persiste las reglas; snapshot() devuelve los enlaces actuales
+ * de un nodo con nombres exactos para guardarlos como reglas, y ports() los
+ * puertos de ese nodo (también los que se han quedado sin enlaces).
+ *
+ * El estado vive en el hilo del loop; los métodos públicos toman su lock.
+ */
+
+#ifndef LINK_MANAGER_H
+#define LINK_MANAGER_H
+
+#include <pipewire/pipewire.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class LinkManager {
+public:
+    struct Rule {
+        std::string output;  // Patrón "nodo:puerto" del puerto de salida
+        std::string input;   // Patrón "nodo:puerto" del puerto de entrada
+    };
+
+    struct LinkInfo {
+        std::string output;
+        std::string input;
+    };
+
+    struct Stats {
+        size_t nodes = 0;
+        size_t ports = 0;
+        size_t links = 0;
+        size_t created = 0;     // Enlaces creados por el manager
+        size_t failed = 0;      // pw_core_create_object sin proxy
+        size_t pending = 0;     // Creados y aún sin global en el registry
+        double lastLinkMs = 0;  // De start() al último enlace creado
+        bool connected = false; // false tras perder el daemon (EPIPE)
+    };
+
+    LinkManager() = default;
+    ~LinkManager();
+
+    LinkManager(const LinkManager&) = delete;
+    LinkManager& operator=(const LinkManager&) = delete;
+
+    // Conecta con el daemon. false si PipeWire no está disponible.
+    bool start();
+    void stop();
+    bool isRunning() const { return loop_ != nullptr; }
+
+    // Sustituye las reglas y crea al momento los enlaces que ya se pueden crear
+    void setRules(std::vector<Rule> rules);
+
+    // Enlaces existentes con algún extremo en un nodo que casa con nodePattern
+    std::vector<LinkInfo> snapshot(const std::string& nodePattern);
+
+    // Puertos ("nodo:puerto") de los nodos que casan con nodePattern
+    std::vector<std::string> ports(const std::string& nodePattern);
+
+    Stats getStats();
+
+    // "nodo:puerto" contra un patrón fnmatch
+    static bool matches(const std::string& pattern, const std::string& name);
+
+private:
+    struct Port {
+        uint32_t node;
+        std::string name;
+        bool output;
+    };
+
+    // Proxy de un enlace creado por el manager
+    struct Request {
+        LinkManager* self;
+        struct pw_proxy* proxy;
+        struct spa_hook listener;
+        std::pair<uint32_t, uint32_t> ports;  // (salida, entrada)
+    };
+
+    static constexpr uint32_t ANY = UINT32_MAX;
+
+    static void on_global(void* data, uint32_t id, uint32_t permissions, const char* type,
+                          uint32_t version, const struct spa_dict* props);
+    static void on_global_remove(void* data, uint32_t id);
+    static void on_core_error(void* data, uint32_t id, int seq, int res, const char* message);
+    static void on_request_removed(void* data);
+    static void on_request_error(void* data, int seq, int res, const char* message);
+
+    // Hilo del loop (o con su lock tomado). Sin argumentos, todos los pares;
+    // con node o port, solo los pares de ese nodo o de ese puerto.
+    void evaluate(uint32_t node = ANY, uint32_t port = ANY);
+    bool ruled(const Port& out, const Port& in) const;
+    bool hasLink(uint32_t outPort, uint32_t inPort) const;
+    void createLink(uint32_t outPort, uint32_t inPort);
+    std::string fullName(const Port& port) const;
+
+    struct pw_thread_loop* loop_ = nullptr;
+    struct pw_context* context_ = nullptr;
+    struct pw_core* core_ = nullptr;
+    struct pw_registry* registry_ = nullptr;
+    struct spa_hook coreListener_{};
+    struct spa_hook registryListener_{};
+    struct pw_core_events coreEvents_{};
+    struct pw_registry_events registryEvents_{};
+
+    std::unordered_map<uint32_t, std::string> nodes_;                   // id → node.name
+    std::unordered_map<uint32_t, Port> ports_;
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> links_; // id → (out, in)
+    std::set<std::pair<uint32_t, uint32_t>> requested_;                 // Creados, sin global aún
+    std::vector<std::unique_ptr<Request>> requests_;
+    struct pw_proxy_events requestEvents_{};
+    std::vector<Rule> rules_;
+
+    std::chrono::steady_clock::time_point startTime_;
+    size_t created_ = 0;
+    size_t failed_ = 0;
+    double lastLinkMs_ = 0;
+    std::atomic<bool> connected_{false};
+};
+
+#endif // LINK_MANAGER_H
@@ -0,0 +1,129 @@
+/**
+ * MirroredRing implementation
+ */
+
+#include "mirrored_ring.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+MirroredRing::~MirroredRing() {
+    release();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Reserva
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool MirroredRing::allocate(size_t minSamples) {
+    release();
+    if (minSamples == 0) return false;
+
+    size_t page = 4096;
+#ifdef __linux__
+    const long sysPage = sysconf(_SC_PAGESIZE);
+    if (sysPage > 0) page = static_cast<size_t>(sysPage);
+#endif
+    const size_t bytes = (minSamples * sizeof(float) + page - 1) / page * page;
+    capacity_ = bytes / sizeof(float);
+
+#ifdef __linux__
+    int fd = memfd_create("synthigme-ring", MFD_CLOEXEC);
+    if (fd >= 0 && ftruncate(fd, static_cast<off_t>(bytes)) == 0) {
+        // Reservar 2× de espacio virtual y mapear el memfd en ambas mitades
+        void* region = mmap(nullptr, bytes * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED) {
+            char* lo = static_cast<char*>(region);
+            void* a = mmap(lo, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+            void* b = mmap(lo + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+            if (a != MAP_FAILED && b != MAP_FAILED) {
+                mapped_ = region;
+                mappedBytes_ = bytes * 2;
+                base_ = reinterpret_cast<float*>(lo);
+            } else {
+                munmap(region, bytes * 2);
+            }
+        }
+    }
+    if (fd >= 0) close(fd);  // Los mapeos mantienen vivas las páginas
+#endif
+
+    if (!mapped_) {
+        std::cerr << "[MirroredRing] memfd mirror unavailable, using software mirror" << std::endl;
+        fallback_.assign(capacity_ * 2, 0.0f);
+        base_ = fallback_.data();
+    }
+
+    // Tocar todas las páginas aquí y no en el hilo de audio
+    std::memset(base_, 0, capacity_ * sizeof(float));
+    reset();
+    return true;
+}
+
+void MirroredRing::release() {
+#ifdef __linux__
+    if (mapped_) {
+        munmap(mapped_, mappedBytes_);
+    }
+#endif
+    mapped_ = nullptr;
+    mappedBytes_ = 0;
+    fallback_.clear();
+    fallback_.shrink_to_fit();
+    base_ = nullptr;
+    capacity_ = 0;
+    reset();
+}
+
+void MirroredRing::reset() {
+    readCount_.store(0, std::memory_order_relaxed);
+    writeCount_.store(0, std::memory_order_relaxed);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Avance y copias
+// ═══════════════════════════════════════════════════════════════════════════
+
+void MirroredRing::commitRead(size_t samples) {
+    samples = std::min(samples, readable());
+    // release: el productor no reescribe el tramo hasta que lo hayamos leído
+    readCount_.store(readCount_.load(std::memory_order_relaxed) + samples,
+                     std::memory_order_release);
+}
+
+void MirroredRing::commitWrite(size_t samples) {
+    samples = std::min(samples, writable());
+    if (!mapped_ && samples > 0) {
+        // Espejo por software: replicar lo escrito en la otra mitad
+        const size_t pos = writePos();
+        const size_t head = std::min(samples, capacity_ - pos);
+        std::memcpy(base_ + pos + capacity_, base_ + pos, head * sizeof(float));
+        if (samples > head) {
+            std::memcpy(base_, base_ + capacity_, (samples - head) * sizeof(float));
+        }
+    }
+    // release: el consumidor ve los datos (y el espejo) antes que el contador
+    writeCount_.store(writeCount_.load(std::memory_order_relaxed) + samples,
+                      std::memory_order_release);
+}
+
+size_t MirroredRing::write(const float* src, size_t samples) {
+    samples = std::min(samples, writable());
+    if (samples == 0) return 0;
+    std::memcpy(writePtr(), src, samples * sizeof(float));
+    commitWrite(samples);
+    return samples;
+}
+
+size_t MirroredRing::read(float* dst, size_t samples) {
+    samples = std::min(samples, readable());
+    if (samples == 0) return 0;
+    std::memcpy(dst, readPtr(), samples * sizeof(float));
+    commitRead(samples);
+    return samples;
+}
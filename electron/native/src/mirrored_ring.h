@@ -0,0 +1,82 @@
+/**
+ * MirroredRing - Ring buffer de float con el almacenamiento mapeado dos veces
+ *
+ * Las mismas páginas físicas (un memfd) se mapean en dos regiones virtuales
+ * contiguas, así que [pos, pos + capacity) es siempre un tramo lineal aunque
+ * cruce el final del ring. Lecturas y escrituras son un único memcpy (o un
+ * único puntero para kernels SIMD) sin partir el bloque ni hacer `% size`
+ * por muestra.
+ *
+ * La capacidad se redondea a páginas. Si memfd/mmap no están disponibles se
+ * usa un espejo por software (buffer de 2× capacidad; commitWrite copia lo
+ * escrito a la otra mitad): misma API, el doble de copia al escribir.
+ *
+ * Un productor y un consumidor pueden usarlo a la vez sin lock (SPSC): cada
+ * lado avanza solo su contador (commitWrite/commitRead, release) y lee el del
+ * otro con acquire. Varios escritores o lectores, allocate() y reset()
+ * requieren que el llamador serialice (PwStream usa ringMutex_ salvo en
+ * render-ahead, donde el ring es SPSC entre su hilo y on_process).
+ */
+
+#ifndef MIRRORED_RING_H
+#define MIRRORED_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+class MirroredRing {
+public:
+    MirroredRing() = default;
+    ~MirroredRing();
+
+    MirroredRing(const MirroredRing&) = delete;
+    MirroredRing& operator=(const MirroredRing&) = delete;
+
+    // Reserva al menos minSamples muestras (redondeado a páginas) a cero.
+    // Reservar de nuevo descarta el contenido.
+    bool allocate(size_t minSamples);
+    void release();
+
+    size_t capacity() const { return capacity_; }
+    bool isMirrored() const { return mapped_ != nullptr; }
+
+    size_t readable() const {
+        return writeCount_.load(std::memory_order_acquire) - readCount_.load(std::memory_order_acquire);
+    }
+    size_t writable() const { return capacity_ - readable(); }
+    // Muestras leídas desde reset() (lo ya consumido, visto desde el productor)
+    size_t readTotal() const { return readCount_.load(std::memory_order_acquire); }
+
+    // Tramos lineales: readPtr() válido para readable() muestras,
+    // writePtr() para writable(). commit* avanza tras usarlos.
+    const float* readPtr() const { return base_ + position(readCount_); }
+    float* writePtr() { return base_ + writePos(); }
+    void commitRead(size_t samples);
+    void commitWrite(size_t samples);
+
+    // Copias acotadas a readable()/writable(). Devuelven muestras copiadas.
+    size_t write(const float* src, size_t samples);
+    size_t read(float* dst, size_t samples);
+
+    void reset();
+
+private:
+    size_t position(const std::atomic<size_t>& count) const {
+        return capacity_ ? count.load(std::memory_order_relaxed) % capacity_ : 0;
+    }
+    size_t writePos() const { return position(writeCount_); }
+
+    float* base_ = nullptr;
+    size_t capacity_ = 0;   // Muestras
+    // Muestras leídas/escritas desde reset() (monótonos; 64 bits no dan la
+    // vuelta). Cada uno lo escribe solo su lado.
+    std::atomic<size_t> readCount_{0};
+    std::atomic<size_t> writeCount_{0};
+
+    void* mapped_ = nullptr;  // Reserva de 2× capacidad (modo memfd)
+    size_t mappedBytes_ = 0;
+    std::vector<float> fallback_;  // Espejo por software
+};
+
+#endif // MIRRORED_RING_H
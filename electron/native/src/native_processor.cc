@@ -0,0 +1,311 @@
+/**
+ * NativeProcessor - Procesadores registrados
+ *
+ * passthrough: copia entradas a salidas (mide el coste y la latencia del bridge)
+ * gain:        ganancia con rampa por bloque (param "gain")
+ * morph:       interpolación de patch entre dos snapshots de matriz y parámetros
+ */
+
+#include "native_processor.h"
+#include "audio_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <utility>
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════
+// passthrough
+// ═══════════════════════════════════════════════════════════════════════════
+
+class PassthroughProcessor : public NativeProcessor {
+public:
+    PassthroughProcessor(int inChannels, int outChannels)
+        : inChannels_(inChannels), outChannels_(outChannels) {}
+
+    const char* type() const override { return "passthrough"; }
+
+    void process(const float* const* in, float* const* out, int frames) override {
+        for (int ch = 0; ch < outChannels_; ch++) {
+            if (ch < inChannels_) {
+                std::memcpy(out[ch], in[ch], frames * sizeof(float));
+            } else {
+                std::memset(out[ch], 0, frames * sizeof(float));
+            }
+        }
+    }
+
+private:
+    int inChannels_;
+    int outChannels_;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// gain
+// ═══════════════════════════════════════════════════════════════════════════
+
+class GainProcessor : public NativeProcessor {
+public:
+    explicit GainProcessor(int channels) : channels_(channels) {}
+
+    const char* type() const override { return "gain"; }
+
+    void process(const float* const* in, float* const* out, int frames) override {
+        // Rampa lineal hasta el objetivo en un bloque (sin clicks)
+        const float step = (target_ - current_) / static_cast<float>(std::max(frames, 1));
+        for (int ch = 0; ch < channels_; ch++) {
+            float g = current_;
+            for (int i = 0; i < frames; i++) {
+                g += step;
+                out[ch][i] = in[ch][i] * g;
+            }
+        }
+        current_ = target_;
+    }
+
+    bool setParam(const std::string& name, float value) override {
+        if (name != "gain") return false;
+        target_ = value;
+        return true;
+    }
+
+    int paramId(const std::string& name) const override {
+        return name == "gain" ? 0 : -1;
+    }
+
+    // Evento con precisión de muestra: salto en el frame exacto
+    void setParamById(int id, float value) override {
+        if (id != 0) return;
+        current_ = value;
+        target_ = value;
+    }
+
+    void rampParamById(int id, float value) override {
+        if (id == 0) target_ = value;
+    }
+
+private:
+    int channels_;
+    float current_ = 1.0f;
+    float target_ = 1.0f;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// morph
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Interpola entre dos estados de patch (A y B) con precisión de muestra.
+ *
+ * Entradas:  [0, sources)  fuentes de la matriz
+ *            sources        CV de morph (se suma al parámetro "morph")
+ * Salidas:   [0, destinations)            destinos de la matriz
+ *            [destinations, outChannels)  carriles de parámetros continuos
+ *
+ * Datos (setData):
+ *   "a" / "b"                 tripletes [fila, columna, ganancia, ...]
+ *                             (columna < destinations; si no, se rechaza)
+ *   "params.a" / "params.b"   un valor por carril de parámetro
+ *
+ * Las dos matrices se funden en una CSR por fila de fuente sobre la unión de
+ * conexiones, con gA y d = gB − gA por celda. Así la matriz interpolada
+ * out = Σ x·(gA + t·d) se factoriza en Σ x·gA + t·Σ x·d: exacta aunque t
+ * cambie en cada muestra (CV) y sin rehacer la CSR por bloque. Los bucles
+ * internos recorren frames contiguos y el compilador los vectoriza.
+ */
+class MorphProcessor : public NativeProcessor {
+public:
+    enum ParamId { MORPH = 0 };
+
+    MorphProcessor(int inChannels, int outChannels)
+        : sources_(inChannels - 1)
+        , outChannels_(outChannels)
+        , destinations_(outChannels)
+        , paramsA_(outChannels, 0.0f)
+        , paramsB_(outChannels, 0.0f)
+        , rowStart_(inChannels, 0) {}
+
+    const char* type() const override { return "morph"; }
+
+    void prepare(int sampleRate, int maxFrames) override {
+        (void)sampleRate;
+        maxFrames_ = maxFrames;
+        t_.assign(maxFrames, 0.0f);
+        accA_.assign(static_cast<size_t>(outChannels_) * maxFrames, 0.0f);
+        accD_.assign(static_cast<size_t>(outChannels_) * maxFrames, 0.0f);
+    }
+
+    void process(const float* const* in, float* const* out, int frames) override {
+        // Posición de morph por muestra: rampa hasta el objetivo + CV
+        const float* cv = in[sources_];
+        const float step = (target_ - morph_) / static_cast<float>(std::max(frames, 1));
+        float m = morph_;
+        for (int i = 0; i < frames; i++) {
+            m += step;
+            t_[i] = std::min(std::max(m + cv[i], 0.0f), 1.0f);
+        }
+        morph_ = target_;
+
+        // Matriz: accA = Σ x·gA, accD = Σ x·d
+        std::fill(accA_.begin(), accA_.end(), 0.0f);
+        std::fill(accD_.begin(), accD_.end(), 0.0f);
+        for (int row = 0; row < sources_; row++) {
+            const float* x = in[row];
+            for (int k = rowStart_[row]; k < rowStart_[row + 1]; k++) {
+                const float a = gainA_[k];
+                const float d = gainD_[k];
+                AudioKernels::mulAdd(&accA_[static_cast<size_t>(cols_[k]) * maxFrames_], x, a, frames);
+                if (d == 0.0f) continue;  // Conexión igual en A y B
+                AudioKernels::mulAdd(&accD_[static_cast<size_t>(cols_[k]) * maxFrames_], x, d, frames);
+            }
+        }
+
+        for (int col = 0; col < destinations_; col++) {
+            AudioKernels::lerp(out[col], &accA_[static_cast<size_t>(col) * maxFrames_], t_.data(),
+                               &accD_[static_cast<size_t>(col) * maxFrames_], frames);
+        }
+
+        // Carriles de parámetros: pA + t·(pB − pA)
+        for (int ch = destinations_; ch < outChannels_; ch++) {
+            const int lane = ch - destinations_;
+            const float a = paramsA_[lane];
+            const float d = paramsB_[lane] - a;
+            for (int i = 0; i < frames; i++) out[ch][i] = a + t_[i] * d;
+        }
+    }
+
+    bool setParam(const std::string& name, float value) override {
+        if (name == "morph") {
+            target_ = std::min(std::max(value, 0.0f), 1.0f);
+            return true;
+        }
+        if (name == "destinations") {
+            const int destinations = std::min(std::max(static_cast<int>(value), 0), outChannels_);
+            // Las matrices ya cargadas deben seguir apuntando a destinos
+            for (const std::vector<Cell>* cells : { &cellsA_, &cellsB_ }) {
+                for (const Cell& c : *cells) {
+                    if (c.col >= destinations) return false;
+                }
+            }
+            destinations_ = destinations;
+            return true;
+        }
+        return false;
+    }
+
+    int paramId(const std::string& name) const override {
+        return name == "morph" ? MORPH : -1;
+    }
+
+    // Evento con precisión de muestra: salto en el frame exacto
+    void setParamById(int id, float value) override {
+        if (id != MORPH) return;
+        morph_ = target_ = std::min(std::max(value, 0.0f), 1.0f);
+    }
+
+    void rampParamById(int id, float value) override {
+        if (id == MORPH) target_ = std::min(std::max(value, 0.0f), 1.0f);
+    }
+
+    bool setData(const std::string& name, const float* data, size_t count) override {
+        if (name == "a" || name == "b") {
+            if (count % 3 != 0) return false;
+            std::vector<Cell> cells;
+            cells.reserve(count / 3);
+            // Una celda inválida rechaza la matriz entera: fila entre las
+            // fuentes, columna entre los destinos (no en los carriles de
+            // parámetros, que process() no mezcla) y ganancia finita
+            for (size_t i = 0; i < count; i += 3) {
+                const float r = data[i], c = data[i + 1], gain = data[i + 2];
+                if (!(r >= 0.0f && r < sources_ && r == std::floor(r))) return false;
+                if (!(c >= 0.0f && c < destinations_ && c == std::floor(c))) return false;
+                if (!std::isfinite(gain)) return false;
+                cells.push_back({ static_cast<int>(r), static_cast<int>(c), gain });
+            }
+            (name == "a" ? cellsA_ : cellsB_) = std::move(cells);
+            rebuild();
+            return true;
+        }
+        if (name == "params.a" || name == "params.b") {
+            std::vector<float>& params = name == "params.a" ? paramsA_ : paramsB_;
+            std::fill(params.begin(), params.end(), 0.0f);
+            std::copy_n(data, std::min(count, params.size()), params.begin());
+            return true;
+        }
+        return false;
+    }
+
+private:
+    struct Cell {
+        int row;
+        int col;
+        float gain;
+    };
+
+    // CSR por fila de fuente sobre la unión de A y B (fuera del hilo de audio)
+    void rebuild() {
+        std::map<std::pair<int, int>, std::pair<float, float>> merged;
+        for (const Cell& c : cellsA_) merged[{ c.row, c.col }].first += c.gain;
+        for (const Cell& c : cellsB_) merged[{ c.row, c.col }].second += c.gain;
+
+        std::fill(rowStart_.begin(), rowStart_.end(), 0);
+        cols_.clear();
+        gainA_.clear();
+        gainD_.clear();
+        for (const auto& [cell, gains] : merged) {
+            rowStart_[cell.first + 1]++;
+            cols_.push_back(cell.second);
+            gainA_.push_back(gains.first);
+            gainD_.push_back(gains.second - gains.first);
+        }
+        for (int row = 0; row < sources_; row++) rowStart_[row + 1] += rowStart_[row];
+    }
+
+    int sources_;
+    int outChannels_;
+    int destinations_;
+    int maxFrames_ = 0;
+    float morph_ = 0.0f;
+    float target_ = 0.0f;
+
+    std::vector<Cell> cellsA_;
+    std::vector<Cell> cellsB_;
+    std::vector<float> paramsA_;
+    std::vector<float> paramsB_;
+
+    // CSR: celdas de la fila r en [rowStart_[r], rowStart_[r + 1])
+    std::vector<int> rowStart_;
+    std::vector<int> cols_;
+    std::vector<float> gainA_;
+    std::vector<float> gainD_;
+
+    std::vector<float> t_;
+    std::vector<float> accA_;
+    std::vector<float> accD_;
+};
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Registro
+// ═══════════════════════════════════════════════════════════════════════════
+
+std::unique_ptr<NativeProcessor> createNativeProcessor(const std::string& type,
+                                                       int inChannels, int outChannels) {
+    if (type == "passthrough") {
+        return std::make_unique<PassthroughProcessor>(inChannels, outChannels);
+    }
+    if (type == "gain" && inChannels == outChannels) {
+        return std::make_unique<GainProcessor>(inChannels);
+    }
+    if (type == "morph" && inChannels >= 2) {
+        return std::make_unique<MorphProcessor>(inChannels, outChannels);
+    }
+    return nullptr;
+}
+
+std::vector<std::string> nativeProcessorTypes() {
+    return { "passthrough", "gain", "morph" };
+}
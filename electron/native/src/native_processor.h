@@ -0,0 +1,84 @@
+/**
+ * NativeProcessor - Interfaz de procesadores DSP nativos
+ *
+ * Un procesador nativo sustituye a un AudioWorklet dentro del grafo Web Audio
+ * a través de ProcessorBridge: recibe bloques planares de sus entradas y
+ * produce bloques planares en sus salidas.
+ *
+ * Reglas (se ejecuta en el hilo de audio del bridge):
+ * - process() no reserva memoria ni toma locks.
+ * - prepare() se llama una vez antes del primer bloque (aquí sí se reserva).
+ * - setParam() y setData() se aplican entre bloques (el bridge los serializa).
+ * - setParamById() llega desde la cola de eventos del bridge en el hilo de
+ *   audio, entre sub-bloques: el bridge parte el bloque en el frame exacto
+ *   del evento, así que process() puede recibir menos de maxFrames.
+ *
+ * Para migrar un módulo: implementar la interfaz y registrarlo en
+ * createNativeProcessor() (native_processor.cc).
+ */
+
+#ifndef NATIVE_PROCESSOR_H
+#define NATIVE_PROCESSOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class NativeProcessor {
+public:
+    virtual ~NativeProcessor() = default;
+
+    virtual const char* type() const = 0;
+
+    virtual void prepare(int sampleRate, int maxFrames) {
+        (void)sampleRate;
+        (void)maxFrames;
+    }
+
+    // in[ch][frame], out[ch][frame] - planar, `frames` <= maxFrames
+    virtual void process(const float* const* in, float* const* out, int frames) = 0;
+
+    // Devuelve false si el parámetro no existe
+    virtual bool setParam(const std::string& name, float value) {
+        (void)name;
+        (void)value;
+        return false;
+    }
+
+    // Parámetros programables con precisión de muestra: id estable por
+    // nombre, -1 si no admite eventos
+    virtual int paramId(const std::string& name) const {
+        (void)name;
+        return -1;
+    }
+
+    // Hilo de audio: sin reservas ni locks. Salto exacto al valor.
+    virtual void setParamById(int id, float value) {
+        (void)id;
+        (void)value;
+    }
+
+    // Como setParam() pero por id: el procesador puede suavizar el cambio.
+    // Lo usa la reproducción de automatización grabada desde setParam().
+    virtual void rampParamById(int id, float value) {
+        setParamById(id, value);
+    }
+
+    // Datos en bloque (tablas, snapshots). Devuelve false si no se admiten.
+    virtual bool setData(const std::string& name, const float* data, size_t count) {
+        (void)name;
+        (void)data;
+        (void)count;
+        return false;
+    }
+};
+
+// Crea un procesador por nombre. nullptr si el tipo no existe o si la
+// configuración de canales no es válida para ese tipo.
+std::unique_ptr<NativeProcessor> createNativeProcessor(const std::string& type,
+                                                       int inChannels, int outChannels);
+
+// Tipos registrados (para listarlos desde JS)
+std::vector<std::string> nativeProcessorTypes();
+
+#endif // NATIVE_PROCESSOR_H
@@ -0,0 +1,330 @@
+/**
+ * PhosphorScope implementation
+ */
+
+#include "phosphor_scope.h"
+#include "denormals.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+// Tabla de tono: intensidad [0, LUT_MAX) → alfa = 1 − e^(−I)
+constexpr size_t LUT_SIZE = 1024;
+constexpr float LUT_MAX = 6.0f;
+// Por debajo, el píxel se considera apagado (< 1/255 tras el tono)
+constexpr float BLACK_LEVEL = 0.002f;
+
+} // namespace
+
+PhosphorScope::PhosphorScope(int width, int height, int fps)
+    : width_(width)
+    , height_(height)
+    , fps_(std::max(1, std::min(fps, 240)))
+{
+    intensity_.assign(static_cast<size_t>(width_) * height_, 0.0f);
+    work_.reserve(MAX_PENDING_POINTS * 2 + 64);
+    pending_.reserve(MAX_PENDING_POINTS * 2 + 64);
+
+    toneLut_.resize(LUT_SIZE);
+    for (size_t i = 0; i < LUT_SIZE; i++) {
+        const float intensity = static_cast<float>(i) * LUT_MAX / LUT_SIZE;
+        toneLut_[i] = static_cast<uint8_t>(std::lround(255.0f * (1.0f - std::exp(-intensity))));
+    }
+}
+
+PhosphorScope::~PhosphorScope() {
+    stop();
+}
+
+size_t PhosphorScope::requiredBytes(int width, int height) {
+    return HEADER_WORDS * sizeof(int32_t) + static_cast<size_t>(width) * height * 4 * 2;
+}
+
+bool PhosphorScope::attachFrameBuffer(void* buffer, size_t bufferSize) {
+    if (running_.load()) {
+        std::cerr << "[PhosphorScope] Cannot attach buffer while running" << std::endl;
+        return false;
+    }
+    const size_t needed = requiredBytes(width_, height_);
+    if (!buffer || bufferSize < needed) {
+        std::cerr << "[PhosphorScope] Buffer too small: " << bufferSize
+                  << " < " << needed << " bytes" << std::endl;
+        return false;
+    }
+
+    header_ = reinterpret_cast<std::atomic<int32_t>*>(buffer);
+    uint8_t* pixels = reinterpret_cast<uint8_t*>(static_cast<int32_t*>(buffer) + HEADER_WORDS);
+    const size_t frameBytes = static_cast<size_t>(width_) * height_ * 4;
+    frames_[0] = pixels;
+    frames_[1] = pixels + frameBytes;
+
+    header_[WIDTH].store(width_, std::memory_order_relaxed);
+    header_[HEIGHT].store(height_, std::memory_order_relaxed);
+    header_[FRONT].store(0, std::memory_order_relaxed);
+    header_[SEQ].store(0, std::memory_order_release);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Ciclo de vida
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool PhosphorScope::start() {
+    if (running_.load()) return true;
+    if (!header_) {
+        std::cerr << "[PhosphorScope] No frame buffer attached" << std::endl;
+        return false;
+    }
+
+    idle_ = false;
+    running_.store(true);
+    thread_ = std::thread(&PhosphorScope::runLoop, this);
+
+    std::cout << "[PhosphorScope] Started " << width_ << "x" << height_
+              << " @ " << fps_ << "fps" << std::endl;
+    return true;
+}
+
+void PhosphorScope::stop() {
+    if (!running_.exchange(false)) return;
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    std::cout << "[PhosphorScope] Stopped. Frames: " << framesPublished_.load()
+              << ", avg " << getAvgRenderUs() << "us/frame" << std::endl;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Entrada y parámetros
+// ═══════════════════════════════════════════════════════════════════════════
+
+void PhosphorScope::submit(const float* x, const float* y, size_t count,
+                           float cx, float cy, float sx, float sy) {
+    if (!x || !y || count == 0) return;
+
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    // Un punto de la capacidad se reserva para el separador de traza
+    const size_t queued = pending_.size() / 2;
+    const size_t room = queued + 1 < MAX_PENDING_POINTS ? MAX_PENDING_POINTS - queued - 1 : 0;
+    const size_t accepted = std::min(count, room);
+    if (accepted < count) {
+        droppedPoints_.fetch_add(count - accepted);
+    }
+    if (accepted == 0) return;
+
+    // Separador de traza
+    if (!pending_.empty()) {
+        pending_.push_back(std::numeric_limits<float>::quiet_NaN());
+        pending_.push_back(0.0f);
+    }
+    for (size_t i = 0; i < accepted; i++) {
+        const float px = cx + x[i] * sx;
+        const float py = cy - y[i] * sy;
+        // Un punto no finito se descarta y corta la traza (ocupa su hueco
+        // como separador: el render salta los segmentos con extremo NaN)
+        if (!std::isfinite(px) || !std::isfinite(py)) {
+            pending_.push_back(std::numeric_limits<float>::quiet_NaN());
+            pending_.push_back(0.0f);
+            continue;
+        }
+        pending_.push_back(px);
+        pending_.push_back(py);
+    }
+}
+
+void PhosphorScope::clear() {
+    clearRequested_.store(true);
+}
+
+void PhosphorScope::setColor(uint8_t r, uint8_t g, uint8_t b) {
+    color_.store((static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b);
+    repaintRequested_.store(true);
+}
+
+void PhosphorScope::setPersistence(float ms) {
+    persistenceMs_.store(std::max(1.0f, std::min(ms, 10000.0f)));
+}
+
+void PhosphorScope::setBeamEnergy(float energy) {
+    beamEnergy_.store(std::max(0.0f, std::min(energy, 100.0f)));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Hilo de render
+// ═══════════════════════════════════════════════════════════════════════════
+
+void PhosphorScope::runLoop() {
+    using clock = std::chrono::steady_clock;
+    // El decaimiento exponencial de la intensidad tiende a subnormales
+    Denormals::enableFlush();
+    const auto period = std::chrono::microseconds(1000000 / fps_);
+    auto next = clock::now();
+    auto last = next;
+
+    while (running_.load()) {
+        next += period;
+        std::this_thread::sleep_until(next);
+
+        const auto now = clock::now();
+        const float dt = std::chrono::duration<float>(now - last).count();
+        last = now;
+
+        // Si el hilo se retrasa mucho, no intentar recuperar ticks perdidos
+        if (now - next > period * 4) {
+            next = now;
+        }
+
+        const auto t0 = clock::now();
+        renderFrame(dt);
+        const uint64_t ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count());
+        totalRenderNs_.fetch_add(ns, std::memory_order_relaxed);
+        renderedFrames_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PhosphorScope::renderFrame(float dtSeconds) {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        work_.swap(pending_);
+        pending_.clear();
+    }
+
+    bool repaint = repaintRequested_.exchange(false);
+    if (clearRequested_.exchange(false)) {
+        std::fill(intensity_.begin(), intensity_.end(), 0.0f);
+        repaint = true;
+    }
+
+    // Sin trazas nuevas y pantalla ya negra: no hay nada que publicar
+    if (work_.empty() && idle_ && !repaint) {
+        return;
+    }
+
+    // Decaimiento exponencial del fósforo
+    const float decay = std::exp(-dtSeconds * 1000.0f / persistenceMs_.load());
+    float peak = 0.0f;
+    for (float& v : intensity_) {
+        v *= decay;
+        if (v > peak) peak = v;
+    }
+
+    // Trazas nuevas: segmentos entre muestras consecutivas
+    const float energy = beamEnergy_.load();
+    for (size_t i = 0; i + 3 < work_.size(); i += 2) {
+        const float x0 = work_[i], y0 = work_[i + 1];
+        const float x1 = work_[i + 2], y1 = work_[i + 3];
+        if (std::isnan(x0) || std::isnan(x1)) continue;
+        drawSegment(x0, y0, x1, y1, energy);
+    }
+    const bool hadPoints = !work_.empty();
+    work_.clear();
+
+    // Tono → RGBA en el frame trasero
+    const int32_t back = 1 - header_[FRONT].load(std::memory_order_relaxed);
+    uint8_t* dst = frames_[back];
+    const uint32_t color = color_.load();
+    const uint8_t r = static_cast<uint8_t>(color >> 16);
+    const uint8_t g = static_cast<uint8_t>(color >> 8);
+    const uint8_t b = static_cast<uint8_t>(color);
+    const float lutScale = static_cast<float>(LUT_SIZE) / LUT_MAX;
+    const size_t pixels = intensity_.size();
+    for (size_t p = 0; p < pixels; p++) {
+        const size_t idx = std::min(static_cast<size_t>(intensity_[p] * lutScale), LUT_SIZE - 1);
+        uint8_t* px = dst + p * 4;
+        px[0] = r;
+        px[1] = g;
+        px[2] = b;
+        px[3] = toneLut_[idx];
+    }
+
+    header_[FRONT].store(back, std::memory_order_release);
+    header_[SEQ].fetch_add(1, std::memory_order_release);
+    framesPublished_.fetch_add(1);
+
+    idle_ = !hadPoints && peak < BLACK_LEVEL;
+}
+
+// Línea anti-aliased (Wu) con coordenadas subpíxel. La energía por píxel es
+// inversamente proporcional a la longitud: un haz rápido deja un trazo tenue.
+void PhosphorScope::drawSegment(float x0, float y0, float x1, float y1, float energy) {
+    // La energía se reparte sobre la longitud completa, también la que cae
+    // fuera de la pantalla (en double: una muestra enorme no desborda)
+    const double fullDx = static_cast<double>(x1) - x0;
+    const double fullDy = static_cast<double>(y1) - y0;
+    const float perPixel = static_cast<float>(
+        energy / std::max(std::sqrt(fullDx * fullDx + fullDy * fullDy), 1.0));
+
+    // Recorte de Liang–Barsky a [0, width−1] × [0, height−1]: el bucle de
+    // Wu no recorre columnas invisibles y lround no recibe valores enormes
+    const double p[4] = { -fullDx, fullDx, -fullDy, fullDy };
+    const double q[4] = { x0 - 0.0, (width_ - 1) - static_cast<double>(x0),
+                          y0 - 0.0, (height_ - 1) - static_cast<double>(y0) };
+    double t0 = 0.0, t1 = 1.0;
+    for (int k = 0; k < 4; k++) {
+        if (p[k] == 0.0) {
+            if (q[k] < 0.0) return;  // Paralelo al borde y fuera
+            continue;
+        }
+        const double t = q[k] / p[k];
+        if (p[k] < 0.0) {
+            if (t > t1) return;
+            t0 = std::max(t0, t);
+        } else {
+            if (t < t0) return;
+            t1 = std::min(t1, t);
+        }
+    }
+    if (t0 > 0.0 || t1 < 1.0) {
+        const double ox = x0, oy = y0;
+        x0 = static_cast<float>(ox + t0 * fullDx);
+        y0 = static_cast<float>(oy + t0 * fullDy);
+        x1 = static_cast<float>(ox + t1 * fullDx);
+        y1 = static_cast<float>(oy + t1 * fullDy);
+    }
+
+    const bool steep = std::fabs(y1 - y0) > std::fabs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    const float gradient = dx > 1e-6f ? dy / dx : 0.0f;
+
+    const int xStart = static_cast<int>(std::lround(x0));
+    const int xEnd = static_cast<int>(std::lround(x1));
+    float y = y0 + gradient * (static_cast<float>(xStart) - x0);
+
+    for (int x = xStart; x <= xEnd; x++) {
+        const float yFloor = std::floor(y);
+        const int yi = static_cast<int>(yFloor);
+        const float frac = y - yFloor;
+        if (steep) {
+            deposit(yi, x, perPixel * (1.0f - frac));
+            deposit(yi + 1, x, perPixel * frac);
+        } else {
+            deposit(x, yi, perPixel * (1.0f - frac));
+            deposit(x, yi + 1, perPixel * frac);
+        }
+        y += gradient;
+    }
+}
+
+double PhosphorScope::getAvgRenderUs() const {
+    const size_t frames = renderedFrames_.load();
+    if (frames == 0) return 0.0;
+    return static_cast<double>(totalRenderNs_.load()) / 1000.0 / static_cast<double>(frames);
+}
@@ -0,0 +1,121 @@
+/**
+ * PhosphorScope - Rasterizador de osciloscopio con persistencia de fósforo
+ *
+ * Emula la pantalla CRT en modo X-Y: cada muestra mueve el haz y deja energía
+ * en un buffer de intensidad (líneas anti-aliased, energía inversamente
+ * proporcional a la velocidad del haz). La intensidad decae exponencialmente
+ * con la persistencia configurada. Un hilo propio compone un frame RGBA a la
+ * tasa de refresco y lo publica en un SharedArrayBuffer; la UI solo lo copia
+ * al canvas.
+ *
+ * Layout del SharedArrayBuffer:
+ * [Int32 × 8]  cabecera
+ *   0 seq     - nativo incrementa al publicar un frame
+ *   1 front   - índice (0/1) del frame completo más reciente
+ *   2 width
+ *   3 height
+ *   4-7 reservado
+ * [Uint8 × width × height × 4] × 2   frames RGBA (doble buffer)
+ *
+ * El color es fijo y el alfa lleva la luminancia, de modo que el frame se
+ * compone sobre la cuadrícula con source-over.
+ */
+
+#ifndef PHOSPHOR_SCOPE_H
+#define PHOSPHOR_SCOPE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PhosphorScope {
+public:
+    // Palabras de la cabecera del SAB
+    static constexpr size_t SEQ = 0;
+    static constexpr size_t FRONT = 1;
+    static constexpr size_t WIDTH = 2;
+    static constexpr size_t HEIGHT = 3;
+    static constexpr size_t HEADER_WORDS = 8;
+
+    // Puntos pendientes máximos entre dos frames (~1.3s @ 48kHz)
+    static constexpr size_t MAX_PENDING_POINTS = 65536;
+
+    PhosphorScope(int width, int height, int fps);
+    ~PhosphorScope();
+
+    PhosphorScope(const PhosphorScope&) = delete;
+    PhosphorScope& operator=(const PhosphorScope&) = delete;
+
+    static size_t requiredBytes(int width, int height);
+
+    bool attachFrameBuffer(void* buffer, size_t bufferSize);
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(); }
+
+    // Encola una traza: pixel = (cx + x·sx, cy − y·sy). Cada llamada es una
+    // traza independiente (no se une con la anterior). Los puntos no finitos
+    // se descartan y cortan la traza; los segmentos se recortan a la pantalla.
+    void submit(const float* x, const float* y, size_t count,
+                float cx, float cy, float sx, float sy);
+    void clear();
+
+    void setColor(uint8_t r, uint8_t g, uint8_t b);
+    void setPersistence(float ms);    // Tiempo hasta 1/e de intensidad
+    void setBeamEnergy(float energy); // Energía depositada por muestra
+
+    // Estadísticas
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    size_t getFramesPublished() const { return framesPublished_.load(); }
+    size_t getDroppedPoints() const { return droppedPoints_.load(); }
+    double getAvgRenderUs() const;
+
+private:
+    void runLoop();
+    void renderFrame(float dtSeconds);
+    void drawSegment(float x0, float y0, float x1, float y1, float energy);
+    void deposit(int x, int y, float value) {
+        if (x >= 0 && x < width_ && y >= 0 && y < height_) {
+            intensity_[static_cast<size_t>(y) * width_ + x] += value;
+        }
+    }
+
+    int width_;
+    int height_;
+    int fps_;
+
+    // Vistas sobre el SAB
+    std::atomic<int32_t>* header_ = nullptr;
+    uint8_t* frames_[2] = { nullptr, nullptr };
+
+    // Estado del hilo de render
+    std::vector<float> intensity_;
+    std::vector<float> work_;           // Puntos tomados de pending_ (x, y intercalados)
+    std::vector<uint8_t> toneLut_;      // Intensidad cuantizada → alfa
+    bool idle_ = false;                 // Último frame publicado ya era negro
+
+    // Entrada (hilo JS) → hilo de render. NaN separa trazas.
+    std::mutex pendingMutex_;
+    std::vector<float> pending_;
+
+    std::atomic<uint32_t> color_{0x00ff00};
+    std::atomic<float> persistenceMs_{60.0f};
+    std::atomic<float> beamEnergy_{1.5f};
+    std::atomic<bool> clearRequested_{false};
+    std::atomic<bool> repaintRequested_{false};  // Publicar aunque esté en reposo
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<size_t> framesPublished_{0};
+    std::atomic<size_t> droppedPoints_{0};
+    std::atomic<uint64_t> totalRenderNs_{0};
+    std::atomic<size_t> renderedFrames_{0};
+};
+
+#endif // PHOSPHOR_SCOPE_H
@@ -10,10 +10,64 @@
  * - channels -> number
  * - sampleRate -> number
  * - underflows -> number
+ * - attachSharedBuffer(Int32Array, bufferFrames [, packetSlots]) -> bool
+ * - getPacketStats() -> { latencyFrames, droppedBlocks, driftPpm, ... } | null  (SAB empaquetado)
+ * - attachNotifyBuffer(Int32Array, wordIndex, watermarkFrames) -> bool
+ * - setCatchUp(bool), catchUp  (output: recortar la latencia que supera el ring)
+ * - setRenderAhead(type, aheadBlocks) -> bool, setRenderAheadParam(name, value) -> bool  (output)
+ * - flushDenormals, renderDenormals  (FTZ/DAZ en los hilos RT y subnormales muestreados)
+ * - onStateChange(fn | null): fn({ state, error, recovering, recoveries, recoveryMs })
+ * - state, lastError, recovering, recoveries, recoveryAttempts, lastRecoveryMs
+ * - setInputConditioning(dcCutoffHz, clipThreshold, gainSmoothingMs), setInputGain(channel, gain)
+ * - getInputLevels() -> { peaks: number[], clips: number[] }  (input; el pico se reinicia)
+ * - attachPluginBridge(PluginBridge, channelOffset) -> bool, detachPluginBridge()
+ *
+ * Y NativeProcessorBridge (procesador nativo dentro del grafo Web Audio):
+ * - new NativeProcessorBridge(type, inChannels, outChannels, sampleRate)
+ * - attachSharedBuffer(Int32Array, ringFrames) -> bool
+ * - start() -> bool, stop(), setParam(name, value) -> bool
+ * - scheduleParam(name, value, frame) -> bool, setData(name, Float32Array) -> bool
+ * - startRecording(frame, maxBytes), stopRecording() -> { startFrame, events, dropped, data, params }
+ * - startPlayback(Uint8Array, frame) -> bool, stopPlayback(), recording, playing
+ * - flushDenormals, denormals, denormalBlocks  (subnormales en la salida muestreada)
+ * - nativeProcessorTypes -> string[]
+ *
+ * Y PhosphorScope (rasterizador de osciloscopio con persistencia):
+ * - new PhosphorScope(width, height, fps)
+ * - attachFrameBuffer(Int32Array) -> bool, start() -> bool, stop()
+ * - submit(Float32Array x, Float32Array y, cx, cy, sx, sy), clear()
+ * - setColor(r, g, b), setPersistence(ms), setBeamEnergy(value)
+ *
+ * Y PipeWireLinkManager (restaura enlaces de puertos desde reglas persistidas):
+ * - new PipeWireLinkManager()
+ * - start() -> bool, stop(), setRules([{ output, input }]) -> number
+ * - snapshot(nodePattern) -> [{ output, input }], ports(nodePattern) -> ["nodo:puerto"]
+ * - getStats(), isRunning
+ *
+ * Y PluginBridge (memoria compartida con el plugin LV2 synthigme-bridge):
+ * - new PluginBridge([name])
+ * - open(sampleRate, sendChannels, returnChannels, ringFrames, latencyFrames) -> bool, close()
+ * - setPipelineLatency(frames), getStats(), isOpen
+ *
+ * Y agregados de salud del audio por sesión (telemetría):
+ * - getAudioHealth() -> { output, input }
+ * - resetAudioHealth()
+ * - audioKernels -> "neon" | "scalar" (kernels compilados, ver audio_kernels.h)
+ * - flushDenormalsSupported -> bool (FTZ/DAZ disponible, ver denormals.h)
  */
 
 #include <napi.h>
+#include "audio_health.h"
+#include "audio_kernels.h"
+#include "denormals.h"
 #include "pw_stream.h"
+#include "processor_bridge.h"
+#include "phosphor_scope.h"
+#include "link_manager.h"
+#include "shm_bridge.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <memory>
 #include <iostream>
 
@@ -39,13 +93,73 @@ private:
     Napi::Value AttachSharedBuffer(const Napi::CallbackInfo& info);
     Napi::Value DetachSharedBuffer(const Napi::CallbackInfo& info);
     Napi::Value HasSharedBuffer(const Napi::CallbackInfo& info);
+    Napi::Value GetPacketStats(const Napi::CallbackInfo& info);
+    
+    // Notificación Atomics.wait/notify para consumidores fuera del worklet
+    Napi::Value AttachNotifyBuffer(const Napi::CallbackInfo& info);
+    Napi::Value DetachNotifyBuffer(const Napi::CallbackInfo& info);
+    Napi::Value HasNotifyBuffer(const Napi::CallbackInfo& info);
+    Napi::Value GetNotifyCount(const Napi::CallbackInfo& info);
+    void ReleaseNotify();
     
     // Latency configuration
     Napi::Value SetLatency(const Napi::CallbackInfo& info);
     Napi::Value GetPrebufferFrames(const Napi::CallbackInfo& info);
     Napi::Value GetRingBufferFrames(const Napi::CallbackInfo& info);
     
+    // Driver mode
+    Napi::Value SetDriverMode(const Napi::CallbackInfo& info);
+    Napi::Value GetDriverMode(const Napi::CallbackInfo& info);
+    Napi::Value SetCatchUp(const Napi::CallbackInfo& info);
+    Napi::Value GetCatchUp(const Napi::CallbackInfo& info);
+    Napi::Value GetDriverTriggers(const Napi::CallbackInfo& info);
+    Napi::Value GetDriverStalls(const Napi::CallbackInfo& info);
+    
+    // Render-ahead
+    Napi::Value SetRenderAhead(const Napi::CallbackInfo& info);
+    Napi::Value SetRenderAheadParam(const Napi::CallbackInfo& info);
+    Napi::Value GetRenderAhead(const Napi::CallbackInfo& info);
+    Napi::Value GetRenderAheadFrames(const Napi::CallbackInfo& info);
+    Napi::Value GetRenderedBlocks(const Napi::CallbackInfo& info);
+    Napi::Value GetRenderSpikes(const Napi::CallbackInfo& info);
+    Napi::Value GetMaxRenderUs(const Napi::CallbackInfo& info);
+    Napi::Value GetRenderDenormals(const Napi::CallbackInfo& info);
+    Napi::Value GetFlushDenormals(const Napi::CallbackInfo& info);
+    
+    // Estado y recuperación automática
+    Napi::Value OnStateChange(const Napi::CallbackInfo& info);
+    Napi::Value GetState(const Napi::CallbackInfo& info);
+    Napi::Value GetLastError(const Napi::CallbackInfo& info);
+    Napi::Value GetRecovering(const Napi::CallbackInfo& info);
+    Napi::Value GetRecoveries(const Napi::CallbackInfo& info);
+    Napi::Value GetRecoveryAttempts(const Napi::CallbackInfo& info);
+    Napi::Value GetLastRecoveryMs(const Napi::CallbackInfo& info);
+    void ReleaseStateCallback();
+    
+    // Acondicionamiento de la captura
+    Napi::Value SetInputConditioning(const Napi::CallbackInfo& info);
+    Napi::Value SetInputGain(const Napi::CallbackInfo& info);
+    Napi::Value GetInputLevels(const Napi::CallbackInfo& info);
+    
+    // Puente LV2 (definidos junto a PluginBridgeWrap)
+    Napi::Value AttachPluginBridge(const Napi::CallbackInfo& info);
+    Napi::Value DetachPluginBridge(const Napi::CallbackInfo& info);
+    
     std::unique_ptr<PwStream> stream_;
+    
+    // Destino de Atomics.notify. Compartido con los callbacks encolados en la
+    // ThreadSafeFunction: si llegan tras detach, ven la referencia vacía.
+    struct NotifyTarget {
+        Napi::ObjectReference array;
+        uint32_t wordIndex = 0;
+        std::atomic<bool> queued{false};  // Coalesce: máx. 1 notify pendiente
+    };
+    std::shared_ptr<NotifyTarget> notifyTarget_;
+    Napi::ThreadSafeFunction notifyTsfn_;
+    
+    // Callback JS de cambios de estado (hilos de PipeWire y de recuperación)
+    Napi::ThreadSafeFunction stateTsfn_;
+    bool hasStateCallback_ = false;
 };
 
 Napi::Object PipeWireAudio::Init(Napi::Env env, Napi::Object exports) {
@@ -55,9 +169,24 @@ Napi::Object PipeWireAudio::Init(Napi::Env env, Napi::Object exports) {
         InstanceMethod<&PipeWireAudio::Write>("write"),
         InstanceMethod<&PipeWireAudio::AttachSharedBuffer>("attachSharedBuffer"),
         InstanceMethod<&PipeWireAudio::DetachSharedBuffer>("detachSharedBuffer"),
+        InstanceMethod<&PipeWireAudio::GetPacketStats>("getPacketStats"),
+        InstanceMethod<&PipeWireAudio::AttachNotifyBuffer>("attachNotifyBuffer"),
+        InstanceMethod<&PipeWireAudio::DetachNotifyBuffer>("detachNotifyBuffer"),
         InstanceMethod<&PipeWireAudio::SetLatency>("setLatency"),
+        InstanceMethod<&PipeWireAudio::SetDriverMode>("setDriverMode"),
+        InstanceMethod<&PipeWireAudio::SetCatchUp>("setCatchUp"),
+        InstanceMethod<&PipeWireAudio::SetRenderAhead>("setRenderAhead"),
+        InstanceMethod<&PipeWireAudio::SetRenderAheadParam>("setRenderAheadParam"),
+        InstanceMethod<&PipeWireAudio::OnStateChange>("onStateChange"),
+        InstanceMethod<&PipeWireAudio::SetInputConditioning>("setInputConditioning"),
+        InstanceMethod<&PipeWireAudio::SetInputGain>("setInputGain"),
+        InstanceMethod<&PipeWireAudio::GetInputLevels>("getInputLevels"),
+        InstanceMethod<&PipeWireAudio::AttachPluginBridge>("attachPluginBridge"),
+        InstanceMethod<&PipeWireAudio::DetachPluginBridge>("detachPluginBridge"),
         InstanceAccessor<&PipeWireAudio::IsRunning>("isRunning"),
         InstanceAccessor<&PipeWireAudio::HasSharedBuffer>("hasSharedBuffer"),
+        InstanceAccessor<&PipeWireAudio::HasNotifyBuffer>("hasNotifyBuffer"),
+        InstanceAccessor<&PipeWireAudio::GetNotifyCount>("notifyCount"),
         InstanceAccessor<&PipeWireAudio::GetChannels>("channels"),
         InstanceAccessor<&PipeWireAudio::GetSampleRate>("sampleRate"),
         InstanceAccessor<&PipeWireAudio::GetUnderflows>("underflows"),
@@ -66,6 +195,23 @@ Napi::Object PipeWireAudio::Init(Napi::Env env, Napi::Object exports) {
         InstanceAccessor<&PipeWireAudio::GetBufferedFrames>("bufferedFrames"),
         InstanceAccessor<&PipeWireAudio::GetPrebufferFrames>("prebufferFrames"),
         InstanceAccessor<&PipeWireAudio::GetRingBufferFrames>("ringBufferFrames"),
+        InstanceAccessor<&PipeWireAudio::GetDriverMode>("driverMode"),
+        InstanceAccessor<&PipeWireAudio::GetCatchUp>("catchUp"),
+        InstanceAccessor<&PipeWireAudio::GetDriverTriggers>("driverTriggers"),
+        InstanceAccessor<&PipeWireAudio::GetDriverStalls>("driverStalls"),
+        InstanceAccessor<&PipeWireAudio::GetRenderAhead>("renderAhead"),
+        InstanceAccessor<&PipeWireAudio::GetRenderAheadFrames>("renderAheadFrames"),
+        InstanceAccessor<&PipeWireAudio::GetRenderedBlocks>("renderedBlocks"),
+        InstanceAccessor<&PipeWireAudio::GetRenderSpikes>("renderSpikes"),
+        InstanceAccessor<&PipeWireAudio::GetMaxRenderUs>("maxRenderUs"),
+        InstanceAccessor<&PipeWireAudio::GetRenderDenormals>("renderDenormals"),
+        InstanceAccessor<&PipeWireAudio::GetFlushDenormals>("flushDenormals"),
+        InstanceAccessor<&PipeWireAudio::GetState>("state"),
+        InstanceAccessor<&PipeWireAudio::GetLastError>("lastError"),
+        InstanceAccessor<&PipeWireAudio::GetRecovering>("recovering"),
+        InstanceAccessor<&PipeWireAudio::GetRecoveries>("recoveries"),
+        InstanceAccessor<&PipeWireAudio::GetRecoveryAttempts>("recoveryAttempts"),
+        InstanceAccessor<&PipeWireAudio::GetLastRecoveryMs>("lastRecoveryMs"),
     });
     
     Napi::FunctionReference* constructor = new Napi::FunctionReference();
@@ -131,6 +277,8 @@ PipeWireAudio::PipeWireAudio(const Napi::CallbackInfo& info)
 }
 
 PipeWireAudio::~PipeWireAudio() {
+    ReleaseNotify();
+    ReleaseStateCallback();
     if (stream_) {
         stream_->stop();
     }
@@ -288,12 +436,16 @@ Napi::Value PipeWireAudio::AttachSharedBuffer(const Napi::CallbackInfo& info) {
     }
     
     size_t bufferFrames = info[1].As<Napi::Number>().Uint32Value();
+    size_t packetSlots = info.Length() > 2 && info[2].IsNumber()
+        ? info[2].As<Napi::Number>().Uint32Value()
+        : 0;
     
     std::cout << "[PwAudio] AttachSharedBuffer: data=" << data 
               << ", byteLength=" << byteLength 
-              << ", frames=" << bufferFrames << std::endl;
+              << ", frames=" << bufferFrames
+              << ", packetSlots=" << packetSlots << std::endl;
     
-    bool success = stream_->attachSharedBuffer(data, byteLength, bufferFrames);
+    bool success = stream_->attachSharedBuffer(data, byteLength, bufferFrames, packetSlots);
     
     return Napi::Boolean::New(env, success);
 }
@@ -314,6 +466,127 @@ Napi::Value PipeWireAudio::HasSharedBuffer(const Napi::CallbackInfo& info) {
     return Napi::Boolean::New(env, has);
 }
 
+Napi::Value PipeWireAudio::GetPacketStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!stream_ || !stream_->isPacketized()) {
+        return env.Null();
+    }
+    
+    const SabPackets& packets = stream_->packets();
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("timing", Napi::Boolean::New(env, packets.hasTiming()));
+    obj.Set("packets", Napi::Number::New(env, static_cast<double>(packets.getPackets())));
+    obj.Set("droppedBlocks", Napi::Number::New(env, static_cast<double>(packets.getDroppedBlocks())));
+    obj.Set("duplicatedBlocks", Napi::Number::New(env, static_cast<double>(packets.getDuplicatedBlocks())));
+    obj.Set("discontinuities", Napi::Number::New(env, static_cast<double>(packets.getDiscontinuities())));
+    obj.Set("latencyFrames", Napi::Number::New(env, packets.getLatencyFrames()));
+    obj.Set("maxLatencyFrames", Napi::Number::New(env, packets.getMaxLatencyFrames()));
+    obj.Set("driftPpm", Napi::Number::New(env, packets.getDriftPpm()));
+    return obj;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Notify buffer methods (Atomics.wait para Web Workers)
+// ═══════════════════════════════════════════════════════════════════════════
+
+Napi::Value PipeWireAudio::AttachNotifyBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!stream_) {
+        Napi::Error::New(env, "Stream not initialized").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (info.Length() < 2 || !info[0].IsTypedArray()) {
+        Napi::TypeError::New(env, "Expected arguments: Int32Array (wrapping SAB), wordIndex [, watermarkFrames]")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::TypedArray typedArray = info[0].As<Napi::TypedArray>();
+    if (typedArray.TypedArrayType() != napi_int32_array) {
+        Napi::TypeError::New(env, "Notify buffer must be an Int32Array")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    uint32_t wordIndex = info[1].As<Napi::Number>().Uint32Value();
+    // Por defecto: un despertar por quantum
+    size_t watermarkFrames = static_cast<size_t>(stream_->getBufferSize());
+    if (info.Length() > 2 && info[2].IsNumber()) {
+        watermarkFrames = info[2].As<Napi::Number>().Uint32Value();
+    }
+    
+    uint8_t* base = static_cast<uint8_t*>(typedArray.ArrayBuffer().Data());
+    void* data = base + typedArray.ByteOffset();
+    size_t byteLength = typedArray.ByteLength();
+    
+    ReleaseNotify();
+    
+    Napi::Function notify = env.Global().Get("Atomics").As<Napi::Object>()
+                               .Get("notify").As<Napi::Function>();
+    
+    auto target = std::make_shared<NotifyTarget>();
+    target->array = Napi::Persistent(typedArray.As<Napi::Object>());
+    target->wordIndex = wordIndex;
+    
+    notifyTsfn_ = Napi::ThreadSafeFunction::New(env, notify, "SynthiGME-SabNotify", 0, 1);
+    notifyTsfn_.Unref(env);  // No mantener vivo el proceso
+    notifyTarget_ = target;
+    
+    Napi::ThreadSafeFunction tsfn = notifyTsfn_;
+    bool success = stream_->attachNotifyBuffer(data, byteLength, wordIndex, watermarkFrames,
+        [target, tsfn](int32_t) {
+            // Hilo notificador: encolar Atomics.notify en el hilo JS
+            if (target->queued.exchange(true)) {
+                return;
+            }
+            tsfn.NonBlockingCall([target](Napi::Env env, Napi::Function notifyFn) {
+                target->queued.store(false);
+                if (target->array.IsEmpty()) {
+                    return;
+                }
+                notifyFn.Call({ target->array.Value(), Napi::Number::New(env, target->wordIndex) });
+            });
+        });
+    
+    if (!success) {
+        ReleaseNotify();
+    }
+    
+    return Napi::Boolean::New(env, success);
+}
+
+Napi::Value PipeWireAudio::DetachNotifyBuffer(const Napi::CallbackInfo& info) {
+    ReleaseNotify();
+    return info.Env().Undefined();
+}
+
+void PipeWireAudio::ReleaseNotify() {
+    if (!notifyTarget_) {
+        return;
+    }
+    // Primero parar el hilo notificador (no se encolan más llamadas)
+    if (stream_) {
+        stream_->detachNotifyBuffer();
+    }
+    notifyTarget_->array.Reset();
+    notifyTarget_.reset();
+    notifyTsfn_.Release();
+}
+
+Napi::Value PipeWireAudio::HasNotifyBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    bool has = stream_ ? stream_->hasNotifyBuffer() : false;
+    return Napi::Boolean::New(env, has);
+}
+
+Napi::Value PipeWireAudio::GetNotifyCount(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t count = stream_ ? stream_->getNotifyCount() : 0;
+    return Napi::Number::New(env, static_cast<double>(count));
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Latency configuration methods
 // ═══════════════════════════════════════════════════════════════════════════
@@ -352,9 +625,1246 @@ Napi::Value PipeWireAudio::GetRingBufferFrames(const Napi::CallbackInfo& info) {
     return Napi::Number::New(env, static_cast<double>(frames));
 }
 
-// Inicialización del módulo
-Napi::Object Init(Napi::Env env, Napi::Object exports) {
-    return PipeWireAudio::Init(env, exports);
+// ═══════════════════════════════════════════════════════════════════════════
+// Driver mode methods
+// ═══════════════════════════════════════════════════════════════════════════
+
+Napi::Value PipeWireAudio::SetDriverMode(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!stream_) {
+        Napi::Error::New(env, "Stream not initialized").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (info.Length() < 1 || !info[0].IsBoolean()) {
+        Napi::TypeError::New(env, "Expected 1 argument: enabled (boolean)")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    stream_->setDriverMode(info[0].As<Napi::Boolean>().Value());
+    
+    return env.Undefined();
+}
+
+Napi::Value PipeWireAudio::GetDriverMode(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    bool enabled = stream_ ? stream_->getDriverMode() : false;
+    return Napi::Boolean::New(env, enabled);
+}
+
+Napi::Value PipeWireAudio::SetCatchUp(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!stream_) {
+        Napi::Error::New(env, "Stream not initialized").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (info.Length() < 1 || !info[0].IsBoolean()) {
+        Napi::TypeError::New(env, "Expected 1 argument: enabled (boolean)")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    stream_->setCatchUp(info[0].As<Napi::Boolean>().Value());
+    
+    return env.Undefined();
+}
+
+Napi::Value PipeWireAudio::GetCatchUp(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    bool enabled = stream_ ? stream_->getCatchUp() : false;
+    return Napi::Boolean::New(env, enabled);
+}
+
+Napi::Value PipeWireAudio::GetDriverTriggers(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t triggers = stream_ ? stream_->getDriverTriggers() : 0;
+    return Napi::Number::New(env, static_cast<double>(triggers));
+}
+
+Napi::Value PipeWireAudio::GetDriverStalls(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t stalls = stream_ ? stream_->getDriverStalls() : 0;
+    return Napi::Number::New(env, static_cast<double>(stalls));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Render-ahead methods
+// ═══════════════════════════════════════════════════════════════════════════
+
+Napi::Value PipeWireAudio::SetRenderAhead(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!stream_) {
+        Napi::Error::New(env, "Stream not initialized").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    // null desactiva el modo
+    if (info.Length() >= 1 && info[0].IsNull()) {
+        return Napi::Boolean::New(env, stream_->setRenderAhead(nullptr, 0));
+    }
+    
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: type (or null), aheadBlocks")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    const int32_t blocks = info[1].As<Napi::Number>().Int32Value();
+    if (blocks < 1 || blocks > static_cast<int32_t>(PwStream::MAX_RENDER_AHEAD_BLOCKS)) {
+        Napi::RangeError::New(env, "aheadBlocks must be between 1 and " +
+                              std::to_string(PwStream::MAX_RENDER_AHEAD_BLOCKS))
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    const std::string type = info[0].As<Napi::String>().Utf8Value();
+    const int channels = stream_->getChannels();
+    std::unique_ptr<NativeProcessor> processor = createNativeProcessor(type, channels, channels);
+    if (!processor) {
+        Napi::Error::New(env, "Unknown native processor or invalid channels: " + type)
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    return Napi::Boolean::New(env, stream_->setRenderAhead(std::move(processor),
+                                                           static_cast<size_t>(blocks)));
+}
+
+Napi::Value PipeWireAudio::SetRenderAheadParam(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: name, value")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    bool ok = stream_ && stream_->setRenderAheadParam(info[0].As<Napi::String>().Utf8Value(),
+                                                      info[1].As<Napi::Number>().FloatValue());
+    return Napi::Boolean::New(env, ok);
+}
+
+Napi::Value PipeWireAudio::GetRenderAhead(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    return Napi::Boolean::New(env, stream_ ? stream_->getRenderAhead() : false);
+}
+
+Napi::Value PipeWireAudio::GetRenderAheadFrames(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t frames = stream_ ? stream_->getRenderAheadFrames() : 0;
+    return Napi::Number::New(env, static_cast<double>(frames));
+}
+
+Napi::Value PipeWireAudio::GetRenderedBlocks(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t blocks = stream_ ? stream_->getRenderedBlocks() : 0;
+    return Napi::Number::New(env, static_cast<double>(blocks));
+}
+
+Napi::Value PipeWireAudio::GetRenderSpikes(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t spikes = stream_ ? stream_->getRenderSpikes() : 0;
+    return Napi::Number::New(env, static_cast<double>(spikes));
+}
+
+Napi::Value PipeWireAudio::GetMaxRenderUs(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    return Napi::Number::New(env, stream_ ? stream_->getMaxRenderUs() : 0.0);
+}
+
+Napi::Value PipeWireAudio::GetRenderDenormals(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t denormals = stream_ ? stream_->getRenderDenormals() : 0;
+    return Napi::Number::New(env, static_cast<double>(denormals));
+}
+
+Napi::Value PipeWireAudio::GetFlushDenormals(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    return Napi::Boolean::New(env, stream_ ? stream_->getFlushDenormals() : false);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Estado y recuperación automática
+// ═══════════════════════════════════════════════════════════════════════════
+
+Napi::Value PipeWireAudio::OnStateChange(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!stream_) {
+        Napi::Error::New(env, "Stream not initialized").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (info.Length() < 1 || !(info[0].IsFunction() || info[0].IsNull())) {
+        Napi::TypeError::New(env, "Expected 1 argument: callback (function or null)")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    ReleaseStateCallback();
+    if (info[0].IsNull()) {
+        return env.Undefined();
+    }
+    
+    stateTsfn_ = Napi::ThreadSafeFunction::New(env, info[0].As<Napi::Function>(),
+                                               "SynthiGME-StreamState", 0, 1);
+    stateTsfn_.Unref(env);  // No mantener vivo el proceso
+    hasStateCallback_ = true;
+    
+    Napi::ThreadSafeFunction tsfn = stateTsfn_;
+    stream_->setStateCallback([tsfn](const StreamStateEvent& event) {
+        auto* copy = new StreamStateEvent(event);
+        napi_status status = tsfn.NonBlockingCall(copy,
+            [](Napi::Env env, Napi::Function callback, StreamStateEvent* ev) {
+                Napi::Object obj = Napi::Object::New(env);
+                obj.Set("state", Napi::String::New(env, ev->state));
+                obj.Set("error", Napi::String::New(env, ev->error));
+                obj.Set("recovering", Napi::Boolean::New(env, ev->recovering));
+                obj.Set("recoveries", Napi::Number::New(env, static_cast<double>(ev->recoveries)));
+                obj.Set("recoveryMs", Napi::Number::New(env, ev->recoveryMs));
+                delete ev;
+                callback.Call({ obj });
+            });
+        if (status != napi_ok) {
+            delete copy;
+        }
+    });
+    
+    return env.Undefined();
+}
+
+void PipeWireAudio::ReleaseStateCallback() {
+    if (!hasStateCallback_) {
+        return;
+    }
+    // Primero dejar de encolar desde los hilos nativos: setStateCallback
+    // espera a una llamada en curso, así que tras él nadie usa stateTsfn_
+    if (stream_) {
+        stream_->setStateCallback(nullptr);
+    }
+    stateTsfn_.Release();
+    hasStateCallback_ = false;
+}
+
+Napi::Value PipeWireAudio::GetState(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    return Napi::String::New(env, stream_ ? stream_->getStreamState() : "unconnected");
+}
+
+Napi::Value PipeWireAudio::GetLastError(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    return Napi::String::New(env, stream_ ? stream_->getLastError() : "");
+}
+
+Napi::Value PipeWireAudio::GetRecovering(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    return Napi::Boolean::New(env, stream_ ? stream_->isRecovering() : false);
+}
+
+Napi::Value PipeWireAudio::GetRecoveries(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t recoveries = stream_ ? stream_->getRecoveries() : 0;
+    return Napi::Number::New(env, static_cast<double>(recoveries));
+}
+
+Napi::Value PipeWireAudio::GetRecoveryAttempts(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t attempts = stream_ ? stream_->getRecoveryAttempts() : 0;
+    return Napi::Number::New(env, static_cast<double>(attempts));
+}
+
+Napi::Value PipeWireAudio::GetLastRecoveryMs(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    return Napi::Number::New(env, stream_ ? stream_->getLastRecoveryMs() : 0.0);
+}
+
+Napi::Value PipeWireAudio::SetInputConditioning(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!stream_) {
+        Napi::Error::New(env, "Stream not initialized").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (info.Length() < 3 || !info[0].IsNumber() || !info[1].IsNumber() || !info[2].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: dcCutoffHz, clipThreshold, gainSmoothingMs")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    InputConditioner& conditioner = stream_->conditioner();
+    conditioner.setDcCutoff(info[0].As<Napi::Number>().FloatValue());
+    conditioner.setClipThreshold(info[1].As<Napi::Number>().FloatValue());
+    conditioner.setGainSmoothing(info[2].As<Napi::Number>().FloatValue());
+    return env.Undefined();
+}
+
+Napi::Value PipeWireAudio::SetInputGain(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!stream_) {
+        Napi::Error::New(env, "Stream not initialized").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: channel (-1 = all), gain")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    stream_->conditioner().setGain(info[0].As<Napi::Number>().Int32Value(),
+                                   info[1].As<Napi::Number>().FloatValue());
+    return env.Undefined();
+}
+
+Napi::Value PipeWireAudio::GetInputLevels(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    Napi::Array peaks = Napi::Array::New(env);
+    Napi::Array clips = Napi::Array::New(env);
+    if (stream_ && stream_->getDirection() == StreamDirection::INPUT) {
+        InputConditioner& conditioner = stream_->conditioner();
+        for (int ch = 0; ch < conditioner.getChannels(); ch++) {
+            const InputConditioner::ChannelStats stats = conditioner.takeStats(ch);
+            peaks.Set(static_cast<uint32_t>(ch), Napi::Number::New(env, stats.peak));
+            clips.Set(static_cast<uint32_t>(ch), Napi::Number::New(env, static_cast<double>(stats.clips)));
+        }
+    }
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("peaks", peaks);
+    result.Set("clips", clips);
+    return result;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// NativeProcessorBridge - procesador nativo entre dos nodos Web Audio
+// ═══════════════════════════════════════════════════════════════════════════
+
+class NativeProcessorBridge : public Napi::ObjectWrap<NativeProcessorBridge> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    NativeProcessorBridge(const Napi::CallbackInfo& info);
+    ~NativeProcessorBridge();
+
+private:
+    Napi::Value AttachSharedBuffer(const Napi::CallbackInfo& info);
+    Napi::Value Start(const Napi::CallbackInfo& info);
+    Napi::Value Stop(const Napi::CallbackInfo& info);
+    Napi::Value SetParam(const Napi::CallbackInfo& info);
+    Napi::Value ScheduleParam(const Napi::CallbackInfo& info);
+    Napi::Value SetData(const Napi::CallbackInfo& info);
+    Napi::Value StartRecording(const Napi::CallbackInfo& info);
+    Napi::Value StopRecording(const Napi::CallbackInfo& info);
+    Napi::Value StartPlayback(const Napi::CallbackInfo& info);
+    Napi::Value StopPlayback(const Napi::CallbackInfo& info);
+    Napi::Value IsRecording(const Napi::CallbackInfo& info);
+    Napi::Value IsPlaying(const Napi::CallbackInfo& info);
+    Napi::Value IsRunning(const Napi::CallbackInfo& info);
+    Napi::Value GetType(const Napi::CallbackInfo& info);
+    Napi::Value GetProcessedBlocks(const Napi::CallbackInfo& info);
+    Napi::Value GetOverflows(const Napi::CallbackInfo& info);
+    Napi::Value GetAppliedEvents(const Napi::CallbackInfo& info);
+    Napi::Value GetDroppedEvents(const Napi::CallbackInfo& info);
+    Napi::Value GetUnderruns(const Napi::CallbackInfo& info);
+    Napi::Value GetLatencyFrames(const Napi::CallbackInfo& info);
+    Napi::Value GetAvgProcessUs(const Napi::CallbackInfo& info);
+    Napi::Value GetMaxProcessUs(const Napi::CallbackInfo& info);
+    Napi::Value GetFlushDenormals(const Napi::CallbackInfo& info);
+    Napi::Value GetDenormals(const Napi::CallbackInfo& info);
+    Napi::Value GetDenormalBlocks(const Napi::CallbackInfo& info);
+    
+    std::unique_ptr<ProcessorBridge> bridge_;
+    Napi::ObjectReference sharedArray_;  // Mantiene vivo el SAB mientras el hilo lo usa
+};
+
+Napi::Object NativeProcessorBridge::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "NativeProcessorBridge", {
+        InstanceMethod<&NativeProcessorBridge::AttachSharedBuffer>("attachSharedBuffer"),
+        InstanceMethod<&NativeProcessorBridge::Start>("start"),
+        InstanceMethod<&NativeProcessorBridge::Stop>("stop"),
+        InstanceMethod<&NativeProcessorBridge::SetParam>("setParam"),
+        InstanceMethod<&NativeProcessorBridge::ScheduleParam>("scheduleParam"),
+        InstanceMethod<&NativeProcessorBridge::SetData>("setData"),
+        InstanceMethod<&NativeProcessorBridge::StartRecording>("startRecording"),
+        InstanceMethod<&NativeProcessorBridge::StopRecording>("stopRecording"),
+        InstanceMethod<&NativeProcessorBridge::StartPlayback>("startPlayback"),
+        InstanceMethod<&NativeProcessorBridge::StopPlayback>("stopPlayback"),
+        InstanceAccessor<&NativeProcessorBridge::IsRecording>("recording"),
+        InstanceAccessor<&NativeProcessorBridge::IsPlaying>("playing"),
+        InstanceAccessor<&NativeProcessorBridge::IsRunning>("isRunning"),
+        InstanceAccessor<&NativeProcessorBridge::GetType>("type"),
+        InstanceAccessor<&NativeProcessorBridge::GetProcessedBlocks>("processedBlocks"),
+        InstanceAccessor<&NativeProcessorBridge::GetOverflows>("overflows"),
+        InstanceAccessor<&NativeProcessorBridge::GetAppliedEvents>("appliedEvents"),
+        InstanceAccessor<&NativeProcessorBridge::GetDroppedEvents>("droppedEvents"),
+        InstanceAccessor<&NativeProcessorBridge::GetUnderruns>("underruns"),
+        InstanceAccessor<&NativeProcessorBridge::GetLatencyFrames>("latencyFrames"),
+        InstanceAccessor<&NativeProcessorBridge::GetAvgProcessUs>("avgProcessUs"),
+        InstanceAccessor<&NativeProcessorBridge::GetMaxProcessUs>("maxProcessUs"),
+        InstanceAccessor<&NativeProcessorBridge::GetFlushDenormals>("flushDenormals"),
+        InstanceAccessor<&NativeProcessorBridge::GetDenormals>("denormals"),
+        InstanceAccessor<&NativeProcessorBridge::GetDenormalBlocks>("denormalBlocks"),
+    });
+    
+    exports.Set("NativeProcessorBridge", func);
+    
+    Napi::Array types = Napi::Array::New(env);
+    uint32_t i = 0;
+    for (const std::string& type : nativeProcessorTypes()) {
+        types.Set(i++, Napi::String::New(env, type));
+    }
+    exports.Set("nativeProcessorTypes", types);
+    return exports;
+}
+
+NativeProcessorBridge::NativeProcessorBridge(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<NativeProcessorBridge>(info)
+{
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 4 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected arguments: type, inChannels, outChannels, sampleRate")
+            .ThrowAsJavaScriptException();
+        return;
+    }
+    
+    std::string type = info[0].As<Napi::String>().Utf8Value();
+    int inChannels = info[1].As<Napi::Number>().Int32Value();
+    int outChannels = info[2].As<Napi::Number>().Int32Value();
+    int sampleRate = info[3].As<Napi::Number>().Int32Value();
+    
+    if (inChannels < 0 || inChannels > 32 || outChannels < 1 || outChannels > 32) {
+        Napi::RangeError::New(env, "Channels must be 0-32 (inputs) and 1-32 (outputs)")
+            .ThrowAsJavaScriptException();
+        return;
+    }
+    
+    if (sampleRate < 8000 || sampleRate > 192000) {
+        Napi::RangeError::New(env, "Sample rate must be between 8000 and 192000")
+            .ThrowAsJavaScriptException();
+        return;
+    }
+    
+    std::unique_ptr<NativeProcessor> processor = createNativeProcessor(type, inChannels, outChannels);
+    if (!processor) {
+        Napi::Error::New(env, "Unknown native processor or invalid channels: " + type)
+            .ThrowAsJavaScriptException();
+        return;
+    }
+    
+    bridge_ = std::make_unique<ProcessorBridge>(std::move(processor), inChannels, outChannels, sampleRate);
+}
+
+NativeProcessorBridge::~NativeProcessorBridge() {
+    if (bridge_) {
+        bridge_->stop();
+    }
+}
+
+Napi::Value NativeProcessorBridge::AttachSharedBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!bridge_) {
+        Napi::Error::New(env, "Bridge not initialized").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (info.Length() < 2 || !info[0].IsTypedArray()) {
+        Napi::TypeError::New(env, "Expected arguments: typedArray (wrapping SAB), ringFrames")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::TypedArray typedArray = info[0].As<Napi::TypedArray>();
+    Napi::ArrayBuffer arrayBuffer = typedArray.ArrayBuffer();
+    size_t ringFrames = info[1].As<Napi::Number>().Uint32Value();
+    
+    bool success = bridge_->attachSharedBuffer(arrayBuffer.Data(), arrayBuffer.ByteLength(), ringFrames);
+    if (success) {
+        sharedArray_ = Napi::Persistent(typedArray.As<Napi::Object>());
+    }
+    return Napi::Boolean::New(env, success);
+}
+
+Napi::Value NativeProcessorBridge::Start(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    bool result = bridge_ ? bridge_->start() : false;
+    return Napi::Boolean::New(env, result);
+}
+
+Napi::Value NativeProcessorBridge::Stop(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (bridge_) {
+        bridge_->stop();
+    }
+    sharedArray_.Reset();
+    return env.Undefined();
+}
+
+Napi::Value NativeProcessorBridge::SetParam(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: name, value")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    bool known = bridge_ && bridge_->setParam(info[0].As<Napi::String>().Utf8Value(),
+                                              info[1].As<Napi::Number>().FloatValue());
+    return Napi::Boolean::New(env, known);
+}
+
+Napi::Value NativeProcessorBridge::ScheduleParam(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 3 || !info[0].IsString() || !info[1].IsNumber() || !info[2].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: name, value, frame")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    // Frame del AudioContext módulo 2^32 (ver processor_bridge.h)
+    const double frame = info[2].As<Napi::Number>().DoubleValue();
+    const uint32_t frame32 = static_cast<uint32_t>(static_cast<uint64_t>(std::max(frame, 0.0)));
+    bool queued = bridge_ && bridge_->scheduleParam(info[0].As<Napi::String>().Utf8Value(),
+                                                    info[1].As<Napi::Number>().FloatValue(),
+                                                    frame32);
+    return Napi::Boolean::New(env, queued);
+}
+
+Napi::Value NativeProcessorBridge::SetData(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsTypedArray() ||
+        info[1].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+        Napi::TypeError::New(env, "Expected arguments: name, Float32Array")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::Float32Array data = info[1].As<Napi::Float32Array>();
+    bool accepted = bridge_ && bridge_->setData(info[0].As<Napi::String>().Utf8Value(),
+                                                data.Data(), data.ElementLength());
+    return Napi::Boolean::New(env, accepted);
+}
+
+Napi::Value NativeProcessorBridge::StartRecording(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: frame, maxBytes?")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    const double frame = info[0].As<Napi::Number>().DoubleValue();
+    const uint32_t frame32 = static_cast<uint32_t>(static_cast<uint64_t>(std::max(frame, 0.0)));
+    // 1 MB ≈ 200k eventos de 5 bytes
+    size_t maxBytes = 1 << 20;
+    if (info.Length() > 1 && info[1].IsNumber()) {
+        maxBytes = info[1].As<Napi::Number>().Uint32Value();
+    }
+    if (maxBytes < AutomationLane::MAX_EVENT_BYTES || maxBytes > (64u << 20)) {
+        Napi::RangeError::New(env, "Recording size must be between 14 bytes and 64 MB")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (bridge_) {
+        bridge_->startRecording(maxBytes, frame32);
+    }
+    return env.Undefined();
+}
+
+Napi::Value NativeProcessorBridge::StopRecording(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!bridge_) return env.Null();
+    
+    const AutomationLane& lane = bridge_->stopRecording();
+    Napi::ArrayBuffer data = Napi::ArrayBuffer::New(env, lane.size());
+    if (lane.size() > 0) {
+        std::memcpy(data.Data(), lane.data(), lane.size());
+    }
+    
+    Napi::Array params = Napi::Array::New(env);
+    const std::vector<std::string>& names = bridge_->getParamNames();
+    for (size_t id = 0; id < names.size(); id++) {
+        params.Set(static_cast<uint32_t>(id), Napi::String::New(env, names[id]));
+    }
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("startFrame", Napi::Number::New(env, lane.startFrame()));
+    result.Set("events", Napi::Number::New(env, static_cast<double>(lane.events())));
+    result.Set("dropped", Napi::Number::New(env, static_cast<double>(lane.dropped())));
+    result.Set("data", data);
+    result.Set("params", params);
+    return result;
+}
+
+Napi::Value NativeProcessorBridge::StartPlayback(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsTypedArray() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: Uint8Array, frame")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::TypedArray array = info[0].As<Napi::TypedArray>();
+    const uint8_t* bytes = static_cast<const uint8_t*>(array.ArrayBuffer().Data()) + array.ByteOffset();
+    const double frame = info[1].As<Napi::Number>().DoubleValue();
+    const uint32_t frame32 = static_cast<uint32_t>(static_cast<uint64_t>(std::max(frame, 0.0)));
+    bool started = bridge_ && bridge_->startPlayback(bytes, array.ByteLength(), frame32);
+    return Napi::Boolean::New(env, started);
+}
+
+Napi::Value NativeProcessorBridge::StopPlayback(const Napi::CallbackInfo& info) {
+    if (bridge_) {
+        bridge_->stopPlayback();
+    }
+    return info.Env().Undefined();
+}
+
+Napi::Value NativeProcessorBridge::IsRecording(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), bridge_ ? bridge_->isRecording() : false);
+}
+
+Napi::Value NativeProcessorBridge::IsPlaying(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), bridge_ ? bridge_->isPlaying() : false);
+}
+
+Napi::Value NativeProcessorBridge::IsRunning(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), bridge_ ? bridge_->isRunning() : false);
+}
+
+Napi::Value NativeProcessorBridge::GetType(const Napi::CallbackInfo& info) {
+    return Napi::String::New(info.Env(), bridge_ ? bridge_->getType() : "");
+}
+
+Napi::Value NativeProcessorBridge::GetProcessedBlocks(const Napi::CallbackInfo& info) {
+    size_t blocks = bridge_ ? bridge_->getProcessedBlocks() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(blocks));
+}
+
+Napi::Value NativeProcessorBridge::GetOverflows(const Napi::CallbackInfo& info) {
+    size_t overflows = bridge_ ? bridge_->getOverflows() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(overflows));
+}
+
+Napi::Value NativeProcessorBridge::GetAppliedEvents(const Napi::CallbackInfo& info) {
+    size_t events = bridge_ ? bridge_->getAppliedEvents() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(events));
+}
+
+Napi::Value NativeProcessorBridge::GetDroppedEvents(const Napi::CallbackInfo& info) {
+    size_t events = bridge_ ? bridge_->getDroppedEvents() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(events));
+}
+
+Napi::Value NativeProcessorBridge::GetUnderruns(const Napi::CallbackInfo& info) {
+    size_t underruns = bridge_ ? bridge_->getUnderruns() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(underruns));
+}
+
+Napi::Value NativeProcessorBridge::GetLatencyFrames(const Napi::CallbackInfo& info) {
+    size_t frames = bridge_ ? bridge_->getLatencyFrames() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(frames));
+}
+
+Napi::Value NativeProcessorBridge::GetAvgProcessUs(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), bridge_ ? bridge_->getAvgProcessUs() : 0.0);
+}
+
+Napi::Value NativeProcessorBridge::GetMaxProcessUs(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), bridge_ ? bridge_->getMaxProcessUs() : 0.0);
+}
+
+Napi::Value NativeProcessorBridge::GetFlushDenormals(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), bridge_ ? bridge_->getFlushDenormals() : false);
+}
+
+Napi::Value NativeProcessorBridge::GetDenormals(const Napi::CallbackInfo& info) {
+    size_t denormals = bridge_ ? bridge_->getDenormals() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(denormals));
+}
+
+Napi::Value NativeProcessorBridge::GetDenormalBlocks(const Napi::CallbackInfo& info) {
+    size_t blocks = bridge_ ? bridge_->getDenormalBlocks() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(blocks));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PhosphorScope - rasterizador del osciloscopio en un hilo del addon
+// ═══════════════════════════════════════════════════════════════════════════
+
+class PhosphorScopeWrap : public Napi::ObjectWrap<PhosphorScopeWrap> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    PhosphorScopeWrap(const Napi::CallbackInfo& info);
+    ~PhosphorScopeWrap();
+
+private:
+    Napi::Value AttachFrameBuffer(const Napi::CallbackInfo& info);
+    Napi::Value Start(const Napi::CallbackInfo& info);
+    Napi::Value Stop(const Napi::CallbackInfo& info);
+    Napi::Value Submit(const Napi::CallbackInfo& info);
+    Napi::Value Clear(const Napi::CallbackInfo& info);
+    Napi::Value SetColor(const Napi::CallbackInfo& info);
+    Napi::Value SetPersistence(const Napi::CallbackInfo& info);
+    Napi::Value SetBeamEnergy(const Napi::CallbackInfo& info);
+    Napi::Value IsRunning(const Napi::CallbackInfo& info);
+    Napi::Value GetFramesPublished(const Napi::CallbackInfo& info);
+    Napi::Value GetDroppedPoints(const Napi::CallbackInfo& info);
+    Napi::Value GetAvgRenderUs(const Napi::CallbackInfo& info);
+    
+    std::unique_ptr<PhosphorScope> scope_;
+    Napi::ObjectReference frameArray_;  // Mantiene vivo el SAB mientras el hilo lo usa
+};
+
+Napi::Object PhosphorScopeWrap::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "PhosphorScope", {
+        InstanceMethod<&PhosphorScopeWrap::AttachFrameBuffer>("attachFrameBuffer"),
+        InstanceMethod<&PhosphorScopeWrap::Start>("start"),
+        InstanceMethod<&PhosphorScopeWrap::Stop>("stop"),
+        InstanceMethod<&PhosphorScopeWrap::Submit>("submit"),
+        InstanceMethod<&PhosphorScopeWrap::Clear>("clear"),
+        InstanceMethod<&PhosphorScopeWrap::SetColor>("setColor"),
+        InstanceMethod<&PhosphorScopeWrap::SetPersistence>("setPersistence"),
+        InstanceMethod<&PhosphorScopeWrap::SetBeamEnergy>("setBeamEnergy"),
+        InstanceAccessor<&PhosphorScopeWrap::IsRunning>("isRunning"),
+        InstanceAccessor<&PhosphorScopeWrap::GetFramesPublished>("framesPublished"),
+        InstanceAccessor<&PhosphorScopeWrap::GetDroppedPoints>("droppedPoints"),
+        InstanceAccessor<&PhosphorScopeWrap::GetAvgRenderUs>("avgRenderUs"),
+    });
+    
+    exports.Set("PhosphorScope", func);
+    return exports;
+}
+
+PhosphorScopeWrap::PhosphorScopeWrap(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<PhosphorScopeWrap>(info)
+{
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: width, height, [fps]")
+            .ThrowAsJavaScriptException();
+        return;
+    }
+    
+    int width = info[0].As<Napi::Number>().Int32Value();
+    int height = info[1].As<Napi::Number>().Int32Value();
+    int fps = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Int32Value() : 60;
+    
+    if (width < 16 || width > 4096 || height < 16 || height > 4096) {
+        Napi::RangeError::New(env, "Width and height must be between 16 and 4096")
+            .ThrowAsJavaScriptException();
+        return;
+    }
+    
+    scope_ = std::make_unique<PhosphorScope>(width, height, fps);
+}
+
+PhosphorScopeWrap::~PhosphorScopeWrap() {
+    if (scope_) {
+        scope_->stop();
+    }
+}
+
+Napi::Value PhosphorScopeWrap::AttachFrameBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!scope_ || info.Length() < 1 || !info[0].IsTypedArray()) {
+        Napi::TypeError::New(env, "Expected argument: typedArray (wrapping SAB)")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::TypedArray typedArray = info[0].As<Napi::TypedArray>();
+    Napi::ArrayBuffer arrayBuffer = typedArray.ArrayBuffer();
+    
+    bool success = scope_->attachFrameBuffer(arrayBuffer.Data(), arrayBuffer.ByteLength());
+    if (success) {
+        frameArray_ = Napi::Persistent(typedArray.As<Napi::Object>());
+    }
+    return Napi::Boolean::New(env, success);
+}
+
+Napi::Value PhosphorScopeWrap::Start(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), scope_ ? scope_->start() : false);
+}
+
+Napi::Value PhosphorScopeWrap::Stop(const Napi::CallbackInfo& info) {
+    if (scope_) {
+        scope_->stop();
+    }
+    frameArray_.Reset();
+    return info.Env().Undefined();
+}
+
+Napi::Value PhosphorScopeWrap::Submit(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 6 || !info[0].IsTypedArray() || !info[1].IsTypedArray() ||
+        info[0].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array ||
+        info[1].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+        Napi::TypeError::New(env, "Expected arguments: Float32Array x, Float32Array y, cx, cy, sx, sy")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::Float32Array x = info[0].As<Napi::Float32Array>();
+    Napi::Float32Array y = info[1].As<Napi::Float32Array>();
+    if (scope_) {
+        scope_->submit(x.Data(), y.Data(), std::min(x.ElementLength(), y.ElementLength()),
+                       info[2].As<Napi::Number>().FloatValue(),
+                       info[3].As<Napi::Number>().FloatValue(),
+                       info[4].As<Napi::Number>().FloatValue(),
+                       info[5].As<Napi::Number>().FloatValue());
+    }
+    return env.Undefined();
+}
+
+Napi::Value PhosphorScopeWrap::Clear(const Napi::CallbackInfo& info) {
+    if (scope_) {
+        scope_->clear();
+    }
+    return info.Env().Undefined();
+}
+
+Napi::Value PhosphorScopeWrap::SetColor(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 3) {
+        Napi::TypeError::New(env, "Expected arguments: r, g, b").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (scope_) {
+        scope_->setColor(static_cast<uint8_t>(info[0].As<Napi::Number>().Uint32Value()),
+                         static_cast<uint8_t>(info[1].As<Napi::Number>().Uint32Value()),
+                         static_cast<uint8_t>(info[2].As<Napi::Number>().Uint32Value()));
+    }
+    return env.Undefined();
+}
+
+Napi::Value PhosphorScopeWrap::SetPersistence(const Napi::CallbackInfo& info) {
+    if (scope_ && info.Length() > 0 && info[0].IsNumber()) {
+        scope_->setPersistence(info[0].As<Napi::Number>().FloatValue());
+    }
+    return info.Env().Undefined();
+}
+
+Napi::Value PhosphorScopeWrap::SetBeamEnergy(const Napi::CallbackInfo& info) {
+    if (scope_ && info.Length() > 0 && info[0].IsNumber()) {
+        scope_->setBeamEnergy(info[0].As<Napi::Number>().FloatValue());
+    }
+    return info.Env().Undefined();
+}
+
+Napi::Value PhosphorScopeWrap::IsRunning(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), scope_ ? scope_->isRunning() : false);
+}
+
+Napi::Value PhosphorScopeWrap::GetFramesPublished(const Napi::CallbackInfo& info) {
+    size_t frames = scope_ ? scope_->getFramesPublished() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(frames));
+}
+
+Napi::Value PhosphorScopeWrap::GetDroppedPoints(const Napi::CallbackInfo& info) {
+    size_t dropped = scope_ ? scope_->getDroppedPoints() : 0;
+    return Napi::Number::New(info.Env(), static_cast<double>(dropped));
+}
+
+Napi::Value PhosphorScopeWrap::GetAvgRenderUs(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), scope_ ? scope_->getAvgRenderUs() : 0.0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PipeWireLinkManager - Restauración de enlaces de puertos por reglas
+// ═══════════════════════════════════════════════════════════════════════════
+
+class LinkManagerWrap : public Napi::ObjectWrap<LinkManagerWrap> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    LinkManagerWrap(const Napi::CallbackInfo& info);
+    ~LinkManagerWrap();
+
+private:
+    Napi::Value Start(const Napi::CallbackInfo& info);
+    Napi::Value Stop(const Napi::CallbackInfo& info);
+    Napi::Value SetRules(const Napi::CallbackInfo& info);
+    Napi::Value Snapshot(const Napi::CallbackInfo& info);
+    Napi::Value Ports(const Napi::CallbackInfo& info);
+    Napi::Value GetStats(const Napi::CallbackInfo& info);
+    Napi::Value IsRunning(const Napi::CallbackInfo& info);
+    
+    LinkManager manager_;
+};
+
+Napi::Object LinkManagerWrap::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "PipeWireLinkManager", {
+        InstanceMethod<&LinkManagerWrap::Start>("start"),
+        InstanceMethod<&LinkManagerWrap::Stop>("stop"),
+        InstanceMethod<&LinkManagerWrap::SetRules>("setRules"),
+        InstanceMethod<&LinkManagerWrap::Snapshot>("snapshot"),
+        InstanceMethod<&LinkManagerWrap::Ports>("ports"),
+        InstanceMethod<&LinkManagerWrap::GetStats>("getStats"),
+        InstanceAccessor<&LinkManagerWrap::IsRunning>("isRunning"),
+    });
+    
+    exports.Set("PipeWireLinkManager", func);
+    return exports;
+}
+
+LinkManagerWrap::LinkManagerWrap(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<LinkManagerWrap>(info)
+{
+}
+
+LinkManagerWrap::~LinkManagerWrap() {
+    manager_.stop();
+}
+
+Napi::Value LinkManagerWrap::Start(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), manager_.start());
+}
+
+Napi::Value LinkManagerWrap::Stop(const Napi::CallbackInfo& info) {
+    manager_.stop();
+    return info.Env().Undefined();
+}
+
+Napi::Value LinkManagerWrap::SetRules(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Expected argument: array of { output, input }")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::Array array = info[0].As<Napi::Array>();
+    std::vector<LinkManager::Rule> rules;
+    for (uint32_t i = 0; i < array.Length(); i++) {
+        Napi::Value item = array.Get(i);
+        if (!item.IsObject()) {
+            continue;
+        }
+        Napi::Object obj = item.As<Napi::Object>();
+        Napi::Value output = obj.Get("output");
+        Napi::Value input = obj.Get("input");
+        if (!output.IsString() || !input.IsString()) {
+            Napi::TypeError::New(env, "Each rule needs string patterns: output, input")
+                .ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        rules.push_back({ output.As<Napi::String>().Utf8Value(), input.As<Napi::String>().Utf8Value() });
+    }
+    
+    size_t count = rules.size();
+    manager_.setRules(std::move(rules));
+    return Napi::Number::New(env, static_cast<double>(count));
+}
+
+Napi::Value LinkManagerWrap::Snapshot(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::string pattern = info.Length() > 0 && info[0].IsString()
+        ? info[0].As<Napi::String>().Utf8Value()
+        : std::string("*");
+    
+    auto links = manager_.snapshot(pattern);
+    Napi::Array result = Napi::Array::New(env, links.size());
+    for (size_t i = 0; i < links.size(); i++) {
+        Napi::Object link = Napi::Object::New(env);
+        link.Set("output", Napi::String::New(env, links[i].output));
+        link.Set("input", Napi::String::New(env, links[i].input));
+        result.Set(static_cast<uint32_t>(i), link);
+    }
+    return result;
+}
+
+Napi::Value LinkManagerWrap::Ports(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::string pattern = info.Length() > 0 && info[0].IsString()
+        ? info[0].As<Napi::String>().Utf8Value()
+        : std::string("*");
+    
+    auto ports = manager_.ports(pattern);
+    Napi::Array result = Napi::Array::New(env, ports.size());
+    for (size_t i = 0; i < ports.size(); i++) {
+        result.Set(static_cast<uint32_t>(i), Napi::String::New(env, ports[i]));
+    }
+    return result;
+}
+
+Napi::Value LinkManagerWrap::GetStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    LinkManager::Stats stats = manager_.getStats();
+    
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("connected", Napi::Boolean::New(env, stats.connected));
+    obj.Set("nodes", Napi::Number::New(env, static_cast<double>(stats.nodes)));
+    obj.Set("ports", Napi::Number::New(env, static_cast<double>(stats.ports)));
+    obj.Set("links", Napi::Number::New(env, static_cast<double>(stats.links)));
+    obj.Set("created", Napi::Number::New(env, static_cast<double>(stats.created)));
+    obj.Set("failed", Napi::Number::New(env, static_cast<double>(stats.failed)));
+    obj.Set("pending", Napi::Number::New(env, static_cast<double>(stats.pending)));
+    obj.Set("lastLinkMs", Napi::Number::New(env, stats.lastLinkMs));
+    return obj;
+}
+
+Napi::Value LinkManagerWrap::IsRunning(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), manager_.isRunning());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PluginBridge - Memoria compartida con el plugin LV2 synthigme-bridge
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Etiqueta para reconocer un PluginBridge en attachPluginBridge()
+static const napi_type_tag PLUGIN_BRIDGE_TAG = { 0x53796e746869474dULL, 0x4c56324272696467ULL };
+
+class PluginBridgeWrap : public Napi::ObjectWrap<PluginBridgeWrap> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    PluginBridgeWrap(const Napi::CallbackInfo& info);
+    
+    std::shared_ptr<ShmBridge> bridge() const { return bridge_; }
+
+private:
+    Napi::Value Open(const Napi::CallbackInfo& info);
+    Napi::Value Close(const Napi::CallbackInfo& info);
+    Napi::Value SetPipelineLatency(const Napi::CallbackInfo& info);
+    Napi::Value GetStats(const Napi::CallbackInfo& info);
+    Napi::Value IsOpen(const Napi::CallbackInfo& info);
+    
+    std::string name_;
+    // Compartido con los PwStream a los que se adjunta: el segmento sigue
+    // mapeado mientras un hilo RT pueda usarlo
+    std::shared_ptr<ShmBridge> bridge_;
+};
+
+Napi::Object PluginBridgeWrap::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "PluginBridge", {
+        InstanceMethod<&PluginBridgeWrap::Open>("open"),
+        InstanceMethod<&PluginBridgeWrap::Close>("close"),
+        InstanceMethod<&PluginBridgeWrap::SetPipelineLatency>("setPipelineLatency"),
+        InstanceMethod<&PluginBridgeWrap::GetStats>("getStats"),
+        InstanceAccessor<&PluginBridgeWrap::IsOpen>("isOpen"),
+    });
+    
+    exports.Set("PluginBridge", func);
+    return exports;
+}
+
+PluginBridgeWrap::PluginBridgeWrap(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<PluginBridgeWrap>(info),
+      name_(ShmBridge::DEFAULT_NAME),
+      bridge_(std::make_shared<ShmBridge>())
+{
+    info.This().As<Napi::Object>().TypeTag(&PLUGIN_BRIDGE_TAG);
+    if (info.Length() > 0 && info[0].IsString()) {
+        name_ = info[0].As<Napi::String>().Utf8Value();
+        if (name_.empty() || name_[0] != '/') {
+            name_ = "/" + name_;
+        }
+    }
+}
+
+Napi::Value PluginBridgeWrap::Open(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 5 || !info[0].IsNumber() || !info[1].IsNumber() || !info[2].IsNumber() ||
+        !info[3].IsNumber() || !info[4].IsNumber()) {
+        Napi::TypeError::New(env, "Expected arguments: sampleRate, sendChannels, returnChannels, ringFrames, latencyFrames")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    int sampleRate = info[0].As<Napi::Number>().Int32Value();
+    int sendChannels = info[1].As<Napi::Number>().Int32Value();
+    int returnChannels = info[2].As<Napi::Number>().Int32Value();
+    int64_t ringFrames = info[3].As<Napi::Number>().Int64Value();
+    int64_t latencyFrames = info[4].As<Napi::Number>().Int64Value();
+    
+    if (sendChannels < 1 || sendChannels > ShmBridge::MAX_CHANNELS ||
+        returnChannels < 1 || returnChannels > ShmBridge::MAX_CHANNELS) {
+        Napi::RangeError::New(env, "Channels must be between 1 and 8").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (ringFrames < 256 || (ringFrames & (ringFrames - 1)) != 0 || latencyFrames < 1) {
+        Napi::RangeError::New(env, "ringFrames must be a power of two >= 256, latencyFrames >= 1")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    // Un segmento nuevo: los streams adjuntos al anterior lo siguen usando
+    // hasta que se vuelvan a adjuntar, así que se crea otro objeto
+    if (bridge_->isOpen()) {
+        bridge_ = std::make_shared<ShmBridge>();
+    }
+    bool ok = bridge_->create(name_, sampleRate, sendChannels, returnChannels,
+                              static_cast<size_t>(ringFrames), static_cast<size_t>(latencyFrames));
+    return Napi::Boolean::New(env, ok);
+}
+
+Napi::Value PluginBridgeWrap::Close(const Napi::CallbackInfo& info) {
+    // Los streams que aún lo tengan adjunto mantienen vivo el mapeo; el
+    // plugin ve appPid = 0 y deja de usarlo
+    bridge_ = std::make_shared<ShmBridge>();
+    return info.Env().Undefined();
+}
+
+Napi::Value PluginBridgeWrap::SetPipelineLatency(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Expected argument: frames").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    int64_t frames = info[0].As<Napi::Number>().Int64Value();
+    bridge_->setPipelineLatency(static_cast<size_t>(std::max<int64_t>(0, frames)));
+    return env.Undefined();
+}
+
+Napi::Value PluginBridgeWrap::GetStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const ShmBridge::Header* header = bridge_->header();
+    if (!header) {
+        return env.Null();
+    }
+    
+    auto pair = [&](const std::atomic<uint32_t>* values) {
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("send", Napi::Number::New(env, values[ShmBridge::SEND].load()));
+        obj.Set("return", Napi::Number::New(env, values[ShmBridge::RETURN].load()));
+        return obj;
+    };
+    
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("name", Napi::String::New(env, name_));
+    obj.Set("pluginConnected", Napi::Boolean::New(env, bridge_->hasPeer()));
+    obj.Set("sampleRate", Napi::Number::New(env, header->sampleRate));
+    obj.Set("ringFrames", Napi::Number::New(env, header->ringFrames));
+    obj.Set("latencyFrames", Napi::Number::New(env, header->latencyFrames.load()));
+    obj.Set("reportedLatency", Napi::Number::New(env, header->reportedLatency.load()));
+    Napi::Object fill = Napi::Object::New(env);
+    fill.Set("send", Napi::Number::New(env, static_cast<double>(bridge_->fillFrames(ShmBridge::SEND))));
+    fill.Set("return", Napi::Number::New(env, static_cast<double>(bridge_->fillFrames(ShmBridge::RETURN))));
+    obj.Set("fillFrames", fill);
+    obj.Set("underruns", pair(header->underruns));
+    obj.Set("overflows", pair(header->overflows));
+    obj.Set("skips", pair(header->skips));
+    return obj;
+}
+
+Napi::Value PluginBridgeWrap::IsOpen(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), bridge_->isOpen());
+}
+
+// Métodos de PipeWireAudio que necesitan PluginBridgeWrap completo
+
+Napi::Value PipeWireAudio::AttachPluginBridge(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject() ||
+        !info[0].As<Napi::Object>().CheckTypeTag(&PLUGIN_BRIDGE_TAG)) {
+        Napi::TypeError::New(env, "Expected arguments: PluginBridge, channelOffset")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    PluginBridgeWrap* wrap = PluginBridgeWrap::Unwrap(info[0].As<Napi::Object>());
+    if (!stream_ || !wrap->bridge()->isOpen()) {
+        return Napi::Boolean::New(env, false);
+    }
+    
+    int channelOffset = info.Length() > 1 && info[1].IsNumber()
+        ? info[1].As<Napi::Number>().Int32Value()
+        : 0;
+    stream_->attachBridge(wrap->bridge(), channelOffset);
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value PipeWireAudio::DetachPluginBridge(const Napi::CallbackInfo& info) {
+    if (stream_) {
+        stream_->detachBridge();
+    }
+    return info.Env().Undefined();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Salud del audio - Agregados de sesión para telemetría
+// ═══════════════════════════════════════════════════════════════════════════
+
+static Napi::Object PercentilesToObject(Napi::Env env, const AudioHealth::Percentiles& p) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("p50", Napi::Number::New(env, p.p50));
+    obj.Set("p95", Napi::Number::New(env, p.p95));
+    obj.Set("p99", Napi::Number::New(env, p.p99));
+    obj.Set("max", Napi::Number::New(env, p.max));
+    return obj;
+}
+
+static Napi::Object HealthToObject(Napi::Env env, const AudioHealth::Snapshot& s) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("streams", Napi::Number::New(env, static_cast<double>(s.streams)));
+    obj.Set("cycles", Napi::Number::New(env, static_cast<double>(s.cycles)));
+    obj.Set("underflows", Napi::Number::New(env, static_cast<double>(s.underflows)));
+    obj.Set("overflows", Napi::Number::New(env, static_cast<double>(s.overflows)));
+    obj.Set("catchUps", Napi::Number::New(env, static_cast<double>(s.catchUps)));
+    obj.Set("catchUpFrames", Napi::Number::New(env, static_cast<double>(s.catchUpFrames)));
+    obj.Set("latencyOverruns", Napi::Number::New(env, static_cast<double>(s.latencyOverruns)));
+    obj.Set("latencyMs", PercentilesToObject(env, s.latencyMs));
+    obj.Set("loadPct", PercentilesToObject(env, s.loadPct));
+
+    Napi::Object quantum = Napi::Object::New(env);
+    quantum.Set("last", Napi::Number::New(env, s.quantum));
+    quantum.Set("min", Napi::Number::New(env, s.quantumMin));
+    quantum.Set("max", Napi::Number::New(env, s.quantumMax));
+    obj.Set("quantum", quantum);
+
+    obj.Set("rate", Napi::Number::New(env, s.rate));
+    obj.Set("channels", Napi::Number::New(env, s.channels));
+    obj.Set("format", Napi::String::New(env, s.format));
+    obj.Set("prebufferMs", Napi::Number::New(env, s.prebufferMs));
+    obj.Set("driverMode", Napi::Boolean::New(env, s.driverMode));
+    return obj;
+}
+
+static Napi::Value GetAudioHealth(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("output", HealthToObject(env, AudioHealth::output().snapshot()));
+    result.Set("input", HealthToObject(env, AudioHealth::input().snapshot()));
+    return result;
+}
+
+static Napi::Value ResetAudioHealth(const Napi::CallbackInfo& info) {
+    AudioHealth::output().reset();
+    AudioHealth::input().reset();
+    return info.Env().Undefined();
+}
+
+// Inicialización del módulo
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    PipeWireAudio::Init(env, exports);
+    NativeProcessorBridge::Init(env, exports);
+    PhosphorScopeWrap::Init(env, exports);
+    LinkManagerWrap::Init(env, exports);
+    PluginBridgeWrap::Init(env, exports);
+    exports.Set("getAudioHealth", Napi::Function::New(env, GetAudioHealth));
+    exports.Set("resetAudioHealth", Napi::Function::New(env, ResetAudioHealth));
+    exports.Set("audioKernels", Napi::String::New(env, AudioKernels::isa()));
+    exports.Set("flushDenormalsSupported", Napi::Boolean::New(env, Denormals::supported()));
+    return exports;
 }
 
 NODE_API_MODULE(pipewire_audio, Init)
@@ -0,0 +1,387 @@
+/**
+ * ProcessorBridge implementation
+ */
+
+#include "processor_bridge.h"
+#include "audio_kernels.h"
+#include "denormals.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+int32_t ringDistance(int32_t from, int32_t to, int32_t size) {
+    return to >= from ? to - from : size - from + to;
+}
+
+// Diferencia de frames módulo 2^32 (positiva si b es posterior a a)
+int32_t frameDelta(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(b - a);
+}
+
+} // namespace
+
+ProcessorBridge::ProcessorBridge(std::unique_ptr<NativeProcessor> processor,
+                                 int inChannels, int outChannels, int sampleRate)
+    : processor_(std::move(processor))
+    , inChannels_(inChannels)
+    , outChannels_(outChannels)
+    , sampleRate_(sampleRate)
+{
+}
+
+ProcessorBridge::~ProcessorBridge() {
+    stop();
+}
+
+size_t ProcessorBridge::requiredBytes(size_t ringFrames, int inChannels, int outChannels) {
+    return HEADER_WORDS * sizeof(int32_t)
+         + ringFrames * static_cast<size_t>(inChannels + outChannels) * sizeof(float);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SharedArrayBuffer
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool ProcessorBridge::attachSharedBuffer(void* buffer, size_t bufferSize, size_t ringFrames) {
+    if (running_.load()) {
+        std::cerr << "[ProcessorBridge] Cannot attach buffer while running" << std::endl;
+        return false;
+    }
+    if (!buffer || ringFrames < static_cast<size_t>(BLOCK_FRAMES) * 2) {
+        std::cerr << "[ProcessorBridge] Invalid buffer or ring too small" << std::endl;
+        return false;
+    }
+
+    const size_t needed = requiredBytes(ringFrames, inChannels_, outChannels_);
+    if (bufferSize < needed) {
+        std::cerr << "[ProcessorBridge] Buffer too small: " << bufferSize
+                  << " < " << needed << " bytes" << std::endl;
+        return false;
+    }
+
+    header_ = reinterpret_cast<std::atomic<int32_t>*>(buffer);
+    float* audio = reinterpret_cast<float*>(static_cast<int32_t*>(buffer) + HEADER_WORDS);
+    inRing_ = audio;
+    outRing_ = audio + ringFrames * inChannels_;
+    ringFrames_ = static_cast<int32_t>(ringFrames);
+
+    // Índices del lado nativo a 0 (el worklet inicializa los suyos)
+    header_[IN_READ].store(0, std::memory_order_relaxed);
+    header_[OUT_WRITE].store(0, std::memory_order_relaxed);
+    header_[BLOCKS].store(0, std::memory_order_release);
+    inputFrames_ = 0;
+
+    std::cout << "[ProcessorBridge] Attached " << processor_->type() << ": "
+              << inChannels_ << "→" << outChannels_ << "ch, ring "
+              << ringFrames << " frames" << std::endl;
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Ciclo de vida
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool ProcessorBridge::start() {
+    if (running_.load()) return true;
+    if (!header_) {
+        std::cerr << "[ProcessorBridge] No shared buffer attached" << std::endl;
+        return false;
+    }
+
+    // Reservas fuera del hilo de audio
+    inPlanar_.assign(static_cast<size_t>(BLOCK_FRAMES) * inChannels_, 0.0f);
+    outPlanar_.assign(static_cast<size_t>(BLOCK_FRAMES) * outChannels_, 0.0f);
+    inPtrs_.resize(inChannels_);
+    outPtrs_.resize(outChannels_);
+    subInPtrs_.resize(inChannels_);
+    subOutPtrs_.resize(outChannels_);
+    for (int ch = 0; ch < inChannels_; ch++) {
+        inPtrs_[ch] = &inPlanar_[static_cast<size_t>(ch) * BLOCK_FRAMES];
+    }
+    for (int ch = 0; ch < outChannels_; ch++) {
+        outPtrs_[ch] = &outPlanar_[static_cast<size_t>(ch) * BLOCK_FRAMES];
+    }
+    processor_->prepare(sampleRate_, BLOCK_FRAMES);
+
+    running_.store(true);
+    thread_ = std::thread(&ProcessorBridge::runLoop, this);
+
+    std::cout << "[ProcessorBridge] Started " << processor_->type()
+              << " @ " << sampleRate_ << "Hz" << std::endl;
+    return true;
+}
+
+void ProcessorBridge::stop() {
+    if (!running_.exchange(false)) return;
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    std::cout << "[ProcessorBridge] Stopped " << processor_->type()
+              << ". Blocks: " << processedBlocks_.load()
+              << ", underruns: " << getUnderruns()
+              << ", avg " << getAvgProcessUs() << "us/block" << std::endl;
+}
+
+bool ProcessorBridge::setParam(const std::string& name, float value) {
+    std::lock_guard<std::mutex> lock(processMutex_);
+    if (!processor_->setParam(name, value)) return false;
+
+    // Se aplica al inicio del siguiente bloque, con rampa
+    if (recording_) {
+        const int id = processor_->paramId(name);
+        if (id >= 0) {
+            registerParamName(id, name);
+            recorder_.append(nextBlockFrame_, id, value, true);
+        }
+    }
+    return true;
+}
+
+bool ProcessorBridge::scheduleParam(const std::string& name, float value, uint32_t frame) {
+    // paramId() es const y no toca estado de audio: no hace falta el mutex
+    const int id = processor_->paramId(name);
+    if (id < 0) return false;
+    registerParamName(id, name);
+
+    const size_t head = eventHead_.load(std::memory_order_relaxed);
+    const size_t tail = eventTail_.load(std::memory_order_acquire);
+    if (head - tail >= MAX_EVENTS) {
+        droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    eventQueue_[head % MAX_EVENTS] = { frame, id, value };
+    eventHead_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool ProcessorBridge::setData(const std::string& name, const float* data, size_t count) {
+    std::lock_guard<std::mutex> lock(processMutex_);
+    return processor_->setData(name, data, count);
+}
+
+void ProcessorBridge::registerParamName(int id, const std::string& name) {
+    if (static_cast<size_t>(id) >= paramNames_.size()) {
+        paramNames_.resize(static_cast<size_t>(id) + 1);
+    }
+    paramNames_[id] = name;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Automatización
+// ═══════════════════════════════════════════════════════════════════════════
+
+void ProcessorBridge::startRecording(size_t capacityBytes, uint32_t startFrame) {
+    std::lock_guard<std::mutex> lock(processMutex_);
+    recorder_.reset(capacityBytes, startFrame);
+    recording_ = true;
+}
+
+const AutomationLane& ProcessorBridge::stopRecording() {
+    std::lock_guard<std::mutex> lock(processMutex_);
+    recording_ = false;
+    return recorder_;
+}
+
+bool ProcessorBridge::startPlayback(const uint8_t* data, size_t size, uint32_t startFrame) {
+    std::lock_guard<std::mutex> lock(processMutex_);
+    playback_.assign(data, size);
+    playCursor_ = playback_.begin(startFrame);
+    playing_ = playback_.next(playCursor_, playNext_);
+    return playing_;
+}
+
+void ProcessorBridge::stopPlayback() {
+    std::lock_guard<std::mutex> lock(processMutex_);
+    playing_ = false;
+}
+
+bool ProcessorBridge::isRecording() {
+    std::lock_guard<std::mutex> lock(processMutex_);
+    return recording_;
+}
+
+bool ProcessorBridge::isPlaying() {
+    std::lock_guard<std::mutex> lock(processMutex_);
+    return playing_;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Hilo del bridge
+// ═══════════════════════════════════════════════════════════════════════════
+
+void ProcessorBridge::runLoop() {
+    // Sondeo a 1/4 de bloque: el retraso de recogida queda muy por debajo
+    // de un render quantum (2.67ms @ 48kHz)
+    const auto pollInterval = std::chrono::microseconds(
+        static_cast<int64_t>(BLOCK_FRAMES) * 1000000 / sampleRate_ / 4);
+    flushDenormals_.store(Denormals::enableFlush());
+
+    while (running_.load()) {
+        bool worked = false;
+        while (running_.load() && processBlock()) {
+            worked = true;
+        }
+        if (!worked) {
+            std::this_thread::sleep_for(pollInterval);
+        }
+    }
+}
+
+bool ProcessorBridge::processBlock() {
+    const int32_t inWrite = header_[IN_WRITE].load(std::memory_order_acquire);
+    int32_t inRead = header_[IN_READ].load(std::memory_order_relaxed);
+    if (ringDistance(inRead, inWrite, ringFrames_) < BLOCK_FRAMES) {
+        return false;
+    }
+
+    // Desintercalar el bloque de entrada (como mucho dos tramos del ring)
+    const int inFirst = std::min(BLOCK_FRAMES, ringFrames_ - inRead);
+    AudioKernels::deinterleave(&inRing_[static_cast<size_t>(inRead) * inChannels_], inChannels_,
+                               inPlanar_.data(), BLOCK_FRAMES, inFirst);
+    AudioKernels::deinterleave(inRing_, inChannels_, inPlanar_.data() + inFirst, BLOCK_FRAMES,
+                               BLOCK_FRAMES - inFirst);
+    inRead = (inRead + BLOCK_FRAMES) % ringFrames_;
+    header_[IN_READ].store(inRead, std::memory_order_release);
+
+    // Frame del AudioContext en que empezó este bloque en el worklet
+    const uint32_t blockFrame =
+        static_cast<uint32_t>(header_[ORIGIN].load(std::memory_order_relaxed)) + inputFrames_;
+    inputFrames_ += BLOCK_FRAMES;
+    drainEvents();
+
+    {
+        std::lock_guard<std::mutex> lock(processMutex_);
+        const auto t0 = std::chrono::steady_clock::now();
+
+        // Partir el bloque en los frames de los eventos que caen dentro;
+        // los atrasados se aplican al inicio
+        int pos = 0;
+        while (pos < BLOCK_FRAMES) {
+            int end = BLOCK_FRAMES;
+            size_t applied = 0;
+            while (applied < pendingCount_) {
+                const int32_t offset = frameDelta(blockFrame, pending_[applied].frame);
+                if (offset > pos) {
+                    end = std::min(offset, BLOCK_FRAMES);
+                    break;
+                }
+                const ParamEvent& ev = pending_[applied];
+                processor_->setParamById(ev.id, ev.value);
+                if (recording_) recorder_.append(blockFrame + pos, ev.id, ev.value, false);
+                applied++;
+            }
+            if (applied > 0) {
+                pendingCount_ -= applied;
+                std::memmove(pending_, pending_ + applied, pendingCount_ * sizeof(ParamEvent));
+                appliedEvents_.fetch_add(applied, std::memory_order_relaxed);
+            }
+            while (playing_) {
+                const int32_t offset = frameDelta(blockFrame, playNext_.frame);
+                if (offset > pos) {
+                    end = std::min(end, offset);
+                    break;
+                }
+                if (playNext_.ramp) {
+                    processor_->rampParamById(playNext_.id, playNext_.value);
+                } else {
+                    processor_->setParamById(playNext_.id, playNext_.value);
+                }
+                playing_ = playback_.next(playCursor_, playNext_);
+            }
+            runProcessor(pos, end - pos);
+            pos = end;
+        }
+        nextBlockFrame_ = blockFrame + BLOCK_FRAMES;
+
+        const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count());
+        totalProcessNs_.fetch_add(ns, std::memory_order_relaxed);
+        if (ns > maxProcessNs_.load(std::memory_order_relaxed)) {
+            maxProcessNs_.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    // Detector de subnormales por muestreo (fuera del tiempo medido)
+    if (processedBlocks_.load(std::memory_order_relaxed) % Denormals::SAMPLE_BLOCKS == 0) {
+        const size_t found = Denormals::countSubnormals(outPlanar_.data(), outPlanar_.size());
+        if (found > 0) {
+            denormals_.fetch_add(found, std::memory_order_relaxed);
+            denormalBlocks_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Intercalar en el ring de salida (si el worklet no consume, se descarta)
+    const int32_t outRead = header_[OUT_READ].load(std::memory_order_acquire);
+    int32_t outWrite = header_[OUT_WRITE].load(std::memory_order_relaxed);
+    const int32_t space = ringFrames_ - 1 - ringDistance(outRead, outWrite, ringFrames_);
+    if (space < BLOCK_FRAMES) {
+        overflows_.fetch_add(1);
+    } else {
+        const int outFirst = std::min(BLOCK_FRAMES, ringFrames_ - outWrite);
+        AudioKernels::interleave(outPlanar_.data(), BLOCK_FRAMES, outChannels_,
+                                 &outRing_[static_cast<size_t>(outWrite) * outChannels_], outFirst);
+        AudioKernels::interleave(outPlanar_.data() + outFirst, BLOCK_FRAMES, outChannels_, outRing_,
+                                 BLOCK_FRAMES - outFirst);
+        outWrite = (outWrite + BLOCK_FRAMES) % ringFrames_;
+        header_[OUT_WRITE].store(outWrite, std::memory_order_release);
+    }
+
+    processedBlocks_.fetch_add(1);
+    header_[BLOCKS].fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void ProcessorBridge::drainEvents() {
+    size_t tail = eventTail_.load(std::memory_order_relaxed);
+    const size_t head = eventHead_.load(std::memory_order_acquire);
+    for (; tail != head; tail++) {
+        const ParamEvent& ev = eventQueue_[tail % MAX_EVENTS];
+        if (pendingCount_ == MAX_EVENTS) {
+            droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        // Inserción ordenada por frame (estable: mismo frame, orden de llegada)
+        size_t i = pendingCount_;
+        while (i > 0 && frameDelta(ev.frame, pending_[i - 1].frame) > 0) {
+            pending_[i] = pending_[i - 1];
+            i--;
+        }
+        pending_[i] = ev;
+        pendingCount_++;
+    }
+    eventTail_.store(tail, std::memory_order_release);
+}
+
+void ProcessorBridge::runProcessor(int offset, int frames) {
+    if (frames <= 0) return;
+    if (offset == 0 && frames == BLOCK_FRAMES) {
+        processor_->process(inPtrs_.data(), outPtrs_.data(), BLOCK_FRAMES);
+        return;
+    }
+    for (int ch = 0; ch < inChannels_; ch++) subInPtrs_[ch] = inPtrs_[ch] + offset;
+    for (int ch = 0; ch < outChannels_; ch++) subOutPtrs_[ch] = outPtrs_[ch] + offset;
+    processor_->process(subInPtrs_.data(), subOutPtrs_.data(), frames);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Estadísticas
+// ═══════════════════════════════════════════════════════════════════════════
+
+size_t ProcessorBridge::getUnderruns() const {
+    return header_ ? static_cast<size_t>(header_[UNDERRUNS].load(std::memory_order_relaxed)) : 0;
+}
+
+size_t ProcessorBridge::getLatencyFrames() const {
+    return header_ ? static_cast<size_t>(header_[LATENCY].load(std::memory_order_relaxed)) : 0;
+}
+
+double ProcessorBridge::getAvgProcessUs() const {
+    const size_t blocks = processedBlocks_.load();
+    if (blocks == 0) return 0.0;
+    return static_cast<double>(totalProcessNs_.load()) / 1000.0 / static_cast<double>(blocks);
+}
@@ -0,0 +1,202 @@
+/**
+ * ProcessorBridge - Procesador nativo dentro del grafo Web Audio
+ *
+ * Permite migrar módulos a C++ uno a uno sin sacar el resto del grafo de
+ * Web Audio. Un AudioWorklet genérico (nativeBridge.worklet.js) copia sus
+ * entradas a un SharedArrayBuffer por instancia; el hilo del bridge ejecuta
+ * el NativeProcessor y devuelve el resultado por el mismo SAB. El worklet lo
+ * reproduce con un retardo fijo (latencyFrames) que se informa a JS.
+ *
+ * Layout del SharedArrayBuffer:
+ * [Int32 × 8]  cabecera (índices en frames, módulo ringFrames)
+ *   0 inWrite    - worklet escribe
+ *   1 inRead     - nativo escribe
+ *   2 outWrite   - nativo escribe
+ *   3 outRead    - worklet escribe
+ *   4 latency    - worklet escribe (retardo fijo en frames)
+ *   5 underruns  - worklet incrementa (bloques sin salida nativa a tiempo)
+ *   6 blocks     - nativo incrementa (bloques procesados)
+ *   7 origin     - worklet escribe: currentFrame − frames enviados (módulo 2^32),
+ *                  para situar cada bloque de entrada en el reloj del AudioContext
+ * [Float32 × ringFrames × inChannels]   ring de entrada (interleaved)
+ * [Float32 × ringFrames × outChannels]  ring de salida (interleaved)
+ *
+ * Atomics.notify del worklet no despierta un futex nativo (V8 lo emula),
+ * así que el hilo sondea el ring de entrada cuatro veces por bloque.
+ *
+ * Eventos de parámetros (scheduleParam): cola SPSC sin locks (hilo JS →
+ * hilo del bridge) con el frame del AudioContext en que deben aplicarse. El
+ * bloque se parte en ese frame y el procesador recibe setParamById() entre
+ * los dos tramos. Los frames se comparan módulo 2^32 (±12 h @ 48 kHz).
+ *
+ * Automatización: con la grabación activa, cada evento aplicado (cola o
+ * setParam) se guarda con su frame en un AutomationLane. La reproducción
+ * decodifica un registro en el hilo del bridge y lo aplica por el mismo
+ * camino que la cola, desde el frame indicado. Los eventos reproducidos no
+ * se vuelven a grabar.
+ *
+ * Denormales: el hilo activa FTZ/DAZ al entrar (denormals.h) y uno de cada
+ * Denormals::SAMPLE_BLOCKS bloques de salida se recorre contando subnormales.
+ * Con FTZ activo el contador debe quedar a 0.
+ */
+
+#ifndef PROCESSOR_BRIDGE_H
+#define PROCESSOR_BRIDGE_H
+
+#include "automation_lane.h"
+#include "native_processor.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ProcessorBridge {
+public:
+    // Palabras de la cabecera del SAB
+    static constexpr size_t IN_WRITE = 0;
+    static constexpr size_t IN_READ = 1;
+    static constexpr size_t OUT_WRITE = 2;
+    static constexpr size_t OUT_READ = 3;
+    static constexpr size_t LATENCY = 4;
+    static constexpr size_t UNDERRUNS = 5;
+    static constexpr size_t BLOCKS = 6;
+    static constexpr size_t ORIGIN = 7;
+    static constexpr size_t HEADER_WORDS = 8;
+
+    // Eventos pendientes como máximo (cola y lista ordenada)
+    static constexpr size_t MAX_EVENTS = 256;
+
+    // Render quantum de Web Audio: el bridge procesa en bloques de este tamaño
+    static constexpr int BLOCK_FRAMES = 128;
+
+    ProcessorBridge(std::unique_ptr<NativeProcessor> processor,
+                    int inChannels, int outChannels, int sampleRate);
+    ~ProcessorBridge();
+
+    ProcessorBridge(const ProcessorBridge&) = delete;
+    ProcessorBridge& operator=(const ProcessorBridge&) = delete;
+
+    // Bytes necesarios para un SAB de ringFrames frames
+    static size_t requiredBytes(size_t ringFrames, int inChannels, int outChannels);
+
+    bool attachSharedBuffer(void* buffer, size_t bufferSize, size_t ringFrames);
+    bool hasSharedBuffer() const { return header_ != nullptr; }
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(); }
+
+    // Se aplica entre bloques. false si el procesador no conoce el parámetro.
+    bool setParam(const std::string& name, float value);
+
+    // Aplica value en el frame `frame` del AudioContext (los atrasados, al
+    // inicio del siguiente bloque). false si el parámetro no admite eventos
+    // o la cola está llena.
+    bool scheduleParam(const std::string& name, float value, uint32_t frame);
+
+    // Datos en bloque (snapshots, tablas). Se aplica entre bloques.
+    bool setData(const std::string& name, const float* data, size_t count);
+
+    // Grabación de automatización desde `startFrame` del AudioContext
+    // (capacidad fija, sin reservas en el hilo de audio)
+    void startRecording(size_t capacityBytes, uint32_t startFrame);
+    // Detiene la grabación. El registro sigue válido hasta el siguiente start.
+    const AutomationLane& stopRecording();
+    // Reproduce un registro desde `startFrame` del AudioContext
+    bool startPlayback(const uint8_t* data, size_t size, uint32_t startFrame);
+    void stopPlayback();
+    bool isRecording();
+    bool isPlaying();
+    // Nombre de cada id de parámetro visto (para exportar el registro)
+    const std::vector<std::string>& getParamNames() const { return paramNames_; }
+
+    // Estadísticas
+    const char* getType() const { return processor_->type(); }
+    int getInputChannels() const { return inChannels_; }
+    int getOutputChannels() const { return outChannels_; }
+    size_t getProcessedBlocks() const { return processedBlocks_.load(); }
+    size_t getOverflows() const { return overflows_.load(); }
+    size_t getAppliedEvents() const { return appliedEvents_.load(); }
+    size_t getDroppedEvents() const { return droppedEvents_.load(); }
+    size_t getUnderruns() const;
+    size_t getLatencyFrames() const;
+    double getAvgProcessUs() const;
+    double getMaxProcessUs() const { return maxProcessNs_.load() / 1000.0; }
+    // FTZ/DAZ activo en el hilo del bridge
+    bool getFlushDenormals() const { return flushDenormals_.load(); }
+    // Subnormales vistos en los bloques de salida muestreados, y esos bloques
+    size_t getDenormals() const { return denormals_.load(); }
+    size_t getDenormalBlocks() const { return denormalBlocks_.load(); }
+
+private:
+    struct ParamEvent {
+        uint32_t frame;
+        int32_t id;
+        float value;
+    };
+
+    void runLoop();
+    bool processBlock();
+    void drainEvents();
+    void runProcessor(int offset, int frames);
+    void registerParamName(int id, const std::string& name);
+
+    std::unique_ptr<NativeProcessor> processor_;
+    int inChannels_;
+    int outChannels_;
+    int sampleRate_;
+
+    // Vistas sobre el SAB
+    std::atomic<int32_t>* header_ = nullptr;
+    float* inRing_ = nullptr;
+    float* outRing_ = nullptr;
+    int32_t ringFrames_ = 0;
+
+    // Bloques planares de trabajo (reservados en start)
+    std::vector<float> inPlanar_;
+    std::vector<float> outPlanar_;
+    std::vector<const float*> inPtrs_;
+    std::vector<float*> outPtrs_;
+    std::vector<const float*> subInPtrs_;   // Tramo del bloque partido por eventos
+    std::vector<float*> subOutPtrs_;
+    uint32_t inputFrames_ = 0;              // Frames de entrada consumidos (módulo 2^32)
+
+    // Cola SPSC de eventos (hilo JS → hilo del bridge)
+    ParamEvent eventQueue_[MAX_EVENTS];
+    std::atomic<size_t> eventHead_{0};      // Escribe el hilo JS
+    std::atomic<size_t> eventTail_{0};      // Escribe el hilo del bridge
+    // Eventos ya extraídos, ordenados por frame (solo hilo del bridge)
+    ParamEvent pending_[MAX_EVENTS];
+    size_t pendingCount_ = 0;
+
+    // Automatización (protegida por processMutex_)
+    uint32_t nextBlockFrame_ = 0;           // Frame en que empieza el siguiente bloque
+    AutomationLane recorder_;
+    bool recording_ = false;
+    AutomationLane playback_;
+    AutomationLane::Cursor playCursor_;
+    AutomationLane::Event playNext_{};
+    bool playing_ = false;
+    std::vector<std::string> paramNames_;   // Solo hilo JS
+
+    std::mutex processMutex_;  // process() vs setParam()/setData()/automatización
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<size_t> processedBlocks_{0};
+    std::atomic<size_t> overflows_{0};
+    std::atomic<size_t> appliedEvents_{0};
+    std::atomic<size_t> droppedEvents_{0};
+    std::atomic<uint64_t> totalProcessNs_{0};
+    std::atomic<uint64_t> maxProcessNs_{0};
+    std::atomic<bool> flushDenormals_{false};
+    std::atomic<size_t> denormals_{0};
+    std::atomic<size_t> denormalBlocks_{0};
+};
+
+#endif // PROCESSOR_BRIDGE_H
@@ -3,6 +3,13 @@
  */
 
 #include "pw_stream.h"
+#include "audio_kernels.h"
+#include "denormals.h"
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cmath>
 #include <iostream>
 
@@ -12,6 +19,22 @@
 static constexpr size_t DEFAULT_RING_BUFFER_FRAMES = 4096;  // ~85ms @ 48kHz
 static constexpr size_t DEFAULT_PREBUFFER_FRAMES = 2048;    // ~42ms @ 48kHz
 
+// Modo driver: prioridad alta para que el session manager elija nuestro nodo
+// como driver del grafo frente a los sinks ALSA (típicamente 1000-2000)
+static constexpr const char* DRIVER_PRIORITY = "30000";
+// Sin datos durante N quanta → disparar igualmente (silencio) para no
+// congelar al resto del grafo si el AudioContext se suspende
+static constexpr int DRIVER_STALL_QUANTA = 4;
+
+// Render-ahead: SCHED_FIFO por debajo del hilo de datos de PipeWire (88 con
+// RTKit) para no competir con el callback que copia lo ya renderizado
+static constexpr int RENDER_AHEAD_RT_PRIORITY = 70;
+
+// Recuperación: primer reintento rápido (reinicio del daemon ~0.5-1s),
+// duplicando hasta un máximo
+static constexpr int RECOVERY_BACKOFF_MIN_MS = 100;
+static constexpr int RECOVERY_BACKOFF_MAX_MS = 5000;
+
 PwStream::PwStream(const std::string& name, int channels, int sampleRate, int bufferSize,
                    StreamDirection direction, const std::string& channelNames,
                    const std::string& description)
@@ -23,16 +46,26 @@ PwStream::PwStream(const std::string& name, int channels, int sampleRate, int bu
     , sampleRate_(sampleRate)
     , bufferSize_(bufferSize)
     , prebufferFrames_(DEFAULT_PREBUFFER_FRAMES)
+    , activePrebufferFrames_(DEFAULT_PREBUFFER_FRAMES)
     , ringBufferFrames_(DEFAULT_RING_BUFFER_FRAMES)
+    , health_(direction == StreamDirection::OUTPUT ? AudioHealth::output() : AudioHealth::input())
 {
     // Inicializar ring buffer con tamaño configurable
-    ringBuffer_.resize(ringBufferFrames_ * channels_, 0.0f);
+    ring_.allocate(ringBufferFrames_ * channels_);
+    conditioner_.prepare(channels_, sampleRate_);
     
     // Inicializar eventos
     std::memset(&events_, 0, sizeof(events_));
     events_.version = PW_VERSION_STREAM_EVENTS;
     events_.process = on_process;
     events_.state_changed = on_state_changed;
+    events_.param_changed = on_param_changed;
+    
+    std::memset(&coreEvents_, 0, sizeof(coreEvents_));
+    coreEvents_.version = PW_VERSION_CORE_EVENTS;
+    coreEvents_.error = on_core_error;
+    std::memset(&coreListener_, 0, sizeof(coreListener_));
+    backoffMs_ = RECOVERY_BACKOFF_MIN_MS;
 }
 
 PwStream::~PwStream() {
@@ -47,6 +80,59 @@ bool PwStream::start() {
     // Inicializar PipeWire
     pw_init(nullptr, nullptr);
     
+    const bool isOutput = (direction_ == StreamDirection::OUTPUT);
+    const bool driving = driverMode_ && isOutput;
+    
+    // Prebuffer efectivo de esta sesión: el configurado, salvo que el modo
+    // lo imponga (prebufferFrames_ se conserva para los siguientes start())
+    activePrebufferFrames_ = prebufferFrames_;
+    if (driving) {
+        // La ocupación del ring se mantiene constante: basta ~1 quantum
+        activePrebufferFrames_ = static_cast<size_t>(bufferSize_);
+    }
+    
+    if (isOutput) {
+        prepareRenderAhead();
+    }
+    
+    // running_ antes de conectar: los errores tempranos ya activan la recuperación
+    running_.store(true);
+    // Pre-buffering solo para output (input no necesita acumular antes de leer)
+    priming_.store(isOutput);
+    triggerPending_.store(false);
+    latencyOverrun_ = false;
+    setStreamState("connecting", "");
+    
+    if (!connectStream()) {
+        running_.store(false);
+        setStreamState("unconnected", "connect failed");
+        return false;
+    }
+    health_.onStreamStart(sampleRate_, isOutput ? activePrebufferFrames_ : 0, driving);
+    
+    if (driving) {
+        pacerStop_.store(false);
+        driverThread_ = std::thread(&PwStream::runDriverPacer, this);
+    }
+    
+    if (renderProcessor_ && isOutput) {
+        renderThread_ = std::thread(&PwStream::runRenderAhead, this);
+    }
+    
+    recoveryThread_ = std::thread(&PwStream::runRecovery, this);
+    
+    const char* dirStr = isOutput ? "OUTPUT" : "INPUT";
+    std::cout << "[PwStream] Started " << dirStr << ": " << name_ 
+              << " (" << channels_ << "ch @ " << sampleRate_ << "Hz, prebuffer: "
+              << activePrebufferFrames_ << " frames, ~" << (activePrebufferFrames_ * 1000 / sampleRate_) << "ms"
+              << (driving ? ", DRIVER" : "")
+              << (renderThread_.joinable() ? ", RENDER-AHEAD " : "")
+              << (renderThread_.joinable() ? renderProcessor_->type() : "") << ")" << std::endl;
+    
+    return true;
+}
+
+bool PwStream::connectStream() {
     // Crear thread loop
     loop_ = pw_thread_loop_new("synthigme-audio", nullptr);
     if (!loop_) {
@@ -56,8 +142,12 @@ bool PwStream::start() {
     
     // Determinar propiedades según dirección
     const bool isOutput = (direction_ == StreamDirection::OUTPUT);
+    const bool driving = driverMode_ && isOutput;
+    const bool stereo = isStereoLayout();
     const char* mediaCategory = isOutput ? "Playback" : "Capture";
-    const char* defaultDesc = isOutput ? "SynthiGME Multichannel Output" : "SynthiGME Multichannel Input";
+    const char* defaultDesc = stereo
+        ? (isOutput ? "SynthiGME Stereo Output" : "SynthiGME Stereo Input")
+        : (isOutput ? "SynthiGME Multichannel Output" : "SynthiGME Multichannel Input");
     const char* nodeDesc = description_.empty() ? defaultDesc : description_.c_str();
     
     // Nombres de canales por defecto si no se especificaron
@@ -74,10 +164,22 @@ bool PwStream::start() {
         PW_KEY_APP_NAME, "SynthiGME",
         PW_KEY_NODE_NAME, name_.c_str(),
         PW_KEY_NODE_DESCRIPTION, nodeDesc,
-        PW_KEY_NODE_CHANNELNAMES, channelNamesStr,
         nullptr
     );
     
+    // En estéreo los puertos toman el nombre de la posición (FL/FR) para que
+    // la sesión (WirePlumber) los enlace 1:1 con el sink/source por defecto
+    if (!stereo || !channelNames_.empty()) {
+        pw_properties_set(props, PW_KEY_NODE_CHANNELNAMES, channelNamesStr);
+    }
+    
+    if (driving) {
+        // El quantum lo marca nuestro bufferSize: un ciclo por bloque recibido
+        pw_properties_setf(props, PW_KEY_NODE_LATENCY, "%d/%d", bufferSize_, sampleRate_);
+        pw_properties_setf(props, PW_KEY_NODE_RATE, "1/%d", sampleRate_);
+        pw_properties_set(props, PW_KEY_PRIORITY_DRIVER, DRIVER_PRIORITY);
+    }
+    
     stream_ = pw_stream_new_simple(
         pw_thread_loop_get_loop(loop_),
         name_.c_str(),
@@ -104,10 +206,16 @@ bool PwStream::start() {
     audio_info.rate = static_cast<uint32_t>(sampleRate_);
     audio_info.channels = static_cast<uint32_t>(channels_);
     
-    // Asignar posiciones de canal (AUX0-AUXN)
+    // Asignar posiciones de canal: FL/FR en estéreo (enlace automático con
+    // el dispositivo por defecto), AUX0-AUXN en multicanal (ruteo en qpwgraph)
     // Los nombres descriptivos se asignan via PW_KEY_NODE_CHANNELNAMES arriba
-    for (int i = 0; i < channels_ && i < SPA_AUDIO_MAX_CHANNELS; i++) {
-        audio_info.position[i] = SPA_AUDIO_CHANNEL_AUX0 + i;
+    if (stereo) {
+        audio_info.position[0] = SPA_AUDIO_CHANNEL_FL;
+        audio_info.position[1] = SPA_AUDIO_CHANNEL_FR;
+    } else {
+        for (int i = 0; i < channels_ && i < SPA_AUDIO_MAX_CHANNELS; i++) {
+            audio_info.position[i] = SPA_AUDIO_CHANNEL_AUX0 + i;
+        }
     }
     
     const struct spa_pod* params[1];
@@ -116,15 +224,18 @@ bool PwStream::start() {
     // Conectar stream con la dirección correcta
     enum pw_direction pwDir = isOutput ? PW_DIRECTION_OUTPUT : PW_DIRECTION_INPUT;
     
+    uint32_t flags = PW_STREAM_FLAG_AUTOCONNECT |
+                     PW_STREAM_FLAG_MAP_BUFFERS |
+                     PW_STREAM_FLAG_RT_PROCESS;
+    if (driving) {
+        flags |= PW_STREAM_FLAG_DRIVER;
+    }
+    
     int res = pw_stream_connect(
         stream_,
         pwDir,
         PW_ID_ANY,
-        static_cast<pw_stream_flags>(
-            PW_STREAM_FLAG_AUTOCONNECT |
-            PW_STREAM_FLAG_MAP_BUFFERS |
-            PW_STREAM_FLAG_RT_PROCESS
-        ),
+        static_cast<pw_stream_flags>(flags),
         params, 1
     );
     
@@ -137,32 +248,24 @@ bool PwStream::start() {
         return false;
     }
     
+    // Caída del daemon: el core informa EPIPE (el stream puede no cambiar de estado)
+    std::memset(&coreListener_, 0, sizeof(coreListener_));
+    pw_core_add_listener(pw_stream_get_core(stream_), &coreListener_, &coreEvents_, this);
+    
     // Iniciar loop
-    running_.store(true);
-    // Pre-buffering solo para output (input no necesita acumular antes de leer)
-    priming_.store(isOutput);
     pw_thread_loop_start(loop_);
-    
-    const char* dirStr = isOutput ? "OUTPUT" : "INPUT";
-    std::cout << "[PwStream] Started " << dirStr << ": " << name_ 
-              << " (" << channels_ << "ch @ " << sampleRate_ << "Hz, prebuffer: "
-              << prebufferFrames_ << " frames, ~" << (prebufferFrames_ * 1000 / sampleRate_) << "ms)" << std::endl;
-    
     return true;
 }
 
-void PwStream::stop() {
-    if (!running_.load()) {
-        return;
-    }
-    
-    running_.store(false);
+void PwStream::teardownStream() {
+    tearingDown_.store(true);
     
     if (loop_) {
         pw_thread_loop_stop(loop_);
     }
     
     if (stream_) {
+        spa_hook_remove(&coreListener_);
         pw_stream_destroy(stream_);
         stream_ = nullptr;
     }
@@ -172,7 +275,36 @@ void PwStream::stop() {
         loop_ = nullptr;
     }
     
+    tearingDown_.store(false);
+}
+
+void PwStream::stop() {
+    if (!running_.load()) {
+        return;
+    }
+    
+    running_.store(false);
+    
+    // La recuperación reconstruye loop y pacer: pararla antes que a ellos
+    {
+        std::lock_guard<std::mutex> lock(recoveryMutex_);
+        recoveryCv_.notify_all();
+    }
+    if (recoveryThread_.joinable()) {
+        recoveryThread_.join();
+    }
+    
+    // El pacer toma el lock del loop: pararlo antes que el loop
+    if (driverThread_.joinable()) {
+        driverThread_.join();
+    }
+    if (renderThread_.joinable()) {
+        renderThread_.join();
+    }
+    
+    teardownStream();
     pw_deinit();
+    setStreamState("unconnected", "");
     
     std::cout << "[PwStream] Stopped. Underflows: " << underflows_.load() << std::endl;
 }
@@ -182,45 +314,30 @@ size_t PwStream::write(const float* data, size_t frames) {
         return 0;
     }
     
-    const size_t samples = frames * channels_;
-    const size_t ringSize = ringBuffer_.size();
+    // Render-ahead: el ring solo lo llena el productor (fuente: SAB)
+    if (renderProcessor_) {
+        return 0;
+    }
     
     std::lock_guard<std::mutex> lock(ringMutex_);
     
-    // Calcular espacio disponible
-    size_t available;
-    if (ringWritePos_ >= ringReadPos_) {
-        available = ringSize - (ringWritePos_ - ringReadPos_) - channels_;
-    } else {
-        available = ringReadPos_ - ringWritePos_ - channels_;
-    }
-    
-    // Limitar a espacio disponible
-    size_t toWrite = std::min(samples, available);
-    size_t framesWritten = toWrite / channels_;
+    // Limitar a espacio disponible (frames completos)
+    const size_t framesWritten = std::min(frames, ring_.writable() / channels_);
     
     // Contar overflow si no caben todos los datos
-    if (toWrite < samples) {
+    if (framesWritten < frames) {
         overflows_.fetch_add(1);
     }
     
-    // Copiar datos al ring buffer
-    for (size_t i = 0; i < toWrite; i++) {
-        ringBuffer_[ringWritePos_] = data[i];
-        ringWritePos_ = (ringWritePos_ + 1) % ringSize;
-    }
+    // Copiar datos al ring buffer (un solo tramo lineal)
+    ring_.write(data, framesWritten * channels_);
     
     // Actualizar contador de frames en buffer (para métricas)
-    size_t buffered;
-    if (ringWritePos_ >= ringReadPos_) {
-        buffered = (ringWritePos_ - ringReadPos_) / channels_;
-    } else {
-        buffered = (ringSize - ringReadPos_ + ringWritePos_) / channels_;
-    }
+    const size_t buffered = ring_.readable() / channels_;
     bufferedFrames_.store(buffered);
     
     // Salir de priming cuando hay suficiente buffer
-    if (priming_.load() && buffered >= prebufferFrames_) {
+    if (priming_.load() && buffered >= activePrebufferFrames_) {
         priming_.store(false);
         std::cout << "[PwStream] Pre-buffer lleno, iniciando reproducción" << std::endl;
     }
@@ -230,6 +347,9 @@ size_t PwStream::write(const float* data, size_t frames) {
 
 void PwStream::on_process(void* userdata) {
     auto* self = static_cast<PwStream*>(userdata);
+    // Data loop de PipeWire: FTZ/DAZ la primera vez que entra cada hilo
+    static thread_local const bool flushed = Denormals::enableFlush();
+    self->dataLoopFlush_.store(flushed, std::memory_order_relaxed);
     if (self->direction_ == StreamDirection::OUTPUT) {
         self->processCallbackOutput();
     } else {
@@ -247,9 +367,83 @@ void PwStream::on_state_changed(void* userdata, enum pw_stream_state old,
         std::cout << " (error: " << error << ")";
     }
     std::cout << std::endl;
+    
+    // Los cambios provocados por stop() o por el desmontaje no son fallos
+    if (!self->running_.load() || self->tearingDown_.load()) {
+        return;
+    }
+    
+    if (state == PW_STREAM_STATE_STREAMING) {
+        self->onStreaming();
+    }
+    self->setStreamState(stateStr, error ? error : "");
+    
+    if (state == PW_STREAM_STATE_ERROR ||
+        (state == PW_STREAM_STATE_UNCONNECTED && old != PW_STREAM_STATE_UNCONNECTED)) {
+        self->requestRecovery(error ? error : "stream disconnected");
+    }
+}
+
+void PwStream::on_core_error(void* userdata, uint32_t id, int seq, int res, const char* message) {
+    auto* self = static_cast<PwStream*>(userdata);
+    (void)seq;
+    
+    std::cerr << "[PwStream] Core error (id " << id << ", " << res << "): "
+              << (message ? message : "") << std::endl;
+    
+    // EPIPE en el core: conexión con el daemon perdida (reinicio o caída)
+    if (id == PW_ID_CORE && res == -EPIPE &&
+        self->running_.load() && !self->tearingDown_.load()) {
+        self->requestRecovery(message ? message : "PipeWire disconnected");
+    }
+}
+
+void PwStream::on_param_changed(void* userdata, uint32_t id, const struct spa_pod* param) {
+    auto* self = static_cast<PwStream*>(userdata);
+    if (!param || id != SPA_PARAM_Format) return;
+    
+    struct spa_audio_info_raw info;
+    std::memset(&info, 0, sizeof(info));
+    if (spa_format_audio_raw_parse(param, &info) < 0) return;
+    
+    const char* format = "other";
+    switch (info.format) {
+        case SPA_AUDIO_FORMAT_F32: format = "F32"; break;
+        case SPA_AUDIO_FORMAT_F64: format = "F64"; break;
+        case SPA_AUDIO_FORMAT_S16: format = "S16"; break;
+        case SPA_AUDIO_FORMAT_S24: format = "S24"; break;
+        case SPA_AUDIO_FORMAT_S32: format = "S32"; break;
+        default: break;
+    }
+    self->health_.onFormat(info.rate, info.channels, format);
+    
+    std::cout << "[PwStream] Format: " << format << " " << info.channels << "ch @ "
+              << info.rate << "Hz" << std::endl;
+}
+
+void PwStream::recordCycle(uint32_t frames, std::chrono::steady_clock::time_point start) {
+    // Latencia: audio pendiente por delante del dispositivo (output) o
+    // capturado y aún no leído por JS (input)
+    size_t latency;
+    if (direction_ == StreamDirection::OUTPUT) {
+        // Con paquetes, la distancia medida hasta el productor
+        latency = sabPackets_.hasTiming()
+            ? static_cast<size_t>(std::max(0.0, sabPackets_.getLatencyFrames()))
+            : pendingSourceFrames();
+    } else {
+        latency = sharedBuffer_ ? sharedFillFrames() : bufferedFrames_.load();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    health_.onCycle(frames, latency, static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
 }
 
 void PwStream::processCallbackOutput() {
+    const auto cycleStart = std::chrono::steady_clock::now();
+    
+    // Modo driver: el ciclo disparado ya se está atendiendo
+    triggerPending_.store(false, std::memory_order_release);
+    
     struct pw_buffer* pwBuf = pw_stream_dequeue_buffer(stream_);
     if (!pwBuf) {
         return;
@@ -266,42 +460,56 @@ void PwStream::processCallbackOutput() {
     // Calcular frames a procesar
     uint32_t stride = sizeof(float) * channels_;
     uint32_t maxFrames = buf->datas[0].maxsize / stride;
+    // Como driver, sin 'requested' el ciclo dura exactamente un quantum nuestro
+    uint32_t fallbackFrames = driverMode_ ?
+                              std::min(static_cast<uint32_t>(bufferSize_), maxFrames) :
+                              maxFrames;
     uint32_t frames = pwBuf->requested ? 
                       std::min(static_cast<uint32_t>(pwBuf->requested), maxFrames) : 
-                      maxFrames;
+                      fallbackFrames;
+    
+    const bool counted = renderOutput(dst, frames);
+    
+    buf->datas[0].chunk->offset = 0;
+    buf->datas[0].chunk->stride = stride;
+    buf->datas[0].chunk->size = frames * stride;
     
+    pw_stream_queue_buffer(stream_, pwBuf);
+    if (counted) {
+        recordCycle(frames, cycleStart);
+    }
+}
+
+void PwStream::processOutput(float* dst, uint32_t frames) {
+    const auto cycleStart = std::chrono::steady_clock::now();
+    triggerPending_.store(false, std::memory_order_release);
+    if (renderOutput(dst, frames)) {
+        recordCycle(frames, cycleStart);
+    }
+}
+
+bool PwStream::renderOutput(float* dst, uint32_t frames) {
     const size_t samples = frames * channels_;
     
     // ═══════════════════════════════════════════════════════════════════════
     // Modo SharedArrayBuffer: lectura lock-free directa
     // ═══════════════════════════════════════════════════════════════════════
-    if (sharedBuffer_) {
+    if (sharedBuffer_ && !renderProcessor_) {
         // Primero transferir del SharedArrayBuffer al ring buffer interno
-        // para mantener el mecanismo de pre-buffering
-        float tempBuf[2048 * 12]; // max 2048 frames * 12 channels
-        size_t transferred = readFromSharedBuffer(tempBuf, 2048);
+        // para mantener el mecanismo de pre-buffering. El ring es espejado:
+        // se copia directamente a su tramo libre, sin buffer intermedio.
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        const size_t transferred = readFromSharedBuffer(ring_.writePtr(), ring_.writable() / channels_);
         
         if (transferred > 0) {
-            // Escribir al ring buffer interno
-            std::lock_guard<std::mutex> lock(ringMutex_);
-            const size_t ringSize = ringBuffer_.size();
-            const size_t samplesToWrite = transferred * channels_;
-            
-            for (size_t i = 0; i < samplesToWrite; i++) {
-                ringBuffer_[ringWritePos_] = tempBuf[i];
-                ringWritePos_ = (ringWritePos_ + 1) % ringSize;
-            }
+            ring_.commitWrite(transferred * channels_);
+            sabPackets_.consume(transferred);
             
             // Actualizar bufferedFrames y salir de priming si corresponde
-            size_t buffered;
-            if (ringWritePos_ >= ringReadPos_) {
-                buffered = (ringWritePos_ - ringReadPos_) / channels_;
-            } else {
-                buffered = (ringSize - ringReadPos_ + ringWritePos_) / channels_;
-            }
+            const size_t buffered = ring_.readable() / channels_;
             bufferedFrames_.store(buffered);
             
-            if (priming_.load() && buffered >= prebufferFrames_) {
+            if (priming_.load() && buffered >= activePrebufferFrames_) {
                 priming_.store(false);
                 std::cout << "[PwStream] SharedArrayBuffer: pre-buffer lleno" << std::endl;
             }
@@ -311,45 +519,68 @@ void PwStream::processCallbackOutput() {
     // ═══════════════════════════════════════════════════════════════════════
     // Leer del ring buffer interno (común para ambos modos)
     // ═══════════════════════════════════════════════════════════════════════
-    const size_t ringSize = ringBuffer_.size();
-    
     {
-        std::lock_guard<std::mutex> lock(ringMutex_);
+        // Render-ahead: el ring es SPSC entre el hilo productor y este, sin
+        // lock; ringMutex_ queda para el productor frente al hilo JS, así que
+        // un bloque lento nunca retiene el data loop
+        std::unique_lock<std::mutex> lock(ringMutex_, std::defer_lock);
+        if (!renderProcessor_) {
+            lock.lock();
+        }
         
         // Calcular datos disponibles
-        size_t available;
-        if (ringWritePos_ >= ringReadPos_) {
-            available = ringWritePos_ - ringReadPos_;
-        } else {
-            available = ringSize - ringReadPos_ + ringWritePos_;
-        }
+        const size_t available = ring_.readable();
         
         // Si estamos en priming O no hay suficientes datos, enviar silencio
         if (priming_.load() || available < samples) {
             std::memset(dst, 0, samples * sizeof(float));
-            buf->datas[0].chunk->offset = 0;
-            buf->datas[0].chunk->stride = stride;
-            buf->datas[0].chunk->size = frames * stride;
-            pw_stream_queue_buffer(stream_, pwBuf);
+            teeBridgeReturn(dst, frames);
             // Contar silent underflow si NO estamos en priming
             if (!priming_.load() && available < samples) {
                 silentUnderflows_.fetch_add(1);
+                health_.onUnderflow();
             }
-            return;
+            return !priming_.load();
         }
         
         // Copiar datos
-        for (size_t i = 0; i < samples; i++) {
-            dst[i] = ringBuffer_[ringReadPos_];
-            ringReadPos_ = (ringReadPos_ + 1) % ringSize;
+        ring_.read(dst, samples);
+        size_t buffered = (available - samples) / channels_;
+        
+        // Paquetes: el ring contiene los frames del AudioContext justo
+        // anteriores al cursor, así que lo entregado termina en cursor − buffered
+        // (en render-ahead el cursor es del productor: lo mide él)
+        if (!renderProcessor_ && sabPackets_.hasTiming()) {
+            sabPackets_.onOutput(sabPackets_.cursorFrame() - static_cast<double>(buffered), frames);
         }
+        
+        // Catch-up: si el AudioContext va por delante del grafo (relojes
+        // distintos), la latencia crece hasta llenar ring y SAB. Al superar
+        // el tamaño del ring se descarta lo más antiguo hasta volver al
+        // prebuffer configurado (solo con setCatchUp; si no, se cuenta el
+        // desborde). En render-ahead lo hace el productor, que es el único
+        // lector del SAB. Con paquetes se usa la latencia medida (cuenta
+        // también los bloques que el worklet no pudo escribir).
+        if (sharedBuffer_ && !renderProcessor_) {
+            const size_t pending = sabPackets_.hasTiming()
+                ? static_cast<size_t>(std::max(0.0, sabPackets_.getLatencyFrames()))
+                : buffered + sharedFillFrames();
+            if (latencyOverrun(pending)) {
+                const size_t excess = pending - activePrebufferFrames_;
+                const size_t fromRing = std::min(excess, buffered);
+                ring_.commitRead(fromRing * channels_);
+                buffered -= fromRing;
+                // Lo descartado de verdad: la latencia medida cuenta también
+                // bloques que el worklet no llegó a escribir
+                health_.onCatchUp(fromRing + discardSharedFrames(excess - fromRing));
+            }
+        }
+        
+        bufferedFrames_.store(buffered);
     }
     
-    buf->datas[0].chunk->offset = 0;
-    buf->datas[0].chunk->stride = stride;
-    buf->datas[0].chunk->size = frames * stride;
-    
-    pw_stream_queue_buffer(stream_, pwBuf);
+    teeBridgeReturn(dst, frames);
+    return true;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -357,6 +588,8 @@ void PwStream::processCallbackOutput() {
 // ═══════════════════════════════════════════════════════════════════════════
 
 void PwStream::processCallbackInput() {
+    const auto cycleStart = std::chrono::steady_clock::now();
+    
     struct pw_buffer* pwBuf = pw_stream_dequeue_buffer(stream_);
     if (!pwBuf) return;
     
@@ -377,46 +610,47 @@ void PwStream::processCallbackInput() {
         return;
     }
     
-    // Escribir al SharedArrayBuffer si está adjunto (lock-free, preferido)
-    if (sharedBuffer_) {
-        writeToSharedBuffer(src, frames);
-    }
+    captureInput(src, frames);
     
-    // También escribir al ring buffer interno para read() no-SAB
-    {
-        std::lock_guard<std::mutex> lock(ringMutex_);
-        const size_t ringSize = ringBuffer_.size();
-        const size_t samples = frames * channels_;
-        
-        // Verificar espacio disponible
-        size_t available;
-        if (ringWritePos_ >= ringReadPos_) {
-            available = ringSize - (ringWritePos_ - ringReadPos_) - channels_;
-        } else {
-            available = ringReadPos_ - ringWritePos_ - channels_;
+    pw_stream_queue_buffer(stream_, pwBuf);
+    recordCycle(frames, cycleStart);
+}
+
+void PwStream::processInput(const float* src, uint32_t frames) {
+    const auto cycleStart = std::chrono::steady_clock::now();
+    captureInput(src, frames);
+    recordCycle(frames, cycleStart);
+}
+
+void PwStream::captureInput(const float* src, uint32_t frames) {
+    // Puente LV2: el envío del DAW se suma a la captura
+    src = mixBridgeSend(src, frames);
+    
+    // El acondicionamiento escribe directamente en el destino: el SAB si
+    // está adjunto (lock-free, preferido) o el ring interno para read().
+    // Con SAB nadie lee el ring, así que no se copia también allí.
+    if (sharedBuffer_) {
+        if (writeToSharedBuffer(src, frames) < frames) {
+            health_.onOverflow();
         }
+        bufferedFrames_.store(sharedFillFrames());
+    } else {
+        std::lock_guard<std::mutex> lock(ringMutex_);
         
-        size_t toWrite = std::min(samples, available);
-        if (toWrite < samples) {
+        // Verificar espacio disponible (frames completos)
+        const size_t toWrite = std::min<size_t>(frames, ring_.writable() / channels_);
+        if (toWrite < frames) {
             overflows_.fetch_add(1);
+            health_.onOverflow();
         }
         
-        for (size_t i = 0; i < toWrite; i++) {
-            ringBuffer_[ringWritePos_] = src[i];
-            ringWritePos_ = (ringWritePos_ + 1) % ringSize;
-        }
+        // Tramo lineal (ring espejado): una sola pasada
+        conditioner_.process(src, ring_.writePtr(), toWrite);
+        ring_.commitWrite(toWrite * channels_);
         
         // Actualizar métricas
-        size_t buffered;
-        if (ringWritePos_ >= ringReadPos_) {
-            buffered = (ringWritePos_ - ringReadPos_) / channels_;
-        } else {
-            buffered = (ringSize - ringReadPos_ + ringWritePos_) / channels_;
-        }
-        bufferedFrames_.store(buffered);
+        bufferedFrames_.store(ring_.readable() / channels_);
     }
-    
-    pw_stream_queue_buffer(stream_, pwBuf);
 }
 
 size_t PwStream::read(float* dest, size_t maxFrames) {
@@ -424,33 +658,65 @@ size_t PwStream::read(float* dest, size_t maxFrames) {
     
     std::lock_guard<std::mutex> lock(ringMutex_);
     
-    const size_t ringSize = ringBuffer_.size();
-    
     // Calcular datos disponibles
-    size_t available;
-    if (ringWritePos_ >= ringReadPos_) {
-        available = (ringWritePos_ - ringReadPos_) / channels_;
-    } else {
-        available = (ringSize - ringReadPos_ + ringWritePos_) / channels_;
-    }
-    
-    size_t toRead = std::min(available, maxFrames);
-    
-    for (size_t frame = 0; frame < toRead; frame++) {
-        for (int ch = 0; ch < channels_; ch++) {
-            dest[frame * channels_ + ch] = ringBuffer_[ringReadPos_];
-            ringReadPos_ = (ringReadPos_ + 1) % ringSize;
-        }
-    }
+    const size_t toRead = std::min(ring_.readable() / channels_, maxFrames);
+    ring_.read(dest, toRead * channels_);
     
     return toRead;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// Puente LV2 - rings en memoria compartida con el plugin del DAW
+// ═══════════════════════════════════════════════════════════════════════════
+
+void PwStream::attachBridge(std::shared_ptr<ShmBridge> bridge, int channelOffset) {
+    std::lock_guard<std::mutex> lock(bridgeMutex_);
+    if (direction_ == StreamDirection::INPUT) {
+        bridgeScratch_.assign(BRIDGE_MAX_FRAMES * channels_, 0.0f);
+    }
+    bridge_ = std::move(bridge);
+    bridgeOffset_ = std::clamp(channelOffset, 0, channels_ - 1);
+    std::cout << "[PwStream] " << name_ << ": LV2 bridge attached at channel " << bridgeOffset_ << std::endl;
+}
+
+void PwStream::detachBridge() {
+    std::lock_guard<std::mutex> lock(bridgeMutex_);
+    bridge_.reset();
+}
+
+bool PwStream::hasBridge() {
+    std::lock_guard<std::mutex> lock(bridgeMutex_);
+    return bridge_ != nullptr;
+}
+
+void PwStream::teeBridgeReturn(const float* data, uint32_t frames) {
+    std::unique_lock<std::mutex> lock(bridgeMutex_, std::try_to_lock);
+    if (!lock || !bridge_ || !bridge_->hasPeer()) {
+        return;
+    }
+    bridge_->writeInterleaved(ShmBridge::RETURN, data, channels_, bridgeOffset_, frames);
+}
+
+const float* PwStream::mixBridgeSend(const float* src, uint32_t frames) {
+    std::unique_lock<std::mutex> lock(bridgeMutex_, std::try_to_lock);
+    if (!lock || !bridge_ || !bridge_->hasPeer() || frames > BRIDGE_MAX_FRAMES) {
+        return src;
+    }
+    // El buffer de PipeWire es de solo lectura: mezclar sobre una copia
+    float* mixed = bridgeScratch_.data();
+    std::memcpy(mixed, src, static_cast<size_t>(frames) * channels_ * sizeof(float));
+    if (bridge_->readInterleaved(ShmBridge::SEND, mixed, channels_, bridgeOffset_, frames, true) == 0) {
+        return src;
+    }
+    return mixed;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // SharedArrayBuffer support - comunicación lock-free con AudioWorklet
 // ═══════════════════════════════════════════════════════════════════════════
 
-bool PwStream::attachSharedBuffer(void* buffer, size_t bufferSize, size_t bufferFrames) {
+bool PwStream::attachSharedBuffer(void* buffer, size_t bufferSize, size_t bufferFrames,
+                                  size_t packetSlots) {
     if (!buffer || bufferSize == 0 || bufferFrames == 0) {
         std::cerr << "[PwStream] Invalid SharedArrayBuffer parameters" << std::endl;
         return false;
@@ -483,13 +749,31 @@ bool PwStream::attachSharedBuffer(void* buffer, size_t bufferSize, size_t buffer
     // Inicializar readIndex a 0
     sharedReadIndex_->store(0, std::memory_order_release);
     
+    // Tabla de paquetes tras el audio (solo salida: el productor es el worklet)
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    sabPackets_.detach();
+    if (packetSlots > 0 && direction_ == StreamDirection::OUTPUT) {
+        const size_t offset = SabPackets::regionOffset(bufferFrames, channels_);
+        if (bufferSize >= offset + SabPackets::regionBytes(packetSlots)) {
+            sabPackets_.attach(bytePtr + offset, packetSlots);
+        } else {
+            std::cerr << "[PwStream] SharedArrayBuffer sin espacio para " << packetSlots
+                      << " paquetes, formato sin marcas de tiempo" << std::endl;
+        }
+    }
+    
     std::cout << "[PwStream] SharedArrayBuffer attached: " << bufferFrames 
-              << " frames, " << channels_ << " channels" << std::endl;
+              << " frames, " << channels_ << " channels"
+              << (sabPackets_.isAttached() ? ", packetized" : "") << std::endl;
     
     return true;
 }
 
 void PwStream::detachSharedBuffer() {
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        sabPackets_.detach();
+    }
     sharedBuffer_ = nullptr;
     sharedBufferSize_ = 0;
     sharedBufferFrames_ = 0;
@@ -524,19 +808,23 @@ size_t PwStream::readFromSharedBuffer(float* dest, size_t maxFrames) {
     // Limitar a lo solicitado
     size_t toRead = std::min(static_cast<size_t>(available), maxFrames);
     
-    // Copiar datos (interleaved)
-    int32_t pos = readIdx;
-    for (size_t frame = 0; frame < toRead; frame++) {
-        size_t baseIndex = pos * channels_;
-        for (int ch = 0; ch < channels_; ch++) {
-            dest[frame * channels_ + ch] = sharedAudioData_[baseIndex + ch];
-        }
-        pos = (pos + 1) % sharedBufferFrames_;
+    // Copiar datos (interleaved). El SAB lo reserva JS y no se puede
+    // espejar: como mucho dos tramos lineales.
+    const size_t first = std::min(toRead, sharedBufferFrames_ - static_cast<size_t>(readIdx));
+    std::memcpy(dest, &sharedAudioData_[static_cast<size_t>(readIdx) * channels_],
+                first * channels_ * sizeof(float));
+    if (toRead > first) {
+        std::memcpy(dest + first * channels_, sharedAudioData_,
+                    (toRead - first) * channels_ * sizeof(float));
     }
+    const int32_t pos = static_cast<int32_t>((readIdx + toRead) % sharedBufferFrames_);
     
     // Actualizar readIndex atómicamente
     sharedReadIndex_->store(pos, std::memory_order_release);
     
+    // Espacio liberado para el productor
+    notifier_.onCommit(toRead);
+    
     return toRead;
 }
 
@@ -565,22 +853,424 @@ size_t PwStream::writeToSharedBuffer(const float* data, size_t frames) {
     
     size_t toWrite = std::min(static_cast<size_t>(available), frames);
     
-    // Copiar datos interleaved al SAB
-    int32_t pos = writeIdx;
-    for (size_t frame = 0; frame < toWrite; frame++) {
-        size_t baseIndex = pos * channels_;
-        for (int ch = 0; ch < channels_; ch++) {
-            sharedAudioData_[baseIndex + ch] = data[frame * channels_ + ch];
-        }
-        pos = (pos + 1) % sharedBufferFrames_;
+    // Acondicionar directamente en el SAB (como mucho dos tramos lineales)
+    const size_t first = std::min(toWrite, sharedBufferFrames_ - static_cast<size_t>(writeIdx));
+    conditioner_.process(data, &sharedAudioData_[static_cast<size_t>(writeIdx) * channels_], first);
+    if (toWrite > first) {
+        conditioner_.process(data + first * channels_, sharedAudioData_, toWrite - first);
     }
+    const int32_t pos = static_cast<int32_t>((writeIdx + toWrite) % sharedBufferFrames_);
     
     // Actualizar writeIndex atómicamente
     sharedWriteIndex_->store(pos, std::memory_order_release);
     
+    // Datos nuevos para consumidores en Atomics.wait
+    notifier_.onCommit(toWrite);
+    
     return toWrite;
 }
 
+size_t PwStream::sharedFillFrames() const {
+    if (!sharedBuffer_ || !sharedWriteIndex_ || !sharedReadIndex_) return 0;
+    const int32_t writeIdx = sharedWriteIndex_->load(std::memory_order_acquire);
+    const int32_t readIdx = sharedReadIndex_->load(std::memory_order_acquire);
+    if (writeIdx >= readIdx) {
+        return static_cast<size_t>(writeIdx - readIdx);
+    }
+    return sharedBufferFrames_ - static_cast<size_t>(readIdx - writeIdx);
+}
+
+bool PwStream::latencyOverrun(size_t pendingFrames) {
+    if (pendingFrames <= ringBufferFrames_) {
+        latencyOverrun_ = false;
+        return false;
+    }
+    if (catchUp_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (!latencyOverrun_) {
+        latencyOverrun_ = true;
+        health_.onLatencyOverrun();
+    }
+    return false;
+}
+
+size_t PwStream::discardSharedFrames(size_t frames) {
+    if (frames == 0 || !sharedReadIndex_) return 0;
+    frames = std::min(frames, sharedFillFrames());
+    const size_t readIdx = static_cast<size_t>(sharedReadIndex_->load(std::memory_order_relaxed));
+    sharedReadIndex_->store(static_cast<int32_t>((readIdx + frames) % sharedBufferFrames_),
+                            std::memory_order_release);
+    sabPackets_.consume(frames, true);
+    notifier_.onCommit(frames);
+    return frames;
+}
+
+bool PwStream::attachNotifyBuffer(void* buffer, size_t bufferSize, size_t wordIndex,
+                                  size_t watermarkFrames, SabNotifier::WakeCallback callback) {
+    return notifier_.attach(buffer, bufferSize, wordIndex, watermarkFrames, std::move(callback));
+}
+
+void PwStream::detachNotifyBuffer() {
+    notifier_.detach();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Modo driver - Web Audio marca el reloj del grafo PipeWire
+// ═══════════════════════════════════════════════════════════════════════════
+
+void PwStream::setDriverMode(bool enabled) {
+    if (running_.load()) {
+        std::cerr << "[PwStream] WARNING: setDriverMode llamado con stream activo, ignorando" << std::endl;
+        return;
+    }
+    if (enabled && direction_ != StreamDirection::OUTPUT) {
+        std::cerr << "[PwStream] WARNING: modo driver solo disponible en OUTPUT, ignorando" << std::endl;
+        return;
+    }
+    driverMode_ = enabled;
+}
+
+size_t PwStream::pendingSourceFrames() {
+    return bufferedFrames_.load() + sharedFillFrames();
+}
+
+void PwStream::runDriverPacer() {
+    using clock = std::chrono::steady_clock;
+    
+    const size_t quantum = static_cast<size_t>(bufferSize_);
+    // El worklet publica bloques de 128 frames: comprobamos dos veces por bloque
+    const auto pollInterval = std::chrono::nanoseconds(64LL * 1000000000LL / sampleRate_);
+    const auto stallTimeout = std::chrono::nanoseconds(
+        static_cast<long long>(DRIVER_STALL_QUANTA) * bufferSize_ * 1000000000LL / sampleRate_);
+    
+    auto lastTrigger = clock::now();
+    bool wasDriving = false;
+    
+    while (running_.load() && !pacerStop_.load()) {
+        std::this_thread::sleep_for(pollInterval);
+        const auto now = clock::now();
+        const bool timedOut = (now - lastTrigger) >= stallTimeout;
+        
+        // Ciclo anterior aún sin atender: no encadenar disparos
+        if (triggerPending_.load(std::memory_order_acquire) && !timedOut) {
+            continue;
+        }
+        
+        const bool ready = pendingSourceFrames() >= quantum;
+        if (!ready && !timedOut) {
+            continue;
+        }
+        
+        pw_thread_loop_lock(loop_);
+        // Si el session manager eligió otro driver somos follower: no disparar
+        const bool driving = stream_ && pw_stream_is_driving(stream_);
+        int res = driving ? pw_stream_trigger_process(stream_) : 0;
+        pw_thread_loop_unlock(loop_);
+        
+        if (driving != wasDriving) {
+            wasDriving = driving;
+            std::cout << "[PwStream] Driver mode: " << (driving ? "driving graph" : "following (another driver active)") << std::endl;
+        }
+        
+        if (!driving) {
+            lastTrigger = now;
+            continue;
+        }
+        
+        if (res >= 0) {
+            triggerPending_.store(true, std::memory_order_release);
+            driverTriggers_.fetch_add(1);
+            if (!ready) {
+                driverStalls_.fetch_add(1);
+            }
+        }
+        lastTrigger = now;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Recuperación automática - errores del stream y reinicios del daemon
+// ═══════════════════════════════════════════════════════════════════════════
+
+void PwStream::requestRecovery(const std::string& reason) {
+    {
+        std::lock_guard<std::mutex> lock(recoveryMutex_);
+        if (!recovering_.load()) {
+            recovering_.store(true);
+            recoveryStart_ = std::chrono::steady_clock::now();
+        }
+        if (recoveryRequested_) {
+            return;
+        }
+        recoveryRequested_ = true;
+    }
+    std::cerr << "[PwStream] " << name_ << ": recuperando (" << reason << ")" << std::endl;
+    setStreamState("recovering", reason);
+    recoveryCv_.notify_all();
+}
+
+void PwStream::runRecovery() {
+    const bool isOutput = (direction_ == StreamDirection::OUTPUT);
+    std::unique_lock<std::mutex> lock(recoveryMutex_);
+    
+    while (running_.load()) {
+        recoveryCv_.wait(lock, [this] { return !running_.load() || recoveryRequested_; });
+        if (!running_.load()) {
+            break;
+        }
+        recoveryRequested_ = false;
+        
+        // Desmontar fuera del lock: el loop de PipeWire puede estar
+        // esperando recoveryMutex_ en on_state_changed
+        lock.unlock();
+        pacerStop_.store(true);
+        if (driverThread_.joinable()) {
+            driverThread_.join();
+        }
+        teardownStream();
+        lock.lock();
+        
+        // Reintentos con backoff; stop() interrumpe la espera. SAB, notificador,
+        // render-ahead y configuración son miembros y no se tocan.
+        bool connected = false;
+        while (running_.load() && !connected) {
+            recoveryCv_.wait_for(lock, std::chrono::milliseconds(backoffMs_),
+                                 [this] { return !running_.load(); });
+            if (!running_.load()) {
+                break;
+            }
+            recoveryAttempts_.fetch_add(1);
+            lock.unlock();
+            connected = connectStream();
+            lock.lock();
+            // Crece también tras conectar: si vuelve a fallar antes de
+            // STREAMING, el siguiente intento espera más (onStreaming lo reinicia)
+            backoffMs_ = std::min(backoffMs_ * 2, RECOVERY_BACKOFF_MAX_MS);
+        }
+        
+        if (connected) {
+            // El ring conserva lo que hubiera; el SAB se ajusta con catch-up
+            priming_.store(isOutput);
+            triggerPending_.store(false);
+            if (driverMode_ && isOutput) {
+                pacerStop_.store(false);
+                driverThread_ = std::thread(&PwStream::runDriverPacer, this);
+            }
+            std::cout << "[PwStream] " << name_ << ": reconectado (intento "
+                      << recoveryAttempts_.load() << ")" << std::endl;
+        }
+    }
+}
+
+void PwStream::onStreaming() {
+    std::lock_guard<std::mutex> lock(recoveryMutex_);
+    backoffMs_ = RECOVERY_BACKOFF_MIN_MS;
+    if (!recovering_.load()) {
+        return;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - recoveryStart_;
+    lastRecoveryUs_.store(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    recoveries_.fetch_add(1);
+    recovering_.store(false);
+    std::cout << "[PwStream] " << name_ << ": recuperado en "
+              << getLastRecoveryMs() << "ms" << std::endl;
+}
+
+void PwStream::setStreamState(const char* state, const std::string& error) {
+    // El callback se invoca con stateMutex_ tomado: setStateCallback(nullptr)
+    // espera a que termine, así que quien lo suelta (ThreadSafeFunction::
+    // Release) no compite con una llamada en curso. El callback no debe
+    // bloquear ni volver a entrar en PwStream (NonBlockingCall).
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    state_ = state;
+    if (!error.empty()) {
+        lastError_ = error;
+    }
+    if (!stateCallback_) {
+        return;
+    }
+    StreamStateEvent event;
+    event.state = state;
+    event.error = error;
+    event.recovering = recovering_.load();
+    event.recoveries = recoveries_.load();
+    event.recoveryMs = getLastRecoveryMs();
+    stateCallback_(event);
+}
+
+void PwStream::setStateCallback(StateCallback callback) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    stateCallback_ = std::move(callback);
+}
+
+std::string PwStream::getStreamState() {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return state_;
+}
+
+std::string PwStream::getLastError() {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return lastError_;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Render-ahead - DSP nativo fuera del callback de PipeWire
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool PwStream::setRenderAhead(std::unique_ptr<NativeProcessor> processor, size_t aheadBlocks) {
+    if (running_.load()) {
+        std::cerr << "[PwStream] WARNING: setRenderAhead llamado con stream activo, ignorando" << std::endl;
+        return false;
+    }
+    if (processor && direction_ != StreamDirection::OUTPUT) {
+        std::cerr << "[PwStream] WARNING: render-ahead solo disponible en OUTPUT, ignorando" << std::endl;
+        return false;
+    }
+    renderProcessor_ = std::move(processor);
+    renderAheadBlocks_ = std::max<size_t>(1, std::min(aheadBlocks, MAX_RENDER_AHEAD_BLOCKS));
+    renderAheadFrames_ = renderProcessor_ ? renderAheadBlocks_ * RENDER_BLOCK_FRAMES : 0;
+    return true;
+}
+
+bool PwStream::prepareRenderAhead() {
+    if (!renderProcessor_ || running_.load()) return false;
+    
+    // El margen renderizado es la latencia: cubre al menos un quantum y
+    // deja hueco en el ring para el bloque en curso
+    const size_t block = RENDER_BLOCK_FRAMES;
+    const size_t quantumBlocks = (static_cast<size_t>(bufferSize_) + block - 1) / block;
+    const size_t maxBlocks = std::max<size_t>(1, ringBufferFrames_ / block - 1);
+    const size_t blocks = std::min(std::max(renderAheadBlocks_, quantumBlocks), maxBlocks);
+    renderAheadFrames_ = blocks * block;
+    activePrebufferFrames_ = renderAheadFrames_;
+    
+    // Reservas fuera del hilo productor
+    renderInterleaved_.assign(block * channels_, 0.0f);
+    renderInPlanar_.assign(block * channels_, 0.0f);
+    renderOutPlanar_.assign(block * channels_, 0.0f);
+    renderInPtrs_.resize(channels_);
+    renderOutPtrs_.resize(channels_);
+    for (int ch = 0; ch < channels_; ch++) {
+        renderInPtrs_[ch] = &renderInPlanar_[static_cast<size_t>(ch) * block];
+        renderOutPtrs_[ch] = &renderOutPlanar_[static_cast<size_t>(ch) * block];
+    }
+    renderProcessor_->prepare(sampleRate_, RENDER_BLOCK_FRAMES);
+    renderReadTotal_ = ring_.readTotal();
+    return true;
+}
+
+size_t PwStream::renderAheadStep() {
+    if (!renderProcessor_ || renderInPtrs_.empty()) return 0;
+    size_t blocks = 0;
+    while (renderAheadBlock()) {
+        blocks++;
+    }
+    return blocks;
+}
+
+bool PwStream::setRenderAheadParam(const std::string& name, float value) {
+    if (!renderProcessor_) return false;
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    return renderProcessor_->setParam(name, value);
+}
+
+void PwStream::runRenderAhead() {
+    sched_param sp{};
+    sp.sched_priority = RENDER_AHEAD_RT_PRIORITY;
+    const int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+    if (err != 0) {
+        std::cerr << "[PwStream] Render-ahead: SCHED_FIFO no disponible (" << std::strerror(err)
+                  << "), usando prioridad normal" << std::endl;
+    }
+    renderFlush_.store(Denormals::enableFlush());
+    
+    // Sondeo a 1/4 de bloque, como ProcessorBridge: el worklet publica en
+    // bloques de 128 frames y el margen renderizado cubre el retraso
+    const auto pollInterval = std::chrono::microseconds(
+        static_cast<int64_t>(RENDER_BLOCK_FRAMES) * 1000000 / sampleRate_ / 4);
+    
+    while (running_.load()) {
+        bool worked = false;
+        while (running_.load() && renderAheadBlock()) {
+            worked = true;
+        }
+        if (!worked) {
+            std::this_thread::sleep_for(pollInterval);
+        }
+    }
+}
+
+bool PwStream::renderAheadBlock() {
+    const size_t block = RENDER_BLOCK_FRAMES;
+    const size_t buffered = ring_.readable() / channels_;
+    if (buffered >= renderAheadFrames_) {
+        return false;
+    }
+    
+    // Catch-up (ver processCallbackOutput): aquí solo se descarta del SAB,
+    // lo ya renderizado está acotado a renderAheadFrames_
+    const size_t shared = sharedFillFrames();
+    if (latencyOverrun(buffered + shared)) {
+        const size_t excess = buffered + shared - activePrebufferFrames_;
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        health_.onCatchUp(discardSharedFrames(excess));
+        return true;
+    }
+    if (shared < block) {
+        return false;
+    }
+    
+    readFromSharedBuffer(renderInterleaved_.data(), block);
+    AudioKernels::deinterleave(renderInterleaved_.data(), channels_, renderInPlanar_.data(), block, block);
+    
+    {
+        std::lock_guard<std::mutex> lock(renderMutex_);
+        const auto t0 = std::chrono::steady_clock::now();
+        renderProcessor_->process(renderInPtrs_.data(), renderOutPtrs_.data(), RENDER_BLOCK_FRAMES);
+        const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count());
+        
+        uint64_t prev = maxRenderNs_.load(std::memory_order_relaxed);
+        while (ns > prev && !maxRenderNs_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+        if (ns > block * 1000000000ULL / static_cast<uint64_t>(sampleRate_)) {
+            renderSpikes_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    if (renderedBlocks_.load(std::memory_order_relaxed) % Denormals::SAMPLE_BLOCKS == 0) {
+        renderDenormals_.fetch_add(Denormals::countSubnormals(renderOutPlanar_.data(), block * channels_),
+                                   std::memory_order_relaxed);
+    }
+    
+    AudioKernels::interleave(renderOutPlanar_.data(), block, channels_, renderInterleaved_.data(), block);
+    
+    // Entrega sin lock (ring SPSC); ringMutex_ solo frente a attach/detach
+    // del SAB desde JS, nunca frente a on_process
+    ring_.write(renderInterleaved_.data(), block * channels_);
+    const size_t filled = ring_.readable() / channels_;
+    bufferedFrames_.store(filled);
+    if (priming_.load() && filled >= activePrebufferFrames_) {
+        priming_.store(false);
+        std::cout << "[PwStream] Render-ahead: margen lleno (" << filled << " frames)" << std::endl;
+    }
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        sabPackets_.consume(block);
+        // Latencia y deriva de los paquetes: lo entregado a PipeWire desde
+        // la última medida termina en cursor − lo que queda en el ring
+        const size_t readTotal = ring_.readTotal();
+        const size_t delivered = (readTotal - renderReadTotal_) / channels_;
+        if (delivered > 0 && sabPackets_.hasTiming()) {
+            sabPackets_.onOutput(sabPackets_.cursorFrame() - static_cast<double>(filled), delivered);
+        }
+        renderReadTotal_ = readTotal;
+    }
+    renderedBlocks_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Configuración de latencia
 // ═══════════════════════════════════════════════════════════════════════════
@@ -594,11 +1284,10 @@ void PwStream::setLatency(size_t prebufferFrames, size_t ringBufferFrames) {
     // Validar rangos razonables (min 256 frames ~5ms, max 16384 frames ~340ms @ 48kHz)
     prebufferFrames_ = std::max<size_t>(256, std::min<size_t>(16384, prebufferFrames));
     ringBufferFrames_ = std::max<size_t>(prebufferFrames_ * 2, std::min<size_t>(32768, ringBufferFrames));
+    activePrebufferFrames_ = prebufferFrames_;
     
     // Redimensionar ring buffer
-    ringBuffer_.resize(ringBufferFrames_ * channels_, 0.0f);
-    ringWritePos_ = 0;
-    ringReadPos_ = 0;
+    ring_.allocate(ringBufferFrames_ * channels_);
     
     std::cout << "[PwStream] Latencia configurada: prebuffer=" << prebufferFrames_ 
               << " frames, ringbuffer=" << ringBufferFrames_ << " frames" << std::endl;
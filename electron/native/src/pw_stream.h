@@ -11,6 +11,10 @@
  * Soporta dos modos de alimentación:
  * 1. write()/read() - llamadas explícitas desde JS
  * 2. SharedArrayBuffer - comunicación lock-free con AudioWorklet
+ *
+ * Si el stream pasa a error/desconectado o el daemon se reinicia (EPIPE en
+ * el core), un hilo de recuperación desmonta y reconecta en segundo plano
+ * con backoff exponencial, conservando SAB, notificador y configuración.
  */
 
 #ifndef PW_STREAM_H
@@ -20,7 +24,18 @@
 #include <spa/param/audio/format-utils.h>
 #include <spa/param/props.h>
 
+#include "audio_health.h"
+#include "input_conditioner.h"
+#include "mirrored_ring.h"
+#include "native_processor.h"
+#include "sab_notifier.h"
+#include "sab_packets.h"
+#include "shm_bridge.h"
+
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <string>
@@ -30,6 +45,15 @@
 
 enum class StreamDirection { OUTPUT, INPUT };
 
+// Transición de estado notificada a JS (hilo de PipeWire o de recuperación)
+struct StreamStateEvent {
+    std::string state;      // unconnected/connecting/paused/streaming/error/recovering
+    std::string error;
+    bool recovering = false;
+    size_t recoveries = 0;
+    double recoveryMs = 0;  // Duración de la última recuperación completada
+};
+
 class PwStream {
 public:
     PwStream(const std::string& name, int channels, int sampleRate, int bufferSize,
@@ -51,40 +75,169 @@ public:
     // SharedArrayBuffer - comunicación lock-free
     // Output: JS escribe, C++ lee (readFromSharedBuffer)
     // Input: C++ escribe, JS lee (writeToSharedBuffer)
-    bool attachSharedBuffer(void* buffer, size_t bufferSize, size_t bufferFrames);
+    // packetSlots > 0 (solo OUTPUT): formato empaquetado, tabla de
+    // descriptores con marca de tiempo tras el audio (ver sab_packets.h)
+    bool attachSharedBuffer(void* buffer, size_t bufferSize, size_t bufferFrames,
+                            size_t packetSlots = 0);
     void detachSharedBuffer();
     bool hasSharedBuffer() const { return sharedBuffer_ != nullptr; }
+    bool isPacketized() const { return sabPackets_.isAttached(); }
+    // Latencia real productor → PipeWire, bloques perdidos/duplicados y deriva
+    const SabPackets& packets() const { return sabPackets_; }
+    
+    // Despertares Atomics.wait para consumidores fuera del worklet
+    // Input: avisa al haber datos nuevos. Output: avisa al liberar espacio.
+    bool attachNotifyBuffer(void* buffer, size_t bufferSize, size_t wordIndex,
+                            size_t watermarkFrames, SabNotifier::WakeCallback callback);
+    void detachNotifyBuffer();
+    bool hasNotifyBuffer() const { return notifier_.isAttached(); }
+    size_t getNotifyCount() const { return notifier_.getNotifyCount(); }
     
     // Configuración de latencia (debe llamarse ANTES de start())
     void setLatency(size_t prebufferFrames, size_t ringBufferFrames);
-    size_t getPrebufferFrames() const { return prebufferFrames_; }
+    // Prebuffer en uso: el configurado, o el que imponen el modo driver
+    // (~1 quantum) y el render-ahead (su margen) mientras el stream corre
+    size_t getPrebufferFrames() const { return activePrebufferFrames_; }
     size_t getRingBufferFrames() const { return ringBufferFrames_; }
     
+    // Modo driver (solo OUTPUT, debe llamarse ANTES de start()):
+    // el stream se crea con PW_STREAM_FLAG_DRIVER y dispara los ciclos del
+    // grafo (pw_stream_trigger_process) según llegan datos al SAB, de modo
+    // que el ritmo de Web Audio es el reloj maestro y el prebuffer baja a
+    // ~1 quantum.
+    void setDriverMode(bool enabled);
+    bool getDriverMode() const { return driverMode_; }
+    
+    // Catch-up (solo OUTPUT, desactivado por defecto): si el AudioContext va
+    // por delante del grafo y la latencia (ring + SAB) supera el ring, se
+    // descarta lo más antiguo hasta volver al prebuffer. Es audible (un salto
+    // en el audio); sin él solo se cuenta el desborde (latencyOverruns en
+    // AudioHealth) y el worklet pierde bloques al llenarse el SAB.
+    void setCatchUp(bool enabled) { catchUp_.store(enabled, std::memory_order_relaxed); }
+    bool getCatchUp() const { return catchUp_.load(std::memory_order_relaxed); }
+    size_t getDriverTriggers() const { return driverTriggers_.load(); }
+    size_t getDriverStalls() const { return driverStalls_.load(); }
+    
+    // Render-ahead (solo OUTPUT, debe llamarse ANTES de start()): un hilo
+    // productor de prioridad alta ejecuta `processor` sobre el audio del SAB
+    // en bloques de RENDER_BLOCK_FRAMES y mantiene hasta aheadBlocks bloques
+    // ya renderizados en el ring; processCallbackOutput solo copia. Un bloque
+    // caro se absorbe con ese margen en lugar de ser un xrun. La latencia
+    // añadida sustituye al prebuffer y se informa en getPrebufferFrames().
+    // nullptr desactiva el modo.
+    static constexpr int RENDER_BLOCK_FRAMES = 128;
+    static constexpr size_t MAX_RENDER_AHEAD_BLOCKS = 64;
+    bool setRenderAhead(std::unique_ptr<NativeProcessor> processor, size_t aheadBlocks);
+    bool setRenderAheadParam(const std::string& name, float value);
+    bool getRenderAhead() const { return renderProcessor_ != nullptr; }
+    size_t getRenderAheadFrames() const { return renderAheadFrames_; }
+    size_t getRenderedBlocks() const { return renderedBlocks_.load(); }
+    // Bloques que tardaron más que su duración (habrían sido xrun en on_process)
+    size_t getRenderSpikes() const { return renderSpikes_.load(); }
+    double getMaxRenderUs() const { return maxRenderNs_.load() / 1000.0; }
+    // Subnormales vistos en los bloques renderizados muestreados
+    size_t getRenderDenormals() const { return renderDenormals_.load(); }
+    // FTZ/DAZ activo en el data loop y, con render-ahead, en su hilo
+    bool getFlushDenormals() const {
+        return dataLoopFlush_.load() && (!renderProcessor_ || renderFlush_.load());
+    }
+    
+    // Estado y recuperación automática
+    // El callback corre en el hilo que cambia el estado, con el estado
+    // bloqueado: no debe bloquear ni llamar a PwStream. Al volver
+    // setStateCallback() ninguna llamada al callback anterior sigue en curso.
+    using StateCallback = std::function<void(const StreamStateEvent&)>;
+    void setStateCallback(StateCallback callback);
+    std::string getStreamState();
+    std::string getLastError();
+    bool isRecovering() const { return recovering_.load(); }
+    size_t getRecoveries() const { return recoveries_.load(); }
+    size_t getRecoveryAttempts() const { return recoveryAttempts_.load(); }
+    double getLastRecoveryMs() const { return lastRecoveryUs_.load() / 1000.0; }
+    
     // Info
     StreamDirection getDirection() const { return direction_; }
     int getChannels() const { return channels_; }
+    // 2 canales: posiciones FL/FR y enlace automático con el dispositivo por defecto
+    bool isStereoLayout() const { return channels_ == 2; }
     int getSampleRate() const { return sampleRate_; }
     int getBufferSize() const { return bufferSize_; }
     size_t getUnderflows() const { return underflows_.load(); }
     size_t getOverflows() const { return overflows_.load(); }
     size_t getSilentUnderflows() const { return silentUnderflows_.load(); }
     size_t getBufferedFrames() const { return bufferedFrames_.load(); }
+    
+    // Puente con el plugin LV2 (shm_bridge.h). OUTPUT copia lo entregado a
+    // PipeWire al ring de retorno; INPUT suma el ring de envío a la captura
+    // antes de acondicionarla. channelOffset = primer canal del stream.
+    // El hilo RT solo lo toma con try_lock: attach/detach nunca lo bloquean.
+    void attachBridge(std::shared_ptr<ShmBridge> bridge, int channelOffset);
+    void detachBridge();
+    bool hasBridge();
+    
+    // Un ciclo de on_process sobre un buffer propio, sin PipeWire (soak y
+    // benchmarks con reloj virtual). Mismo camino que el callback: SAB,
+    // cebado, catch-up, puente y telemetría. No requiere start().
+    void processOutput(float* dst, uint32_t frames);
+    void processInput(const float* src, uint32_t frames);
+    // Render-ahead sin hilo, para lo mismo: prepareRenderAhead() hace las
+    // reservas de start() (tras setRenderAhead) y renderAheadStep() ejecuta
+    // lo que haría el hilo productor hasta quedarse sin margen o sin SAB.
+    // Devuelve los bloques renderizados o descartados por catch-up.
+    bool prepareRenderAhead();
+    size_t renderAheadStep();
+    
+    // Input mode: DC, ganancia y detección de picos/recortes por canal,
+    // aplicados en la misma pasada que escribe el SAB o el ring interno
+    InputConditioner& conditioner() { return conditioner_; }
 
 private:
     // PipeWire callbacks (static para usar como C callbacks)
     static void on_process(void* userdata);
     static void on_state_changed(void* userdata, enum pw_stream_state old,
                                   enum pw_stream_state state, const char* error);
+    static void on_param_changed(void* userdata, uint32_t id, const struct spa_pod* param);
+    static void on_core_error(void* userdata, uint32_t id, int seq, int res, const char* message);
+    
+    bool connectStream();          // Crea loop + stream y conecta (start y recuperación)
+    void teardownStream();         // Destruye stream y loop (stop y recuperación)
+    void requestRecovery(const std::string& reason);
+    void runRecovery();            // Hilo: desmonta y reconecta con backoff
+    void onStreaming();            // Cierra una recuperación en curso
+    void setStreamState(const char* state, const std::string& error);
     
     void processCallbackOutput();  // Playback: ring buffer → PipeWire
     void processCallbackInput();   // Capture: PipeWire → ring buffer/SAB
+    bool renderOutput(float* dst, uint32_t frames);  // false = cebando (no cuenta)
+    void captureInput(const float* src, uint32_t frames);
     void runLoop();
+    void runDriverPacer();         // Modo driver: dispara ciclos según llega audio
+    size_t pendingSourceFrames();  // Frames en SAB + ring interno (output)
+    void runRenderAhead();         // Render-ahead: hilo productor
+    bool renderAheadBlock();       // Renderiza un bloque del SAB al ring si hay hueco
     
     // Output mode: Lee datos del SharedArrayBuffer (JS escribe, C++ lee)
     size_t readFromSharedBuffer(float* dest, size_t maxFrames);
     
-    // Input mode: Escribe datos al SharedArrayBuffer (C++ escribe, JS lee)
+    // Input mode: Acondiciona y escribe datos al SharedArrayBuffer (C++ escribe, JS lee)
     size_t writeToSharedBuffer(const float* data, size_t frames);
+    
+    // Frames escritos y no leídos en el SharedArrayBuffer
+    size_t sharedFillFrames() const;
+    // Output mode: true si hay que recortar pendingFrames (catch-up activo y
+    // por encima del ring); sin catch-up cuenta el desborde y devuelve false
+    bool latencyOverrun(size_t pendingFrames);
+    // Output mode: descarta los frames más antiguos del SharedArrayBuffer
+    // (con ringMutex_ tomado: avanza el cursor de paquetes). Devuelve los
+    // realmente descartados (como mucho lo que haya en el SAB).
+    size_t discardSharedFrames(size_t frames);
+    
+    // Puente LV2 desde el hilo RT (sin efecto si no hay plugin conectado)
+    void teeBridgeReturn(const float* data, uint32_t frames);
+    const float* mixBridgeSend(const float* src, uint32_t frames);
+    
+    // Salud del audio: latencia y carga del ciclo recién atendido
+    void recordCycle(uint32_t frames, std::chrono::steady_clock::time_point start);
 
     std::string name_;
     StreamDirection direction_;
@@ -96,16 +249,15 @@ private:
     
     // Configuración de latencia (configurable antes de start)
     size_t prebufferFrames_ = 2048;   // ~42ms @ 48kHz por defecto
+    size_t activePrebufferFrames_ = 2048;  // Efectivo de la sesión (ver start())
     size_t ringBufferFrames_ = 4096;  // ~85ms @ 48kHz por defecto
     
     // PipeWire objects
     struct pw_thread_loop* loop_ = nullptr;
     struct pw_stream* stream_ = nullptr;
     
-    // Ring buffer interno para datos de audio
-    std::vector<float> ringBuffer_;
-    size_t ringWritePos_ = 0;
-    size_t ringReadPos_ = 0;
+    // Ring buffer interno para datos de audio (espejado: tramos lineales)
+    MirroredRing ring_;
     std::mutex ringMutex_;
     
     // SharedArrayBuffer externo (comunicación lock-free)
@@ -117,6 +269,23 @@ private:
     std::atomic<int32_t>* sharedReadIndex_ = nullptr;
     float* sharedAudioData_ = nullptr;
     
+    // Palabra de notificación (Atomics.wait/notify) en un SAB dedicado
+    SabNotifier notifier_;
+    
+    // Descriptores de bloque del worklet (formato empaquetado). Cursor
+    // protegido por ringMutex_: avanza con lo que entra al ring interno.
+    SabPackets sabPackets_;
+    
+    // Acondicionamiento de la captura (solo INPUT)
+    InputConditioner conditioner_;
+    
+    // Puente LV2
+    static constexpr size_t BRIDGE_MAX_FRAMES = 8192;
+    std::mutex bridgeMutex_;
+    std::shared_ptr<ShmBridge> bridge_;
+    int bridgeOffset_ = 0;
+    std::vector<float> bridgeScratch_;         // Captura + envío (INPUT)
+    
     std::atomic<bool> running_{false};
     std::atomic<bool> priming_{true};  // Pre-buffering: no reproduce hasta llenar
     std::atomic<size_t> underflows_{0};
@@ -124,8 +293,63 @@ private:
     std::atomic<size_t> silentUnderflows_{0};  // Silencio enviado por buffer bajo
     std::atomic<size_t> bufferedFrames_{0};  // Para métricas de latencia
     
+    // Catch-up de latencia (ver setCatchUp)
+    std::atomic<bool> catchUp_{false};
+    bool latencyOverrun_ = false;  // Desborde en curso: se cuenta una vez por episodio
+    
+    // Modo driver
+    bool driverMode_ = false;
+    std::thread driverThread_;
+    std::atomic<bool> triggerPending_{false};  // Ciclo disparado, process() pendiente
+    std::atomic<size_t> driverTriggers_{0};
+    std::atomic<size_t> driverStalls_{0};      // Ciclos forzados sin datos (evita congelar el grafo)
+    std::atomic<bool> pacerStop_{false};       // La recuperación para el pacer sin parar el stream
+    
+    // Render-ahead
+    std::unique_ptr<NativeProcessor> renderProcessor_;
+    size_t renderAheadBlocks_ = 0;
+    size_t renderAheadFrames_ = 0;
+    std::thread renderThread_;
+    std::mutex renderMutex_;                   // process() vs setRenderAheadParam()
+    std::vector<float> renderInterleaved_;     // Bloque del SAB / bloque renderizado
+    std::vector<float> renderInPlanar_;
+    std::vector<float> renderOutPlanar_;
+    std::vector<const float*> renderInPtrs_;
+    std::vector<float*> renderOutPtrs_;
+    size_t renderReadTotal_ = 0;               // ring_.readTotal() del último onOutput (productor)
+    std::atomic<size_t> renderedBlocks_{0};
+    std::atomic<size_t> renderSpikes_{0};
+    std::atomic<uint64_t> maxRenderNs_{0};
+    std::atomic<size_t> renderDenormals_{0};
+    std::atomic<bool> renderFlush_{false};
+    std::atomic<bool> dataLoopFlush_{false};
+    
+    // Agregados de sesión para telemetría (compartidos por dirección)
+    AudioHealth& health_;
+    
+    // Recuperación automática
+    std::thread recoveryThread_;
+    std::mutex recoveryMutex_;
+    std::condition_variable recoveryCv_;
+    bool recoveryRequested_ = false;           // Protegido por recoveryMutex_
+    int backoffMs_ = 0;                        // Protegido por recoveryMutex_
+    std::chrono::steady_clock::time_point recoveryStart_;
+    std::atomic<bool> recovering_{false};      // Desde el fallo hasta volver a STREAMING
+    std::atomic<bool> tearingDown_{false};     // Ignorar los estados de nuestro propio desmontaje
+    std::atomic<size_t> recoveries_{0};
+    std::atomic<size_t> recoveryAttempts_{0};
+    std::atomic<uint64_t> lastRecoveryUs_{0};
+    
+    // Estado publicado
+    std::mutex stateMutex_;
+    std::string state_ = "unconnected";
+    std::string lastError_;
+    StateCallback stateCallback_;
+    
     // Stream events
     struct pw_stream_events events_;
+    struct pw_core_events coreEvents_;
+    struct spa_hook coreListener_;
 };
 
 #endif // PW_STREAM_H
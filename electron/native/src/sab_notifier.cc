@@ -0,0 +1,148 @@
+/**
+ * SabNotifier implementation
+ */
+
+#include "sab_notifier.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <iostream>
+#include <thread>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Primitivas futex (la memoria del SAB es memoria normal del proceso)
+// ═══════════════════════════════════════════════════════════════════════════
+
+int SabNotifier::wait(std::atomic<int32_t>* word, int32_t expected, int timeoutMs) {
+    if (!word) return -1;
+
+    struct timespec ts;
+    struct timespec* tsPtr = nullptr;
+    if (timeoutMs >= 0) {
+        ts.tv_sec = timeoutMs / 1000;
+        ts.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+        tsPtr = &ts;
+    }
+
+    long res = syscall(SYS_futex, reinterpret_cast<int32_t*>(word), FUTEX_WAIT_PRIVATE,
+                       expected, tsPtr, nullptr, 0);
+    // EAGAIN: el valor ya había cambiado → equivale a despertar
+    if (res == 0 || errno == EAGAIN) return 0;
+    return -1;
+}
+
+void SabNotifier::wake(std::atomic<int32_t>* word) {
+    if (!word) return;
+    syscall(SYS_futex, reinterpret_cast<int32_t*>(word), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Ciclo de vida
+// ═══════════════════════════════════════════════════════════════════════════
+
+SabNotifier::~SabNotifier() {
+    detach();
+}
+
+bool SabNotifier::attach(void* buffer, size_t bufferSize, size_t wordIndex,
+                         size_t watermarkFrames, WakeCallback callback) {
+    if (!buffer || (wordIndex + 1) * sizeof(int32_t) > bufferSize) {
+        std::cerr << "[SabNotifier] Invalid notify word: index " << wordIndex
+                  << ", buffer " << bufferSize << " bytes" << std::endl;
+        return false;
+    }
+
+    detach();
+
+    int32_t* words = static_cast<int32_t*>(buffer);
+    word_.store(reinterpret_cast<std::atomic<int32_t>*>(&words[wordIndex]),
+                std::memory_order_relaxed);
+    watermarkFrames_ = std::max<size_t>(1, watermarkFrames);
+    pendingFrames_ = 0;
+    callback_ = std::move(callback);
+    notifyCount_.store(0);
+
+    active_.store(true, std::memory_order_release);
+    thread_ = std::thread(&SabNotifier::runNotifier, this);
+
+    std::cout << "[SabNotifier] Attached: word " << wordIndex
+              << ", watermark " << watermarkFrames_ << " frames" << std::endl;
+    return true;
+}
+
+void SabNotifier::detach() {
+    if (!active_.exchange(false)) {
+        return;
+    }
+
+    // Un hilo RT que ya pasó la comprobación de active_ aún puede escribir la
+    // palabra: esperar a que salga (dura unas instrucciones y un FUTEX_WAKE)
+    while (inUse_.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    // FUTEX_WAKE despierta al notificador sin alterar la palabra
+    // (los consumidores JS no ven un cambio de secuencia espurio)
+    wake(word_.load(std::memory_order_relaxed));
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    callback_ = nullptr;
+
+    std::cout << "[SabNotifier] Detached. Notifies: " << notifyCount_.load() << std::endl;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Hilo RT: acumula y despierta al cruzar la marca de agua
+// ═══════════════════════════════════════════════════════════════════════════
+
+void SabNotifier::onCommit(size_t frames) {
+    if (frames == 0) {
+        return;
+    }
+
+    // Orden secuencial en ambos lados: o detach() ve inUse_ > 0 y espera,
+    // o este hilo ve active_ == false y no toca la palabra
+    inUse_.fetch_add(1);
+    if (active_.load()) {
+        pendingFrames_ += frames;
+        if (pendingFrames_ >= watermarkFrames_) {
+            pendingFrames_ = 0;
+            std::atomic<int32_t>* word = word_.load(std::memory_order_relaxed);
+            word->fetch_add(1, std::memory_order_release);
+            notifyCount_.fetch_add(1, std::memory_order_relaxed);
+            wake(word);
+        }
+    }
+    inUse_.fetch_sub(1, std::memory_order_release);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Hilo notificador: traduce el futex nativo al callback (Atomics.notify)
+// ═══════════════════════════════════════════════════════════════════════════
+
+void SabNotifier::runNotifier() {
+    std::atomic<int32_t>* word = word_.load(std::memory_order_relaxed);
+    int32_t lastSeq = word->load(std::memory_order_acquire);
+
+    while (active_.load(std::memory_order_acquire)) {
+        // Timeout de seguridad: cubre un wake de detach() que llegue antes
+        // de entrar en el futex (no hay sondeo: sin cambios no hay trabajo)
+        wait(word, lastSeq, 250);
+
+        int32_t seq = word->load(std::memory_order_acquire);
+        if (seq == lastSeq) {
+            continue;  // Despertar de detach() o espurio
+        }
+        lastSeq = seq;
+
+        if (callback_ && active_.load(std::memory_order_acquire)) {
+            callback_(seq);
+        }
+    }
+}
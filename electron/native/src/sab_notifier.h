@@ -0,0 +1,78 @@
+/**
+ * SabNotifier - Despertares por futex sobre una palabra de un SharedArrayBuffer
+ *
+ * Permite que consumidores fuera del AudioWorklet (grabadores o analizadores
+ * en un Web Worker) bloqueen en Atomics.wait() en lugar de sondear
+ * Atomics.load() con un temporizador.
+ *
+ * Funcionamiento:
+ * - El hilo RT llama a onCommit(frames) tras cada commit en el SAB.
+ * - Cuando lo acumulado desde el último despertar alcanza la marca de agua
+ *   (watermark), incrementa la palabra de secuencia y hace FUTEX_WAKE.
+ * - Un hilo notificador bloqueado en esa misma palabra invoca el callback
+ *   (el binding lo traduce a Atomics.notify() en el hilo JS).
+ *
+ * Atomics.wait de V8 no es un futex del kernel (FutexEmulation), por eso el
+ * despertar de JS pasa por el callback; los consumidores nativos pueden
+ * usar wait() directamente sobre la misma palabra.
+ *
+ * detach() espera a que el hilo RT salga de onCommit() (contador inUse_)
+ * antes de volver: después el binding puede soltar el typed array del SAB
+ * y attach() reescribir la configuración sin carreras con el hilo RT.
+ */
+
+#ifndef SAB_NOTIFIER_H
+#define SAB_NOTIFIER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+class SabNotifier {
+public:
+    // Recibe el nuevo valor de la palabra de secuencia
+    using WakeCallback = std::function<void(int32_t seq)>;
+
+    SabNotifier() = default;
+    ~SabNotifier();
+
+    SabNotifier(const SabNotifier&) = delete;
+    SabNotifier& operator=(const SabNotifier&) = delete;
+
+    // Layout: palabra Int32 en buffer[wordIndex]. watermarkFrames = frames
+    // acumulados necesarios para emitir un despertar (mínimo 1)
+    // detach() no vuelve hasta que el hilo RT deja de tocar la palabra.
+    bool attach(void* buffer, size_t bufferSize, size_t wordIndex,
+                size_t watermarkFrames, WakeCallback callback);
+    void detach();
+    bool isAttached() const { return active_.load(std::memory_order_acquire); }
+
+    // Llamado desde el hilo RT tras publicar frames (input) o liberar
+    // espacio (output). Sin locks ni reservas de memoria.
+    void onCommit(size_t frames);
+
+    size_t getWatermarkFrames() const { return watermarkFrames_; }
+    size_t getNotifyCount() const { return notifyCount_.load(std::memory_order_relaxed); }
+
+    // Espera nativa sobre una palabra (para consumidores en C++).
+    // Devuelve 0 si despertó, -1 si timeout o error.
+    static int wait(std::atomic<int32_t>* word, int32_t expected, int timeoutMs);
+    static void wake(std::atomic<int32_t>* word);
+
+private:
+    void runNotifier();
+
+    std::atomic<std::atomic<int32_t>*> word_{nullptr};
+    // Solo se escriben con el notificador inactivo y el hilo RT fuera de onCommit()
+    size_t watermarkFrames_ = 0;
+    size_t pendingFrames_ = 0;  // Después, solo lo toca el hilo RT
+    WakeCallback callback_;
+    std::thread thread_;
+    std::atomic<bool> active_{false};
+    std::atomic<int> inUse_{0};  // Hilos RT dentro de onCommit()
+    std::atomic<size_t> notifyCount_{0};
+};
+
+#endif // SAB_NOTIFIER_H
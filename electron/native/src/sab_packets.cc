@@ -0,0 +1,173 @@
+/**
+ * SabPackets implementation
+ */
+
+#include "sab_packets.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+size_t SabPackets::regionOffset(size_t bufferFrames, int channels) {
+    const size_t end = 8 + bufferFrames * static_cast<size_t>(channels) * sizeof(float);
+    return (end + 7) & ~static_cast<size_t>(7);
+}
+
+bool SabPackets::attach(void* region, size_t slots) {
+    if (!region || slots == 0) {
+        return false;
+    }
+    header_ = static_cast<std::atomic<int32_t>*>(region);
+    slots_ = static_cast<uint8_t*>(region) + HEADER_BYTES;
+    slotCount_ = slots;
+
+    // El worklet pone packetCount a 0 al recibir el SAB; aquí solo el cursor,
+    // que arranca en lo ya publicado (un SAB en uso no se relee desde 0)
+    header_[1].store(static_cast<int32_t>(slots), std::memory_order_relaxed);
+    readPacket_ = static_cast<uint32_t>(header_[0].load(std::memory_order_acquire));
+    havePacket_ = false;
+    packetOffset_ = 0;
+    packetFrames_ = 0;
+    resetTiming();
+
+    packets_.store(0);
+    droppedBlocks_.store(0);
+    duplicatedBlocks_.store(0);
+    discontinuities_.store(0);
+    latencyFrames_.store(0);
+    maxLatencyFrames_.store(0);
+    driftPpm_.store(0);
+    return true;
+}
+
+void SabPackets::detach() {
+    header_ = nullptr;
+    slots_ = nullptr;
+    slotCount_ = 0;
+    havePacket_ = false;
+}
+
+void SabPackets::resetTiming() {
+    driftActive_ = false;
+}
+
+bool SabPackets::nextPacket() {
+    const uint32_t count = static_cast<uint32_t>(header_[0].load(std::memory_order_acquire));
+    if (count == readPacket_) {
+        return false;
+    }
+    // El worklet reinició la tabla (nuevo worklet sobre el mismo SAB) o nos
+    // adelantó una vuelta entera: retomar desde el descriptor más antiguo vivo.
+    // Distancia con signo: packetCount da la vuelta (2^32 bloques, ~4 meses
+    // a 48 kHz) y eso no es un reinicio.
+    const int32_t ahead = static_cast<int32_t>(count - readPacket_);
+    if (ahead < 0 || static_cast<size_t>(ahead) > slotCount_) {
+        readPacket_ = count > slotCount_ ? count - static_cast<uint32_t>(slotCount_) : 0;
+        havePacket_ = false;
+        discontinuities_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const uint8_t* slot = slots_ + (readPacket_ % slotCount_) * SLOT_BYTES;
+    int32_t seq;
+    int32_t frames;
+    double contextFrame;
+    std::memcpy(&seq, slot, sizeof(seq));
+    std::memcpy(&frames, slot + 4, sizeof(frames));
+    std::memcpy(&contextFrame, slot + 16, sizeof(contextFrame));
+    readPacket_++;
+
+    if (havePacket_) {
+        const int32_t delta = static_cast<int32_t>(static_cast<uint32_t>(seq) - static_cast<uint32_t>(lastSeq_));
+        if (delta > 1) {
+            droppedBlocks_.fetch_add(static_cast<size_t>(delta - 1), std::memory_order_relaxed);
+        } else if (delta <= 0) {
+            duplicatedBlocks_.fetch_add(1, std::memory_order_relaxed);
+        }
+        // Salto de la línea de tiempo no explicado por bloques perdidos
+        // (AudioContext suspendido y reanudado, worklet recreado...)
+        const double expected = cursorFrame_ + static_cast<double>(packetFrames_);
+        if (std::fabs(contextFrame - expected) > 0.5) {
+            if (delta == 1) {
+                discontinuities_.fetch_add(1, std::memory_order_relaxed);
+            }
+            resetTiming();
+        }
+    }
+
+    lastSeq_ = seq;
+    cursorFrame_ = contextFrame;
+    packetFrames_ = frames > 0 ? static_cast<size_t>(frames) : 0;
+    packetOffset_ = 0;
+    havePacket_ = true;
+    packets_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void SabPackets::consume(size_t frames, bool discarded) {
+    if (!header_) {
+        return;
+    }
+    if (discarded) {
+        resetTiming();
+    }
+    while (frames > 0) {
+        if (!havePacket_ || packetOffset_ >= packetFrames_) {
+            if (!nextPacket()) {
+                // Frames sin descriptor: el worklet no empaqueta, sin referencia
+                havePacket_ = false;
+                return;
+            }
+            continue;
+        }
+        const size_t take = std::min(frames, packetFrames_ - packetOffset_);
+        packetOffset_ += take;
+        frames -= take;
+    }
+}
+
+double SabPackets::producedEndFrame() const {
+    const uint32_t count = static_cast<uint32_t>(header_[0].load(std::memory_order_acquire));
+    if (count == 0) {
+        return cursorFrame();
+    }
+    const uint8_t* slot = slots_ + ((count - 1) % slotCount_) * SLOT_BYTES;
+    int32_t frames;
+    double contextFrame;
+    std::memcpy(&frames, slot + 4, sizeof(frames));
+    std::memcpy(&contextFrame, slot + 16, sizeof(contextFrame));
+    return contextFrame + static_cast<double>(frames);
+}
+
+void SabPackets::onOutput(double outputFrame, size_t outputFrames) {
+    if (!header_ || !havePacket_) {
+        return;
+    }
+
+    const double produced = producedEndFrame();
+    const double latency = produced - outputFrame;
+    latencyFrames_.store(latency, std::memory_order_relaxed);
+    if (latency > maxLatencyFrames_.load(std::memory_order_relaxed)) {
+        maxLatencyFrames_.store(latency, std::memory_order_relaxed);
+    }
+
+    if (!driftActive_ || driftOutputFrames_ >= DRIFT_WINDOW_FRAMES) {
+        driftActive_ = true;
+        driftStartProduced_ = produced;
+        driftOutputFrames_ = 0;
+        driftN_ = driftSx_ = driftSy_ = driftSxx_ = driftSxy_ = 0;
+    }
+
+    const double x = driftOutputFrames_;
+    const double y = produced - driftStartProduced_;
+    driftN_ += 1;
+    driftSx_ += x;
+    driftSy_ += y;
+    driftSxx_ += x * x;
+    driftSxy_ += x * y;
+    driftOutputFrames_ += static_cast<double>(outputFrames);
+
+    const double denom = driftN_ * driftSxx_ - driftSx_ * driftSx_;
+    if (x >= DRIFT_MIN_FRAMES && denom > 0) {
+        const double slope = (driftN_ * driftSxy_ - driftSx_ * driftSy_) / denom;
+        driftPpm_.store((slope - 1.0) * 1e6, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * SabPackets - Tabla de paquetes con marca de tiempo del SAB de salida
+ *
+ * El ring del SAB solo lleva frames: sin más, el lado nativo no sabe cuándo
+ * produjo el worklet cada bloque y la latencia o la deriva se deducen del
+ * nivel de llenado. En formato empaquetado el worklet publica, por cada
+ * bloque que escribe, un descriptor con su número de secuencia y el
+ * currentFrame/currentTime del AudioContext. PwStream avanza un cursor sobre
+ * los descriptores a medida que consume frames, lo que permite medir la
+ * latencia real productor → PipeWire, detectar bloques perdidos o duplicados
+ * y estimar la deriva entre el reloj del AudioContext y el del grafo.
+ *
+ * Layout (a continuación del audio, alineado a 8 bytes; el resto del SAB no
+ * cambia, así que un addon sin paquetes ignora la tabla):
+ *   Int32[0]  packetCount  descriptores publicados (worklet, antes de writeIndex)
+ *   Int32[1]  slots        capacidad de la tabla
+ *   Int32[2-3] reservado
+ *   slots × 32 bytes, descriptor i en (packetCount − 1) % slots:
+ *     Int32   seq          bloque del worklet (incluye los descartados)
+ *     Int32   frames
+ *     Int32[2] reservado
+ *     Float64 contextFrame currentFrame del AudioContext
+ *     Float64 contextTime  currentTime
+ *
+ * Un descriptor solo se reescribe tras `slots` bloques más; con
+ * slots > bufferFrames / bloque el worklet no puede alcanzar uno que el
+ * lector aún no ha consumido (el ring lleno le impide escribir).
+ *
+ * Un único lector: el hilo que consume el SAB (on_process o render-ahead).
+ */
+
+#ifndef SAB_PACKETS_H
+#define SAB_PACKETS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class SabPackets {
+public:
+    static constexpr size_t HEADER_BYTES = 16;
+    static constexpr size_t SLOT_BYTES = 32;
+
+    // Offset de la tabla tras bufferFrames × channels floats (8 + audio, alineado)
+    static size_t regionOffset(size_t bufferFrames, int channels);
+    static size_t regionBytes(size_t slots) { return HEADER_BYTES + slots * SLOT_BYTES; }
+
+    bool attach(void* region, size_t slots);
+    void detach();
+    bool isAttached() const { return header_ != nullptr; }
+
+    // Avanza el cursor sobre los frames recién leídos del SAB. Los frames
+    // descartados por el catch-up (discarded) reinician la ventana de deriva.
+    void consume(size_t frames, bool discarded = false);
+
+    // true cuando el cursor tiene un paquete de referencia
+    bool hasTiming() const { return havePacket_; }
+    // Frame del AudioContext del siguiente frame por leer del SAB
+    double cursorFrame() const { return cursorFrame_ + static_cast<double>(packetOffset_); }
+    // Fin (contextFrame + frames) del último paquete publicado por el worklet
+    double producedEndFrame() const;
+
+    // Tras entregar outputFrames a PipeWire. outputFrame = frame del
+    // AudioContext que sigue a lo entregado. Latencia = distancia hasta lo
+    // último que produjo el worklet; alimenta también la estimación de deriva.
+    void onOutput(double outputFrame, size_t outputFrames);
+
+    size_t getPackets() const { return packets_.load(std::memory_order_relaxed); }
+    size_t getDroppedBlocks() const { return droppedBlocks_.load(std::memory_order_relaxed); }
+    size_t getDuplicatedBlocks() const { return duplicatedBlocks_.load(std::memory_order_relaxed); }
+    size_t getDiscontinuities() const { return discontinuities_.load(std::memory_order_relaxed); }
+    double getLatencyFrames() const { return latencyFrames_.load(std::memory_order_relaxed); }
+    double getMaxLatencyFrames() const { return maxLatencyFrames_.load(std::memory_order_relaxed); }
+    // Deriva del reloj del AudioContext respecto al del grafo (ppm, > 0: JS más rápido)
+    double getDriftPpm() const { return driftPpm_.load(std::memory_order_relaxed); }
+
+private:
+    bool nextPacket();
+    void resetTiming();
+
+    std::atomic<int32_t>* header_ = nullptr;
+    uint8_t* slots_ = nullptr;
+    size_t slotCount_ = 0;
+
+    // Cursor (solo el hilo lector)
+    uint32_t readPacket_ = 0;
+    bool havePacket_ = false;
+    int32_t lastSeq_ = 0;
+    double cursorFrame_ = 0;     // contextFrame del paquete actual
+    size_t packetOffset_ = 0;    // Frames ya consumidos del paquete actual
+    size_t packetFrames_ = 0;
+
+    // Deriva: regresión lineal de lo producido por el worklet (frames del
+    // AudioContext) frente a lo entregado a PipeWire (frames del grafo).
+    // Pendiente 1 = mismo reloj. Ventanas de DRIFT_WINDOW_FRAMES.
+    static constexpr double DRIFT_MIN_FRAMES = 65536;
+    static constexpr double DRIFT_WINDOW_FRAMES = 4194304;
+    bool driftActive_ = false;
+    double driftStartProduced_ = 0;
+    double driftOutputFrames_ = 0;
+    double driftN_ = 0, driftSx_ = 0, driftSy_ = 0, driftSxx_ = 0, driftSxy_ = 0;
+
+    std::atomic<size_t> packets_{0};
+    std::atomic<size_t> droppedBlocks_{0};
+    std::atomic<size_t> duplicatedBlocks_{0};
+    std::atomic<size_t> discontinuities_{0};
+    std::atomic<double> latencyFrames_{0};
+    std::atomic<double> maxLatencyFrames_{0};
+    std::atomic<double> driftPpm_{0};
+};
+
+#endif // SAB_PACKETS_H
@@ -0,0 +1,386 @@
+/**
+ * ShmBridge implementation
+ */
+
+#include "shm_bridge.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+size_t headerBytes() {
+    return (sizeof(ShmBridge::Header) + 63) & ~static_cast<size_t>(63);
+}
+
+size_t segmentBytes(size_t ringFrames, int sendChannels, int returnChannels) {
+    return headerBytes() + ringFrames * static_cast<size_t>(sendChannels + returnChannels) * sizeof(float);
+}
+
+}  // namespace
+
+ShmBridge::~ShmBridge() {
+    close();
+}
+
+bool ShmBridge::create(const std::string& name, int sampleRate, int sendChannels,
+                       int returnChannels, size_t ringFrames, size_t latencyFrames) {
+    if (sampleRate <= 0 || sendChannels < 1 || sendChannels > MAX_CHANNELS ||
+        returnChannels < 1 || returnChannels > MAX_CHANNELS || ringFrames < 256 ||
+        ringFrames > (1u << 20) || (ringFrames & (ringFrames - 1)) != 0) {
+        std::cerr << "[ShmBridge] Invalid parameters" << std::endl;
+        return false;
+    }
+
+    close();
+
+    // Un segmento que sobrevivió a una app caída se sustituye
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        std::cerr << "[ShmBridge] shm_open(" << name << ") failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    const size_t bytes = segmentBytes(ringFrames, sendChannels, returnChannels);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        std::cerr << "[ShmBridge] ftruncate failed: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void* map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        std::cerr << "[ShmBridge] mmap failed: " << std::strerror(errno) << std::endl;
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // Páginas nuevas de ftruncate: todo a cero, índices incluidos
+    header_ = static_cast<Header*>(map);
+    mapBytes_ = bytes;
+    name_ = name;
+    owner_ = true;
+    inode_ = st.st_ino;
+
+    header_->version = VERSION;
+    header_->sampleRate = static_cast<uint32_t>(sampleRate);
+    header_->sendChannels = static_cast<uint32_t>(sendChannels);
+    header_->returnChannels = static_cast<uint32_t>(returnChannels);
+    header_->ringFrames = static_cast<uint32_t>(ringFrames);
+    header_->latencyFrames.store(static_cast<uint32_t>(std::clamp<size_t>(latencyFrames, 1, ringFrames / 4)));
+    header_->appPid.store(static_cast<uint32_t>(getpid()));
+
+    data_[SEND] = reinterpret_cast<float*>(static_cast<uint8_t*>(map) + headerBytes());
+    data_[RETURN] = data_[SEND] + ringFrames * static_cast<size_t>(sendChannels);
+    primed_[SEND] = primed_[RETURN] = false;
+    setPipelineLatency(pipelineFrames_);
+
+    header_->magic.store(MAGIC, std::memory_order_release);
+
+    std::cout << "[ShmBridge] Created " << name << ": " << sendChannels << " send / "
+              << returnChannels << " return ch, ring " << ringFrames << " frames, latency "
+              << header_->latencyFrames.load() << " frames" << std::endl;
+    return true;
+}
+
+bool ShmBridge::open(const std::string& name) {
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return false;  // La app no está en marcha: el plugin reintentará
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < headerBytes()) {
+        ::close(fd);
+        return false;
+    }
+
+    const size_t bytes = static_cast<size_t>(st.st_size);
+    void* map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    Header* header = static_cast<Header*>(map);
+    const bool valid = header->magic.load(std::memory_order_acquire) == MAGIC &&
+                       header->version == VERSION &&
+                       header->sendChannels >= 1 && header->sendChannels <= MAX_CHANNELS &&
+                       header->returnChannels >= 1 && header->returnChannels <= MAX_CHANNELS &&
+                       header->ringFrames >= 256 && (header->ringFrames & (header->ringFrames - 1)) == 0 &&
+                       header->appPid.load() != 0 &&
+                       segmentBytes(header->ringFrames, static_cast<int>(header->sendChannels),
+                                    static_cast<int>(header->returnChannels)) <= bytes;
+    if (!valid) {
+        munmap(map, bytes);
+        return false;
+    }
+
+    header_ = header;
+    mapBytes_ = bytes;
+    name_ = name;
+    owner_ = false;
+    data_[SEND] = reinterpret_cast<float*>(static_cast<uint8_t*>(map) + headerBytes());
+    data_[RETURN] = data_[SEND] + static_cast<size_t>(header->ringFrames) * header->sendChannels;
+
+    resetConsumer(RETURN);
+    header_->pluginActive.fetch_add(1);
+    return true;
+}
+
+void ShmBridge::close() {
+    if (!header_) {
+        return;
+    }
+
+    if (owner_) {
+        header_->appPid.store(0);
+        // Solo si el nombre sigue apuntando a este segmento: un create()
+        // posterior (otra instancia del puente) puede haberlo sustituido
+        int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+        if (fd >= 0) {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_ino == inode_) {
+                shm_unlink(name_.c_str());
+            }
+            ::close(fd);
+        }
+        std::cout << "[ShmBridge] Closed " << name_ << ". Underruns send/return: "
+                  << header_->underruns[SEND].load() << "/" << header_->underruns[RETURN].load()
+                  << std::endl;
+    } else {
+        header_->pluginActive.fetch_sub(1);
+    }
+
+    munmap(header_, mapBytes_);
+    header_ = nullptr;
+    data_[SEND] = data_[RETURN] = nullptr;
+    mapBytes_ = 0;
+    owner_ = false;
+}
+
+bool ShmBridge::isAlive() const {
+    if (!header_) {
+        return false;
+    }
+    const pid_t pid = static_cast<pid_t>(header_->appPid.load());
+    return pid != 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+bool ShmBridge::hasPeer() const {
+    if (!header_) {
+        return false;
+    }
+    return owner_ ? header_->pluginActive.load(std::memory_order_relaxed) > 0
+                  : header_->appPid.load(std::memory_order_relaxed) != 0;
+}
+
+int ShmBridge::channels(RingId ring) const {
+    if (!header_) {
+        return 0;
+    }
+    return static_cast<int>(ring == SEND ? header_->sendChannels : header_->returnChannels);
+}
+
+size_t ShmBridge::fillFrames(RingId ring) const {
+    if (!header_) {
+        return 0;
+    }
+    const RingIndices& r = header_->rings[ring];
+    return r.write.load(std::memory_order_acquire) - r.read.load(std::memory_order_acquire);
+}
+
+void ShmBridge::setPipelineLatency(size_t frames) {
+    pipelineFrames_ = frames;
+    if (header_ && owner_) {
+        header_->reportedLatency.store(static_cast<uint32_t>(2 * header_->latencyFrames.load() + frames));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Productor
+// ═══════════════════════════════════════════════════════════════════════════
+
+size_t ShmBridge::writeInterleaved(RingId ring, const float* src, int srcChannels,
+                                   int channelOffset, size_t frames) {
+    if (!header_ || !src) {
+        return 0;
+    }
+
+    RingIndices& r = header_->rings[ring];
+    const size_t ringFrames = header_->ringFrames;
+    const uint32_t mask = header_->ringFrames - 1;
+    const int ch = channels(ring);
+    const uint32_t w = r.write.load(std::memory_order_relaxed);
+    const size_t space = ringFrames - (w - r.read.load(std::memory_order_acquire));
+    const size_t n = std::min(frames, space);
+    if (n < frames) {
+        header_->overflows[ring].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    float* data = data_[ring];
+    for (size_t i = 0; i < n; i++) {
+        float* out = data + ((w + static_cast<uint32_t>(i)) & mask) * ch;
+        const float* in = src + i * srcChannels;
+        for (int c = 0; c < ch; c++) {
+            const int sc = channelOffset + c;
+            out[c] = sc < srcChannels ? in[sc] : 0.0f;
+        }
+    }
+
+    r.write.store(w + static_cast<uint32_t>(n), std::memory_order_release);
+    if (ring == RETURN) {
+        header_->appFrames.fetch_add(n, std::memory_order_relaxed);
+    }
+    return n;
+}
+
+size_t ShmBridge::writePlanar(RingId ring, const float* const* src, size_t frames) {
+    if (!header_ || !src) {
+        return 0;
+    }
+
+    RingIndices& r = header_->rings[ring];
+    const size_t ringFrames = header_->ringFrames;
+    const uint32_t mask = header_->ringFrames - 1;
+    const int ch = channels(ring);
+    const uint32_t w = r.write.load(std::memory_order_relaxed);
+    const size_t space = ringFrames - (w - r.read.load(std::memory_order_acquire));
+    const size_t n = std::min(frames, space);
+    if (n < frames) {
+        header_->overflows[ring].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    float* data = data_[ring];
+    for (size_t i = 0; i < n; i++) {
+        float* out = data + ((w + static_cast<uint32_t>(i)) & mask) * ch;
+        for (int c = 0; c < ch; c++) {
+            out[c] = src[c] ? src[c][i] : 0.0f;
+        }
+    }
+
+    r.write.store(w + static_cast<uint32_t>(n), std::memory_order_release);
+    return n;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Consumidor - cebado, underruns y corrección de deriva
+// ═══════════════════════════════════════════════════════════════════════════
+
+void ShmBridge::resetConsumer(RingId ring) {
+    if (!header_) {
+        return;
+    }
+    RingIndices& r = header_->rings[ring];
+    r.read.store(r.write.load(std::memory_order_acquire), std::memory_order_release);
+    primed_[ring] = false;
+}
+
+size_t ShmBridge::beginRead(RingId ring, size_t frames) {
+    RingIndices& r = header_->rings[ring];
+    const size_t ringFrames = header_->ringFrames;
+    const size_t target = header_->latencyFrames.load(std::memory_order_relaxed);
+    const uint32_t w = r.write.load(std::memory_order_acquire);
+    uint32_t rd = r.read.load(std::memory_order_relaxed);
+    size_t fill = w - rd;
+
+    if (fill > ringFrames) {
+        // Índices incoherentes (productor reiniciado): volver a cebar
+        r.read.store(w, std::memory_order_release);
+        primed_[ring] = false;
+        return 0;
+    }
+
+    if (!primed_[ring]) {
+        if (fill < std::max(target, frames)) {
+            return 0;
+        }
+        primed_[ring] = true;
+    }
+
+    if (fill < frames) {
+        header_->underruns[ring].fetch_add(1, std::memory_order_relaxed);
+        primed_[ring] = false;
+        return 0;
+    }
+
+    // Relojes distintos a cada lado: si lo acumulado se aleja del objetivo
+    // más de dos veces el margen, descartar lo más antiguo hasta el objetivo
+    const size_t limit = target + 2 * std::max(target, frames);
+    if (fill > limit) {
+        rd += static_cast<uint32_t>(fill - target);
+        r.read.store(rd, std::memory_order_release);
+        header_->skips[ring].fetch_add(1, std::memory_order_relaxed);
+        if (target < frames) {
+            primed_[ring] = false;
+            return 0;
+        }
+    }
+    return frames;
+}
+
+size_t ShmBridge::readInterleaved(RingId ring, float* dst, int dstChannels,
+                                  int channelOffset, size_t frames, bool mix) {
+    if (!header_ || !dst || beginRead(ring, frames) == 0) {
+        return 0;
+    }
+
+    RingIndices& r = header_->rings[ring];
+    const uint32_t mask = header_->ringFrames - 1;
+    const int ch = channels(ring);
+    const int last = std::min(ch, dstChannels - channelOffset);
+    const uint32_t rd = r.read.load(std::memory_order_relaxed);
+
+    const float* data = data_[ring];
+    for (size_t i = 0; i < frames; i++) {
+        const float* in = data + ((rd + static_cast<uint32_t>(i)) & mask) * ch;
+        float* out = dst + i * dstChannels + channelOffset;
+        for (int c = 0; c < last; c++) {
+            out[c] = mix ? out[c] + in[c] : in[c];
+        }
+    }
+
+    r.read.store(rd + static_cast<uint32_t>(frames), std::memory_order_release);
+    return frames;
+}
+
+size_t ShmBridge::readPlanar(RingId ring, float* const* dst, size_t frames) {
+    const int ch = channels(ring);
+    if (!header_ || !dst || beginRead(ring, frames) == 0) {
+        for (int c = 0; c < ch; c++) {
+            if (dst && dst[c]) {
+                std::memset(dst[c], 0, frames * sizeof(float));
+            }
+        }
+        return 0;
+    }
+
+    RingIndices& r = header_->rings[ring];
+    const uint32_t mask = header_->ringFrames - 1;
+    const uint32_t rd = r.read.load(std::memory_order_relaxed);
+
+    const float* data = data_[ring];
+    for (size_t i = 0; i < frames; i++) {
+        const float* in = data + ((rd + static_cast<uint32_t>(i)) & mask) * ch;
+        for (int c = 0; c < ch; c++) {
+            if (dst[c]) {
+                dst[c][i] = in[c];
+            }
+        }
+    }
+
+    r.read.store(rd + static_cast<uint32_t>(frames), std::memory_order_release);
+    return frames;
+}
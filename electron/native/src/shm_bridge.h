@@ -0,0 +1,126 @@
+/**
+ * ShmBridge - Rings de audio en memoria compartida POSIX para el plugin LV2
+ *
+ * Conecta una instancia en marcha de SynthiGME con el plugin
+ * `synthigme-bridge.lv2` dentro de un DAW sin pasar por el grafo PipeWire:
+ *
+ *   DAW (plugin) ── envío ──→ shm ──→ stream de entrada (se suma a la captura)
+ *   DAW (plugin) ←─ retorno ── shm ←── stream de salida (copia de lo entregado)
+ *
+ * La app crea el segmento (`create`, propietaria: lo borra al cerrar) y el
+ * plugin lo abre (`open`). Cada ring es SPSC de frames intercalados con
+ * índices libres uint32 (fill = write − read); sin locks ni reservas en los
+ * hilos de audio. El consumidor de cada ring (app: envío, plugin: retorno)
+ * se ceba hasta latencyFrames antes de leer, vuelve a cebarse tras un
+ * underrun y salta al objetivo si la deriva entre relojes acumula demasiado.
+ *
+ * Sin dependencias de PipeWire ni N-API: el plugin LV2 compila este mismo
+ * archivo (ver lv2/).
+ */
+
+#ifndef SHM_BRIDGE_H
+#define SHM_BRIDGE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class ShmBridge {
+public:
+    static constexpr uint32_t MAGIC = 0x53474252;  // 'SGBR'
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int MAX_CHANNELS = 8;
+    static constexpr const char* DEFAULT_NAME = "/synthigme-bridge";
+
+    enum RingId { SEND = 0, RETURN = 1 };
+
+    // Índices de un ring (cada uno en su línea de caché)
+    struct RingIndices {
+        alignas(64) std::atomic<uint32_t> write;
+        alignas(64) std::atomic<uint32_t> read;
+    };
+
+    // Cabecera del segmento. magic se publica el último (release).
+    struct Header {
+        std::atomic<uint32_t> magic;
+        uint32_t version;
+        uint32_t sampleRate;
+        uint32_t sendChannels;
+        uint32_t returnChannels;
+        uint32_t ringFrames;
+        std::atomic<uint32_t> latencyFrames;     // Objetivo de cebado de ambos consumidores
+        std::atomic<uint32_t> reportedLatency;   // Ida y vuelta que el plugin informa al host
+        std::atomic<uint32_t> appPid;            // 0 = la app cerró el puente
+        std::atomic<uint32_t> pluginActive;      // Instancias del plugin conectadas
+        std::atomic<uint64_t> appFrames;         // Frames de retorno publicados (latido)
+        std::atomic<uint32_t> underruns[2];      // Por ring, contados por su consumidor
+        std::atomic<uint32_t> overflows[2];      // Por ring, contados por su productor
+        std::atomic<uint32_t> skips[2];          // Saltos por deriva
+        RingIndices rings[2];
+    };
+
+    ShmBridge() = default;
+    ~ShmBridge();
+
+    ShmBridge(const ShmBridge&) = delete;
+    ShmBridge& operator=(const ShmBridge&) = delete;
+
+    // Lado app: crea (o recrea) el segmento. latencyFrames se limita a
+    // ringFrames / 4 para dejar margen a quantums distintos a cada lado.
+    bool create(const std::string& name, int sampleRate, int sendChannels,
+                int returnChannels, size_t ringFrames, size_t latencyFrames);
+    // Lado plugin: abre un segmento existente y valida la cabecera
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+    bool isOwner() const { return owner_; }
+    // La app sigue viva (el plugin lo comprueba para volver a conectar)
+    bool isAlive() const;
+    // Hay alguien al otro lado (app: algún plugin conectado; plugin: la app
+    // no ha cerrado el puente). Sin par no se escribe: no hay quien consuma.
+    bool hasPeer() const;
+
+    const Header* header() const { return header_; }
+    int sampleRate() const { return header_ ? static_cast<int>(header_->sampleRate) : 0; }
+    int channels(RingId ring) const;
+    size_t ringFrames() const { return header_ ? header_->ringFrames : 0; }
+    size_t fillFrames(RingId ring) const;
+
+    // Ida y vuelta que informa el plugin: cebado de ambos rings + lo que la
+    // app declare de su propio camino (Web Audio, SAB, prebuffer)
+    void setPipelineLatency(size_t frames);
+
+    // ─── Productor ───────────────────────────────────────────────────────────
+    // Intercalado: canales [channelOffset, channelOffset + ring) de src
+    // (los que falten se escriben a 0). Sin hueco: se descarta y se cuenta.
+    size_t writeInterleaved(RingId ring, const float* src, int srcChannels,
+                            int channelOffset, size_t frames);
+    // Planar (puertos LV2): src[ch] para cada canal del ring (nullptr = 0)
+    size_t writePlanar(RingId ring, const float* const* src, size_t frames);
+
+    // ─── Consumidor ──────────────────────────────────────────────────────────
+    // Suma (mix) o copia en los canales [channelOffset, ...) de dst. Si no
+    // hay datos (cebando o underrun) deja dst intacto y devuelve 0.
+    size_t readInterleaved(RingId ring, float* dst, int dstChannels,
+                           int channelOffset, size_t frames, bool mix);
+    // Planar: escribe dst[ch] entero (silencio si no hay datos)
+    size_t readPlanar(RingId ring, float* const* dst, size_t frames);
+    // El consumidor descarta lo pendiente y vuelve a cebar (al (re)conectar)
+    void resetConsumer(RingId ring);
+
+private:
+    // Frames legibles ya cebados (0 = nada que leer este ciclo)
+    size_t beginRead(RingId ring, size_t frames);
+
+    Header* header_ = nullptr;
+    float* data_[2] = { nullptr, nullptr };
+    size_t mapBytes_ = 0;
+    std::string name_;
+    bool owner_ = false;
+    unsigned long inode_ = 0;            // Segmento creado (close() no borra uno ajeno)
+    bool primed_[2] = { false, false };  // Estado del consumidor (un solo hilo)
+    size_t pipelineFrames_ = 0;
+};
+
+#endif // SHM_BRIDGE_H
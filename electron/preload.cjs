@@ -9,6 +9,9 @@
  * - oscAPI: comunicación OSC peer-to-peer
  * - multichannelAPI: audio multicanal 12ch OUTPUT via PipeWire con SharedArrayBuffer
  * - multichannelInputAPI: audio multicanal 8ch INPUT via PipeWire con SharedArrayBuffer
+ * - nativeBridgeAPI: procesadores DSP nativos dentro del grafo Web Audio (SAB)
+ * - phosphorScopeAPI: rasterizador nativo del osciloscopio con persistencia (SAB)
+ * - audioHealthAPI: agregados de salud del audio nativo por sesión (telemetría)
  * 
  * @see /OSC.md - Documentación del protocolo OSC
  */
@@ -96,6 +99,31 @@ window.oscAPI = {
 let nativeAudio = null;
 let nativeStream = null;
 
+// Listeners de transiciones de estado de los streams nativos (error,
+// recuperación automática tras un reinicio de PipeWire). Se sueltan al cerrar.
+const streamStateListeners = { output: new Set(), input: new Set() };
+
+function watchStreamState(stream, direction) {
+  stream.onStateChange?.((event) => {
+    if (event.state === 'recovering') {
+      console.warn(`[Preload] ${direction} stream lost, recovering:`, event.error);
+    }
+    restoreLinksAfterRecovery(event);
+    for (const listener of streamStateListeners[direction]) {
+      try {
+        listener(event);
+      } catch (e) {
+        console.error('[Preload] stream state listener error:', e);
+      }
+    }
+  });
+}
+
+function addStreamStateListener(direction, callback) {
+  streamStateListeners[direction].add(callback);
+  return () => streamStateListeners[direction].delete(callback);
+}
+
 try {
   const addonPaths = [
     path.join(__dirname, 'native/build/Release/pipewire_audio.node'),
@@ -133,6 +161,17 @@ window.multichannelAPI = {
     return ipcRenderer.invoke('multichannel:check');
   },
   
+  /**
+   * Abre el stream de salida PipeWire.
+   * @param {Object} config - { sampleRate, channels, driverMode, catchUp, renderAhead, name, channelNames, description }
+   *   Con channels = 2 el addon usa posiciones FL/FR (estéreo nativo, se enlaza
+   *   solo con el sink por defecto); name/channelNames/description son opcionales.
+   *   renderAhead = { processor, blocks, params }: un hilo nativo ejecuta el
+   *   procesador sobre la mezcla del SAB con `blocks` bloques de 128 frames de
+   *   margen (esa es la latencia informada en lugar del prebuffer).
+   *   catchUp = true: si la latencia supera el ring se descarta audio hasta
+   *   volver al prebuffer (audible); por defecto solo se cuenta el desborde.
+   */
   open: (config) => {
     if (nativeAudio && !nativeStream) {
       try {
@@ -140,7 +179,10 @@ window.multichannelAPI = {
         const channels = config?.channels || 8;
         const bufferSize = 256;
         
-        nativeStream = new nativeAudio.PipeWireAudio('SynthiGME', channels, sampleRate, bufferSize);
+        nativeStream = new nativeAudio.PipeWireAudio(
+          config?.name || 'SynthiGME', channels, sampleRate, bufferSize,
+          'output', config?.channelNames || '', config?.description || ''
+        );
         
         // Aplicar configuración de latencia si existe
         const latencyConfig = window._multichannelLatencyConfig;
@@ -152,6 +194,31 @@ window.multichannelAPI = {
           console.log(`[Preload] Latency applied: ${prebufferFrames} frames (${latencyConfig.prebufferMs}ms)`);
         }
         
+        // Modo driver: SynthiGME marca el reloj del grafo PipeWire
+        if (config?.driverMode) {
+          nativeStream.setDriverMode(true);
+          console.log('[Preload] Driver mode enabled (SynthiGME as graph clock)');
+        }
+        
+        // Catch-up: recorta la latencia acumulada por deriva de relojes
+        if (config?.catchUp) {
+          nativeStream.setCatchUp(true);
+          console.log('[Preload] Latency catch-up enabled');
+        }
+        
+        // Render-ahead: DSP nativo en un hilo productor, on_process solo copia
+        if (config?.renderAhead?.processor) {
+          const { processor, blocks = 4, params = {} } = config.renderAhead;
+          if (nativeStream.setRenderAhead(processor, blocks)) {
+            for (const [name, value] of Object.entries(params)) {
+              nativeStream.setRenderAheadParam(name, value);
+            }
+            console.log(`[Preload] Render-ahead enabled: ${processor}, ${blocks} blocks`);
+          }
+        }
+        
+        watchStreamState(nativeStream, 'output');
+        attachPluginBridge(nativeStream, 'output');
         const started = nativeStream.start();
         
         if (!started) {
@@ -170,7 +237,9 @@ window.multichannelAPI = {
             channels, 
             direct: true,
             latencyMs: parseFloat(actualLatencyMs),
-            prebufferFrames: actualPrebuffer
+            prebufferFrames: actualPrebuffer,
+            driverMode: nativeStream.driverMode,
+            renderAhead: nativeStream.renderAhead
           }
         });
       } catch (e) {
@@ -184,8 +253,12 @@ window.multichannelAPI = {
   /**
    * Adjunta un SharedArrayBuffer - pasamos un Int32Array que lo envuelve
    * porque N-API no puede detectar SharedArrayBuffer directamente
+   * @param {SharedArrayBuffer} sharedBuffer
+   * @param {number} bufferFrames
+   * @param {number} [packetSlots=0] - Descriptores con marca de tiempo tras el
+   *   audio (formato empaquetado, ver sab_packets.h). 0 = solo frames.
    */
-  attachSharedBuffer: (sharedBuffer, bufferFrames) => {
+  attachSharedBuffer: (sharedBuffer, bufferFrames, packetSlots = 0) => {
     console.log('[Preload] attachSharedBuffer called, type:', sharedBuffer?.constructor?.name, 'frames:', bufferFrames);
     if (nativeStream && sharedBuffer instanceof SharedArrayBuffer) {
       try {
@@ -193,7 +266,7 @@ window.multichannelAPI = {
         // El addon C++ extraerá el buffer subyacente del TypedArray
         const wrapper = new Int32Array(sharedBuffer);
         console.log('[Preload] Passing Int32Array wrapper, length:', wrapper.length);
-        const success = nativeStream.attachSharedBuffer(wrapper, bufferFrames);
+        const success = nativeStream.attachSharedBuffer(wrapper, bufferFrames, packetSlots);
         console.log('[Preload] attachSharedBuffer:', success ? 'OK - LOCK-FREE MODE!' : 'FAILED');
         return success;
       } catch (e) {
@@ -205,6 +278,33 @@ window.multichannelAPI = {
     return false;
   },
   
+  /**
+   * Adjunta una palabra de notificación para productores fuera del worklet.
+   * El addon incrementa controlBuffer[wordIndex] y llama a Atomics.notify
+   * cada vez que libera watermarkFrames de espacio en el SAB de salida.
+   * @param {SharedArrayBuffer} notifyBuffer - SAB dedicado (Int32)
+   * @param {number} wordIndex - Índice Int32 de la palabra de secuencia
+   * @param {number} [watermarkFrames] - Frames por despertar (default: quantum)
+   * @returns {boolean}
+   */
+  attachNotifyBuffer: (notifyBuffer, wordIndex, watermarkFrames) => {
+    if (nativeStream && notifyBuffer instanceof SharedArrayBuffer) {
+      try {
+        return nativeStream.attachNotifyBuffer(new Int32Array(notifyBuffer), wordIndex, watermarkFrames);
+      } catch (e) {
+        console.error('[Preload] attachNotifyBuffer error:', e);
+        return false;
+      }
+    }
+    return false;
+  },
+  
+  detachNotifyBuffer: () => {
+    if (nativeStream?.hasNotifyBuffer) {
+      nativeStream.detachNotifyBuffer();
+    }
+  },
+  
   write: (audioData) => {
     if (nativeStream) {
       // Asegurar que sea Float32Array
@@ -227,17 +327,29 @@ window.multichannelAPI = {
   
   close: () => {
     if (nativeStream) {
+      if (nativeStream.hasNotifyBuffer) {
+        nativeStream.detachNotifyBuffer();
+      }
       if (nativeStream.hasSharedBuffer) {
         nativeStream.detachSharedBuffer();
       }
+      nativeStream.detachPluginBridge?.();
       nativeStream.stop();
+      nativeStream.onStateChange?.(null);
       nativeStream = null;
+      streamStateListeners.output.clear();
       console.log('[Preload] Native stream stopped');
       return Promise.resolve();
     }
     return ipcRenderer.invoke('multichannel:close');
   },
   
+  /**
+   * Kernels DSP con los que se compiló el addon
+   * @returns {string|null} 'neon', 'scalar' o null sin addon
+   */
+  getKernels: () => nativeAudio?.audioKernels || null,
+  
   /**
    * Configura la latencia del stream (debe llamarse ANTES de open())
    * @param {number} prebufferMs - Latencia en milisegundos (5-200)
@@ -260,6 +372,25 @@ window.multichannelAPI = {
     return true;
   },
   
+  /**
+   * Transiciones de estado del stream de salida. Si PipeWire falla o se
+   * reinicia, el addon reconecta solo (backoff exponencial) conservando SAB
+   * y configuración: recibirás 'recovering' y luego 'streaming' con recoveryMs.
+   * @param {Function} callback - callback({ state, error, recovering, recoveries, recoveryMs })
+   * @returns {Function} Función para eliminar el listener
+   */
+  onStateChange: (callback) => addStreamStateListener('output', callback),
+  
+  /**
+   * Parámetro del procesador render-ahead (se aplica entre bloques).
+   * @param {string} name
+   * @param {number} value
+   * @returns {boolean} false sin render-ahead o si el procesador no lo conoce
+   */
+  setRenderAheadParam: (name, value) => {
+    return nativeStream?.renderAhead ? nativeStream.setRenderAheadParam(name, value) : false;
+  },
+  
   getInfo: () => {
     if (nativeStream) {
       const sampleRate = nativeStream.sampleRate || 48000;
@@ -272,6 +403,24 @@ window.multichannelAPI = {
         silentUnderflows: nativeStream.silentUnderflows,
         bufferedFrames: nativeStream.bufferedFrames,
         hasSharedBuffer: nativeStream.hasSharedBuffer,
+        notifyCount: nativeStream.notifyCount,
+        driverMode: nativeStream.driverMode,
+        driverTriggers: nativeStream.driverTriggers,
+        driverStalls: nativeStream.driverStalls,
+        catchUp: nativeStream.catchUp,
+        renderAhead: nativeStream.renderAhead,
+        renderAheadFrames: nativeStream.renderAheadFrames,
+        renderedBlocks: nativeStream.renderedBlocks,
+        renderSpikes: nativeStream.renderSpikes,
+        maxRenderUs: nativeStream.maxRenderUs,
+        renderDenormals: nativeStream.renderDenormals,
+        flushDenormals: nativeStream.flushDenormals,
+        packets: nativeStream.getPacketStats?.() ?? null,
+        state: nativeStream.state,
+        lastError: nativeStream.lastError,
+        recovering: nativeStream.recovering,
+        recoveries: nativeStream.recoveries,
+        lastRecoveryMs: nativeStream.lastRecoveryMs,
         prebufferFrames: prebufferFrames,
         prebufferMs: parseFloat(prebufferMs),
         sampleRate: sampleRate,
@@ -305,7 +454,8 @@ window.multichannelInputAPI = {
   
   /**
    * Abre un stream de captura PipeWire con 8 canales (input_amp_1..8)
-   * @param {Object} config - { sampleRate, channels }
+   * o estéreo (channels = 2, se enlaza solo con el source por defecto)
+   * @param {Object} config - { sampleRate, channels, name, description }
    */
   open: (config) => {
     if (nativeAudio && !nativeInputStream) {
@@ -314,14 +464,16 @@ window.multichannelInputAPI = {
         const channels = config?.channels || 8;
         const bufferSize = 256;
         const direction = 'input';
-        const channelNames = '';  // Usa los nombres por defecto del addon (input_amp_1..8)
-        const description = 'SynthiGME Multichannel Input';
+        const channelNames = '';  // Usa los nombres por defecto del addon (input_amp_1..8 / FL,FR)
+        const description = config?.description || 'SynthiGME Multichannel Input';
         
         nativeInputStream = new nativeAudio.PipeWireAudio(
-          'SynthiGME-Input', channels, sampleRate, bufferSize,
+          config?.name || 'SynthiGME-Input', channels, sampleRate, bufferSize,
           direction, channelNames, description
         );
         
+        watchStreamState(nativeInputStream, 'input');
+        attachPluginBridge(nativeInputStream, 'input');
         const started = nativeInputStream.start();
         
         if (!started) {
@@ -376,13 +528,88 @@ window.multichannelInputAPI = {
     return false;
   },
   
+  /**
+   * Adjunta una palabra de notificación para consumidores fuera del worklet
+   * (grabador o analizador en un Web Worker). Tras cada watermarkFrames de
+   * audio capturado, el addon incrementa controlBuffer[wordIndex] y llama a
+   * Atomics.notify, de modo que el worker puede bloquear con
+   * Atomics.wait(control, wordIndex, lastSeq) sin sondear.
+   * @param {SharedArrayBuffer} notifyBuffer - SAB dedicado (Int32)
+   * @param {number} wordIndex - Índice Int32 de la palabra de secuencia
+   * @param {number} [watermarkFrames] - Frames por despertar (default: quantum)
+   * @returns {boolean}
+   */
+  attachNotifyBuffer: (notifyBuffer, wordIndex, watermarkFrames) => {
+    if (nativeInputStream && notifyBuffer instanceof SharedArrayBuffer) {
+      try {
+        return nativeInputStream.attachNotifyBuffer(new Int32Array(notifyBuffer), wordIndex, watermarkFrames);
+      } catch (e) {
+        console.error('[Preload] Input attachNotifyBuffer error:', e);
+        return false;
+      }
+    }
+    return false;
+  },
+  
+  detachNotifyBuffer: () => {
+    if (nativeInputStream?.hasNotifyBuffer) {
+      nativeInputStream.detachNotifyBuffer();
+    }
+  },
+  
+  /**
+   * Acondicionamiento nativo de la captura (DC, ganancia, recortes).
+   * Se aplica en la misma pasada que escribe el SAB.
+   * @param {Object} config - { dcCutoffHz, clipThreshold, gainSmoothingMs, gain?, gains? }
+   * @returns {boolean}
+   */
+  setConditioning: (config) => {
+    if (!nativeInputStream) return false;
+    nativeInputStream.setInputConditioning(
+      config?.dcCutoffHz ?? 0, config?.clipThreshold ?? 0.999, config?.gainSmoothingMs ?? 20
+    );
+    if (typeof config?.gain === 'number') {
+      nativeInputStream.setInputGain(-1, config.gain);
+    }
+    (config?.gains || []).forEach((gain, ch) => nativeInputStream.setInputGain(ch, gain));
+    return true;
+  },
+  
+  /**
+   * Ganancia de un canal de entrada (lineal, suavizada en el addon).
+   * @param {number} channel - 0-7 (-1 = todos)
+   * @param {number} gain
+   */
+  setInputGain: (channel, gain) => {
+    nativeInputStream?.setInputGain(channel, gain);
+  },
+  
+  /**
+   * Picos desde la última llamada y recortes acumulados por canal.
+   * @returns {{ peaks: number[], clips: number[] } | null}
+   */
+  getLevels: () => (nativeInputStream ? nativeInputStream.getInputLevels() : null),
+  
+  /**
+   * Transiciones de estado del stream de captura (ver multichannelAPI.onStateChange).
+   * @param {Function} callback - callback({ state, error, recovering, recoveries, recoveryMs })
+   * @returns {Function} Función para eliminar el listener
+   */
+  onStateChange: (callback) => addStreamStateListener('input', callback),
+  
   close: () => {
     if (nativeInputStream) {
+      if (nativeInputStream.hasNotifyBuffer) {
+        nativeInputStream.detachNotifyBuffer();
+      }
       if (nativeInputStream.hasSharedBuffer) {
         nativeInputStream.detachSharedBuffer();
       }
+      nativeInputStream.detachPluginBridge?.();
       nativeInputStream.stop();
+      nativeInputStream.onStateChange?.(null);
       nativeInputStream = null;
+      streamStateListeners.input.clear();
       console.log('[Preload] Native input stream stopped');
       return Promise.resolve();
     }
@@ -399,6 +626,12 @@ window.multichannelInputAPI = {
         silentUnderflows: nativeInputStream.silentUnderflows,
         bufferedFrames: nativeInputStream.bufferedFrames,
         hasSharedBuffer: nativeInputStream.hasSharedBuffer,
+        notifyCount: nativeInputStream.notifyCount,
+        state: nativeInputStream.state,
+        lastError: nativeInputStream.lastError,
+        recovering: nativeInputStream.recovering,
+        recoveries: nativeInputStream.recoveries,
+        lastRecoveryMs: nativeInputStream.lastRecoveryMs,
         sampleRate: sampleRate,
         direct: true,
         direction: 'input'
@@ -407,3 +640,406 @@ window.multichannelInputAPI = {
     return Promise.resolve(null);
   }
 };
+
+// ─────────────────────────────────────────────────────────────────────────────
+// API del Bridge de Procesadores Nativos
+// Ejecuta un procesador C++ dentro del grafo Web Audio
+// Flujo: nodo → nativeBridge.worklet → SAB → C++ → SAB → worklet → grafo
+// ─────────────────────────────────────────────────────────────────────────────
+
+const nativeBridges = new Map();
+let nextBridgeId = 1;
+
+window.nativeBridgeAPI = {
+  isAvailable: () => Boolean(nativeAudio?.NativeProcessorBridge) && typeof SharedArrayBuffer !== 'undefined',
+  
+  /**
+   * Tipos de procesador registrados en el addon
+   * @returns {string[]}
+   */
+  listProcessors: () => (nativeAudio?.nativeProcessorTypes ? [...nativeAudio.nativeProcessorTypes] : []),
+  
+  /**
+   * Crea un procesador nativo, le adjunta el SAB y arranca su hilo.
+   * @param {string} type - Tipo registrado (ver listProcessors)
+   * @param {SharedArrayBuffer} sharedBuffer - SAB creado por NativeBridgeNode
+   * @param {Object} config - { inputs, outputs, sampleRate, ringFrames }
+   * @returns {{ success: boolean, id?: number, error?: string }}
+   */
+  create: (type, sharedBuffer, config) => {
+    if (!nativeAudio?.NativeProcessorBridge) {
+      return { success: false, error: 'Native audio not available' };
+    }
+    if (!(sharedBuffer instanceof SharedArrayBuffer)) {
+      return { success: false, error: 'Invalid shared buffer' };
+    }
+    try {
+      const bridge = new nativeAudio.NativeProcessorBridge(
+        type, config?.inputs ?? 1, config?.outputs ?? 1, config?.sampleRate || 48000
+      );
+      if (!bridge.attachSharedBuffer(new Int32Array(sharedBuffer), config?.ringFrames)) {
+        return { success: false, error: 'Failed to attach shared buffer' };
+      }
+      if (!bridge.start()) {
+        return { success: false, error: 'Failed to start bridge thread' };
+      }
+      const id = nextBridgeId++;
+      nativeBridges.set(id, bridge);
+      console.log(`[Preload] Native bridge #${id} started (${type})`);
+      return { success: true, id };
+    } catch (e) {
+      return { success: false, error: e.message };
+    }
+  },
+  
+  setParam: (id, name, value) => {
+    const bridge = nativeBridges.get(id);
+    return bridge ? bridge.setParam(name, value) : false;
+  },
+  
+  /**
+   * Programa un parámetro en un frame del AudioContext (precisión de muestra).
+   * @param {number} id
+   * @param {string} name
+   * @param {number} value
+   * @param {number} frame - Frame absoluto (ctx.currentTime × sampleRate)
+   * @returns {boolean} false si el parámetro no admite eventos o la cola está llena
+   */
+  scheduleParam: (id, name, value, frame) => {
+    const bridge = nativeBridges.get(id);
+    return bridge ? bridge.scheduleParam(name, value, frame) : false;
+  },
+  
+  /**
+   * Datos en bloque para el procesador (snapshots, tablas).
+   * @param {number} id
+   * @param {string} name
+   * @param {Float32Array} data
+   * @returns {boolean}
+   */
+  setData: (id, name, data) => {
+    const bridge = nativeBridges.get(id);
+    return bridge ? bridge.setData(name, data) : false;
+  },
+  
+  /**
+   * Empieza a grabar los eventos de parámetros con marca de muestra.
+   * @param {number} id
+   * @param {number} frame - Frame del AudioContext al empezar
+   * @param {number} [maxBytes] - Capacidad del registro (1 MB por defecto)
+   */
+  startRecording: (id, frame, maxBytes) => {
+    nativeBridges.get(id)?.startRecording(frame, maxBytes);
+  },
+  
+  /**
+   * @param {number} id
+   * @returns {{ startFrame: number, events: number, dropped: number,
+   *   data: ArrayBuffer, params: string[] } | null}
+   */
+  stopRecording: (id) => {
+    const bridge = nativeBridges.get(id);
+    return bridge ? bridge.stopRecording() : null;
+  },
+  
+  /**
+   * Reproduce un registro desde un frame del AudioContext.
+   * @param {number} id
+   * @param {Uint8Array} data - Eventos codificados (ver stopRecording)
+   * @param {number} frame
+   * @returns {boolean}
+   */
+  startPlayback: (id, data, frame) => {
+    const bridge = nativeBridges.get(id);
+    return bridge ? bridge.startPlayback(data, frame) : false;
+  },
+  
+  stopPlayback: (id) => {
+    nativeBridges.get(id)?.stopPlayback();
+  },
+  
+  getStats: (id) => {
+    const bridge = nativeBridges.get(id);
+    if (!bridge) return null;
+    return {
+      type: bridge.type,
+      running: bridge.isRunning,
+      processedBlocks: bridge.processedBlocks,
+      overflows: bridge.overflows,
+      underruns: bridge.underruns,
+      latencyFrames: bridge.latencyFrames,
+      avgProcessUs: bridge.avgProcessUs,
+      maxProcessUs: bridge.maxProcessUs,
+      flushDenormals: bridge.flushDenormals,
+      denormals: bridge.denormals,
+      denormalBlocks: bridge.denormalBlocks,
+      appliedEvents: bridge.appliedEvents,
+      droppedEvents: bridge.droppedEvents,
+      recording: bridge.recording,
+      playing: bridge.playing
+    };
+  },
+  
+  destroy: (id) => {
+    const bridge = nativeBridges.get(id);
+    if (bridge) {
+      bridge.stop();
+      nativeBridges.delete(id);
+      console.log(`[Preload] Native bridge #${id} stopped`);
+    }
+  }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// API del Osciloscopio de Fósforo (rasterizador nativo)
+// El addon acumula las trazas con persistencia y publica frames RGBA en un SAB
+// Flujo: scopeCapture → submit() → hilo nativo → SAB → canvas (putImageData)
+// ─────────────────────────────────────────────────────────────────────────────
+
+const phosphorScopes = new Map();
+let nextPhosphorId = 1;
+
+window.phosphorScopeAPI = {
+  isAvailable: () => Boolean(nativeAudio?.PhosphorScope) && typeof SharedArrayBuffer !== 'undefined',
+  
+  /**
+   * Crea un rasterizador, le adjunta el SAB de frames y arranca su hilo.
+   * @param {number} width - Ancho en píxeles (resolución interna del canvas)
+   * @param {number} height - Alto en píxeles
+   * @param {SharedArrayBuffer} frameBuffer - Cabecera Int32 × 8 + 2 frames RGBA
+   * @param {Object} [config] - { fps, color: [r, g, b], persistenceMs, beamEnergy }
+   * @returns {{ success: boolean, id?: number, error?: string }}
+   */
+  create: (width, height, frameBuffer, config) => {
+    if (!nativeAudio?.PhosphorScope) {
+      return { success: false, error: 'Native audio not available' };
+    }
+    if (!(frameBuffer instanceof SharedArrayBuffer)) {
+      return { success: false, error: 'Invalid frame buffer' };
+    }
+    try {
+      const scope = new nativeAudio.PhosphorScope(width, height, config?.fps || 60);
+      if (!scope.attachFrameBuffer(new Int32Array(frameBuffer))) {
+        return { success: false, error: 'Failed to attach frame buffer' };
+      }
+      if (config?.color) scope.setColor(...config.color);
+      if (config?.persistenceMs) scope.setPersistence(config.persistenceMs);
+      if (config?.beamEnergy) scope.setBeamEnergy(config.beamEnergy);
+      if (!scope.start()) {
+        return { success: false, error: 'Failed to start render thread' };
+      }
+      const id = nextPhosphorId++;
+      phosphorScopes.set(id, scope);
+      console.log(`[Preload] Phosphor scope #${id} started (${width}x${height})`);
+      return { success: true, id };
+    } catch (e) {
+      return { success: false, error: e.message };
+    }
+  },
+  
+  /**
+   * Encola una traza X-Y. pixel = (cx + x·sx, cy − y·sy)
+   */
+  submit: (id, bufferX, bufferY, cx, cy, sx, sy) => {
+    phosphorScopes.get(id)?.submit(bufferX, bufferY, cx, cy, sx, sy);
+  },
+  
+  clear: (id) => phosphorScopes.get(id)?.clear(),
+  setColor: (id, r, g, b) => phosphorScopes.get(id)?.setColor(r, g, b),
+  setPersistence: (id, ms) => phosphorScopes.get(id)?.setPersistence(ms),
+  setBeamEnergy: (id, energy) => phosphorScopes.get(id)?.setBeamEnergy(energy),
+  
+  getStats: (id) => {
+    const scope = phosphorScopes.get(id);
+    if (!scope) return null;
+    return {
+      running: scope.isRunning,
+      framesPublished: scope.framesPublished,
+      droppedPoints: scope.droppedPoints,
+      avgRenderUs: scope.avgRenderUs
+    };
+  },
+  
+  destroy: (id) => {
+    const scope = phosphorScopes.get(id);
+    if (scope) {
+      scope.stop();
+      phosphorScopes.delete(id);
+      console.log(`[Preload] Phosphor scope #${id} stopped`);
+    }
+  }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// API de enlaces PipeWire (restauración nativa de conexiones de puertos)
+// El addon escucha el registry y crea los enlaces de las reglas en cuanto
+// aparecen los puertos: los streams quedan conectados en el mismo arranque.
+// Reglas: [{ output: 'nodo:puerto', input: 'nodo:puerto' }] con comodines fnmatch
+// ─────────────────────────────────────────────────────────────────────────────
+
+let linkManager = null;
+
+// Tras un reinicio de PipeWire el manager pierde su conexión (EPIPE): se
+// rearranca cuando un stream vuelve a 'streaming' y reaplica las reglas.
+function restoreLinksAfterRecovery(event) {
+  if (!linkManager || event.state !== 'streaming' || event.recoveries === 0) return;
+  if (linkManager.getStats().connected) return;
+  linkManager.stop();
+  if (linkManager.start()) {
+    console.log('[Preload] PipeWire link manager restarted after recovery');
+  }
+}
+
+window.pipewireLinksAPI = {
+  isAvailable: () => Boolean(nativeAudio?.PipeWireLinkManager),
+  
+  /**
+   * Arranca el manager (idempotente) con las reglas dadas.
+   * @param {Array<{output: string, input: string}>} rules
+   * @returns {{ success: boolean, rules?: number, error?: string }}
+   */
+  start: (rules = []) => {
+    if (!nativeAudio?.PipeWireLinkManager) {
+      return { success: false, error: 'Native audio not available' };
+    }
+    try {
+      linkManager ??= new nativeAudio.PipeWireLinkManager();
+      const count = linkManager.setRules(rules);
+      if (!linkManager.start()) {
+        return { success: false, error: 'Failed to connect to PipeWire' };
+      }
+      return { success: true, rules: count };
+    } catch (e) {
+      return { success: false, error: e.message };
+    }
+  },
+  
+  setRules: (rules) => {
+    try {
+      return linkManager ? linkManager.setRules(rules) : 0;
+    } catch (e) {
+      console.warn('[Preload] setRules failed:', e.message);
+      return 0;
+    }
+  },
+  
+  /**
+   * Enlaces actuales con algún extremo en un nodo que casa con el patrón
+   * (nombres exactos, listos para guardarse como reglas).
+   */
+  snapshot: (nodePattern = 'SynthiGME*') => linkManager?.snapshot(nodePattern) ?? [],
+  
+  /**
+   * Puertos ("nodo:puerto") de los nodos que casan con el patrón, tengan o
+   * no enlaces: los que no aparecen en snapshot() se quedaron sin ruteo.
+   */
+  ports: (nodePattern = 'SynthiGME*') => linkManager?.ports(nodePattern) ?? [],
+  
+  /**
+   * @returns {{ connected, nodes, ports, links, created, failed, pending, lastLinkMs }|null}
+   */
+  getStats: () => (linkManager ? { running: linkManager.isRunning, ...linkManager.getStats() } : null),
+  
+  stop: () => {
+    linkManager?.stop();
+  }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// API del puente LV2 (plugin synthigme-bridge en un DAW)
+// El addon crea un segmento de memoria compartida con dos rings: el stream
+// de salida copia ahí lo que entrega a PipeWire (retorno del plugin) y el de
+// entrada suma a la captura lo que el plugin envía. Se adjunta a los streams
+// abiertos y a los que se abran mientras esté activo.
+// ─────────────────────────────────────────────────────────────────────────────
+
+let pluginBridge = null;
+let pluginBridgeOffsets = { output: 0, input: 0 };
+
+function attachPluginBridge(stream, direction) {
+  if (!pluginBridge?.isOpen || !stream?.attachPluginBridge) return;
+  try {
+    stream.attachPluginBridge(pluginBridge, pluginBridgeOffsets[direction]);
+  } catch (e) {
+    console.warn(`[Preload] attachPluginBridge (${direction}) failed:`, e.message);
+  }
+}
+
+window.pluginBridgeAPI = {
+  isAvailable: () => Boolean(nativeAudio?.PluginBridge),
+  
+  /**
+   * Crea el segmento compartido (recrea si ya existía) y lo adjunta a los streams.
+   * @param {Object} config - { sampleRate, sendChannels, returnChannels, ringFrames,
+   *   latencyFrames, returnOffset, sendOffset, pipelineFrames }
+   *   returnOffset: primer canal de salida que recibe el plugin;
+   *   sendOffset: primer canal de entrada al que se suma el envío.
+   * @returns {{ success: boolean, error?: string }}
+   */
+  start: (config = {}) => {
+    if (!nativeAudio?.PluginBridge) {
+      return { success: false, error: 'Native audio not available' };
+    }
+    try {
+      const {
+        sampleRate = 48000, sendChannels = 2, returnChannels = 2,
+        ringFrames = 8192, latencyFrames = 512,
+        returnOffset = 0, sendOffset = 0, pipelineFrames = 0
+      } = config;
+      pluginBridge ??= new nativeAudio.PluginBridge();
+      pluginBridge.setPipelineLatency(pipelineFrames);
+      if (!pluginBridge.open(sampleRate, sendChannels, returnChannels, ringFrames, latencyFrames)) {
+        return { success: false, error: 'Failed to create shared memory' };
+      }
+      pluginBridgeOffsets = { output: returnOffset, input: sendOffset };
+      attachPluginBridge(nativeStream, 'output');
+      attachPluginBridge(nativeInputStream, 'input');
+      return { success: true };
+    } catch (e) {
+      return { success: false, error: e.message };
+    }
+  },
+  
+  /**
+   * Latencia propia de la app (Web Audio, SAB, prebuffer) que el plugin
+   * suma a la de los rings al informar al host.
+   * @param {number} frames
+   */
+  setPipelineLatency: (frames) => {
+    pluginBridge?.setPipelineLatency(frames);
+  },
+  
+  /**
+   * @returns {{ pluginConnected, latencyFrames, reportedLatency, fillFrames, underruns, overflows, skips }|null}
+   */
+  getStats: () => pluginBridge?.getStats() ?? null,
+  
+  stop: () => {
+    if (!pluginBridge) return;
+    nativeStream?.detachPluginBridge?.();
+    nativeInputStream?.detachPluginBridge?.();
+    pluginBridge.close();
+  }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// API de salud del audio nativo (agregados de sesión para telemetría)
+// El addon acumula por dirección, a través de reaperturas de stream:
+// underflows/overflows, catch-ups, percentiles de latencia y carga del
+// callback, y quantum/rate/formato negociados con PipeWire.
+// ─────────────────────────────────────────────────────────────────────────────
+window.audioHealthAPI = {
+  isAvailable: () => typeof nativeAudio?.getAudioHealth === 'function',
+  
+  /**
+   * @returns {{ output: Object, input: Object }|null} Snapshot de la sesión
+   */
+  getSnapshot: () => {
+    try {
+      return nativeAudio?.getAudioHealth ? nativeAudio.getAudioHealth() : null;
+    } catch (e) {
+      console.warn('[Preload] getAudioHealth failed:', e.message);
+      return null;
+    }
+  }
+};
@@ -11,7 +11,8 @@ import {
   activateMultichannelOutput, activateMultichannelOutputFallback,
   deactivateMultichannelOutput,
   activateMultichannelInput, deactivateMultichannelInput,
-  ensureSystemAudioInput, restoreMultichannelIfSaved
+  ensureSystemAudioInput, restoreMultichannelIfSaved,
+  activateNativeStereoOutput, deactivateNativeStereoOutput, closeNativeStereoInput
 } from './audioSetup.js';
 import {
   buildPanel1, buildPanel2, buildPanel4,
@@ -1005,6 +1006,24 @@ class App {
    */
   async _deactivateMultichannelOutput() { return deactivateMultichannelOutput(this); }
 
+  // ═══════════════════════════════════════════════════════════════════════════
+  // ESTÉREO NATIVO (2 canales via PipeWire) - SOLO ELECTRON + LINUX
+  // ═══════════════════════════════════════════════════════════════════════════
+  // En modo estéreo con el dispositivo por defecto, la salida pasa por un
+  // stream PipeWire de 2 canales en lugar de la pila de audio de Chromium.
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /**
+   * Activa la salida estéreo nativa (PipeWire 2ch) si está disponible.
+   * @returns {Promise<{success: boolean, error?: string}>}
+   */
+  async _activateNativeStereoOutput() { return activateNativeStereoOutput(this); }
+
+  /**
+   * Desactiva la salida estéreo nativa y restaura la salida de Chromium.
+   */
+  async _deactivateNativeStereoOutput() { return deactivateNativeStereoOutput(this); }
+
   // ═══════════════════════════════════════════════════════════════════════════
   // MULTICANAL INPUT (8 canales via PipeWire) - SOLO ELECTRON + LINUX
   // ═══════════════════════════════════════════════════════════════════════════
@@ -1045,6 +1064,7 @@ class App {
       try { this._systemAudioSplitter.disconnect(); } catch (e) {}
       this._systemAudioSplitter = null;
     }
+    closeNativeStereoInput(this);
     this._systemAudioConnected = false;
     log.info('🎤 System audio input disconnected');
   }
@@ -1067,6 +1087,7 @@ class App {
       this._inputRoutingGains.forEach(row => row.forEach(g => g.disconnect()));
       this._inputRoutingGains = null;
     }
+    closeNativeStereoInput(this);
     this._systemAudioConnected = false;
     
     // Reconectar con el nuevo dispositivo
@@ -11,6 +11,9 @@
 import { createLogger } from './utils/logger.js';
 import { attachProcessorErrorHandler } from './utils/audio.js';
 import { STORAGE_KEYS, isMobileDevice } from './utils/constants.js';
+import { inputAmplifierConfig } from './configs/index.js';
+import { startLinkManager, captureLinkRules } from './core/pipewireLinks.js';
+import { startPluginBridge, stopPluginBridge, estimatePipelineFrames } from './core/pluginBridge.js';
 
 const log = createLogger('App');
 
@@ -125,6 +128,35 @@ export async function restoreMultichannelIfSaved(app) {
       app.audioSettingsModal.setOutputMode('stereo', false);
     }
   }
+
+  // Modo estéreo (o multicanal revertido): salida nativa PipeWire 2ch en Linux
+  if (app.audioSettingsModal?.outputMode !== 'multichannel') {
+    const stereoResult = await activateNativeStereoOutput(app);
+    if (stereoResult.success) {
+      log.info('🔊 Native stereo output active (PipeWire 2ch)');
+    }
+  }
+}
+
+/**
+ * Registra en el log las caídas del stream nativo y su recuperación
+ * automática (el addon reconecta solo tras un error o reinicio de PipeWire).
+ * El preload suelta el listener al cerrar el stream.
+ *
+ * @param {object} api - multichannelAPI o multichannelInputAPI
+ * @param {string} prefix - Prefijo de log
+ */
+function logStreamRecovery(api, prefix) {
+  let lost = false;
+  api.onStateChange?.((event) => {
+    if (event.state === 'recovering' && !lost) {
+      lost = true;
+      log.warn(`${prefix} PipeWire stream lost (${event.error}), reconnecting...`);
+    } else if (event.state === 'streaming' && lost) {
+      lost = false;
+      log.info(`${prefix} PipeWire stream recovered in ${event.recoveryMs.toFixed(0)}ms`);
+    }
+  });
 }
 
 /**
@@ -154,6 +186,9 @@ export async function activateMultichannelOutput(app) {
     return { success: false, error: 'AudioContext no inicializado' };
   }
 
+  // El stream de salida nativo es único: liberar el estéreo nativo si está activo
+  await deactivateNativeStereoOutput(app);
+
   // Primero forzar 12 canales en el engine
   const channelLabels = ['1', '2', '3', '4', '5', '6', '7', '8', '9', '10', '11', '12'];
   app.engine.forcePhysicalChannels(12, channelLabels, true);
@@ -167,9 +202,15 @@ export async function activateMultichannelOutput(app) {
     window.multichannelAPI.setLatency(configuredLatencyMs);
   }
 
+  // Modo driver: el stream PipeWire marca el reloj del grafo al ritmo de Web Audio
+  const driverMode = app.audioSettingsModal?.getDriverMode?.() || false;
+
+  // Enlaces guardados: se crean en cuanto aparezcan los puertos del stream
+  startLinkManager();
+
   // Abrir el stream multicanal
   const sampleRate = app.engine.audioCtx?.sampleRate || 48000;
-  const result = await window.multichannelAPI.open({ sampleRate, channels: 12 });
+  const result = await window.multichannelAPI.open({ sampleRate, channels: 12, driverMode });
 
   if (!result.success) {
     app.engine.forcePhysicalChannels(2, ['L', 'R'], false);
@@ -177,13 +218,23 @@ export async function activateMultichannelOutput(app) {
   }
 
   log.info('🎛️ Multichannel stream opened:', result.info);
+  logStreamRecovery(window.multichannelAPI, '🎛️');
 
   const ctx = app.engine.audioCtx;
 
+  // Puente LV2 (opcional): el DAW recibe las salidas y envía a las entradas
+  startPluginBridge({
+    sampleRate,
+    pipelineFrames: estimatePipelineFrames(ctx, result.info?.prebufferFrames)
+  });
+
   // Crear SharedArrayBuffer en el renderer si está disponible
   // Layout: [writeIndex(4), readIndex(4), audioData(frames * 12ch * 4bytes)]
+  // + tabla de paquetes (formato empaquetado: cada bloque lleva su
+  // currentFrame/currentTime; el addon mide latencia real y deriva)
   const SHARED_BUFFER_FRAMES = 8192;  // ~170ms @ 48kHz
   const channels = 12;
+  const PACKET_SLOTS = 2 * SHARED_BUFFER_FRAMES / 128;  // > bloques que caben en el ring
   let sharedBuffer = null;
 
   // DEBUG: Verificar disponibilidad de SharedArrayBuffer
@@ -193,7 +244,8 @@ export async function activateMultichannelOutput(app) {
   if (typeof SharedArrayBuffer !== 'undefined') {
     console.warn('[SAB Debug] SharedArrayBuffer disponible, intentando crear...');
     try {
-      const byteLength = 8 + (SHARED_BUFFER_FRAMES * channels * 4);
+      const audioEnd = Math.ceil((8 + SHARED_BUFFER_FRAMES * channels * 4) / 8) * 8;
+      const byteLength = audioEnd + 16 + PACKET_SLOTS * 32;
       sharedBuffer = new SharedArrayBuffer(byteLength);
       console.warn('[SAB Debug] SharedArrayBuffer creado:', byteLength, 'bytes');
 
@@ -204,11 +256,12 @@ export async function activateMultichannelOutput(app) {
 
       // Adjuntar al native stream via preload
       console.warn('[SAB Debug] Llamando attachSharedBuffer...');
-      const attached = window.multichannelAPI.attachSharedBuffer(sharedBuffer, SHARED_BUFFER_FRAMES);
+      const attached = window.multichannelAPI.attachSharedBuffer(sharedBuffer, SHARED_BUFFER_FRAMES, PACKET_SLOTS);
       console.warn('[SAB Debug] attachSharedBuffer resultado:', attached);
       if (attached) {
         app._sharedAudioBuffer = sharedBuffer;
         app._sharedBufferFrames = SHARED_BUFFER_FRAMES;
+        app._sharedPacketSlots = PACKET_SLOTS;
         log.info('🎛️ SharedArrayBuffer creado y adjuntado:', SHARED_BUFFER_FRAMES, 'frames - LOCK-FREE MODE!');
       } else {
         log.warn('🎛️ No se pudo adjuntar SharedArrayBuffer, usando fallback');
@@ -266,7 +319,8 @@ export async function activateMultichannelOutput(app) {
         app._multichannelWorklet.port.postMessage({
           type: 'init',
           sharedBuffer: app._sharedAudioBuffer,
-          bufferFrames: app._sharedBufferFrames
+          bufferFrames: app._sharedBufferFrames,
+          packetSlots: app._sharedPacketSlots
         });
         log.info('🎛️ SharedArrayBuffer enviado al worklet');
       }
@@ -373,6 +427,10 @@ export async function deactivateMultichannelOutput(app) {
 
   log.info('🎛️ Deactivating multichannel output...');
 
+  // Guardar el ruteo actual (qpwgraph) para restaurarlo en la próxima apertura
+  captureLinkRules();
+  stopPluginBridge();
+
   // Cerrar el stream nativo
   if (window.multichannelAPI) {
     await window.multichannelAPI.close();
@@ -448,6 +506,8 @@ export async function activateMultichannelInput(app) {
   const ctx = app.engine.audioCtx;
   const sampleRate = ctx?.sampleRate || 48000;
 
+  startLinkManager();
+
   // Abrir el stream de captura PipeWire
   const result = await window.multichannelInputAPI.open({ sampleRate, channels: 8 });
 
@@ -456,6 +516,10 @@ export async function activateMultichannelInput(app) {
   }
 
   log.info('🎤 Multichannel input stream opened:', result.info);
+  logStreamRecovery(window.multichannelInputAPI, '🎤');
+
+  // DC, ganancia y detección de recortes en el addon (antes del SAB)
+  window.multichannelInputAPI.setConditioning?.(inputAmplifierConfig.nativeConditioning);
 
   // Crear SharedArrayBuffer para recibir audio capturado
   // Layout: [writeIndex(4), readIndex(4), audioData(frames * 8ch * 4bytes)]
@@ -465,6 +529,7 @@ export async function activateMultichannelInput(app) {
 
   if (typeof SharedArrayBuffer !== 'undefined') {
     try {
+      // Sin tabla de paquetes: en captura el productor es el addon
       const byteLength = 8 + (SHARED_BUFFER_FRAMES * channels * 4);
       sharedBuffer = new SharedArrayBuffer(byteLength);
 
@@ -566,6 +631,9 @@ export async function deactivateMultichannelInput(app) {
 
   log.info('🎤 Deactivating multichannel input...');
 
+  // Guardar el ruteo actual (qpwgraph) para restaurarlo en la próxima apertura
+  captureLinkRules();
+
   // Cerrar el stream nativo
   if (window.multichannelInputAPI) {
     await window.multichannelInputAPI.close();
@@ -599,6 +667,279 @@ export async function deactivateMultichannelInput(app) {
   }
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// ESTÉREO NATIVO (PipeWire 2ch) - ELECTRON + LINUX
+// ─────────────────────────────────────────────────────────────────────────────
+// En modo estéreo, si el addon está disponible, la salida y la entrada del
+// sistema pasan por streams PipeWire de 2 canales (FL/FR) en lugar de la pila
+// de audio de Chromium: menos buffering y estadísticas de underflows/latencia.
+// El destination de Web Audio solo recibe silencio (mantiene vivo el grafo).
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Frames del SAB de los streams estéreo nativos (~170ms @ 48kHz) */
+const NATIVE_STEREO_BUFFER_FRAMES = 8192;
+
+/**
+ * Indica si puede usarse el camino PipeWire nativo para estéreo:
+ * Electron + Linux, addon cargado, SharedArrayBuffer y preferencia activa.
+ *
+ * @param {object} app - Instancia de la aplicación
+ * @returns {Promise<boolean>}
+ */
+export async function isNativeStereoAvailable(app) {
+  if (window.electronAPI?.platform !== 'linux' || !window.multichannelAPI) {
+    return false;
+  }
+  if (app.audioSettingsModal?.getNativeStereo?.() === false) {
+    return false;
+  }
+  try {
+    const result = await window.multichannelAPI.checkAvailability();
+    return Boolean(result?.available && result.native && result.sharedArrayBuffer);
+  } catch (e) {
+    return false;
+  }
+}
+
+/**
+ * Crea un SAB [writeIndex, readIndex, audio] y lo adjunta al stream nativo.
+ *
+ * @param {object} api - multichannelAPI o multichannelInputAPI
+ * @param {number} channels - Canales intercalados
+ * @returns {SharedArrayBuffer|null}
+ */
+function attachNativeSharedBuffer(api, channels) {
+  try {
+    // Índices a 0 (un SAB nuevo ya está inicializado a cero)
+    const sharedBuffer = new SharedArrayBuffer(8 + (NATIVE_STEREO_BUFFER_FRAMES * channels * 4));
+    return api.attachSharedBuffer(sharedBuffer, NATIVE_STEREO_BUFFER_FRAMES) ? sharedBuffer : null;
+  } catch (e) {
+    log.warn('🔊 Error creando SharedArrayBuffer estéreo:', e.message);
+    return null;
+  }
+}
+
+/**
+ * Activa la salida estéreo nativa (PipeWire 2ch) en lugar de la de Chromium.
+ * Solo con el dispositivo de salida por defecto y 2 canales físicos: con un
+ * dispositivo concreto seleccionado se mantiene setSinkId.
+ *
+ * @param {object} app - Instancia de la aplicación
+ * @returns {Promise<{success: boolean, error?: string}>}
+ */
+export async function activateNativeStereoOutput(app) {
+  if (app._nativeStereoActive) {
+    return { success: true };
+  }
+  if (app._multichannelActive) {
+    return { success: false, error: 'Multicanal activo' };
+  }
+
+  const ctx = app.engine.audioCtx;
+  if (!ctx || !app.engine.merger) {
+    return { success: false, error: 'AudioContext no inicializado' };
+  }
+
+  const deviceId = app.audioSettingsModal?.selectedOutputDevice;
+  if ((deviceId && deviceId !== 'default') || app.engine.physicalChannels !== 2) {
+    return { success: false, error: 'Dispositivo de salida no estéreo por defecto' };
+  }
+
+  if (!(await isNativeStereoAvailable(app))) {
+    return { success: false, error: 'Estéreo nativo no disponible' };
+  }
+
+  // Mismo buffer y modo driver que el multicanal
+  const configuredLatencyMs = app.audioSettingsModal?.getConfiguredLatencyMs?.() || 42;
+  window.multichannelAPI.setLatency?.(configuredLatencyMs, ctx.sampleRate);
+  const driverMode = app.audioSettingsModal?.getDriverMode?.() || false;
+
+  const result = await window.multichannelAPI.open({
+    sampleRate: ctx.sampleRate,
+    channels: 2,
+    driverMode,
+    name: 'SynthiGME-Stereo',
+    description: 'SynthiGME Stereo Output'
+  });
+  if (!result.success) {
+    return { success: false, error: result.error };
+  }
+
+  const sharedBuffer = attachNativeSharedBuffer(window.multichannelAPI, 2);
+  if (!sharedBuffer) {
+    await window.multichannelAPI.close();
+    return { success: false, error: 'SharedArrayBuffer no disponible' };
+  }
+
+  try {
+    await ctx.audioWorklet.addModule('./assets/js/worklets/multichannelCapture.worklet.js');
+  } catch (e) {
+    log.error('🔊 Failed to load capture worklet for native stereo:', e);
+    await window.multichannelAPI.close();
+    return { success: false, error: 'Failed to load worklet' };
+  }
+
+  const worklet = new AudioWorkletNode(ctx, 'multichannel-capture', {
+    numberOfInputs: 1,
+    numberOfOutputs: 1,
+    channelCount: 2,
+    channelCountMode: 'explicit',
+    channelInterpretation: 'discrete',
+    processorOptions: { channels: 2 }
+  });
+  attachProcessorErrorHandler(worklet, 'multichannel-capture');
+
+  worklet.port.onmessage = (event) => {
+    if (event.data.type === 'ready') {
+      worklet.port.postMessage({
+        type: 'init',
+        sharedBuffer,
+        bufferFrames: NATIVE_STEREO_BUFFER_FRAMES
+      });
+    }
+  };
+
+  const silencer = ctx.createGain();
+  silencer.gain.value = 0;
+
+  // merger → worklet → silencer → destination (Chromium solo recibe silencio)
+  try { app.engine.merger.disconnect(); } catch (e) {}
+  app.engine.merger.connect(worklet);
+  worklet.connect(silencer);
+  silencer.connect(ctx.destination);
+
+  app._nativeStereoWorklet = worklet;
+  app._nativeStereoSilencer = silencer;
+  app._nativeStereoActive = true;
+  app.audioSettingsModal?.setNativeStereoActive?.(true);
+
+  log.info('🔊 Native stereo output active:', result.info);
+  return { success: true };
+}
+
+/**
+ * Desactiva la salida estéreo nativa y devuelve el merger al destination.
+ *
+ * @param {object} app - Instancia de la aplicación
+ */
+export async function deactivateNativeStereoOutput(app) {
+  if (!app._nativeStereoActive) return;
+
+  if (window.multichannelAPI) {
+    await window.multichannelAPI.close();
+  }
+
+  if (app._nativeStereoWorklet) {
+    try {
+      app._nativeStereoWorklet.port.postMessage({ type: 'stop' });
+      app.engine.merger?.disconnect(app._nativeStereoWorklet);
+      app._nativeStereoWorklet.disconnect();
+      app._nativeStereoWorklet.port.close();
+    } catch (e) {}
+    app._nativeStereoWorklet = null;
+  }
+
+  if (app._nativeStereoSilencer) {
+    try { app._nativeStereoSilencer.disconnect(); } catch (e) {}
+    app._nativeStereoSilencer = null;
+  }
+
+  const ctx = app.engine.audioCtx;
+  if (app.engine.merger && ctx) {
+    app.engine.merger.connect(ctx.destination);
+  }
+
+  app._nativeStereoActive = false;
+  app.audioSettingsModal?.setNativeStereoActive?.(false);
+  log.info('🔊 Native stereo output deactivated');
+}
+
+/**
+ * Abre la captura estéreo nativa (PipeWire 2ch, source por defecto) y
+ * devuelve el AudioWorkletNode que la reproduce, para usarlo como fuente
+ * en lugar de getUserMedia. Devuelve null si no está disponible.
+ *
+ * @param {object} app - Instancia de la aplicación
+ * @returns {Promise<AudioWorkletNode|null>}
+ */
+export async function openNativeStereoInput(app) {
+  const ctx = app.engine.audioCtx;
+  if (!ctx || !window.multichannelInputAPI || app._multichannelInputActive) {
+    return null;
+  }
+  if (!(await isNativeStereoAvailable(app))) {
+    return null;
+  }
+
+  const result = await window.multichannelInputAPI.open({
+    sampleRate: ctx.sampleRate,
+    channels: 2,
+    name: 'SynthiGME-Stereo-Input',
+    description: 'SynthiGME Stereo Input'
+  });
+  if (!result.success) {
+    log.warn('🎤 Native stereo input failed, using getUserMedia:', result.error);
+    return null;
+  }
+
+  const sharedBuffer = attachNativeSharedBuffer(window.multichannelInputAPI, 2);
+  if (!sharedBuffer) {
+    await window.multichannelInputAPI.close();
+    return null;
+  }
+
+  try {
+    await ctx.audioWorklet.addModule('./assets/js/worklets/multichannelPlayback.worklet.js');
+  } catch (e) {
+    log.error('🎤 Failed to load playback worklet for native stereo:', e);
+    await window.multichannelInputAPI.close();
+    return null;
+  }
+
+  const worklet = new AudioWorkletNode(ctx, 'multichannel-playback', {
+    numberOfInputs: 0,
+    numberOfOutputs: 1,
+    outputChannelCount: [2],
+    channelCount: 2,
+    channelCountMode: 'explicit',
+    channelInterpretation: 'discrete',
+    processorOptions: { channels: 2 }
+  });
+  attachProcessorErrorHandler(worklet, 'multichannel-playback');
+
+  worklet.port.onmessage = (event) => {
+    if (event.data.type === 'ready') {
+      worklet.port.postMessage({
+        type: 'init',
+        sharedBuffer,
+        bufferFrames: NATIVE_STEREO_BUFFER_FRAMES
+      });
+    }
+  };
+
+  app._nativeStereoInputWorklet = worklet;
+  log.info('🎤 Native stereo input active (PipeWire 2ch)');
+  return worklet;
+}
+
+/**
+ * Cierra la captura estéreo nativa si está abierta.
+ * Los nodos de ruteo los desconecta quien llama (_disconnectSystemAudioInput).
+ *
+ * @param {object} app - Instancia de la aplicación
+ */
+export function closeNativeStereoInput(app) {
+  if (!app._nativeStereoInputWorklet) return;
+
+  try {
+    app._nativeStereoInputWorklet.port.postMessage({ type: 'stop' });
+    app._nativeStereoInputWorklet.port.close();
+  } catch (e) {}
+  app._nativeStereoInputWorklet = null;
+
+  window.multichannelInputAPI?.close();
+}
+
 /**
  * Asegura que el audio del sistema esté conectado a los Input Amplifiers.
  * Solicita permiso de micrófono si es necesario.
@@ -610,12 +951,6 @@ export async function ensureSystemAudioInput(app, deviceId = null) {
   // Evitar reconectar si ya está conectado con el mismo dispositivo
   if (app._systemAudioConnected && !deviceId) return;
 
-  // Verificar si el permiso fue denegado previamente (evita bucle en Chrome móvil)
-  if (app.audioSettingsModal?.isMicrophonePermissionDenied?.()) {
-    log.info(' Microphone permission previously denied, skipping getUserMedia');
-    return;
-  }
-
   if (!app.inputAmplifiers?.isStarted) {
     log.warn(' Input amplifiers not ready for system audio');
     return;
@@ -625,28 +960,43 @@ export async function ensureSystemAudioInput(app, deviceId = null) {
   if (!ctx) return;
 
   try {
-    // Configurar constraints para getUserMedia
-    const audioConstraints = {
-      echoCancellation: false,
-      noiseSuppression: false,
-      autoGainControl: false
-    };
-
-    // Si se especifica un dispositivo, usarlo
-    if (deviceId && deviceId !== 'default') {
-      audioConstraints.deviceId = { exact: deviceId };
+    // Linux + addon: captura estéreo PipeWire nativa (sin getUserMedia)
+    let stream = null;
+    let sourceNode = null;
+    if (!deviceId || deviceId === 'default') {
+      sourceNode = await openNativeStereoInput(app);
     }
 
-    // Solicitar acceso al micrófono/entrada de línea
-    const stream = await navigator.mediaDevices.getUserMedia({ audio: audioConstraints });
+    if (!sourceNode) {
+      // Verificar si el permiso fue denegado previamente (evita bucle en Chrome móvil)
+      if (app.audioSettingsModal?.isMicrophonePermissionDenied?.()) {
+        log.info(' Microphone permission previously denied, skipping getUserMedia');
+        return;
+      }
 
-    // Permiso concedido - limpiar flag si existía
-    if (app.audioSettingsModal?.clearMicrophonePermissionDenied) {
-      app.audioSettingsModal.clearMicrophonePermissionDenied();
-    }
+      // Configurar constraints para getUserMedia
+      const audioConstraints = {
+        echoCancellation: false,
+        noiseSuppression: false,
+        autoGainControl: false
+      };
+
+      // Si se especifica un dispositivo, usarlo
+      if (deviceId && deviceId !== 'default') {
+        audioConstraints.deviceId = { exact: deviceId };
+      }
+
+      // Solicitar acceso al micrófono/entrada de línea
+      stream = await navigator.mediaDevices.getUserMedia({ audio: audioConstraints });
 
-    // Crear nodo fuente desde el stream
-    const sourceNode = ctx.createMediaStreamSource(stream);
+      // Permiso concedido - limpiar flag si existía
+      if (app.audioSettingsModal?.clearMicrophonePermissionDenied) {
+        app.audioSettingsModal.clearMicrophonePermissionDenied();
+      }
+
+      // Crear nodo fuente desde el stream
+      sourceNode = ctx.createMediaStreamSource(stream);
+    }
     const channelCount = sourceNode.channelCount || 2;
 
     log.info(` System audio input: ${channelCount} channels`);
@@ -31,5 +31,18 @@ export default {
   
   audio: {
     levelSmoothingTime: 0.03   // Tiempo de suavizado para evitar clicks
+  },
+  
+  // ─────────────────────────────────────────────────────────────────────────
+  // ACONDICIONAMIENTO NATIVO DE LA CAPTURA (Electron + PipeWire multicanal)
+  // ─────────────────────────────────────────────────────────────────────────
+  // Se aplica en el addon, en la misma pasada que escribe el SAB de entrada,
+  // antes de llegar a los Input Amplifiers.
+  
+  nativeConditioning: {
+    dcCutoffHz: 2,           // DC blocker de 1er orden (0 = desactivado)
+    gain: 1,                 // Ganancia lineal por defecto de los 8 canales
+    gainSmoothingMs: 20,     // Suavizado de los cambios de ganancia
+    clipThreshold: 0.999     // |x| a partir del cual una muestra cuenta como recorte
   }
 };
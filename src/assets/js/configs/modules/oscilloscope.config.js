@@ -50,6 +50,21 @@ export default {
     glowColor: '#00ff00',      // Glow del Beam 1
     glowColor2: '#00ff00',     // Glow del Beam 2
     
+    // ─────────────────────────────────────────────────────────────────────
+    // PERSISTENCIA DE FÓSFORO (modo X-Y, solo Electron con addon nativo)
+    // Un hilo del addon acumula el recorrido del haz con decaimiento
+    // exponencial y publica cada frame como imagen; la UI solo la copia.
+    // persistenceMs: tiempo hasta que la intensidad cae a 1/e
+    // beamEnergy: brillo depositado por muestra (más = trazo más saturado)
+    // En navegador se mantiene el trazo con canvas.
+    // ─────────────────────────────────────────────────────────────────────
+    phosphor: {
+      enabled: true,
+      persistenceMs: 60,
+      beamEnergy: 1.5,
+      fps: 60
+    },
+    
     // ─────────────────────────────────────────────────────────────────────
     // ELEMENTOS DE UI
     // ─────────────────────────────────────────────────────────────────────
@@ -0,0 +1,158 @@
+/**
+ * Automation lanes - Registros de automatización con precisión de muestra
+ *
+ * Codifica y decodifica el formato de AutomationLane (automation_lane.h)
+ * que graba el bridge nativo, y lo vuelca sobre AudioParams para reproducir
+ * una interpretación en un OfflineAudioContext (render de alta calidad sin
+ * el hilo nativo).
+ *
+ * El mismo formato sirve para la automatización de la app (mandos, matriz y
+ * OSC), que graba core/automationRecorder.js con direcciones OSC como nombres
+ * de parámetro.
+ *
+ * Formato por evento:
+ *   varint  cabecera = delta_frames << 2 | rampa << 1 | cambia_id
+ *   varint  id de parámetro (solo si cambia_id)
+ *   float32 valor (little-endian)
+ * delta_frames es relativo al evento anterior (el primero, a startFrame).
+ * rampa = 1: el valor llegó por setParam (rampa de un bloque nativo).
+ *
+ * @example
+ * ```javascript
+ * bridge.startRecording();
+ * // ... interpretación ...
+ * const recording = bridge.stopRecording();
+ * bridge.play(recording, ctx.currentTime + 1);
+ *
+ * // Render offline
+ * scheduleAutomation(recording, name => offlineGain.gain, { startTime: 0 });
+ * ```
+ */
+
+/** Frames de la rampa de setParam en el nativo (ProcessorBridge::BLOCK_FRAMES) */
+export const AUTOMATION_RAMP_FRAMES = 128;
+
+/**
+ * @typedef {Object} AutomationEvent
+ * @property {number} frame - Frame absoluto (módulo 2^32)
+ * @property {number} id - Id de parámetro del procesador
+ * @property {number} value
+ * @property {boolean} ramp - true si se grabó desde setParam
+ */
+
+/**
+ * @typedef {Object} AutomationRecording
+ * @property {number} startFrame - Frame del AudioContext al empezar a grabar
+ * @property {number} sampleRate
+ * @property {number} events - Eventos grabados
+ * @property {number} dropped - Eventos perdidos (registro lleno)
+ * @property {Uint8Array} data - Eventos codificados
+ * @property {string[]} params - Nombre de cada id de parámetro
+ */
+
+/**
+ * Decodifica un registro.
+ * @param {Uint8Array} data
+ * @param {number} [startFrame=0]
+ * @returns {AutomationEvent[]} Eventos en orden (se detiene si está truncado)
+ */
+export function decodeAutomationLane(data, startFrame = 0) {
+  const events = [];
+  const view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+  let pos = 0;
+  let frame = startFrame;
+  let id = -1;
+
+  const varint = () => {
+    let value = 0;
+    let scale = 1;
+    while (pos < data.length) {
+      const byte = data[pos++];
+      value += (byte & 0x7f) * scale;
+      if (!(byte & 0x80)) return value;
+      scale *= 128;
+    }
+    return null;
+  };
+
+  while (pos < data.length) {
+    const head = varint();
+    if (head === null) break;
+    if (head % 2 === 1) {
+      id = varint();
+      if (id === null) break;
+    }
+    if (pos + 4 > data.length) break;
+    const value = view.getFloat32(pos, true);
+    pos += 4;
+    frame = (frame + Math.floor(head / 4)) >>> 0;
+    events.push({ frame, id, value, ramp: Math.floor(head / 2) % 2 === 1 });
+  }
+  return events;
+}
+
+/**
+ * Codifica eventos ordenados por frame (p. ej. tras editarlos en JS).
+ * @param {AutomationEvent[]} events
+ * @param {number} [startFrame=0]
+ * @returns {Uint8Array}
+ */
+export function encodeAutomationLane(events, startFrame = 0) {
+  const bytes = [];
+  const float = new DataView(new ArrayBuffer(4));
+  const varint = (value) => {
+    while (value >= 0x80) {
+      bytes.push((value % 128) | 0x80);
+      value = Math.floor(value / 128);
+    }
+    bytes.push(value);
+  };
+
+  let lastFrame = startFrame;
+  let lastId = -1;
+  for (const { frame, id, value, ramp } of events) {
+    const delta = Math.max(0, frame - lastFrame);
+    const idChanged = id !== lastId;
+    varint(delta * 4 + (ramp ? 2 : 0) + (idChanged ? 1 : 0));
+    if (idChanged) varint(id);
+    float.setFloat32(0, value, true);
+    for (let i = 0; i < 4; i++) bytes.push(float.getUint8(i));
+    lastFrame += delta;
+    lastId = id;
+  }
+  return Uint8Array.from(bytes);
+}
+
+/**
+ * Programa un registro sobre AudioParams (render offline o reproducción
+ * sin el bridge nativo). Los saltos usan setValueAtTime; las rampas de
+ * setParam, una rampa lineal de AUTOMATION_RAMP_FRAMES desde el valor previo.
+ * @param {AutomationRecording} recording
+ * @param {(name: string) => AudioParam|null} resolveParam - AudioParam por nombre de parámetro
+ * @param {Object} [options]
+ * @param {number} [options.startTime=0] - Instante (s) que corresponde a recording.startFrame
+ * @param {number} [options.sampleRate=recording.sampleRate]
+ * @returns {number} Eventos programados
+ */
+export function scheduleAutomation(recording, resolveParam, options = {}) {
+  const sampleRate = options.sampleRate ?? recording.sampleRate;
+  const startTime = options.startTime ?? 0;
+  const lastValues = new Map();
+  let scheduled = 0;
+
+  for (const event of decodeAutomationLane(recording.data, recording.startFrame)) {
+    const param = resolveParam(recording.params[event.id]);
+    if (!param) continue;
+    const time = startTime + ((event.frame - recording.startFrame) >>> 0) / sampleRate;
+    const previous = lastValues.get(param);
+    if (event.ramp && previous !== undefined) {
+      param.setValueAtTime(previous, time);
+      param.linearRampToValueAtTime(event.value, time + AUTOMATION_RAMP_FRAMES / sampleRate);
+    } else {
+      param.setValueAtTime(event.value, time);
+    }
+    lastValues.set(param, event.value);
+    scheduled++;
+  }
+  return scheduled;
+}
@@ -0,0 +1,231 @@
+/**
+ * Automation recorder - Graba y reproduce la interpretación en la app
+ *
+ * Escucha todos los cambios de parámetros de la app en el espacio de
+ * direcciones OSC (oscBridge.addTap): mandos, matriz y MIDI Learn locales,
+ * mensajes OSC entrantes y lo que se esté reproduciendo. Cada evento se sella
+ * con el frame del AudioContext y se guarda en el formato delta de
+ * automationLane.js, el mismo que graba el bridge nativo.
+ *
+ * Cada dirección es un parámetro (params[id]) y el float32 del evento lleva
+ * su valor. Los argumentos no numéricos (color de pin, 'hi'/'lo', notas
+ * [nota, velocity]) forman un parámetro propio `dirección JSON` con valor 0.
+ *
+ * La reproducción aplica primero el patch del inicio de la grabación y
+ * despacha cada evento con oscBridge.dispatchLocal cuando el reloj del
+ * AudioContext alcanza su frame: pasa por los mismos manejadores que el OSC
+ * entrante, así que la resolución es la del temporizador (PLAYBACK_TICK_MS),
+ * no de muestra. Para precisión de muestra: procesadores del bridge nativo.
+ *
+ * @example
+ * ```javascript
+ * const recorder = new AutomationRecorder({ getContext: () => engine.audioCtx });
+ * recorder.start();
+ * // ... interpretación ...
+ * const recording = recorder.stop();
+ * await recorder.play(recording);
+ * ```
+ */
+
+import { oscBridge } from '../osc/oscBridge.js';
+import { createLogger } from '../utils/logger.js';
+import { decodeAutomationLane, encodeAutomationLane } from './automationLane.js';
+
+const log = createLogger('AutomationRecorder');
+
+/** Máximo de eventos por grabación (el resto cuenta como dropped) */
+export const MAX_AUTOMATION_EVENTS = 1 << 20;
+
+/** Intervalo del reloj de reproducción (ms) */
+export const PLAYBACK_TICK_MS = 5;
+
+/**
+ * @typedef {import('./automationLane.js').AutomationRecording & { state?: Object }} AppAutomationRecording
+ * state: patch serializado al empezar a grabar (se aplica antes de reproducir)
+ */
+
+/**
+ * Frame actual del AudioContext
+ * @param {BaseAudioContext} ctx
+ * @returns {number}
+ */
+function contextFrame(ctx) {
+  return Math.round(ctx.currentTime * ctx.sampleRate);
+}
+
+/**
+ * Clave de parámetro para una dirección y sus argumentos
+ * @param {string} address
+ * @param {Array} args
+ * @returns {{ key: string, value: number }}
+ */
+export function automationParamKey(address, args) {
+  if (args.length === 1 && typeof args[0] === 'number' && Number.isFinite(args[0])) {
+    return { key: address, value: args[0] };
+  }
+  return { key: `${address} ${JSON.stringify(args)}`, value: 0 };
+}
+
+/**
+ * Mensaje OSC de un evento grabado
+ * @param {string} key - params[id]
+ * @param {number} value
+ * @returns {{ address: string, args: Array }}
+ */
+export function automationMessage(key, value) {
+  const space = key.indexOf(' ');
+  if (space < 0) return { address: key, args: [value] };
+  return { address: key.slice(0, space), args: JSON.parse(key.slice(space + 1)) };
+}
+
+export class AutomationRecorder {
+  /**
+   * @param {Object} options
+   * @param {() => BaseAudioContext|null} options.getContext - AudioContext que da el reloj
+   * @param {() => Object} [options.serializeState] - Patch actual (se guarda al empezar)
+   * @param {(state: Object) => Promise<void>|void} [options.applyState] - Aplica un patch
+   */
+  constructor({ getContext, serializeState = null, applyState = null }) {
+    this._getContext = getContext;
+    this._serializeState = serializeState;
+    this._applyState = applyState;
+
+    /** @type {Function|null} Cancelación del tap mientras se graba */
+    this._untap = null;
+    this._events = [];
+    this._params = [];
+    this._paramIds = new Map();
+    this._dropped = 0;
+    this._startFrame = 0;
+    this._originFrame = 0;
+    this._sampleRate = 0;
+    this._state = null;
+
+    /** @type {ReturnType<typeof setInterval>|null} */
+    this._timer = null;
+
+    /** @type {Function|null} Se llama al terminar una reproducción completa */
+    this.onPlaybackEnd = null;
+  }
+
+  get isRecording() {
+    return this._untap !== null;
+  }
+
+  get isPlaying() {
+    return this._timer !== null;
+  }
+
+  /**
+   * Empieza a grabar. Necesita un AudioContext activo.
+   * @returns {boolean}
+   */
+  start() {
+    if (this.isRecording) return true;
+    const ctx = this._getContext();
+    if (!ctx) return false;
+
+    this._events = [];
+    this._params = [];
+    this._paramIds.clear();
+    this._dropped = 0;
+    this._sampleRate = ctx.sampleRate;
+    this._originFrame = contextFrame(ctx);
+    this._startFrame = this._originFrame >>> 0;
+    this._state = this._serializeState ? this._serializeState() : null;
+    this._untap = oscBridge.addTap((address, args) => this._record(ctx, address, args));
+    log.info(`Grabando automatización desde el frame ${this._startFrame}`);
+    return true;
+  }
+
+  /**
+   * Termina la grabación.
+   * @returns {AppAutomationRecording|null}
+   */
+  stop() {
+    if (!this.isRecording) return null;
+    this._untap();
+    this._untap = null;
+
+    const recording = {
+      startFrame: this._startFrame,
+      sampleRate: this._sampleRate,
+      events: this._events.length,
+      dropped: this._dropped,
+      data: encodeAutomationLane(this._events, this._startFrame),
+      params: this._params.slice(),
+      state: this._state
+    };
+    this._events = [];
+    log.info(`Automatización grabada: ${recording.events} eventos, ${recording.data.length} bytes`);
+    return recording;
+  }
+
+  /**
+   * Reproduce una grabación desde ahora con el reloj del AudioContext.
+   * @param {AppAutomationRecording} recording
+   * @param {Object} [options]
+   * @param {boolean} [options.applyState=true] - Aplicar antes el patch inicial
+   * @returns {Promise<boolean>}
+   */
+  async play(recording, { applyState = true } = {}) {
+    this.stopPlayback();
+    const ctx = this._getContext();
+    if (!ctx || !recording?.data) return false;
+
+    if (applyState && recording.state && this._applyState) {
+      await this._applyState(recording.state);
+    }
+
+    const events = decodeAutomationLane(recording.data, recording.startFrame);
+    const scale = ctx.sampleRate / (recording.sampleRate || ctx.sampleRate);
+    const origin = contextFrame(ctx);
+    let next = 0;
+
+    const tick = () => {
+      const elapsed = contextFrame(ctx) - origin;
+      while (next < events.length) {
+        const event = events[next];
+        if (((event.frame - recording.startFrame) >>> 0) * scale > elapsed) break;
+        next++;
+        const key = recording.params[event.id];
+        if (key === undefined) continue;
+        const { address, args } = automationMessage(key, event.value);
+        oscBridge.dispatchLocal(address, args);
+      }
+      if (next >= events.length) {
+        this.stopPlayback();
+        this.onPlaybackEnd?.();
+      }
+    };
+
+    this._timer = setInterval(tick, PLAYBACK_TICK_MS);
+    tick();
+    return true;
+  }
+
+  /** Detiene la reproducción en curso */
+  stopPlayback() {
+    if (this._timer === null) return;
+    clearInterval(this._timer);
+    this._timer = null;
+  }
+
+  /** @private */
+  _record(ctx, address, args) {
+    if (this._events.length >= MAX_AUTOMATION_EVENTS) {
+      this._dropped++;
+      return;
+    }
+    const { key, value } = automationParamKey(address, args);
+    let id = this._paramIds.get(key);
+    if (id === undefined) {
+      id = this._params.length;
+      this._params.push(key);
+      this._paramIds.set(key, id);
+    }
+    // Relativo al origen sin módulo: encodeAutomationLane espera frames crecientes
+    const frame = this._startFrame + Math.max(0, contextFrame(ctx) - this._originFrame);
+    this._events.push({ frame, id, value, ramp: false });
+  }
+}
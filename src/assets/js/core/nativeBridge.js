@@ -0,0 +1,238 @@
+import { createLogger } from '../utils/logger.js';
+import { attachProcessorErrorHandler } from '../utils/audio.js';
+
+const log = createLogger('NativeBridge');
+
+/**
+ * NativeBridgeNode - Procesador DSP nativo (C++) como nodo del grafo Web Audio.
+ *
+ * Permite migrar módulos a nativo uno a uno: el nodo se conecta como
+ * cualquier AudioNode (`bridge.node`) y el resto del grafo no cambia.
+ * La salida llega con un retardo fijo de `latencyFrames` (por defecto dos
+ * render quanta), que se informa en getStats() para compensarlo donde haga
+ * falta. Solo disponible en Electron con el addon nativo.
+ */
+
+const HEADER_BYTES = 8 * 4;
+const UNDERRUNS_WORD = 5;
+const BLOCKS_WORD = 6;
+
+export const NATIVE_BRIDGE_DEFAULT_LATENCY_FRAMES = 256;
+export const NATIVE_BRIDGE_RING_FRAMES = 4096;
+
+const loadedContexts = new WeakSet();
+
+/**
+ * Bytes del SharedArrayBuffer de un bridge (ver processor_bridge.h)
+ * @param {number} ringFrames
+ * @param {number} inputs
+ * @param {number} outputs
+ * @returns {number}
+ */
+export function nativeBridgeBufferBytes(ringFrames, inputs, outputs) {
+  return HEADER_BYTES + ringFrames * (inputs + outputs) * 4;
+}
+
+export class NativeBridgeNode {
+  /**
+   * @returns {boolean} true si el addon expone el bridge y hay SharedArrayBuffer
+   */
+  static isAvailable() {
+    return typeof window !== 'undefined' && Boolean(window.nativeBridgeAPI?.isAvailable());
+  }
+
+  /**
+   * Crea el procesador nativo y su AudioWorkletNode.
+   * @param {AudioContext} ctx
+   * @param {string} type - Tipo registrado en el addon ('passthrough', 'gain'...)
+   * @param {Object} [options]
+   * @param {number} [options.inputs=1] - Canales de entrada
+   * @param {number} [options.outputs=1] - Canales de salida
+   * @param {number} [options.latencyFrames=256] - Retardo fijo (frames)
+   * @param {Object<string, number>} [options.params] - Parámetros iniciales
+   * @returns {Promise<NativeBridgeNode|null>} null si el bridge no está disponible
+   */
+  static async create(ctx, type, options = {}) {
+    if (!NativeBridgeNode.isAvailable()) {
+      log.warn('Native bridge not available');
+      return null;
+    }
+
+    const inputs = options.inputs ?? 1;
+    const outputs = options.outputs ?? 1;
+    const latencyFrames = options.latencyFrames ?? NATIVE_BRIDGE_DEFAULT_LATENCY_FRAMES;
+    const ringFrames = NATIVE_BRIDGE_RING_FRAMES;
+
+    const sharedBuffer = new SharedArrayBuffer(nativeBridgeBufferBytes(ringFrames, inputs, outputs));
+    const result = window.nativeBridgeAPI.create(type, sharedBuffer, {
+      inputs, outputs, sampleRate: ctx.sampleRate, ringFrames
+    });
+    if (!result.success) {
+      log.error(`Failed to create native processor "${type}":`, result.error);
+      return null;
+    }
+
+    try {
+      if (!loadedContexts.has(ctx)) {
+        await ctx.audioWorklet.addModule('./assets/js/worklets/nativeBridge.worklet.js');
+        loadedContexts.add(ctx);
+      }
+
+      const node = new AudioWorkletNode(ctx, 'native-bridge', {
+        numberOfInputs: inputs > 0 ? 1 : 0,
+        numberOfOutputs: 1,
+        outputChannelCount: [outputs],
+        channelCount: Math.max(inputs, 1),
+        channelCountMode: 'explicit',
+        channelInterpretation: 'discrete',
+        processorOptions: { inputs, outputs, latencyFrames }
+      });
+      attachProcessorErrorHandler(node, 'native-bridge');
+      node.port.postMessage({ type: 'init', sharedBuffer, ringFrames });
+
+      const bridge = new NativeBridgeNode(ctx, node, result.id, type, sharedBuffer, latencyFrames);
+      for (const [name, value] of Object.entries(options.params || {})) {
+        bridge.setParam(name, value);
+      }
+      log.info(`Native processor "${type}" bridged (${inputs}→${outputs}ch, ${latencyFrames} frames)`);
+      return bridge;
+    } catch (e) {
+      window.nativeBridgeAPI.destroy(result.id);
+      log.error(`Failed to create bridge worklet for "${type}":`, e);
+      return null;
+    }
+  }
+
+  constructor(ctx, node, id, type, sharedBuffer, latencyFrames) {
+    this.ctx = ctx;
+    this.node = node;
+    this.type = type;
+    this.latencyFrames = latencyFrames;
+    this._id = id;
+    this._control = new Int32Array(sharedBuffer, 0, 8);
+  }
+
+  /**
+   * @param {string} name
+   * @param {number} value
+   * @returns {boolean} false si el procesador no conoce el parámetro
+   */
+  setParam(name, value) {
+    if (this._id === null) return false;
+    return window.nativeBridgeAPI.setParam(this._id, name, value);
+  }
+
+  /**
+   * Programa un parámetro con precisión de muestra en el reloj del contexto.
+   * Un tiempo ya pasado se aplica al inicio del siguiente bloque nativo.
+   * @param {string} name
+   * @param {number} value
+   * @param {number} time - Segundos en el reloj de ctx (ctx.currentTime)
+   * @returns {boolean} false si el parámetro no admite eventos o la cola está llena
+   */
+  scheduleParam(name, value, time) {
+    if (this._id === null) return false;
+    const frame = Math.max(0, Math.round(time * this.ctx.sampleRate));
+    return window.nativeBridgeAPI.scheduleParam(this._id, name, value, frame);
+  }
+
+  /**
+   * Datos en bloque para el procesador (snapshots, tablas).
+   * @param {string} name
+   * @param {Float32Array|number[]} data
+   * @returns {boolean} false si el procesador no los admite
+   */
+  setData(name, data) {
+    if (this._id === null) return false;
+    const array = data instanceof Float32Array ? data : Float32Array.from(data);
+    return window.nativeBridgeAPI.setData(this._id, name, array);
+  }
+
+  /**
+   * Graba desde ahora los eventos de parámetros (setParam y scheduleParam)
+   * con marca de muestra (ver core/automationLane.js).
+   * @param {Object} [options]
+   * @param {number} [options.maxBytes] - Capacidad (1 MB ≈ 200k eventos)
+   */
+  startRecording({ maxBytes } = {}) {
+    if (this._id === null) return;
+    const frame = Math.round(this.ctx.currentTime * this.ctx.sampleRate);
+    window.nativeBridgeAPI.startRecording(this._id, frame, maxBytes);
+  }
+
+  /**
+   * @returns {import('./automationLane.js').AutomationRecording|null}
+   */
+  stopRecording() {
+    if (this._id === null) return null;
+    const result = window.nativeBridgeAPI.stopRecording(this._id);
+    if (!result) return null;
+    if (result.dropped > 0) {
+      log.warn(`Automation recording full: ${result.dropped} events dropped`);
+    }
+    return {
+      startFrame: result.startFrame,
+      sampleRate: this.ctx.sampleRate,
+      events: result.events,
+      dropped: result.dropped,
+      data: new Uint8Array(result.data),
+      params: Array.from(result.params)
+    };
+  }
+
+  /**
+   * Reproduce un registro en sincronía con el reloj del contexto: el inicio
+   * de la grabación cae en `time`. Es exacto si el desfase entre ambos es
+   * múltiplo del bloque nativo (128 frames).
+   * @param {import('./automationLane.js').AutomationRecording} recording
+   * @param {number} [time=ctx.currentTime]
+   * @returns {boolean}
+   */
+  play(recording, time = this.ctx.currentTime) {
+    if (this._id === null || !recording?.data) return false;
+    const frame = Math.round(time * this.ctx.sampleRate);
+    return window.nativeBridgeAPI.startPlayback(this._id, recording.data, frame);
+  }
+
+  stopPlayback() {
+    if (this._id === null) return;
+    window.nativeBridgeAPI.stopPlayback(this._id);
+  }
+
+  /**
+   * Latencia y salud del bridge.
+   * @returns {{ type: string, latencyFrames: number, latencyMs: number,
+   *   underruns: number, processedBlocks: number, overflows: number,
+   *   avgProcessUs: number, maxProcessUs: number, flushDenormals: boolean,
+   *   denormals: number, denormalBlocks: number, appliedEvents: number,
+   *   droppedEvents: number }}
+   * denormals: subnormales en los bloques de salida muestreados (1 de cada
+   * 16); con flushDenormals activo debe quedar a 0.
+   */
+  getStats() {
+    const native = this._id !== null ? window.nativeBridgeAPI.getStats(this._id) : null;
+    return {
+      type: this.type,
+      latencyFrames: this.latencyFrames,
+      latencyMs: (this.latencyFrames / this.ctx.sampleRate) * 1000,
+      underruns: Atomics.load(this._control, UNDERRUNS_WORD),
+      processedBlocks: Atomics.load(this._control, BLOCKS_WORD),
+      overflows: native?.overflows ?? 0,
+      avgProcessUs: native?.avgProcessUs ?? 0,
+      maxProcessUs: native?.maxProcessUs ?? 0,
+      flushDenormals: native?.flushDenormals ?? false,
+      denormals: native?.denormals ?? 0,
+      denormalBlocks: native?.denormalBlocks ?? 0,
+      appliedEvents: native?.appliedEvents ?? 0,
+      droppedEvents: native?.droppedEvents ?? 0
+    };
+  }
+
+  dispose() {
+    if (this._id === null) return;
+    this.node.port.postMessage({ type: 'stop' });
+    this.node.disconnect();
+    window.nativeBridgeAPI.destroy(this._id);
+    this._id = null;
+  }
+}
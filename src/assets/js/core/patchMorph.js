@@ -0,0 +1,165 @@
+import { createLogger } from '../utils/logger.js';
+import { NativeBridgeNode } from './nativeBridge.js';
+
+const log = createLogger('PatchMorph');
+
+/**
+ * PatchMorph - Morphing con precisión de muestra entre dos estados de patch.
+ *
+ * Envuelve el procesador nativo "morph" (native_processor.cc) en un
+ * NativeBridgeNode. Guarda dos snapshots (A y B) de ganancias de matriz y de
+ * parámetros continuos y el nativo interpola entre ellos muestra a muestra
+ * según la posición de morph:
+ *
+ *   t = clamp(morph + CV, 0, 1)
+ *   destino[col] = Σ fuente[row] · (gA + t·(gB − gA))
+ *   carril[p]    = pA + t·(pB − pA)
+ *
+ * Canales del nodo:
+ * - Entradas [0, sources): fuentes de la matriz; entrada `cvInput`: CV de morph
+ * - Salidas [0, destinations): destinos; después, un carril por parámetro
+ *   (señal 0-1 lista para conectar a un AudioParam)
+ *
+ * La posición se controla con setMorph() (inmediata con rampa de un bloque,
+ * o programada en un instante exacto) y desde CV por la última entrada. Solo
+ * disponible en Electron con el addon nativo.
+ *
+ * Ningún módulo de la app lo usa todavía: las matrices de los paneles son
+ * nodos Web Audio y no hay control de morph en la UI ni en OSC.
+ *
+ * @example
+ * ```javascript
+ * const morph = await PatchMorph.create(ctx, { sources: 4, destinations: 4, params: 2 });
+ * morph.setSnapshot('a', { connections: [[0, 1, 1]], params: [0.2, 0.8] });
+ * morph.setSnapshot('b', { connections: [[0, 2, 0.5]], params: [1, 0] });
+ * morph.setMorph(1, ctx.currentTime + 0.5);
+ * ```
+ */
+
+/**
+ * Convierte un MatrixState ({ connections: [[row, col, ...]] }) en tripletes
+ * [row, col, gain] para setSnapshot().
+ * @param {{ connections?: Array<Array<number|string>> }} matrixState
+ * @param {(row: number, col: number, entry: Array) => number} [gainFn] - Ganancia por conexión (1 por defecto)
+ * @returns {Array<[number, number, number]>}
+ */
+export function matrixStateToTriplets(matrixState, gainFn = () => 1) {
+  const connections = matrixState?.connections || [];
+  return connections.map(entry => [entry[0], entry[1], gainFn(entry[0], entry[1], entry)]);
+}
+
+/**
+ * Aplana tripletes [row, col, gain] al formato de setData("a"/"b").
+ * @param {Array<[number, number, number]>} connections
+ * @returns {Float32Array}
+ */
+export function flattenTriplets(connections) {
+  const data = new Float32Array(connections.length * 3);
+  connections.forEach(([row, col, gain], i) => {
+    data[i * 3] = row;
+    data[i * 3 + 1] = col;
+    data[i * 3 + 2] = gain;
+  });
+  return data;
+}
+
+export class PatchMorph {
+  /**
+   * @returns {boolean}
+   */
+  static isAvailable() {
+    return NativeBridgeNode.isAvailable()
+      && window.nativeBridgeAPI.listProcessors().includes('morph');
+  }
+
+  /**
+   * @param {AudioContext} ctx
+   * @param {Object} options
+   * @param {number} options.sources - Filas de la matriz (entradas del nodo)
+   * @param {number} options.destinations - Columnas de la matriz (salidas del nodo)
+   * @param {number} [options.params=0] - Parámetros continuos (salidas extra)
+   * @param {number} [options.latencyFrames] - Ver NativeBridgeNode
+   * @returns {Promise<PatchMorph|null>} null si el procesador no está disponible
+   */
+  static async create(ctx, { sources, destinations, params = 0, latencyFrames } = {}) {
+    if (!PatchMorph.isAvailable()) {
+      log.warn('Native morph processor not available');
+      return null;
+    }
+    const bridge = await NativeBridgeNode.create(ctx, 'morph', {
+      inputs: sources + 1,
+      outputs: destinations + params,
+      latencyFrames,
+      params: { destinations }
+    });
+    if (!bridge) return null;
+    return new PatchMorph(bridge, sources, destinations, params);
+  }
+
+  /**
+   * @param {NativeBridgeNode} bridge
+   * @param {number} sources
+   * @param {number} destinations
+   * @param {number} params
+   * @private
+   */
+  constructor(bridge, sources, destinations, params) {
+    this.bridge = bridge;
+    this.node = bridge.node;
+    this.sources = sources;
+    this.destinations = destinations;
+    this.params = params;
+    /** Canal de entrada de la CV de morph */
+    this.cvInput = sources;
+  }
+
+  /**
+   * Fija uno de los dos estados. Se aplica entre bloques nativos.
+   * @param {'a'|'b'} slot
+   * @param {Object} snapshot
+   * @param {Array<[number, number, number]>} [snapshot.connections] - [row, col, gain]
+   * @param {number[]} [snapshot.params] - Un valor por carril de parámetro
+   * @returns {boolean} false si el nativo rechaza algún dato (índices fuera de rango)
+   */
+  setSnapshot(slot, { connections = [], params = [] } = {}) {
+    if (slot !== 'a' && slot !== 'b') {
+      throw new Error(`Invalid morph slot: ${slot}`);
+    }
+    const okMatrix = this.bridge.setData(slot, flattenTriplets(connections));
+    const okParams = this.bridge.setData(`params.${slot}`, Float32Array.from(params));
+    if (!okMatrix) log.warn(`Morph snapshot ${slot} rejected (index out of range?)`);
+    return okMatrix && okParams;
+  }
+
+  /**
+   * Posición de morph 0 (A) … 1 (B).
+   * Sin `time`, se aplica con una rampa de un bloque; con `time`, como
+   * salto exacto en ese instante del reloj del contexto.
+   * @param {number} value
+   * @param {number} [time] - Segundos en el reloj de ctx
+   * @returns {boolean}
+   */
+  setMorph(value, time) {
+    if (time === undefined) return this.bridge.setParam('morph', value);
+    return this.bridge.scheduleParam('morph', value, time);
+  }
+
+  /**
+   * Salida de un carril de parámetro (índice de canal del nodo).
+   * @param {number} index - Índice del parámetro
+   * @returns {number}
+   */
+  paramOutput(index) {
+    return this.destinations + index;
+  }
+
+  getStats() {
+    return this.bridge.getStats();
+  }
+
+  dispose() {
+    this.bridge.dispose();
+  }
+}
+
+export default PatchMorph;
@@ -0,0 +1,152 @@
+/**
+ * PipeWire links - Restauración de las conexiones de puertos al arrancar
+ *
+ * Persiste en localStorage un mapa de enlaces por nombre ("nodo:puerto",
+ * con comodines fnmatch) y se lo pasa al LinkManager nativo
+ * (link_manager.h), que crea los enlaces en cuanto aparecen los puertos de
+ * los streams SynthiGME y del hardware. Sustituye el paso manual por
+ * qpwgraph tras cada arranque.
+ *
+ * Las reglas se capturan de los enlaces existentes antes de cerrar un stream
+ * multicanal y al salir de la app (beforeunload): el ruteo que el usuario
+ * hizo a mano se guarda y se restaura en la siguiente apertura, también en
+ * un arranque en frío tras enrutar y cerrar.
+ *
+ * @example
+ * ```javascript
+ * startLinkManager();                  // Reglas guardadas
+ * saveLinkRules([{ output: 'SynthiGME:Out_1', input: 'alsa_output.usb-*:playback_AUX0' }]);
+ * captureLinkRules();                  // Enlaces actuales de SynthiGME* → reglas
+ * ```
+ */
+
+import { createLogger } from '../utils/logger.js';
+import { STORAGE_KEYS } from '../utils/constants.js';
+
+const log = createLogger('PipeWireLinks');
+
+/** window donde ya está registrada la captura al salir */
+let exitCaptureTarget = null;
+
+/** Patrón de nodos cuyos enlaces se capturan (salida, entrada y estéreo) */
+export const SYNTHI_NODE_PATTERN = 'SynthiGME*';
+
+/**
+ * @typedef {Object} LinkRule
+ * @property {string} output - Patrón "nodo:puerto" del puerto de salida
+ * @property {string} input - Patrón "nodo:puerto" del puerto de entrada
+ */
+
+function getLinksAPI() {
+  return typeof window !== 'undefined' && window.pipewireLinksAPI?.isAvailable()
+    ? window.pipewireLinksAPI
+    : null;
+}
+
+/**
+ * Filtra entradas inválidas y duplicadas.
+ * @param {*} rules
+ * @returns {LinkRule[]}
+ */
+export function normalizeLinkRules(rules) {
+  if (!Array.isArray(rules)) return [];
+  const seen = new Set();
+  const result = [];
+  for (const rule of rules) {
+    if (typeof rule?.output !== 'string' || typeof rule?.input !== 'string') continue;
+    if (!rule.output.includes(':') || !rule.input.includes(':')) continue;
+    const key = `${rule.output}\n${rule.input}`;
+    if (seen.has(key)) continue;
+    seen.add(key);
+    result.push({ output: rule.output, input: rule.input });
+  }
+  return result;
+}
+
+/**
+ * Une reglas guardadas con enlaces capturados. Cada puerto de SynthiGME
+ * presente en la captura reemplaza todas sus reglas exactas anteriores por
+ * sus enlaces actuales, aunque no tenga ninguno (el usuario lo desenrutó).
+ * Se conservan las reglas con comodines, las de puertos no capturados y las
+ * cuyo otro extremo no existe ahora (hardware desconectado: no pudo enlazarse).
+ * @param {LinkRule[]} saved
+ * @param {LinkRule[]} links - Enlaces actuales (nombres exactos)
+ * @param {string[]} [ports] - Puertos capturados ("nodo:puerto"); por defecto,
+ *   los extremos de los enlaces
+ * @param {string[]} [present] - Todos los puertos del grafo; sin él, ambos
+ *   extremos se dan por presentes
+ * @returns {LinkRule[]}
+ */
+export function rulesFromLinks(saved, links, ports, present) {
+  const captured = normalizeLinkRules(links);
+  const covered = new Set(ports ?? captured.flatMap(link => [link.output, link.input]));
+  const exists = present ? new Set(present) : null;
+  const replaced = rule =>
+    !/[*?[]/.test(rule.output + rule.input) &&
+    (covered.has(rule.output) || covered.has(rule.input)) &&
+    (!exists || (exists.has(rule.output) && exists.has(rule.input)));
+  const kept = normalizeLinkRules(saved).filter(rule => !replaced(rule));
+  return normalizeLinkRules([...kept, ...captured]);
+}
+
+/**
+ * @returns {LinkRule[]}
+ */
+export function loadLinkRules() {
+  try {
+    return normalizeLinkRules(JSON.parse(localStorage.getItem(STORAGE_KEYS.PIPEWIRE_LINK_RULES) || '[]'));
+  } catch {
+    return [];
+  }
+}
+
+/**
+ * Guarda las reglas y las aplica si el manager está arrancado.
+ * @param {LinkRule[]} rules
+ * @returns {LinkRule[]} Reglas guardadas
+ */
+export function saveLinkRules(rules) {
+  const normalized = normalizeLinkRules(rules);
+  localStorage.setItem(STORAGE_KEYS.PIPEWIRE_LINK_RULES, JSON.stringify(normalized));
+  getLinksAPI()?.setRules(normalized);
+  return normalized;
+}
+
+/**
+ * Arranca el LinkManager nativo con las reglas guardadas (idempotente).
+ * Se llama antes de abrir los streams para que los enlaces se creen en
+ * cuanto aparezcan sus puertos.
+ * @returns {boolean} true si el manager está activo
+ */
+export function startLinkManager() {
+  const api = getLinksAPI();
+  if (!api) return false;
+  const rules = loadLinkRules();
+  const result = api.start(rules);
+  if (!result.success) {
+    log.warn('PipeWire link manager not started:', result.error);
+    return false;
+  }
+  if (rules.length > 0) {
+    log.info(`PipeWire link manager restoring ${rules.length} link rules`);
+  }
+  if (exitCaptureTarget !== window) {
+    // Los streams siguen abiertos al salir: sus enlaces aún existen
+    window.addEventListener('beforeunload', () => captureLinkRules());
+    exitCaptureTarget = window;
+  }
+  return true;
+}
+
+/**
+ * Guarda como reglas los enlaces actuales de los nodos SynthiGME. Un puerto
+ * abierto sin enlaces borra sus reglas: el ruteo deshecho no vuelve.
+ * @param {string} [nodePattern]
+ * @returns {LinkRule[]|null} Reglas guardadas (null sin manager o sin puertos SynthiGME)
+ */
+export function captureLinkRules(nodePattern = SYNTHI_NODE_PATTERN) {
+  const api = getLinksAPI();
+  const ports = api?.ports(nodePattern);
+  if (!ports?.length) return null;
+  return saveLinkRules(rulesFromLinks(loadLinkRules(), api.snapshot(nodePattern), ports, api.ports('*')));
+}
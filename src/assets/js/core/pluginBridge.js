@@ -0,0 +1,91 @@
+/**
+ * Plugin bridge - Envío/retorno con el plugin LV2 synthigme-bridge
+ *
+ * Con el puente activo, un DAW con el plugin `synthigme-bridge.lv2` en una
+ * pista intercambia audio con SynthiGME por memoria compartida
+ * (shm_bridge.h), en su propio callback y con la latencia informada al
+ * host, en lugar de enrutar por el grafo PipeWire:
+ *
+ * - retorno: copia de las salidas multicanal (por defecto Out 1-2)
+ * - envío: se suma a las entradas multicanal (por defecto input_amp 1-2)
+ *
+ * Es opcional (localStorage) y solo funciona con el stream multicanal nativo.
+ *
+ * @example
+ * ```javascript
+ * setPluginBridgeEnabled(true);
+ * startPluginBridge({ sampleRate: 48000, pipelineFrames: 2048 });
+ * ```
+ */
+
+import { createLogger } from '../utils/logger.js';
+import { STORAGE_KEYS } from '../utils/constants.js';
+
+const log = createLogger('PluginBridge');
+
+/** Cebado de cada ring (frames): margen para quantums distintos en DAW y PipeWire */
+export const PLUGIN_BRIDGE_LATENCY_FRAMES = 512;
+
+function getBridgeAPI() {
+  return typeof window !== 'undefined' && window.pluginBridgeAPI?.isAvailable()
+    ? window.pluginBridgeAPI
+    : null;
+}
+
+/**
+ * @returns {boolean}
+ */
+export function isPluginBridgeEnabled() {
+  return localStorage.getItem(STORAGE_KEYS.PLUGIN_BRIDGE) === 'true';
+}
+
+/**
+ * Persiste la preferencia; desactivar cierra el puente si está abierto.
+ * @param {boolean} enabled
+ */
+export function setPluginBridgeEnabled(enabled) {
+  localStorage.setItem(STORAGE_KEYS.PLUGIN_BRIDGE, String(Boolean(enabled)));
+  if (!enabled) {
+    stopPluginBridge();
+  }
+}
+
+/**
+ * Latencia propia de la app entre lo que entra por la captura y lo que sale
+ * al stream: prebuffer nativo de salida + base del AudioContext.
+ * @param {AudioContext} ctx
+ * @param {number} prebufferFrames
+ * @returns {number} frames
+ */
+export function estimatePipelineFrames(ctx, prebufferFrames = 0) {
+  const sampleRate = ctx?.sampleRate || 48000;
+  const baseFrames = Math.round((ctx?.baseLatency || 0) * sampleRate);
+  return Math.max(0, Math.round(prebufferFrames) + baseFrames);
+}
+
+/**
+ * Abre el puente si está habilitado. Se llama al activar la salida
+ * multicanal nativa (el preload lo adjunta también a la entrada).
+ * @param {Object} options - { sampleRate, pipelineFrames }
+ * @returns {boolean} true si el puente quedó abierto
+ */
+export function startPluginBridge({ sampleRate = 48000, pipelineFrames = 0 } = {}) {
+  if (!isPluginBridgeEnabled()) return false;
+  const api = getBridgeAPI();
+  if (!api) return false;
+  const result = api.start({
+    sampleRate,
+    latencyFrames: PLUGIN_BRIDGE_LATENCY_FRAMES,
+    pipelineFrames
+  });
+  if (!result.success) {
+    log.warn('Plugin bridge not started:', result.error);
+    return false;
+  }
+  log.info(`Plugin bridge open (${sampleRate} Hz, pipeline ${pipelineFrames} frames)`);
+  return true;
+}
+
+export function stopPluginBridge() {
+  getBridgeAPI()?.stop();
+}
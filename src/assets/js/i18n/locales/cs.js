@@ -164,6 +164,8 @@ export default {
   "settings.shortcuts.knobModifiers": "Otočné knoflíky: podržte Ctrl/Cmd pro 10x rychlejší pohyb, Shift pro 10x jemnější ovládání.",
   "settings.shortcuts.mute": "Ztlumit/Zrušit ztlumení",
   "settings.shortcuts.record": "Nahrávat/Zastavit",
+  "settings.shortcuts.automationRecord": "Nahrávat/Zastavit automatizaci",
+  "settings.shortcuts.automationPlay": "Přehrát/Zastavit automatizaci",
   "settings.shortcuts.patches": "Otevřít patches",
   "settings.shortcuts.settings": "Otevřít nastavení",
   "settings.shortcuts.fullscreen": "Přepnout na celou obrazovku",
@@ -204,6 +206,8 @@ export default {
   "audio.mode.stereo": "Stereo",
   "audio.mode.multichannel": "Vícekanálový (12ch)",
   "audio.mode.multichannel.desc": "12 nezávislých kanálů přes PipeWire. Směrovat v qpwgraph.",
+  "audio.mode.nativeStereo": "Stereo přes nativní PipeWire",
+  "audio.mode.nativeStereo.tooltip": "Posílá stereo výstup i vstup přímo přes PipeWire místo zvukového stacku Chromia. Nižší latence se statistikou podtečení. Používá výchozí zařízení.",
   "audio.mode.unavailable": "(Vyžaduje Electron + PipeWire)",
   "audio.outputs.title": "Výstupy → Systém",
   "audio.outputs.channels": "Zjištěné kanály:",
@@ -224,6 +228,8 @@ export default {
   "audio.latency.description": "Upravte zvukový buffer. Nižší = rychlejší odezva, ale vyšší riziko praskání.",
   "audio.latency.webAudio": "Web Audio Buffer:",
   "audio.latency.multichannel": "Vícekanálový buffer:",
+  "audio.latency.driverMode": "SynthiGME jako hlavní hodiny (driver)",
+  "audio.latency.driverMode.tooltip": "Graf PipeWire sleduje tempo Web Audio. Buffer klesne na ~1 kvantum; ostatní zařízení v grafu sledují hodiny SynthiGME.",
   "audio.latency.interactive": "~10ms (Interaktivní)",
   "audio.latency.balanced": "~25ms (Vyvážený)",
   "audio.latency.playback": "~50ms (Přehrávání)",
@@ -303,6 +309,11 @@ export default {
   "toast.recordingStarted": "Nahrávání zahájeno",
   "toast.recordingSaved": "Nahrávání uloženo: {filename}",
   "toast.recordingEmpty": "Žádný zvuk nahraný",
+  "toast.automationRecordingStarted": "Nahrávání automatizace zahájeno",
+  "toast.automationSaved": "Automatizace nahrána: {events} událostí",
+  "toast.automationEmpty": "Žádná automatizace nenahrána",
+  "toast.automationPlaybackStarted": "Přehrávání automatizace",
+  "toast.automationPlaybackEnded": "Přehrávání automatizace dokončeno",
   "toast.recordingError": "Chyba nahrávání",
   "settings.reset": "Obnovit výchozí nastavení",
   "settings.reset.description": "Odstraní všechny uložené předvolby a obnoví výchozí hodnoty. Stránka se znovu načte.",
@@ -164,6 +164,8 @@ export default {
   "settings.shortcuts.knobModifiers": "Knöpfe: Halten Sie Strg/Befehl für 10x schnellere Bewegung, Umschalt für 10x feinere Kontrolle.",
   "settings.shortcuts.mute": "Stummschalten/Aktivieren",
   "settings.shortcuts.record": "Aufnahme/Stopp",
+  "settings.shortcuts.automationRecord": "Automation aufnehmen/stoppen",
+  "settings.shortcuts.automationPlay": "Automation abspielen/stoppen",
   "settings.shortcuts.patches": "Patches öffnen",
   "settings.shortcuts.settings": "Einstellungen öffnen",
   "settings.shortcuts.fullscreen": "Vollbild umschalten",
@@ -204,6 +206,8 @@ export default {
   "audio.mode.stereo": "Stereo",
   "audio.mode.multichannel": "Mehrkanalig (12K)",
   "audio.mode.multichannel.desc": "12 unabhängige Kanäle über PipeWire. Routing in qpwgraph.",
+  "audio.mode.nativeStereo": "Stereo über natives PipeWire",
+  "audio.mode.nativeStereo.tooltip": "Leitet Stereo-Ausgang und -Eingang direkt über PipeWire statt über den Audio-Stack von Chromium. Geringere Latenz, mit Underflow-Statistik. Verwendet das Standardgerät.",
   "audio.mode.unavailable": "(Erfordert Electron + PipeWire)",
   "audio.outputs.title": "Ausgänge → System",
   "audio.outputs.channels": "Erkannte Kanäle:",
@@ -224,6 +228,8 @@ export default {
   "audio.latency.description": "Audiopuffer anpassen. Niedriger = schnellere Reaktion, aber höheres Risiko von Klicks.",
   "audio.latency.webAudio": "Web Audio Puffer:",
   "audio.latency.multichannel": "Mehrkanal-Puffer:",
+  "audio.latency.driverMode": "SynthiGME als Master-Clock (Driver)",
+  "audio.latency.driverMode.tooltip": "Der PipeWire-Graph folgt dem Web-Audio-Takt. Der Puffer sinkt auf ~1 Quantum; andere Geräte im Graph folgen der Clock von SynthiGME.",
   "audio.latency.interactive": "~10ms (Interaktiv)",
   "audio.latency.balanced": "~25ms (Ausgewogen)",
   "audio.latency.playback": "~50ms (Wiedergabe)",
@@ -303,6 +309,11 @@ export default {
   "toast.recordingStarted": "Aufnahme gestartet",
   "toast.recordingSaved": "Aufnahme gespeichert: {filename}",
   "toast.recordingEmpty": "Kein Audio aufgezeichnet",
+  "toast.automationRecordingStarted": "Automationsaufnahme gestartet",
+  "toast.automationSaved": "Automation aufgenommen: {events} Ereignisse",
+  "toast.automationEmpty": "Keine Automation aufgenommen",
+  "toast.automationPlaybackStarted": "Automation wird abgespielt",
+  "toast.automationPlaybackEnded": "Automationswiedergabe beendet",
   "toast.recordingError": "Aufnahmefehler",
   "settings.reset": "Standardeinstellungen wiederherstellen",
   "settings.reset.description": "Entfernt alle gespeicherten Einstellungen und stellt die Standardwerte wieder her. Die Seite wird neu geladen.",
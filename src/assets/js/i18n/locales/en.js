@@ -164,6 +164,8 @@ export default {
   "settings.shortcuts.knobModifiers": "Knobs: hold Ctrl/Cmd for 10× faster movement, Shift for 10× finer control.",
   "settings.shortcuts.mute": "Mute/Unmute",
   "settings.shortcuts.record": "Record/Stop",
+  "settings.shortcuts.automationRecord": "Record/Stop automation",
+  "settings.shortcuts.automationPlay": "Play/Stop automation",
   "settings.shortcuts.patches": "Open patches",
   "settings.shortcuts.settings": "Open settings",
   "settings.shortcuts.fullscreen": "Toggle fullscreen",
@@ -204,6 +206,8 @@ export default {
   "audio.mode.stereo": "Stereo",
   "audio.mode.multichannel": "Multichannel (12ch)",
   "audio.mode.multichannel.desc": "Outputs 12 independent channels via PipeWire. Route in qpwgraph.",
+  "audio.mode.nativeStereo": "Stereo via native PipeWire",
+  "audio.mode.nativeStereo.tooltip": "Sends stereo output and input through PipeWire directly instead of Chromium's audio stack. Lower latency, with underflow stats. Uses the default device.",
   "audio.mode.unavailable": "(Requires Electron + PipeWire)",
   "audio.outputs.title": "Outputs → System",
   "audio.outputs.channels": "Detected channels:",
@@ -224,6 +228,8 @@ export default {
   "audio.latency.description": "Adjust audio buffer. Lower = faster response but higher risk of clicks.",
   "audio.latency.webAudio": "Web Audio Buffer:",
   "audio.latency.multichannel": "Multichannel Buffer:",
+  "audio.latency.driverMode": "SynthiGME as master clock (driver)",
+  "audio.latency.driverMode.tooltip": "The PipeWire graph follows the Web Audio pace. Buffer drops to ~1 quantum; other devices in the graph follow SynthiGME's clock.",
   "audio.latency.interactive": "~10ms (Interactive)",
   "audio.latency.balanced": "~25ms (Balanced)",
   "audio.latency.playback": "~50ms (Playback)",
@@ -303,6 +309,11 @@ export default {
   "toast.recordingStarted": "Recording started",
   "toast.recordingSaved": "Recording saved: {filename}",
   "toast.recordingEmpty": "No audio recorded",
+  "toast.automationRecordingStarted": "Automation recording started",
+  "toast.automationSaved": "Automation recorded: {events} events",
+  "toast.automationEmpty": "No automation recorded",
+  "toast.automationPlaybackStarted": "Playing automation",
+  "toast.automationPlaybackEnded": "Automation playback finished",
   "toast.recordingError": "Recording error",
   "settings.reset": "Restore default settings",
   "settings.reset.description": "Remove all saved preferences and restore default values. The page will reload.",
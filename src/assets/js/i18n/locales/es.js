@@ -164,6 +164,8 @@ export default {
   "settings.shortcuts.knobModifiers": "Knobs: mantén Ctrl/Cmd para mover 10× más rápido y Shift para 10× más preciso.",
   "settings.shortcuts.mute": "Silenciar/Activar",
   "settings.shortcuts.record": "Grabar/Detener",
+  "settings.shortcuts.automationRecord": "Grabar/Detener automatización",
+  "settings.shortcuts.automationPlay": "Reproducir/Detener automatización",
   "settings.shortcuts.patches": "Abrir patches",
   "settings.shortcuts.settings": "Abrir ajustes",
   "settings.shortcuts.fullscreen": "Pantalla completa",
@@ -204,6 +206,8 @@ export default {
   "audio.mode.stereo": "Estéreo",
   "audio.mode.multichannel": "Multicanal (12ch)",
   "audio.mode.multichannel.desc": "12 canales independientes vía PipeWire. Rutea en qpwgraph.",
+  "audio.mode.nativeStereo": "Estéreo vía PipeWire nativo",
+  "audio.mode.nativeStereo.tooltip": "Envía la salida y la entrada estéreo directamente por PipeWire en lugar de la pila de audio de Chromium. Menor latencia, con estadísticas de underflows. Usa el dispositivo por defecto.",
   "audio.mode.unavailable": "(Requiere Electron + PipeWire)",
   "audio.outputs.title": "Salidas → Sistema",
   "audio.outputs.channels": "Canales detectados:",
@@ -224,6 +228,8 @@ export default {
   "audio.latency.description": "Ajusta el buffer de audio. Menor = respuesta más rápida pero más riesgo de clicks.",
   "audio.latency.webAudio": "Buffer Web Audio:",
   "audio.latency.multichannel": "Buffer Multicanal:",
+  "audio.latency.driverMode": "SynthiGME como reloj maestro (driver)",
+  "audio.latency.driverMode.tooltip": "El grafo PipeWire sigue el ritmo de Web Audio. El buffer baja a ~1 quantum; el resto de dispositivos del grafo siguen el reloj de SynthiGME.",
   "audio.latency.interactive": "~10ms (Interactivo)",
   "audio.latency.balanced": "~25ms (Equilibrado)",
   "audio.latency.playback": "~50ms (Reproducción)",
@@ -303,6 +309,11 @@ export default {
   "toast.recordingStarted": "Grabación iniciada",
   "toast.recordingSaved": "Grabación guardada: {filename}",
   "toast.recordingEmpty": "No se grabó audio",
+  "toast.automationRecordingStarted": "Grabación de automatización iniciada",
+  "toast.automationSaved": "Automatización grabada: {events} eventos",
+  "toast.automationEmpty": "No hay automatización grabada",
+  "toast.automationPlaybackStarted": "Reproduciendo automatización",
+  "toast.automationPlaybackEnded": "Reproducción de automatización terminada",
   "toast.recordingError": "Error al grabar",
   "settings.reset": "Restaurar ajustes por defecto",
   "settings.reset.description": "Elimina todas las preferencias guardadas y restaura los valores por defecto. La página se recargará.",
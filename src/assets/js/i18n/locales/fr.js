@@ -164,6 +164,8 @@ export default {
   "settings.shortcuts.knobModifiers": "Boutons : maintenez Ctrl/Cmd pour un mouvement 10× plus rapide, Shift pour un contrôle 10× plus fin.",
   "settings.shortcuts.mute": "Sourdine/Activer",
   "settings.shortcuts.record": "Enregistrer/Arrêter",
+  "settings.shortcuts.automationRecord": "Enregistrer/Arrêter l'automation",
+  "settings.shortcuts.automationPlay": "Lire/Arrêter l'automation",
   "settings.shortcuts.patches": "Ouvrir les patches",
   "settings.shortcuts.settings": "Ouvrir les paramètres",
   "settings.shortcuts.fullscreen": "Basculer en plein écran",
@@ -204,6 +206,8 @@ export default {
   "audio.mode.stereo": "Stéréo",
   "audio.mode.multichannel": "Multicanal (12 canaux)",
   "audio.mode.multichannel.desc": "12 canaux indépendants via PipeWire. Routez dans qpwgraph.",
+  "audio.mode.nativeStereo": "Stéréo via PipeWire natif",
+  "audio.mode.nativeStereo.tooltip": "Envoie la sortie et l'entrée stéréo directement via PipeWire au lieu de la pile audio de Chromium. Latence plus faible, avec statistiques d'underflows. Utilise le périphérique par défaut.",
   "audio.mode.unavailable": "(Nécessite Electron + PipeWire)",
   "audio.outputs.title": "Sorties → Système",
   "audio.outputs.channels": "Canaux détectés :",
@@ -224,6 +228,8 @@ export default {
   "audio.latency.description": "Ajuste le tampon audio. Moins = réponse plus rapide mais plus de risque de clics.",
   "audio.latency.webAudio": "Tampon Web Audio :",
   "audio.latency.multichannel": "Tampon Multicanal :",
+  "audio.latency.driverMode": "SynthiGME comme horloge maître (driver)",
+  "audio.latency.driverMode.tooltip": "Le graphe PipeWire suit le rythme de Web Audio. Le tampon descend à ~1 quantum ; les autres périphériques du graphe suivent l'horloge de SynthiGME.",
   "audio.latency.interactive": "~10ms (Interactif)",
   "audio.latency.balanced": "~25ms (Équilibré)",
   "audio.latency.playback": "~50ms (Lecture)",
@@ -303,6 +309,11 @@ export default {
   "toast.recordingStarted": "Enregistrement commencé",
   "toast.recordingSaved": "Enregistrement enregistré : {filename}",
   "toast.recordingEmpty": "Aucun audio enregistré",
+  "toast.automationRecordingStarted": "Enregistrement de l'automation commencé",
+  "toast.automationSaved": "Automation enregistrée : {events} événements",
+  "toast.automationEmpty": "Aucune automation enregistrée",
+  "toast.automationPlaybackStarted": "Lecture de l'automation",
+  "toast.automationPlaybackEnded": "Lecture de l'automation terminée",
   "toast.recordingError": "Erreur d'enregistrement",
   "settings.reset": "Restaurer les paramètres par défaut",
   "settings.reset.description": "Supprime toutes les préférences enregistrées et restaure les valeurs par défaut. La page sera rechargée.",
@@ -164,6 +164,8 @@ export default {
   "settings.shortcuts.knobModifiers": "Manopole: tieni premuto Ctrl/Cmd per movimento 10x più veloce, Maiusc per controllo 10x più fine.",
   "settings.shortcuts.mute": "Silenzioso/Non silenzioso",
   "settings.shortcuts.record": "Registra/Ferma",
+  "settings.shortcuts.automationRecord": "Registra/Ferma automazione",
+  "settings.shortcuts.automationPlay": "Riproduci/Ferma automazione",
   "settings.shortcuts.patches": "Apri patch",
   "settings.shortcuts.settings": "Apri impostazioni",
   "settings.shortcuts.fullscreen": "Attiva/disattiva schermo intero",
@@ -204,6 +206,8 @@ export default {
   "audio.mode.stereo": "Stereo",
   "audio.mode.multichannel": "Multicanale (12ch)",
   "audio.mode.multichannel.desc": "12 canali indipendenti tramite PipeWire. Instrada in qpwgraph.",
+  "audio.mode.nativeStereo": "Stereo tramite PipeWire nativo",
+  "audio.mode.nativeStereo.tooltip": "Invia uscita e ingresso stereo direttamente tramite PipeWire invece dello stack audio di Chromium. Latenza inferiore, con statistiche di underflow. Usa il dispositivo predefinito.",
   "audio.mode.unavailable": "(Richiede Electron + PipeWire)",
   "audio.outputs.title": "Uscite → Sistema",
   "audio.outputs.channels": "Canali rilevati:",
@@ -224,6 +228,8 @@ export default {
   "audio.latency.description": "Regola il buffer audio. Minore = risposta più veloce ma maggiore rischio di clic.",
   "audio.latency.webAudio": "Buffer Web Audio:",
   "audio.latency.multichannel": "Buffer Multicanale:",
+  "audio.latency.driverMode": "SynthiGME come clock master (driver)",
+  "audio.latency.driverMode.tooltip": "Il grafo PipeWire segue il ritmo di Web Audio. Il buffer scende a ~1 quantum; gli altri dispositivi del grafo seguono il clock di SynthiGME.",
   "audio.latency.interactive": "~10ms (Interattivo)",
   "audio.latency.balanced": "~25ms (Bilanciato)",
   "audio.latency.playback": "~50ms (Riproduzione)",
@@ -303,6 +309,11 @@ export default {
   "toast.recordingStarted": "Registrazione iniziata",
   "toast.recordingSaved": "Registrazione salvata: {filename}",
   "toast.recordingEmpty": "Nessun audio registrato",
+  "toast.automationRecordingStarted": "Registrazione automazione iniziata",
+  "toast.automationSaved": "Automazione registrata: {events} eventi",
+  "toast.automationEmpty": "Nessuna automazione registrata",
+  "toast.automationPlaybackStarted": "Riproduzione automazione",
+  "toast.automationPlaybackEnded": "Riproduzione automazione terminata",
   "toast.recordingError": "Errore di registrazione",
   "settings.reset": "Ripristina impostazioni predefinite",
   "settings.reset.description": "Rimuove tutte le preferenze salvate e ripristina i valori predefiniti. La pagina verrà ricaricata.",
@@ -164,6 +164,8 @@ export default {
   "settings.shortcuts.knobModifiers": "Botões: mantenha Ctrl/Cmd pressionado para movimento 10x mais rápido, Shift para controle 10x mais fino.",
   "settings.shortcuts.mute": "Mutar/Desmutar",
   "settings.shortcuts.record": "Gravar/Parar",
+  "settings.shortcuts.automationRecord": "Gravar/Parar automação",
+  "settings.shortcuts.automationPlay": "Reproduzir/Parar automação",
   "settings.shortcuts.patches": "Abrir patches",
   "settings.shortcuts.settings": "Abrir configurações",
   "settings.shortcuts.fullscreen": "Alternar tela cheia",
@@ -204,6 +206,8 @@ export default {
   "audio.mode.stereo": "Estéreo",
   "audio.mode.multichannel": "Multicanal (12ch)",
   "audio.mode.multichannel.desc": "12 canais independentes via PipeWire. Rotear no qpwgraph.",
+  "audio.mode.nativeStereo": "Estéreo via PipeWire nativo",
+  "audio.mode.nativeStereo.tooltip": "Envia a saída e a entrada estéreo diretamente pelo PipeWire em vez da pilha de áudio do Chromium. Menor latência, com estatísticas de underflows. Usa o dispositivo predefinido.",
   "audio.mode.unavailable": "(Requer Electron + PipeWire)",
   "audio.outputs.title": "Saídas → Sistema",
   "audio.outputs.channels": "Canais detectados:",
@@ -224,6 +228,8 @@ export default {
   "audio.latency.description": "Ajustar buffer de áudio. Menor = resposta mais rápida, mas maior risco de cliques.",
   "audio.latency.webAudio": "Buffer Web Audio:",
   "audio.latency.multichannel": "Buffer Multicanal:",
+  "audio.latency.driverMode": "SynthiGME como relógio mestre (driver)",
+  "audio.latency.driverMode.tooltip": "O grafo PipeWire segue o ritmo do Web Audio. O buffer desce para ~1 quantum; os restantes dispositivos do grafo seguem o relógio do SynthiGME.",
   "audio.latency.interactive": "~10ms (Interativo)",
   "audio.latency.balanced": "~25ms (Equilibrado)",
   "audio.latency.playback": "~50ms (Reprodução)",
@@ -303,6 +309,11 @@ export default {
   "toast.recordingStarted": "Gravação iniciada",
   "toast.recordingSaved": "Gravação salva: {filename}",
   "toast.recordingEmpty": "Nenhum áudio gravado",
+  "toast.automationRecordingStarted": "Gravação de automação iniciada",
+  "toast.automationSaved": "Automação gravada: {events} eventos",
+  "toast.automationEmpty": "Nenhuma automação gravada",
+  "toast.automationPlaybackStarted": "Reproduzindo automação",
+  "toast.automationPlaybackEnded": "Reprodução de automação concluída",
   "toast.recordingError": "Erro de gravação",
   "settings.reset": "Restaurar configurações padrão",
   "settings.reset.description": "Remove todas as preferências salvas e restaura os valores padrão. A página será recarregada.",
@@ -10,6 +10,8 @@
  * - Mecanismo anti-loop para evitar reenvíos infinitos
  * - Configuración de prefijo OSC personalizable
  * - Callbacks para mensajes entrantes
+ * - Taps de cambios de parámetros (grabación de automatización) y despacho
+ *   local de direcciones (reproducción)
  *
  * @module osc/oscBridge
  * @see /OSC.md - Documentación completa del protocolo
@@ -48,6 +50,12 @@ class OSCBridge {
     
     /** @type {Map<string, Set<Function>>} Callbacks por dirección OSC */
     this._listeners = new Map();
+
+    /** @type {Set<Function>} Observadores de todos los cambios de parámetros */
+    this._taps = new Set();
+
+    /** @type {boolean} true mientras dispatchLocal entrega un mensaje */
+    this.dispatchingLocal = false;
   }
 
   /**
@@ -177,8 +185,16 @@ class OSCBridge {
    * oscBridge.send('/SynthiGME/osc/1/frequency', 5.0, { skipPrefix: true });
    */
   send(address, value, options = {}) {
+    // Normalizar valor a array
+    const args = Array.isArray(value) ? value : [value];
+
+    // Los taps ven el cambio aunque no haya red OSC
+    this._tap(address, args, 'local');
+
     if (!this.connected || !this.config.sendEnabled) {
-      console.log('[OSCBridge] send blocked - connected:', this.connected, 'sendEnabled:', this.config.sendEnabled);
+      if (this._taps.size === 0) {
+        console.log('[OSCBridge] send blocked - connected:', this.connected, 'sendEnabled:', this.config.sendEnabled);
+      }
       return false;
     }
 
@@ -189,9 +205,6 @@ class OSCBridge {
       fullAddress = prefix + address;
     }
 
-    // Normalizar valor a array
-    const args = Array.isArray(value) ? value : [value];
-
     if (this.config.verbose) {
       console.log('[OSCBridge] Enviando:', fullAddress, args);
     }
@@ -260,6 +273,50 @@ class OSCBridge {
     return this.on('*', callback);
   }
 
+  /**
+   * Registra un observador de todos los cambios de parámetros de la app:
+   * los locales (mandos, matriz, MIDI Learn; pasan por send aunque no haya
+   * red OSC), los OSC entrantes y los despachados con dispatchLocal.
+   *
+   * @param {Function} callback - (address, args, source) => {} con la dirección
+   *   relativa (sin prefijo) y source 'local' | 'osc' | 'automation'
+   * @returns {Function} Función para cancelar
+   */
+  addTap(callback) {
+    this._taps.add(callback);
+    return () => this._taps.delete(callback);
+  }
+
+  /**
+   * Indica si los módulos de sincronización deben generar mensajes para los
+   * cambios locales: hay red OSC o algún tap escuchando.
+   * @returns {boolean}
+   */
+  wantsLocalChanges() {
+    return this.connected || this._taps.size > 0;
+  }
+
+  /**
+   * Entrega un mensaje a los listeners como si hubiera llegado por OSC, sin
+   * red (reproducción de automatización). Mientras dura, dispatchingLocal es
+   * true: los módulos de sincronización no descartan el mensaje por su
+   * ventana anti-rebote.
+   *
+   * @param {string} address - Dirección relativa (sin prefijo)
+   * @param {Array} args - Argumentos del mensaje
+   */
+  dispatchLocal(address, args) {
+    this._tap(address, args, 'automation');
+
+    this.dispatchingLocal = true;
+    try {
+      const value = args.length === 1 ? args[0] : args;
+      this._notifyListeners(this.getFormattedPrefix() + address, value, null);
+    } finally {
+      this.dispatchingLocal = false;
+    }
+  }
+
   /**
    * Actualiza la configuración
    * @param {Object} config - Nueva configuración parcial
@@ -294,6 +351,8 @@ class OSCBridge {
         console.log('[OSCBridge] Recibido:', address, args, 'de', from);
       }
 
+      this._tap(address, args, 'osc');
+
       // Extraer valor (primer argumento o array completo)
       const value = args.length === 1 ? args[0] : args;
 
@@ -352,6 +411,24 @@ class OSCBridge {
     });
   }
 
+  /**
+   * Notifica un cambio a los taps con la dirección sin prefijo
+   * @private
+   */
+  _tap(address, args, source) {
+    if (this._taps.size === 0) return;
+
+    const prefix = this.getFormattedPrefix();
+    const relative = address.startsWith(prefix) ? address.slice(prefix.length) : address;
+    this._taps.forEach(cb => {
+      try {
+        cb(relative, args, source);
+      } catch (err) {
+        console.error('[OSCBridge] Error en tap:', err);
+      }
+    });
+  }
+
   /**
    * Emite un evento de documento
    * @private
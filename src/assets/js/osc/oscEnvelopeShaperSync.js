@@ -113,7 +113,7 @@ class EnvelopeShaperOSCSync {
    * @param {number} dialValue - Valor del dial
    */
   sendChange(index, param, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
 
     const paramDef = MODULE_PARAMETERS[param];
     if (!paramDef) return;
@@ -137,7 +137,7 @@ class EnvelopeShaperOSCSync {
    * @param {boolean} active - true = gate on, false = gate off
    */
   sendGate(index, active) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
 
     const address = `env/${index}/${GATE_PARAMETER.address}`;
     oscBridge.send(address, active ? 1 : 0);
@@ -180,7 +180,7 @@ class EnvelopeShaperOSCSync {
    * @private
    */
   _handleIncoming(index, param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
@@ -217,7 +217,7 @@ class EnvelopeShaperOSCSync {
    * @private
    */
   _handleIncomingGate(index, value) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
@@ -47,7 +47,7 @@ class InputAmplifierOSCSync {
    * @param {number} uiValue - Valor del knob (0-1)
    */
   sendLevelChange(channel, uiValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const oscValue = uiToOSCValue(uiValue, 'in', 'level');
     const address = `in/${channel + 1}/level`;
@@ -87,7 +87,7 @@ class InputAmplifierOSCSync {
    * @private
    */
   _handleIncomingLevel(channel, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     const uiValue = oscToUIValue(oscValue, 'in', 'level');
 
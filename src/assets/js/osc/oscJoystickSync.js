@@ -56,7 +56,7 @@ class JoystickOSCSync {
    * @param {number} ny - Posición normalizada Y (-1..+1)
    */
   sendPositionChange(joyIndex, nx, ny) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const joyNum = joyIndex + 1;
     
@@ -84,7 +84,7 @@ class JoystickOSCSync {
    * @param {number} dialValue - Valor del knob (0-10)
    */
   sendRangeYChange(joyIndex, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const address = `joy/${joyIndex + 1}/rangeY`;
     
@@ -104,7 +104,7 @@ class JoystickOSCSync {
    * @param {number} dialValue - Valor del knob (0-10)
    */
   sendRangeXChange(joyIndex, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const address = `joy/${joyIndex + 1}/rangeX`;
     
@@ -147,7 +147,7 @@ class JoystickOSCSync {
    * @private
    */
   _handleIncoming(joyIndex, param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
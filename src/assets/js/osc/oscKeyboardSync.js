@@ -94,7 +94,7 @@ class KeyboardOSCSync {
    * @param {number} value - Valor del dial
    */
   sendChange(side, param, value) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
 
     const key = `${side}/${param}`;
     const address = PARAM_TO_ADDRESS[key];
@@ -116,7 +116,7 @@ class KeyboardOSCSync {
    * @param {number} velocity - Velocity (1-127)
    */
   sendNoteOn(side, note, velocity) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     oscBridge.send(`keyboard/${side}/noteOn`, [note, velocity]);
   }
 
@@ -126,7 +126,7 @@ class KeyboardOSCSync {
    * @param {number} note - Nota MIDI (0-127)
    */
   sendNoteOff(side, note) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     oscBridge.send(`keyboard/${side}/noteOff`, note);
   }
 
@@ -164,7 +164,7 @@ class KeyboardOSCSync {
    * @private
    */
   _handleIncoming(side, param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
@@ -204,7 +204,7 @@ class KeyboardOSCSync {
    * @private
    */
   _handleIncomingNote(side, type, value) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     const kbModule = this._app._keyboardModules?.[side];
     if (!kbModule) return;
@@ -472,7 +472,7 @@ class MatrixOSCSync {
    * @private
    */
   _sendPinChange(matrixType, rowIndex, colIndex, activate, pinColor) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
 
     // Obtener routing del panel correspondiente
     const routing = matrixType === 'audio'
@@ -555,7 +555,7 @@ class MatrixOSCSync {
    * @private
    */
   _handleIncoming(matrixType, fullAddress, value) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     // Extraer la parte de dirección tras el prefijo y tipo de matriz
     // fullAddress: /SynthiGME/audio/osc/1/sinSaw/Out/1
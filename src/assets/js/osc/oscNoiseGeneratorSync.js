@@ -59,7 +59,7 @@ class NoiseGeneratorOSCSync {
    * @param {number} dialValue - Valor del dial (0-10)
    */
   sendColourChange(noiseIndex, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const address = `noise/${noiseIndex + 1}/colour`;
     
@@ -79,7 +79,7 @@ class NoiseGeneratorOSCSync {
    * @param {number} dialValue - Valor del dial (0-10)
    */
   sendLevelChange(noiseIndex, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const address = `noise/${noiseIndex + 1}/level`;
     
@@ -122,7 +122,7 @@ class NoiseGeneratorOSCSync {
    * @private
    */
   _handleIncoming(noiseIndex, param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
@@ -76,7 +76,7 @@ class OscillatorOSCSync {
    * @param {number} uiValue - Valor del knob (0-1)
    */
   sendKnobChange(oscIndex, knobIndex, uiValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const oscKey = KNOB_INDEX_TO_OSC_KEY[knobIndex];
     if (!oscKey) return;
@@ -106,7 +106,7 @@ class OscillatorOSCSync {
    * @param {'hi'|'lo'} rangeState - Estado del switch
    */
   sendRangeChange(oscIndex, rangeState) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const address = `osc/${oscIndex + 1}/range`;
     
@@ -158,7 +158,7 @@ class OscillatorOSCSync {
    * @private
    */
   _handleIncomingKnob(oscIndex, param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     const knobIndex = OSC_KEY_TO_KNOB_INDEX[param];
     if (knobIndex === undefined) return;
@@ -198,7 +198,7 @@ class OscillatorOSCSync {
    * @private
    */
   _handleIncomingRange(oscIndex, rangeValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     const normalizedRange = (rangeValue === 'lo' || rangeValue === 'LO') ? 'lo' : 'hi';
 
@@ -59,7 +59,7 @@ class OutputChannelOSCSync {
    * @param {number} dialValue - Valor del fader (0-10)
    */
   sendLevelChange(channel, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const address = `out/${channel + 1}/level`;
     
@@ -79,7 +79,7 @@ class OutputChannelOSCSync {
    * @param {number} value - Valor bipolar (-5 a 5)
    */
   sendFilterChange(channel, value) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const address = `out/${channel + 1}/filter`;
     
@@ -99,7 +99,7 @@ class OutputChannelOSCSync {
    * @param {number} value - Valor interno del pan (-1 a 1)
    */
   sendPanChange(channel, value) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     // Convertir de rango interno (-1..+1) a escala OSC (0-10)
     // -1 = 0, 0 = 5, +1 = 10
@@ -122,7 +122,7 @@ class OutputChannelOSCSync {
    * @param {boolean} isOn - Estado del switch
    */
   sendPowerChange(channel, isOn) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const oscValue = isOn ? 1 : 0;
     const address = `out/${channel + 1}/on`;
@@ -165,7 +165,7 @@ class OutputChannelOSCSync {
    * @private
    */
   _handleIncoming(channel, param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
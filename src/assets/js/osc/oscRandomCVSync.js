@@ -76,7 +76,7 @@ class RandomCVOSCSync {
    * @param {number} dialValue - Valor del dial
    */
   sendChange(param, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
     
     const address = PARAM_TO_ADDRESS[param];
     if (!address) return;
@@ -116,7 +116,7 @@ class RandomCVOSCSync {
    * @private
    */
   _handleIncoming(param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
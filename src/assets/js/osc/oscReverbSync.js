@@ -67,7 +67,7 @@ class ReverbOSCSync {
    * @param {number} dialValue - Valor del dial (0-10)
    */
   sendChange(param, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
 
     const address = PARAM_TO_ADDRESS[param];
     if (!address) return;
@@ -107,7 +107,7 @@ class ReverbOSCSync {
    * @private
    */
   _handleIncoming(param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
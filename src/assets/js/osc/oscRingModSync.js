@@ -66,7 +66,7 @@ class RingModOSCSync {
    * @param {number} dialValue - Valor del dial (0-10)
    */
   sendChange(index, param, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
 
     const paramDef = MODULE_PARAMETERS[param];
     if (!paramDef) return;
@@ -112,7 +112,7 @@ class RingModOSCSync {
    * @private
    */
   _handleIncoming(index, param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
@@ -100,7 +100,7 @@ class SequencerOSCSync {
    * @param {number} dialValue - Valor del dial
    */
   sendKnobChange(param, dialValue) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
 
     const paramDef = KNOB_PARAMETERS[param];
     if (!paramDef) return;
@@ -124,7 +124,7 @@ class SequencerOSCSync {
    * @param {boolean} active - true = on, false = off
    */
   sendSwitchChange(switchName, active) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
 
     const paramDef = SWITCH_PARAMETERS[switchName];
     if (!paramDef) return;
@@ -138,7 +138,7 @@ class SequencerOSCSync {
    * @param {string} buttonName - Nombre del botón
    */
   sendButtonPress(buttonName) {
-    if (!oscBridge.connected) return;
+    if (!oscBridge.wantsLocalChanges()) return;
 
     const paramDef = BUTTON_PARAMETERS[buttonName];
     if (!paramDef) return;
@@ -184,7 +184,7 @@ class SequencerOSCSync {
    * @private
    */
   _handleIncomingKnob(param, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
@@ -224,7 +224,7 @@ class SequencerOSCSync {
    * @private
    */
   _handleIncomingSwitch(switchName, oscValue) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
@@ -247,7 +247,7 @@ class SequencerOSCSync {
    * @private
    */
   _handleIncomingButton(buttonName) {
-    if (this._ignoreOSCUpdates || !this._app) return;
+    if ((this._ignoreOSCUpdates && !oscBridge.dispatchingLocal) || !this._app) return;
 
     this._ignoreOSCUpdates = true;
 
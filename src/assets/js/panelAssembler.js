@@ -903,7 +903,8 @@ export function buildPanel2(app) {
       beam1OffsetY: beamOffsets.beam1Y || 0,
       beam2OffsetY: beamOffsets.beam2Y || 0,
       centerOffsetX: centerOffset.x || 0,
-      centerOffsetY: centerOffset.y || 0
+      centerOffsetY: centerOffset.y || 0,
+      phosphor: displayStyles.phosphor
     });
     
     // Crear contenedor de knobs (a la derecha del display)
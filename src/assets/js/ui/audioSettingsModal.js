@@ -8,6 +8,9 @@ import { STORAGE_KEYS, OUTPUT_CHANNELS, INPUT_CHANNELS, DEFAULT_PHYSICAL_CHANNEL
 
 const log = createLogger('AudioSettingsModal');
 
+/** Latencia del buffer multicanal en modo driver (~1 quantum de 256 frames @ 48kHz) */
+const DRIVER_MODE_LATENCY_MS = 5;
+
 /**
  * Clase que maneja la ventana modal de configuración de audio del sistema.
  * Permite mapear N salidas lógicas a N salidas físicas de forma aditiva.
@@ -78,6 +81,11 @@ export class AudioSettingsModal {
     
     // Callbacks para cambios de modo
     this.onOutputModeChange = options.onOutputModeChange;
+    this.onNativeStereoChange = options.onNativeStereoChange;
+    
+    // Estéreo nativo (PipeWire 2ch en Linux): activo por defecto
+    this._nativeStereo = localStorage.getItem(STORAGE_KEYS.AUDIO_NATIVE_STEREO) !== 'false';
+    this._nativeStereoActive = false;  // Lo notifica audioSetup al abrir/cerrar el stream
     
     // Dispositivos seleccionados (solo relevante en modo estéreo)
     this.selectedOutputDevice = localStorage.getItem(STORAGE_KEYS.OUTPUT_DEVICE) || 'default';
@@ -728,6 +736,14 @@ export class AudioSettingsModal {
     if (els.inputDesc) els.inputDesc.textContent = t('audio.inputs.description');
     if (els.inputPermissionBtn) els.inputPermissionBtn.textContent = t('audio.inputs.enable');
     if (els.latencyLabel) els.latencyLabel.textContent = t('audio.latency.label') || 'Latencia:';
+    if (els.nativeStereoLabel) {
+      els.nativeStereoLabel.textContent = t('audio.mode.nativeStereo');
+      els.nativeStereoLabel.title = t('audio.mode.nativeStereo.tooltip');
+    }
+    if (els.driverModeLabel) {
+      els.driverModeLabel.textContent = t('audio.latency.driverMode');
+      els.driverModeLabel.title = t('audio.latency.driverMode.tooltip');
+    }
     
     // Actualizar nombres de configuración de canales
     this._updateChannelInfo();
@@ -897,6 +913,14 @@ export class AudioSettingsModal {
     if (selectedRadio) {
       selectedRadio.checked = true;
     }
+    
+    // Estéreo nativo: requiere el mismo addon PipeWire que el multicanal
+    if (this.nativeStereoRow) {
+      const showNativeStereo = this.multichannelAvailable
+        && this.outputMode === 'stereo'
+        && window.electronAPI?.platform === 'linux';
+      this.nativeStereoRow.style.display = showNativeStereo ? 'flex' : 'none';
+    }
   }
   
   /**
@@ -1323,6 +1347,34 @@ export class AudioSettingsModal {
     this._textElements.modeDesc.style.display = this.outputMode === 'multichannel' ? 'block' : 'none';
     modeContainer.appendChild(this._textElements.modeDesc);
     
+    // Estéreo nativo PipeWire (solo Linux con addon, en modo estéreo)
+    this.nativeStereoRow = document.createElement('div');
+    this.nativeStereoRow.className = 'audio-settings-mode__native-stereo';
+    this.nativeStereoRow.style.display = 'none'; // Se muestra en _updateOutputModeUI
+    
+    this.nativeStereoCheckbox = document.createElement('input');
+    this.nativeStereoCheckbox.type = 'checkbox';
+    this.nativeStereoCheckbox.id = 'audioNativeStereoCheckbox';
+    this.nativeStereoCheckbox.className = 'settings-checkbox';
+    this.nativeStereoCheckbox.checked = this._nativeStereo;
+    this.nativeStereoCheckbox.addEventListener('change', () => {
+      this._nativeStereo = this.nativeStereoCheckbox.checked;
+      localStorage.setItem(STORAGE_KEYS.AUDIO_NATIVE_STEREO, String(this._nativeStereo));
+      if (this.onNativeStereoChange) {
+        this.onNativeStereoChange(this._nativeStereo);
+      }
+    });
+    
+    this._textElements.nativeStereoLabel = document.createElement('label');
+    this._textElements.nativeStereoLabel.className = 'settings-checkbox-label';
+    this._textElements.nativeStereoLabel.htmlFor = 'audioNativeStereoCheckbox';
+    this._textElements.nativeStereoLabel.textContent = t('audio.mode.nativeStereo');
+    this._textElements.nativeStereoLabel.title = t('audio.mode.nativeStereo.tooltip');
+    
+    this.nativeStereoRow.appendChild(this.nativeStereoCheckbox);
+    this.nativeStereoRow.appendChild(this._textElements.nativeStereoLabel);
+    modeContainer.appendChild(this.nativeStereoRow);
+    
     section.appendChild(modeContainer);
     
     // ─────────────────────────────────────────────────────────────────────────
@@ -1530,6 +1582,40 @@ export class AudioSettingsModal {
     this.multichannelLatencyRow.appendChild(this.multichannelLatencySelect);
     section.appendChild(this.multichannelLatencyRow);
     
+    // ─────────────────────────────────────────────────────────────────────────
+    // MODO DRIVER (SynthiGME marca el reloj del grafo PipeWire)
+    // ─────────────────────────────────────────────────────────────────────────
+    this.driverModeRow = document.createElement('div');
+    this.driverModeRow.className = 'audio-settings-latency__row audio-settings-latency__row--multichannel';
+    this.driverModeRow.style.display = 'none'; // Oculto por defecto
+    
+    this.driverModeCheckbox = document.createElement('input');
+    this.driverModeCheckbox.type = 'checkbox';
+    this.driverModeCheckbox.id = 'audioDriverModeCheckbox';
+    this.driverModeCheckbox.className = 'settings-checkbox';
+    this._driverMode = localStorage.getItem(STORAGE_KEYS.AUDIO_DRIVER_MODE) === 'true';
+    this.driverModeCheckbox.checked = this._driverMode;
+    this.multichannelLatencySelect.disabled = this._driverMode;
+    
+    this._textElements.driverModeLabel = document.createElement('label');
+    this._textElements.driverModeLabel.className = 'settings-checkbox-label';
+    this._textElements.driverModeLabel.htmlFor = 'audioDriverModeCheckbox';
+    this._textElements.driverModeLabel.textContent = t('audio.latency.driverMode') || 'SynthiGME como reloj maestro (driver)';
+    this._textElements.driverModeLabel.title = t('audio.latency.driverMode.tooltip') || '';
+    
+    this.driverModeCheckbox.addEventListener('change', () => {
+      this._driverMode = this.driverModeCheckbox.checked;
+      localStorage.setItem(STORAGE_KEYS.AUDIO_DRIVER_MODE, String(this._driverMode));
+      // En modo driver el buffer lo fija el quantum, no el prebuffer
+      this.multichannelLatencySelect.disabled = this._driverMode;
+      this._updateTotalLatency();
+      this._showMultichannelLatencyMessage();
+    });
+    
+    this.driverModeRow.appendChild(this.driverModeCheckbox);
+    this.driverModeRow.appendChild(this._textElements.driverModeLabel);
+    section.appendChild(this.driverModeRow);
+    
     // Mensaje de reconexión para Multicanal
     this.multichannelLatencyMessage = document.createElement('div');
     this.multichannelLatencyMessage.className = 'audio-settings-latency__message audio-settings-latency__message--multichannel';
@@ -1584,15 +1670,17 @@ export class AudioSettingsModal {
   _updateTotalLatency() {
     if (!this.totalLatencyValue) return;
     
-    const isMultichannel = this.outputMode === 'multichannel';
+    const usesNativeBuffer = this.outputMode === 'multichannel' || this._nativeStereoActive;
     const webAudioMs = this._webAudioLatencyMs || 25;
-    const multichannelMs = isMultichannel ? (this._multichannelLatencyMs || 42) : 0;
+    // En modo driver la ocupación del ring es ~1 quantum (256 frames ≈ 5ms)
+    const bufferMs = this._driverMode ? DRIVER_MODE_LATENCY_MS : (this._multichannelLatencyMs || 42);
+    const multichannelMs = usesNativeBuffer ? bufferMs : 0;
     
     const totalMs = webAudioMs + multichannelMs;
     
     // Formatear el texto
     let text = `~${totalMs}ms`;
-    if (isMultichannel) {
+    if (usesNativeBuffer) {
       text += ` (${webAudioMs} + ${multichannelMs})`;
     }
     
@@ -1615,7 +1703,12 @@ export class AudioSettingsModal {
     if (!this.multichannelLatencyRow) return;
     
     const isMultichannel = this.outputMode === 'multichannel';
-    this.multichannelLatencyRow.style.display = isMultichannel ? 'flex' : 'none';
+    // El estéreo nativo usa el mismo buffer PipeWire (y modo driver) que el multicanal
+    const usesNativeBuffer = isMultichannel || this._nativeStereoActive;
+    this.multichannelLatencyRow.style.display = usesNativeBuffer ? 'flex' : 'none';
+    if (this.driverModeRow) {
+      this.driverModeRow.style.display = usesNativeBuffer ? 'flex' : 'none';
+    }
     
     // Actualizar descripción de modo
     if (this._textElements.modeDesc) {
@@ -1695,6 +1788,31 @@ export class AudioSettingsModal {
     return this._multichannelLatencyMs || 42;
   }
 
+  /**
+   * Indica si el usuario quiere el estéreo por PipeWire nativo (Linux)
+   * @returns {boolean}
+   */
+  getNativeStereo() {
+    return this._nativeStereo;
+  }
+
+  /**
+   * Notifica si el stream estéreo nativo está abierto (muestra su latencia)
+   * @param {boolean} active
+   */
+  setNativeStereoActive(active) {
+    this._nativeStereoActive = active;
+    this._updateLatencyVisibility();
+  }
+
+  /**
+   * Indica si el stream multicanal debe crearse como driver del grafo PipeWire
+   * @returns {boolean}
+   */
+  getDriverMode() {
+    return this._driverMode || false;
+  }
+
   /**
    * Construye la matriz de ruteo dentro del contenedor.
    * ORDEN: stereo buses primero (Pan 1-4 L/R, Pan 5-8 L/R), luego Out 1-8.
@@ -43,6 +43,8 @@ const DEFAULT_SHORTCUTS = {
   redo: { key: 'u', shift: false, ctrl: true, alt: false },
   mute: { key: 'm', shift: false, ctrl: false, alt: false },
   record: { key: 'r', shift: false, ctrl: false, alt: false },
+  automationRecord: { key: 'r', shift: true, ctrl: false, alt: false },
+  automationPlay: { key: 'p', shift: true, ctrl: false, alt: false },
   patches: { key: 'p', shift: false, ctrl: false, alt: false },
   settings: { key: 's', shift: false, ctrl: false, alt: false },
   fullscreen: { key: 'f', shift: false, ctrl: false, alt: false },
@@ -89,6 +91,8 @@ const SHORTCUT_ACTIONS = {
   redo: () => document.dispatchEvent(new CustomEvent('synth:redo')),
   mute: () => document.dispatchEvent(new CustomEvent('synth:toggleMute')),
   record: () => document.dispatchEvent(new CustomEvent('synth:toggleRecording')),
+  automationRecord: () => document.dispatchEvent(new CustomEvent('synth:toggleAutomationRecording')),
+  automationPlay: () => document.dispatchEvent(new CustomEvent('synth:toggleAutomationPlayback')),
   patches: () => document.dispatchEvent(new CustomEvent('synth:togglePatches')),
   settings: () => document.dispatchEvent(new CustomEvent('synth:toggleSettings')),
   fullscreen: async () => {
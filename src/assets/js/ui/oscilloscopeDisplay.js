@@ -26,6 +26,8 @@
  * ```
  */
 
+import { PhosphorLayer } from './phosphorLayer.js';
+
 export class OscilloscopeDisplay {
   /**
    * @param {Object} options - Opciones de configuración
@@ -45,6 +47,8 @@ export class OscilloscopeDisplay {
    * @param {string} [options.glowColor2=null] - Color del glow del Beam 2 (null = usa lineColor2)
    * @param {boolean} [options.showGrid=true] - Mostrar cuadrícula
    * @param {boolean} [options.showTriggerIndicator=true] - Mostrar indicador de trigger
+   * @param {Object} [options.phosphor] - Persistencia de fósforo nativa en modo X-Y
+   *   ({ enabled, persistenceMs, beamEnergy, fps }); sin addon se ignora
    */
   constructor(options = {}) {
     const {
@@ -76,7 +80,8 @@ export class OscilloscopeDisplay {
       beam1OffsetY = 0,            // Ajuste fino vertical del Beam 1 (px)
       beam2OffsetY = 0,            // Ajuste fino vertical del Beam 2 (px)
       centerOffsetX = 0,           // Desplazamiento X del centro Lissajous (px)
-      centerOffsetY = 0            // Desplazamiento Y del centro Lissajous (px)
+      centerOffsetY = 0,           // Desplazamiento Y del centro Lissajous (px)
+      phosphor = null              // Persistencia de fósforo (solo Electron con addon)
     } = options;
     
     // Calcular resolución real (con soporte Retina)
@@ -147,6 +152,24 @@ export class OscilloscopeDisplay {
     this._pendingData = null;      // Datos pendientes de dibujar
     this._rafId = null;            // ID del requestAnimationFrame activo
     this._isRunning = false;       // Si el loop de animación está activo
+    
+    // ─────────────────────────────────────────────────────────────────────────
+    // PERSISTENCIA DE FÓSFORO (modo X-Y)
+    // ─────────────────────────────────────────────────────────────────────────
+    // El addon rasteriza y hace decaer el trazo en su propio hilo; aquí solo se
+    // le envían las muestras y se compone el frame publicado. Sin addon queda
+    // en null y el modo X-Y sigue trazando con canvas.
+    // ─────────────────────────────────────────────────────────────────────────
+    this.phosphor = null;
+    this._phosphorSubmitted = null;  // Última captura enviada (no reenviar al redibujar)
+    if (phosphor?.enabled) {
+      this.phosphor = PhosphorLayer.create(this.width, this.height, {
+        color: lineColor,
+        persistenceMs: phosphor.persistenceMs,
+        beamEnergy: phosphor.beamEnergy,
+        fps: phosphor.fps
+      });
+    }
   }
 
   /**
@@ -182,6 +205,9 @@ export class OscilloscopeDisplay {
     if (this._pendingData) {
       this._drawInternal(this._pendingData);
       this._pendingData = null;
+    } else if (this._phosphorActive() && this.lastData) {
+      // El fósforo sigue decayendo sin datos nuevos: recomponer el frame
+      this._drawInternal(this.lastData);
     }
     
     // Programar siguiente frame
@@ -223,6 +249,7 @@ export class OscilloscopeDisplay {
   setMode(mode) {
     if (mode === 'yt' || mode === 'xy') {
       this.mode = mode;
+      this.phosphor?.clear();
       // Redibujar con los últimos datos
       if (this.lastData) {
         this.draw(this.lastData);
@@ -481,6 +508,40 @@ export class OscilloscopeDisplay {
     }
   }
 
+  /**
+   * Indica si el modo actual se compone con la capa de fósforo nativa.
+   * @returns {boolean}
+   * @private
+   */
+  _phosphorActive() {
+    return this.phosphor !== null && this.mode === 'xy';
+  }
+
+  /**
+   * Dibuja en modo X-Y con persistencia de fósforo: envía la captura al
+   * rasterizador nativo (una sola vez por captura) y compone su último frame.
+   * Usa el mismo mapeo que _drawXY, sin decimar: el addon traza cada muestra.
+   * @param {Object} data - Datos de captura
+   * @private
+   */
+  _drawXYPhosphor(data) {
+    const { bufferX, bufferY } = data;
+    if (!bufferX || !bufferY || bufferX.length === 0) return;
+    
+    if (data !== this._phosphorSubmitted) {
+      const dpr = this.dpr || 1;
+      const cx = this.width / 2 + (this.centerOffsetX || 0) * dpr;
+      const cy = this.height / 2 + (this.centerOffsetY || 0) * dpr;
+      this.phosphor.submit(bufferX, bufferY, cx, cy, this.width / 2, this.height / 2);
+      this._phosphorSubmitted = data;
+    }
+    
+    this.phosphor.blit(this.ctx);
+    
+    const hasXSignal = bufferX.some(v => Math.abs(v) > 0.01);
+    this._drawTriggerIndicator(hasXSignal);
+  }
+
   /**
    * Dibuja en modo X-Y (Lissajous).
    * @param {Float32Array} bufferX - Datos de la señal X
@@ -587,6 +648,7 @@ export class OscilloscopeDisplay {
     
     // Si no hay señal, dibujar vacío
     if (data.noSignal) {
+      this.phosphor?.clear();
       this.drawEmpty();
       return;
     }
@@ -608,7 +670,10 @@ export class OscilloscopeDisplay {
     }
     
     // Dibujar señal según modo
-    if (this.mode === 'xy') {
+    if (this._phosphorActive()) {
+      // Modo X-Y con persistencia nativa
+      this._drawXYPhosphor(data);
+    } else if (this.mode === 'xy') {
       // Modo X-Y (Lissajous): una sola figura paramétrica
       this._drawXY(data.bufferX, data.bufferY);
     } else {
@@ -697,6 +762,9 @@ export class OscilloscopeDisplay {
       cancelAnimationFrame(this.animationId);
       this.animationId = null;
     }
+    this.phosphor?.dispose();
+    this.phosphor = null;
+    this._phosphorSubmitted = null;
     this.lastData = null;
   }
 }
@@ -0,0 +1,186 @@
+/**
+ * PhosphorLayer - Capa de persistencia de fósforo para el osciloscopio (X-Y)
+ *
+ * Envuelve el rasterizador nativo (window.phosphorScopeAPI, solo Electron con
+ * addon): las muestras se envían al addon, cuyo hilo acumula el recorrido del
+ * haz con decaimiento exponencial y publica frames RGBA en un
+ * SharedArrayBuffer. Esta capa solo copia el frame más reciente a un canvas
+ * auxiliar cuando cambia y lo compone sobre el canvas del display.
+ *
+ * Layout del SAB (debe coincidir con phosphor_scope.h):
+ * [Int32 × 8] cabecera: 0 seq, 1 front, 2 width, 3 height, 4-7 reservado
+ * [Uint8 × width × height × 4] × 2   frames RGBA (doble buffer)
+ *
+ * @example
+ * ```javascript
+ * const layer = PhosphorLayer.create(600, 450, { color: '#00ff00' });
+ * if (layer) {
+ *   layer.submit(bufferX, bufferY, 300, 225, 300, 225);
+ *   layer.blit(ctx);
+ * }
+ * ```
+ */
+
+const HEADER_WORDS = 8;
+const SEQ = 0;
+const FRONT = 1;
+
+/**
+ * Convierte un color CSS hexadecimal (#rgb o #rrggbb) a [r, g, b].
+ * @param {string} hex
+ * @returns {number[]} Componentes 0-255 (verde si no se puede interpretar)
+ */
+export function parseHexColor(hex) {
+  if (typeof hex !== 'string') return [0, 255, 0];
+  let h = hex.trim().replace(/^#/, '');
+  if (h.length === 3) h = h.split('').map(c => c + c).join('');
+  if (!/^[0-9a-fA-F]{6}$/.test(h)) return [0, 255, 0];
+  return [0, 2, 4].map(i => parseInt(h.slice(i, i + 2), 16));
+}
+
+/**
+ * Bytes del SharedArrayBuffer para un frame de width × height.
+ * @param {number} width
+ * @param {number} height
+ * @returns {number}
+ */
+export function phosphorBufferBytes(width, height) {
+  return HEADER_WORDS * 4 + width * height * 4 * 2;
+}
+
+export class PhosphorLayer {
+  /**
+   * Indica si el rasterizador nativo está disponible.
+   * @returns {boolean}
+   */
+  static isAvailable() {
+    return typeof window !== 'undefined'
+      && !!window.phosphorScopeAPI
+      && typeof SharedArrayBuffer !== 'undefined'
+      && window.phosphorScopeAPI.isAvailable();
+  }
+
+  /**
+   * Crea la capa y arranca el hilo nativo.
+   * @param {number} width - Ancho en píxeles (resolución interna del canvas)
+   * @param {number} height - Alto en píxeles
+   * @param {Object} [options]
+   * @param {string} [options.color='#00ff00'] - Color del trazo
+   * @param {number} [options.persistenceMs] - Tiempo hasta 1/e de intensidad
+   * @param {number} [options.beamEnergy] - Energía depositada por muestra
+   * @param {number} [options.fps] - Frames por segundo del hilo nativo
+   * @returns {PhosphorLayer|null} null si no está disponible o falla
+   */
+  static create(width, height, options = {}) {
+    if (!PhosphorLayer.isAvailable()) return null;
+    width = Math.round(width);
+    height = Math.round(height);
+
+    const sab = new SharedArrayBuffer(phosphorBufferBytes(width, height));
+    const result = window.phosphorScopeAPI.create(width, height, sab, {
+      fps: options.fps,
+      color: parseHexColor(options.color || '#00ff00'),
+      persistenceMs: options.persistenceMs,
+      beamEnergy: options.beamEnergy
+    });
+    if (!result?.success) {
+      console.warn('[PhosphorLayer] Native rasterizer unavailable:', result?.error);
+      return null;
+    }
+    return new PhosphorLayer(result.id, width, height, sab);
+  }
+
+  /**
+   * @param {number} id - Id devuelto por phosphorScopeAPI.create
+   * @param {number} width
+   * @param {number} height
+   * @param {SharedArrayBuffer} sab
+   * @private
+   */
+  constructor(id, width, height, sab) {
+    this.id = id;
+    this.width = width;
+    this.height = height;
+    this._sab = sab;
+    this._header = new Int32Array(sab, 0, HEADER_WORDS);
+    this._frameBytes = width * height * 4;
+    this._lastSeq = 0;
+
+    // ImageData no puede envolver un SAB: se copia el frame al cambiar
+    this._canvas = document.createElement('canvas');
+    this._canvas.width = width;
+    this._canvas.height = height;
+    this._ctx = this._canvas.getContext('2d');
+    this._imageData = this._ctx.createImageData(width, height);
+  }
+
+  /**
+   * Envía una traza al rasterizador: pixel = (cx + x·sx, cy − y·sy).
+   * @param {Float32Array} bufferX
+   * @param {Float32Array} bufferY
+   */
+  submit(bufferX, bufferY, cx, cy, sx, sy) {
+    if (this.id === null || !bufferX || !bufferY) return;
+    window.phosphorScopeAPI.submit(this.id, bufferX, bufferY, cx, cy, sx, sy);
+  }
+
+  /** Apaga el fósforo de inmediato (cambio de modo, sin señal). */
+  clear() {
+    if (this.id === null) return;
+    window.phosphorScopeAPI.clear(this.id);
+  }
+
+  /** @param {string} hex - Color CSS del trazo */
+  setColor(hex) {
+    if (this.id === null) return;
+    const [r, g, b] = parseHexColor(hex);
+    window.phosphorScopeAPI.setColor(this.id, r, g, b);
+  }
+
+  /** @param {number} ms - Tiempo hasta 1/e de intensidad */
+  setPersistence(ms) {
+    if (this.id === null) return;
+    window.phosphorScopeAPI.setPersistence(this.id, ms);
+  }
+
+  /**
+   * Compone el frame publicado más reciente sobre ctx.
+   * Solo copia píxeles del SAB si el nativo ha publicado uno nuevo.
+   * @param {CanvasRenderingContext2D} ctx
+   * @returns {boolean} true si se copió un frame nuevo
+   */
+  blit(ctx) {
+    if (this.id === null) return false;
+    const seq = Atomics.load(this._header, SEQ);
+    const fresh = seq !== this._lastSeq;
+    if (fresh) {
+      const front = Atomics.load(this._header, FRONT);
+      const offset = HEADER_WORDS * 4 + front * this._frameBytes;
+      this._imageData.data.set(new Uint8Array(this._sab, offset, this._frameBytes));
+      this._ctx.putImageData(this._imageData, 0, 0);
+      this._lastSeq = seq;
+    }
+    ctx.drawImage(this._canvas, 0, 0);
+    return fresh;
+  }
+
+  /**
+   * Estadísticas del hilo nativo.
+   * @returns {Object|null}
+   */
+  getStats() {
+    if (this.id === null) return null;
+    return window.phosphorScopeAPI.getStats(this.id);
+  }
+
+  /** Detiene el hilo nativo y libera recursos. */
+  dispose() {
+    if (this.id === null) return;
+    window.phosphorScopeAPI.destroy(this.id);
+    this.id = null;
+    this._sab = null;
+    this._header = null;
+  }
+}
+
+export default PhosphorLayer;
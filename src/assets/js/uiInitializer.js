@@ -12,6 +12,7 @@ import { sessionManager } from './state/sessionManager.js';
 import { undoRedoManager } from './state/undoRedoManager.js';
 import { DormancyManager } from './core/dormancyManager.js';
 import { RecordingEngine } from './core/recordingEngine.js';
+import { AutomationRecorder } from './core/automationRecorder.js';
 import { AudioSettingsModal } from './ui/audioSettingsModal.js';
 import { RecordingSettingsModal } from './ui/recordingSettingsModal.js';
 import { RecordingOverlay } from './ui/recordingOverlay.js';
@@ -141,12 +142,16 @@ export function setupAudioSettingsModal(app) {
       onOutputDeviceChange: async (deviceId) => {
         // Desactivar multicanal si estaba activo (por si acaso)
         await app._deactivateMultichannelOutput();
+        // El estéreo nativo va al sink por defecto: se suelta antes de setSinkId
+        await app._deactivateNativeStereoOutput();
         
         const result = await app.engine.setOutputDevice(deviceId);
         if (result.success) {
           log.info(` Output device changed. Channels: ${result.channels}`);
           // La notificación de canales se hace a través del callback registrado abajo
         }
+        // Solo se reactiva con el dispositivo por defecto (estéreo)
+        await app._activateNativeStereoOutput();
       },
       
       // ─────────────────────────────────────────────────────────────────────────
@@ -220,6 +225,32 @@ export function setupAudioSettingsModal(app) {
               log.info(`🔊 Stereo mode restored. Device: ${deviceId}, Channels: ${result.channels}`);
             }
           }
+          
+          // Linux: salida estéreo por PipeWire nativo si está disponible
+          await app._activateNativeStereoOutput();
+        }
+      },
+      
+      // ─────────────────────────────────────────────────────────────────────────
+      // CALLBACK DE ESTÉREO NATIVO (PipeWire 2ch en lugar de Chromium)
+      // ─────────────────────────────────────────────────────────────────────────
+      // Solo afecta al modo estéreo. La entrada se reconecta para pasar de
+      // getUserMedia a la captura PipeWire (o al revés).
+      // ─────────────────────────────────────────────────────────────────────────
+      onNativeStereoChange: async (enabled) => {
+        if (!app.engine.audioCtx || app.audioSettingsModal.isMultichannelMode()) return;
+        
+        if (enabled) {
+          const result = await app._activateNativeStereoOutput();
+          if (!result.success) {
+            log.warn('🔊 Native stereo not activated:', result.error);
+          }
+        } else {
+          await app._deactivateNativeStereoOutput();
+        }
+        
+        if (app._systemAudioConnected) {
+          await app._reconnectSystemAudioInput(app.audioSettingsModal.selectedInputDevice);
         }
       },
       
@@ -496,6 +527,64 @@ export function setupRecording(app) {
     document.addEventListener('synth:toggleRecordingSettings', () => {
       app._recordingSettingsModal.toggle();
     });
+
+    // Automatización: cambios de mandos, matriz, MIDI y OSC con el frame del
+    // AudioContext; se reproducen sobre el patch del inicio de la grabación
+    app._automationRecorder = new AutomationRecorder({
+      getContext: () => app.engine.audioCtx,
+      serializeState: () => app._serializeCurrentState(),
+      applyState: (state) => app._applyPatch(state)
+    });
+    app._lastAutomation = null;
+    app._automationRecorder.onPlaybackEnd = () => {
+      showToast(t('toast.automationPlaybackEnded'));
+    };
+
+    document.addEventListener('synth:toggleAutomationRecording', async () => {
+      const recorder = app._automationRecorder;
+      if (recorder.isRecording) {
+        const recording = recorder.stop();
+        if (recording.events > 0) {
+          app._lastAutomation = recording;
+          showToast(t('toast.automationSaved', { events: recording.events }), { level: 'success' });
+        } else {
+          showToast(t('toast.automationEmpty'), { level: 'warning' });
+        }
+        return;
+      }
+      if (!app.engine.dspEnabled) {
+        showToast(t('toast.dspRequired'), { level: 'warning' });
+        return;
+      }
+      await app.ensureAudio();
+      if (recorder.start()) {
+        showToast(t('toast.automationRecordingStarted'), { level: 'success' });
+      }
+    });
+
+    document.addEventListener('synth:toggleAutomationPlayback', async () => {
+      const recorder = app._automationRecorder;
+      if (recorder.isPlaying) {
+        recorder.stopPlayback();
+        return;
+      }
+      if (!app._lastAutomation) {
+        showToast(t('toast.automationEmpty'), { level: 'warning' });
+        return;
+      }
+      if (!app.engine.dspEnabled) {
+        showToast(t('toast.dspRequired'), { level: 'warning' });
+        return;
+      }
+      await app.ensureAudio();
+      try {
+        if (await recorder.play(app._lastAutomation)) {
+          showToast(t('toast.automationPlaybackStarted'));
+        }
+      } catch (e) {
+        log.error(' Automation playback error:', e);
+      }
+    });
   }
 
 
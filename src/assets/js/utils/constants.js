@@ -68,6 +68,10 @@ export const STORAGE_KEYS = {
   INPUT_DEVICE: `${STORAGE_PREFIX}input-device`,
   MIC_PERMISSION_DENIED: `${STORAGE_PREFIX}mic-permission-denied`,
   AUDIO_LATENCY: `${STORAGE_PREFIX}audio-latency`,
+  AUDIO_DRIVER_MODE: `${STORAGE_PREFIX}audio-driver-mode`,
+  AUDIO_NATIVE_STEREO: `${STORAGE_PREFIX}audio-native-stereo`,
+  PIPEWIRE_LINK_RULES: `${STORAGE_PREFIX}pipewire-link-rules`,
+  PLUGIN_BRIDGE: `${STORAGE_PREFIX}plugin-bridge`,
   
   // Grabación
   RECORDING_TRACKS: `${STORAGE_PREFIX}recording-tracks`,
@@ -241,6 +245,9 @@ export const STORAGE_KEYS = {
   /** Cola de eventos offline (JSON array) */
   TELEMETRY_QUEUE: `${STORAGE_PREFIX}telemetry-queue`,
   
+  /** Último informe de salud del audio, pendiente de enviar al salir (JSON) */
+  TELEMETRY_AUDIO_HEALTH: `${STORAGE_PREFIX}telemetry-audio-health`,
+  
   // ─────────────────────────────────────────────────────────────────────────
   // Efecto glow (halo brillante en controles)
   // ─────────────────────────────────────────────────────────────────────────
@@ -1,7 +1,8 @@
 /**
  * Módulo de telemetría anónima mínima.
  *
- * Envía eventos agregados (errores, sesiones) a un endpoint configurable
+ * Envía eventos agregados (errores, sesiones, salud del audio nativo) a un
+ * endpoint configurable
  * (Google Apps Script) respetando estrictamente el consentimiento del usuario.
  *
  * Principios:
@@ -28,7 +29,10 @@ const log = createLogger('Telemetry');
 // ─────────────────────────────────────────────────────────────────────────────
 
 /** URL del endpoint (inyectada en build, vacía = desactivado) */
-const ENDPOINT_URL = typeof __TELEMETRY_URL__ !== 'undefined' ? __TELEMETRY_URL__ : '';
+let ENDPOINT_URL = typeof __TELEMETRY_URL__ !== 'undefined' ? __TELEMETRY_URL__ : '';
+
+/** URL inyectada en build (para restaurar tras tests) */
+const BUILD_ENDPOINT_URL = ENDPOINT_URL;
 
 /** Versión de la app (inyectada en build) */
 const APP_VERSION = typeof __BUILD_VERSION__ !== 'undefined' ? __BUILD_VERSION__ : 'dev';
@@ -67,6 +71,9 @@ let initialized = false;
 /** Función para desuscribirse de errorHandler */
 let unsubError = null;
 
+/** Ciclos registrados en el último informe (no repetir informes idénticos) */
+let lastAudioHealthCycles = 0;
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Detección de entorno
 // ─────────────────────────────────────────────────────────────────────────────
@@ -189,6 +196,9 @@ export function isEnabled() {
 export function setEnabled(enabled) {
   try {
     localStorage.setItem(STORAGE_KEYS.TELEMETRY_ENABLED, String(!!enabled));
+    if (!enabled) {
+      savePendingAudioHealth(null);
+    }
     if (enabled && !initialized) {
       init();
     }
@@ -240,6 +250,37 @@ function clearOfflineQueue() {
   }
 }
 
+/**
+ * Carga el informe de salud del audio pendiente.
+ * @returns {Object|null} Payload audio_health
+ */
+function loadPendingAudioHealth() {
+  try {
+    const raw = localStorage.getItem(STORAGE_KEYS.TELEMETRY_AUDIO_HEALTH);
+    if (!raw) return null;
+    const parsed = JSON.parse(raw);
+    return parsed?.type === 'audio_health' ? parsed : null;
+  } catch {
+    return null;
+  }
+}
+
+/**
+ * Guarda (sustituye) el informe de salud del audio pendiente.
+ * @param {Object|null} payload - null para borrarlo
+ */
+function savePendingAudioHealth(payload) {
+  try {
+    if (payload) {
+      localStorage.setItem(STORAGE_KEYS.TELEMETRY_AUDIO_HEALTH, JSON.stringify(payload));
+    } else {
+      localStorage.removeItem(STORAGE_KEYS.TELEMETRY_AUDIO_HEALTH);
+    }
+  } catch {
+    // Storage lleno o no disponible
+  }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Envío de eventos
 // ─────────────────────────────────────────────────────────────────────────────
@@ -302,6 +343,19 @@ function sendBeaconBatch(payloads) {
   }
 }
 
+/**
+ * Envía con sendBeacon todo lo pendiente (memoria + offline).
+ */
+function beaconPending() {
+  const offlineEvents = loadOfflineQueue();
+  const allEvents = [...offlineEvents, ...eventQueue];
+  eventQueue = [];
+  if (allEvents.length > 0) {
+    sendBeaconBatch(allEvents);
+    clearOfflineQueue();
+  }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Flush
 // ─────────────────────────────────────────────────────────────────────────────
@@ -342,9 +396,17 @@ export async function flush() {
  */
 export function trackEvent(type, data = {}) {
   if (!isEnabled()) return;
-  if (sessionEventCount >= MAX_EVENTS_PER_SESSION) return;
+  enqueuePayload(buildPayload(type, data));
+}
+
+/**
+ * Encola un payload ya construido (cuenta para el límite de sesión).
+ * @param {Object} payload
+ * @returns {boolean} true si se encoló
+ */
+function enqueuePayload(payload) {
+  if (sessionEventCount >= MAX_EVENTS_PER_SESSION) return false;
 
-  const payload = buildPayload(type, data);
   eventQueue.push(payload);
   sessionEventCount++;
 
@@ -353,6 +415,7 @@ export function trackEvent(type, data = {}) {
     saveOfflineQueue([...loadOfflineQueue(), ...eventQueue]);
     eventQueue = [];
   }
+  return true;
 }
 
 /**
@@ -374,6 +437,95 @@ export function trackError(errorEntry) {
   });
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Salud del audio nativo
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Compacta los agregados de una dirección (output/input) del addon.
+ * @param {Object} dir - Snapshot de AudioHealth para una dirección
+ * @returns {Object|null} null si no hubo ciclos
+ */
+function compactAudioHealth(dir) {
+  if (!dir || !(dir.cycles > 0)) return null;
+  const pct = p => [p?.p50 || 0, p?.p95 || 0, p?.p99 || 0, p?.max || 0];
+  return {
+    streams: dir.streams || 0,
+    cycles: dir.cycles,
+    underflows: dir.underflows || 0,
+    overflows: dir.overflows || 0,
+    catchUps: dir.catchUps || 0,
+    catchUpFrames: dir.catchUpFrames || 0,
+    latencyOverruns: dir.latencyOverruns || 0,
+    latencyMs: pct(dir.latencyMs),       // [p50, p95, p99, max]
+    loadPct: pct(dir.loadPct),           // [p50, p95, p99, max]
+    quantum: [dir.quantum?.last || 0, dir.quantum?.min || 0, dir.quantum?.max || 0],
+    rate: dir.rate || 0,
+    channels: dir.channels || 0,
+    format: dir.format || '',
+    prebufferMs: dir.prebufferMs || 0,
+    driverMode: !!dir.driverMode
+  };
+}
+
+/**
+ * Construye los datos del evento audio_health a partir del snapshot del addon.
+ * Los agregados son acumulados de sesión.
+ * @param {{ output?: Object, input?: Object }|null} snapshot
+ * @returns {Object|null} null si no hay nada que informar
+ */
+export function buildAudioHealthData(snapshot) {
+  const output = compactAudioHealth(snapshot?.output);
+  const input = compactAudioHealth(snapshot?.input);
+  if (!output && !input) return null;
+  const data = {};
+  if (output) data.output = output;
+  if (input) data.input = input;
+  return data;
+}
+
+/**
+ * Actualiza el informe de salud del audio nativo (solo Electron con addon).
+ *
+ * Hay un único informe por sesión: cada llamada sustituye al pendiente
+ * (guardado en localStorage) y se envía al salir con sendAudioHealth().
+ * Si la sesión acaba sin salir (cuelgue, corte de corriente), se envía al
+ * arrancar la siguiente marcado con `recovered`.
+ *
+ * @param {Object} [snapshot] - Snapshot de audioHealthAPI (por defecto, se lee)
+ * @returns {boolean} true si se sustituyó el informe pendiente
+ */
+export function trackAudioHealth(snapshot) {
+  if (!isEnabled()) return false;
+
+  const snap = snapshot ?? (typeof window !== 'undefined'
+    ? window.audioHealthAPI?.getSnapshot?.()
+    : null);
+  const data = buildAudioHealthData(snap);
+  if (!data) return false;
+
+  // Sin ciclos nuevos, el pendiente ya es el último
+  const cycles = (data.output?.cycles || 0) + (data.input?.cycles || 0);
+  if (cycles <= lastAudioHealthCycles) return false;
+
+  savePendingAudioHealth(buildPayload('audio_health', data));
+  lastAudioHealthCycles = cycles;
+  return true;
+}
+
+/**
+ * Encola el informe de salud del audio pendiente y lo retira.
+ * @param {Object} [extra] - Campos añadidos a data (p. ej. { recovered: true })
+ * @returns {boolean} true si había informe y se encoló
+ */
+export function sendAudioHealth(extra = {}) {
+  if (!isEnabled()) return false;
+  const payload = loadPendingAudioHealth();
+  if (!payload) return false;
+  savePendingAudioHealth(null);
+  return enqueuePayload({ ...payload, data: { ...payload.data, ...extra } });
+}
+
 /**
  * Inicializa el sistema de telemetría.
  * Conecta con errorHandler, configura flush periódico y listeners de ciclo de vida.
@@ -398,31 +550,44 @@ export function init() {
     trackEvent('session_start');
   }
 
+  // Informe de salud del audio de una sesión anterior que no llegó a salir
+  sendAudioHealth({ recovered: true });
+
   // Flush inicial tras breve delay (no esperar los 30s del intervalo)
   setTimeout(() => flush().catch(() => {}), 3000);
 
   // Suscribirse a errores globales
   unsubError = onError(trackError);
 
-  // Flush periódico
-  flushIntervalId = setInterval(flush, FLUSH_INTERVAL_MS);
+  // Flush periódico (y refresco del informe de salud del audio pendiente)
+  flushIntervalId = setInterval(() => {
+    trackAudioHealth();
+    flush().catch(() => {});
+  }, FLUSH_INTERVAL_MS);
 
   // Flush al perder visibilidad (usuario cambia de pestaña / cierra)
   if (typeof document !== 'undefined') {
     document.addEventListener('visibilitychange', () => {
       if (document.visibilityState === 'hidden') {
+        // Agregados de audio de la sesión hasta ahora (Electron con addon)
+        trackAudioHealth();
         // sendBeacon es más fiable que fetch cuando se cierra la pestaña
-        const offlineEvents = loadOfflineQueue();
-        const allEvents = [...offlineEvents, ...eventQueue];
-        eventQueue = [];
-        if (allEvents.length > 0) {
-          sendBeaconBatch(allEvents);
-          clearOfflineQueue();
-        }
+        beaconPending();
       }
     });
   }
 
+  // Al salir: informe final de salud del audio. pagehide cubre el cierre de
+  // pestaña; en Electron, la ventana se cierra con close() (beforeunload).
+  if (typeof window !== 'undefined') {
+    const sendFinal = () => {
+      trackAudioHealth();
+      if (sendAudioHealth()) beaconPending();
+    };
+    window.addEventListener('pagehide', sendFinal);
+    window.addEventListener('beforeunload', sendFinal);
+  }
+
   // Flush cuando se recupera la conexión
   if (typeof window !== 'undefined') {
     window.addEventListener('online', () => {
@@ -446,11 +611,14 @@ export const _testing = {
   get ENDPOINT_URL() { return ENDPOINT_URL; },
   get MAX_EVENTS_PER_SESSION() { return MAX_EVENTS_PER_SESSION; },
   get MAX_AUTO_ERRORS() { return MAX_AUTO_ERRORS; },
+  loadPendingAudioHealth,
   buildPayload,
   sendBatch,
   loadOfflineQueue,
   saveOfflineQueue,
   clearOfflineQueue,
+  /** Simula una URL de build para ejercitar la cola sin red */
+  setEndpointUrl(url) { ENDPOINT_URL = url; },
   reset() {
     if (flushIntervalId !== null) {
       clearInterval(flushIntervalId);
@@ -464,5 +632,7 @@ export const _testing = {
     eventQueue = [];
     sessionEventCount = 0;
     autoErrorCount = 0;
+    lastAudioHealthCycles = 0;
+    ENDPOINT_URL = BUILD_ENDPOINT_URL;
   }
 };
@@ -9,9 +9,20 @@
  * - writeIndex: posición de escritura (worklet actualiza)
  * - readIndex: posición de lectura (C++ actualiza via preload)
  * 
+ * Formato empaquetado (opcional, init con packetSlots): tras el audio,
+ * alineada a 8 bytes, una tabla de descriptores por bloque escrito con su
+ * secuencia y el currentFrame/currentTime del AudioContext, para que el
+ * addon mida latencia real, bloques perdidos y deriva (ver sab_packets.h):
+ *   Int32[0] packetCount, Int32[1] slots, Int32[2-3] reservado
+ *   slot × 32 bytes: Int32 seq, Int32 frames, Int32[2] reservado,
+ *                    Float64 contextFrame, Float64 contextTime
+ * 
  * Fallback: Si SharedArrayBuffer no está disponible, usa MessagePort.
  */
 
+const PACKET_HEADER_BYTES = 16;
+const PACKET_SLOT_BYTES = 32;
+
 class MultichannelCaptureProcessor extends AudioWorkletProcessor {
   constructor(options) {
     super();
@@ -26,6 +37,13 @@ class MultichannelCaptureProcessor extends AudioWorkletProcessor {
     this.overflowCount = 0;
     this.stopped = false;  // Flag para detener el procesamiento
     
+    // Formato empaquetado (null = solo frames)
+    this.packetHeader = null;
+    this.packetInts = null;
+    this.packetFloats = null;
+    this.packetSlots = 0;
+    this.blockSeq = 0;     // Cuenta también los bloques descartados
+    
     // Fallback: acumular y enviar via MessagePort si no hay SharedArrayBuffer
     this.fallbackMode = true;
     this.fallbackChunkSize = options.processorOptions?.chunkSize || 2048;
@@ -69,10 +87,14 @@ class MultichannelCaptureProcessor extends AudioWorkletProcessor {
       // Inicializar writeIndex a 0 (readIndex lo inicializa C++)
       Atomics.store(this.controlBuffer, 0, 0);
       
+      if (data.packetSlots > 0) {
+        this.initPackets(data.packetSlots, audioByteOffset + this.bufferFrames * this.channels * 4);
+      }
+      
       this.fallbackMode = false;
       this.initialized = true;
       
-      console.log(`[Worklet] SharedArrayBuffer OK: ${this.bufferFrames} frames ring buffer`);
+      console.log(`[Worklet] SharedArrayBuffer OK: ${this.bufferFrames} frames ring buffer${this.packetSlots ? `, ${this.packetSlots} packet slots` : ''}`);
       this.port.postMessage({ type: 'initialized', bufferFrames: this.bufferFrames });
     } catch (e) {
       console.error('[Worklet] SharedArrayBuffer init failed:', e);
@@ -80,6 +102,33 @@ class MultichannelCaptureProcessor extends AudioWorkletProcessor {
     }
   }
   
+  initPackets(slots, audioEnd) {
+    const offset = Math.ceil(audioEnd / 8) * 8;
+    if (offset + PACKET_HEADER_BYTES + slots * PACKET_SLOT_BYTES > this.sharedBuffer.byteLength) {
+      console.warn('[Worklet] SharedArrayBuffer sin espacio para la tabla de paquetes');
+      return;
+    }
+    this.packetHeader = new Int32Array(this.sharedBuffer, offset, 4);
+    this.packetInts = new Int32Array(this.sharedBuffer, offset + PACKET_HEADER_BYTES, slots * 8);
+    this.packetFloats = new Float64Array(this.sharedBuffer, offset + PACKET_HEADER_BYTES, slots * 4);
+    this.packetSlots = slots;
+    Atomics.store(this.packetHeader, 0, 0);
+  }
+  
+  /**
+   * Publica el descriptor del bloque recién escrito. Va antes de
+   * writeIndex: cuando el addon ve los frames, su descriptor ya está.
+   */
+  writePacket(seq, frameCount) {
+    const count = Atomics.load(this.packetHeader, 0) >>> 0;
+    const slot = count % this.packetSlots;
+    this.packetInts[slot * 8] = seq;
+    this.packetInts[slot * 8 + 1] = frameCount;
+    this.packetFloats[slot * 4 + 2] = currentFrame;
+    this.packetFloats[slot * 4 + 3] = currentTime;
+    Atomics.store(this.packetHeader, 0, (count + 1) | 0);
+  }
+  
   process(inputs, outputs, parameters) {
     // Si se ha recibido señal de stop, devolver false para destruir el worklet
     if (this.stopped) {
@@ -124,6 +173,9 @@ class MultichannelCaptureProcessor extends AudioWorkletProcessor {
   }
   
   writeToSharedBuffer(input, frameCount) {
+    const seq = this.blockSeq;
+    this.blockSeq = (this.blockSeq + 1) | 0;
+    
     // Leer índices atómicamente
     const writeIndex = Atomics.load(this.controlBuffer, 0);
     const readIndex = Atomics.load(this.controlBuffer, 1);
@@ -156,6 +208,10 @@ class MultichannelCaptureProcessor extends AudioWorkletProcessor {
       writePos = (writePos + 1) % this.bufferFrames;
     }
     
+    if (this.packetSlots) {
+      this.writePacket(seq, frameCount);
+    }
+    
     // Actualizar writeIndex atómicamente (memory barrier)
     Atomics.store(this.controlBuffer, 0, writePos);
   }
@@ -0,0 +1,186 @@
+/**
+ * AudioWorklet puente hacia un procesador nativo (ProcessorBridge del addon)
+ *
+ * Permite que un procesador C++ ocupe el lugar de un nodo Web Audio:
+ * las entradas se copian a un SharedArrayBuffer, el hilo nativo procesa
+ * bloques de 128 frames y el resultado vuelve por el mismo SAB.
+ *
+ * Flujo: nodo Web Audio → este worklet → SAB → C++ → SAB → este worklet → grafo
+ *
+ * La salida se reproduce con un retardo FIJO de latencyFrames: si el nativo
+ * llega tarde, se emite silencio, se cuenta un underrun y los frames
+ * atrasados se descartan al llegar (el retardo nunca crece).
+ *
+ * origin = currentFrame − frames enviados (módulo 2^32): el nativo sitúa
+ * cada bloque de entrada en el reloj del AudioContext para aplicar eventos
+ * programados (scheduleParam) en su frame exacto. Si se pierde entrada por
+ * overflow, origin se corrige en el siguiente bloque enviado.
+ *
+ * Layout del SharedArrayBuffer (ver processor_bridge.h):
+ * [Int32 × 8]: inWrite, inRead, outWrite, outRead, latency, underruns, blocks, origin
+ * [Float32]:   ring de entrada (ringFrames × inChannels, interleaved)
+ * [Float32]:   ring de salida (ringFrames × outChannels, interleaved)
+ */
+
+const IN_WRITE = 0;
+const IN_READ = 1;
+const OUT_WRITE = 2;
+const OUT_READ = 3;
+const LATENCY = 4;
+const UNDERRUNS = 5;
+const ORIGIN = 7;
+const HEADER_WORDS = 8;
+
+class NativeBridgeProcessor extends AudioWorkletProcessor {
+  constructor(options) {
+    super();
+
+    this.inChannels = options?.processorOptions?.inputs ?? 1;
+    this.outChannels = options?.processorOptions?.outputs ?? 1;
+    this.latencyFrames = options?.processorOptions?.latencyFrames ?? 256;
+
+    this.controlBuffer = null;
+    this.inRing = null;
+    this.outRing = null;
+    this.ringFrames = 0;
+    this.initialized = false;
+    this.stopped = false;
+
+    // Estado local (cada índice tiene un único escritor)
+    this.inWrite = 0;
+    this.outRead = 0;
+    this.framesIn = 0;      // Frames enviados al nativo (para el cebado)
+    this.framesSent = 0;    // Frames escritos en el ring (módulo 2^32)
+    this.skipFrames = 0;    // Frames atrasados a descartar tras un underrun
+    this.inputOverflows = 0;
+
+    this.port.onmessage = (event) => {
+      if (event.data.type === 'init' && event.data.sharedBuffer) {
+        this.initSharedBuffer(event.data);
+      } else if (event.data.type === 'stop') {
+        this.stopped = true;
+      }
+    };
+
+    this.port.postMessage({ type: 'ready' });
+  }
+
+  initSharedBuffer(data) {
+    const { sharedBuffer, ringFrames } = data;
+    this.ringFrames = ringFrames;
+    this.controlBuffer = new Int32Array(sharedBuffer, 0, HEADER_WORDS);
+
+    const audioOffset = HEADER_WORDS * 4;
+    this.inRing = new Float32Array(sharedBuffer, audioOffset, ringFrames * this.inChannels);
+    this.outRing = new Float32Array(
+      sharedBuffer,
+      audioOffset + ringFrames * this.inChannels * 4,
+      ringFrames * this.outChannels
+    );
+
+    Atomics.store(this.controlBuffer, IN_WRITE, 0);
+    Atomics.store(this.controlBuffer, OUT_READ, 0);
+    Atomics.store(this.controlBuffer, LATENCY, this.latencyFrames);
+    Atomics.store(this.controlBuffer, UNDERRUNS, 0);
+    Atomics.store(this.controlBuffer, ORIGIN, 0);
+
+    this.initialized = true;
+    this.port.postMessage({ type: 'initialized', latencyFrames: this.latencyFrames });
+  }
+
+  _distance(from, to) {
+    return to >= from ? to - from : this.ringFrames - from + to;
+  }
+
+  process(inputs, outputs) {
+    if (this.stopped) {
+      return false;
+    }
+
+    const output = outputs[0];
+    if (!output || output.length === 0) {
+      return true;
+    }
+    const frames = output[0].length;
+
+    if (!this.initialized) {
+      for (let ch = 0; ch < output.length; ch++) output[ch].fill(0);
+      return true;
+    }
+
+    this._writeInput(inputs[0], frames);
+    this._readOutput(output, frames);
+    return true;
+  }
+
+  _writeInput(input, frames) {
+    const inRead = Atomics.load(this.controlBuffer, IN_READ);
+    const space = this.ringFrames - 1 - this._distance(inRead, this.inWrite);
+    if (space < frames) {
+      // El nativo no consume: el underrun de salida mantendrá el retardo
+      this.inputOverflows++;
+      this.framesIn += frames;
+      return;
+    }
+
+    const channels = this.inChannels;
+    let pos = this.inWrite;
+    for (let i = 0; i < frames; i++) {
+      const base = pos * channels;
+      for (let ch = 0; ch < channels; ch++) {
+        // Entrada desconectada: input no trae canales → silencio
+        const data = input?.[ch];
+        this.inRing[base + ch] = data ? data[i] : 0;
+      }
+      pos = (pos + 1) % this.ringFrames;
+    }
+
+    this.inWrite = pos;
+    this.framesIn += frames;
+    Atomics.store(this.controlBuffer, ORIGIN, (currentFrame - this.framesSent) | 0);
+    this.framesSent = (this.framesSent + frames) | 0;
+    Atomics.store(this.controlBuffer, IN_WRITE, pos);
+  }
+
+  _readOutput(output, frames) {
+    // Cebado: el bloque k se lee cuando ya se envió el bloque k + latencyFrames
+    if (this.framesIn < this.latencyFrames + frames) {
+      for (let ch = 0; ch < output.length; ch++) output[ch].fill(0);
+      return;
+    }
+
+    const outWrite = Atomics.load(this.controlBuffer, OUT_WRITE);
+    let available = this._distance(this.outRead, outWrite);
+
+    // Descartar frames que llegaron tarde (retardo fijo)
+    if (this.skipFrames > 0 && available > 0) {
+      const drop = Math.min(this.skipFrames, available);
+      this.outRead = (this.outRead + drop) % this.ringFrames;
+      this.skipFrames -= drop;
+      available -= drop;
+    }
+
+    if (available < frames) {
+      for (let ch = 0; ch < output.length; ch++) output[ch].fill(0);
+      this.skipFrames += frames;
+      Atomics.add(this.controlBuffer, UNDERRUNS, 1);
+      Atomics.store(this.controlBuffer, OUT_READ, this.outRead);
+      return;
+    }
+
+    const channels = this.outChannels;
+    let pos = this.outRead;
+    for (let i = 0; i < frames; i++) {
+      const base = pos * channels;
+      for (let ch = 0; ch < output.length; ch++) {
+        output[ch][i] = ch < channels ? this.outRing[base + ch] : 0;
+      }
+      pos = (pos + 1) % this.ringFrames;
+    }
+
+    this.outRead = pos;
+    Atomics.store(this.controlBuffer, OUT_READ, pos);
+  }
+}
+
+registerProcessor('native-bridge', NativeBridgeProcessor);
@@ -21,6 +21,9 @@ import {
   activateMultichannelInput,
   deactivateMultichannelOutput,
   deactivateMultichannelInput,
+  isNativeStereoAvailable,
+  activateNativeStereoOutput,
+  deactivateNativeStereoOutput,
 } from '../src/assets/js/audioSetup.js';
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -142,6 +145,70 @@ describe('activateMultichannelInput', () => {
     assert.ok(typeof result === 'object');
     assert.equal(result.success, false);
   });
+
+  it('aplica el acondicionamiento nativo de la config al abrir el stream', async () => {
+    const calls = [];
+    const attached = [];
+    const previous = window.multichannelInputAPI;
+    window.multichannelInputAPI = {
+      open: async () => ({ success: true, info: {} }),
+      setConditioning: (config) => calls.push(config),
+      onStateChange: () => () => {},
+      attachSharedBuffer: (buffer, frames) => {
+        attached.push({ buffer, frames });
+        return true;
+      },
+      close: async () => {}
+    };
+    try {
+      const app = buildMockApp({
+        engine: buildMockEngine({ audioCtx: { sampleRate: 48000 } }),
+        inputAmplifiers: { isStarted: true },
+        _disconnectSystemAudioInput: () => {}
+      });
+      const result = await activateMultichannelInput(app);
+      // SAB adjuntado; falla después al cargar el worklet (sin audioWorklet en el mock)
+      assert.equal(attached.length, 1);
+      assert.ok(attached[0].buffer instanceof SharedArrayBuffer);
+      assert.equal(attached[0].buffer.byteLength, 8 + attached[0].frames * 8 * 4);
+      assert.equal(app._sharedInputBuffer, attached[0].buffer);
+      assert.equal(result.success, false);
+      assert.equal(result.error, 'Failed to load worklet');
+      assert.equal(calls.length, 1);
+      assert.equal(calls[0].dcCutoffHz, 2);
+      assert.equal(calls[0].clipThreshold, 0.999);
+    } finally {
+      window.multichannelInputAPI = previous;
+    }
+  });
+
+  it('se suscribe a las transiciones de estado del stream (recuperación automática)', async () => {
+    let listener = null;
+    const previous = window.multichannelInputAPI;
+    window.multichannelInputAPI = {
+      open: async () => ({ success: true, info: {} }),
+      onStateChange: (callback) => {
+        listener = callback;
+        return () => {};
+      },
+      attachSharedBuffer: () => false,
+      close: async () => {}
+    };
+    try {
+      const app = buildMockApp({
+        engine: buildMockEngine({ audioCtx: { sampleRate: 48000 } }),
+        inputAmplifiers: { isStarted: true },
+        _disconnectSystemAudioInput: () => {}
+      });
+      await activateMultichannelInput(app);
+      assert.equal(typeof listener, 'function');
+      // Caída y recuperación: solo registra en el log, no lanza
+      listener({ state: 'recovering', error: 'connection error', recovering: true, recoveries: 0, recoveryMs: 0 });
+      listener({ state: 'streaming', error: '', recovering: false, recoveries: 1, recoveryMs: 420 });
+    } finally {
+      window.multichannelInputAPI = previous;
+    }
+  });
 });
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -161,3 +228,78 @@ describe('deactivateMultichannelInput', () => {
     await assert.doesNotReject(() => deactivateMultichannelInput(app));
   });
 });
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Estéreo nativo (PipeWire 2ch)
+// ─────────────────────────────────────────────────────────────────────────────
+
+describe('isNativeStereoAvailable', () => {
+  it('false fuera de Linux/Electron', async () => {
+    const app = buildMockApp();
+    assert.equal(await isNativeStereoAvailable(app), false);
+  });
+
+  it('false si el usuario lo desactivó', async () => {
+    const prevElectron = window.electronAPI;
+    const prevApi = window.multichannelAPI;
+    window.electronAPI = { platform: 'linux' };
+    window.multichannelAPI = {
+      checkAvailability: async () => ({ available: true, native: true, sharedArrayBuffer: true })
+    };
+    try {
+      const app = buildMockApp({ audioSettingsModal: { getNativeStereo: () => false } });
+      assert.equal(await isNativeStereoAvailable(app), false);
+      const appOn = buildMockApp({ audioSettingsModal: { getNativeStereo: () => true } });
+      assert.equal(await isNativeStereoAvailable(appOn), true);
+    } finally {
+      window.electronAPI = prevElectron;
+      window.multichannelAPI = prevApi;
+    }
+  });
+
+  it('false sin SharedArrayBuffer (addon por IPC)', async () => {
+    const prevElectron = window.electronAPI;
+    const prevApi = window.multichannelAPI;
+    window.electronAPI = { platform: 'linux' };
+    window.multichannelAPI = {
+      checkAvailability: async () => ({ available: true, native: false, sharedArrayBuffer: false })
+    };
+    try {
+      assert.equal(await isNativeStereoAvailable(buildMockApp()), false);
+    } finally {
+      window.electronAPI = prevElectron;
+      window.multichannelAPI = prevApi;
+    }
+  });
+});
+
+describe('activateNativeStereoOutput', () => {
+  it('devuelve success:false sin AudioContext', async () => {
+    const app = buildMockApp({ engine: buildMockEngine({ audioCtx: null }) });
+    const result = await activateNativeStereoOutput(app);
+    assert.equal(result.success, false);
+  });
+
+  it('no se activa con multicanal activo', async () => {
+    const app = buildMockApp({ _multichannelActive: true });
+    const result = await activateNativeStereoOutput(app);
+    assert.equal(result.success, false);
+    assert.ok(!app._nativeStereoActive);
+  });
+
+  it('no se activa con un dispositivo de salida concreto', async () => {
+    const app = buildMockApp({
+      engine: buildMockEngine({ audioCtx: { sampleRate: 48000 }, merger: {}, physicalChannels: 2 }),
+      audioSettingsModal: { selectedOutputDevice: 'usb-card-1' },
+    });
+    const result = await activateNativeStereoOutput(app);
+    assert.equal(result.success, false);
+  });
+});
+
+describe('deactivateNativeStereoOutput', () => {
+  it('no lanza si no está activo', async () => {
+    const app = buildMockApp();
+    await assert.doesNotReject(() => deactivateNativeStereoOutput(app));
+  });
+});
@@ -0,0 +1,98 @@
+/**
+ * Tests para core/automationLane.js — Registros de automatización nativos
+ *
+ * Verifica:
+ * - Decodificación de un registro producido por AutomationLane (C++)
+ * - Ida y vuelta encode → decode, deltas grandes y frames módulo 2^32
+ * - Registros truncados: se decodifican los eventos completos
+ * - scheduleAutomation: saltos con setValueAtTime y rampas desde el valor previo
+ */
+
+import { describe, it } from 'node:test';
+import assert from 'node:assert/strict';
+
+import {
+  decodeAutomationLane,
+  encodeAutomationLane,
+  scheduleAutomation,
+  AUTOMATION_RAMP_FRAMES
+} from '../../src/assets/js/core/automationLane.js';
+
+// Grabado por ProcessorBridge con startFrame 5000: scheduleParam('gain', 0.5) en 5010,
+// scheduleParam('gain', 0.25) en 5200 y setParam('gain', 2) antes del bloque 5512
+const NATIVE_RECORDING = Uint8Array.from([
+  41, 0, 0, 0, 0, 63,
+  248, 5, 0, 0, 128, 62,
+  226, 9, 0, 0, 0, 64
+]);
+
+const NATIVE_EVENTS = [
+  { frame: 5010, id: 0, value: 0.5, ramp: false },
+  { frame: 5200, id: 0, value: 0.25, ramp: false },
+  { frame: 5512, id: 0, value: 2, ramp: true }
+];
+
+class MockParam {
+  constructor() {
+    this.calls = [];
+  }
+  setValueAtTime(value, time) {
+    this.calls.push(['set', value, time]);
+  }
+  linearRampToValueAtTime(value, time) {
+    this.calls.push(['ramp', value, time]);
+  }
+}
+
+describe('decodeAutomationLane / encodeAutomationLane', () => {
+  it('decodifica el formato del registro nativo', () => {
+    assert.deepEqual(decodeAutomationLane(NATIVE_RECORDING, 5000), NATIVE_EVENTS);
+  });
+
+  it('codifica byte a byte igual que el nativo (5-6 bytes por evento)', () => {
+    assert.deepEqual(encodeAutomationLane(NATIVE_EVENTS, 5000), NATIVE_RECORDING);
+  });
+
+  it('ida y vuelta con varios parámetros, deltas grandes y vuelta de 2^32', () => {
+    const start = 2 ** 32 - 100;
+    const events = [
+      { frame: start + 10, id: 3, value: 1.5, ramp: false },
+      { frame: start + 10, id: 1, value: -0.75, ramp: true },
+      { frame: (start + 1_000_000) >>> 0, id: 1, value: 0, ramp: false }
+    ];
+    // encode trabaja con frames sin envolver; decode los devuelve módulo 2^32
+    const unwrapped = events.map(e => ({ ...e, frame: e.frame >= start ? e.frame : e.frame + 2 ** 32 }));
+    const data = encodeAutomationLane(unwrapped, start);
+    assert.deepEqual(decodeAutomationLane(data, start), events);
+  });
+
+  it('un registro truncado devuelve solo los eventos completos', () => {
+    const events = decodeAutomationLane(NATIVE_RECORDING.subarray(0, 14), 5000);
+    assert.deepEqual(events, NATIVE_EVENTS.slice(0, 2));
+  });
+});
+
+describe('scheduleAutomation', () => {
+  const recording = {
+    startFrame: 5000,
+    sampleRate: 48000,
+    data: NATIVE_RECORDING,
+    params: ['gain']
+  };
+
+  it('programa saltos y rampas relativas a startTime', () => {
+    const param = new MockParam();
+    const count = scheduleAutomation(recording, name => (name === 'gain' ? param : null), { startTime: 1 });
+    assert.equal(count, 3);
+    assert.deepEqual(param.calls, [
+      ['set', 0.5, 1 + 10 / 48000],
+      ['set', 0.25, 1 + 200 / 48000],
+      ['set', 0.25, 1 + 512 / 48000],
+      ['ramp', 2, 1 + 512 / 48000 + AUTOMATION_RAMP_FRAMES / 48000]
+    ]);
+  });
+
+  it('ignora parámetros sin AudioParam', () => {
+    assert.equal(scheduleAutomation(recording, () => null), 0);
+  });
+});
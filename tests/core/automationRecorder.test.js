@@ -0,0 +1,147 @@
+/**
+ * Tests para core/automationRecorder.js — Automatización de la app
+ *
+ * Verifica:
+ * - Los cambios locales llegan al grabador aunque no haya red OSC
+ * - Frames del AudioContext relativos al inicio y formato de automationLane.js
+ * - Argumentos no numéricos como parámetro propio (color de pin, notas)
+ * - Reproducción: patch inicial, eventos a su frame y manejadores de los
+ *   módulos de sincronización sin la ventana anti-rebote
+ */
+
+import { describe, it, afterEach, mock } from 'node:test';
+import assert from 'node:assert/strict';
+
+import { oscBridge } from '../../src/assets/js/osc/oscBridge.js';
+import { oscillatorOSCSync } from '../../src/assets/js/osc/oscOscillatorSync.js';
+import { decodeAutomationLane } from '../../src/assets/js/core/automationLane.js';
+import {
+  AutomationRecorder,
+  automationParamKey,
+  automationMessage,
+  PLAYBACK_TICK_MS
+} from '../../src/assets/js/core/automationRecorder.js';
+
+function createContext(sampleRate = 48000) {
+  return { sampleRate, currentTime: 1 };
+}
+
+describe('AutomationRecorder', () => {
+  afterEach(() => {
+    mock.timers.reset();
+    oscBridge._listeners.clear();
+    oscBridge._taps.clear();
+  });
+
+  it('sin grabación ni red, los módulos no generan mensajes', () => {
+    assert.equal(oscBridge.connected, false);
+    assert.equal(oscBridge.wantsLocalChanges(), false);
+  });
+
+  it('graba cambios locales sin red OSC con el frame del AudioContext', () => {
+    const ctx = createContext();
+    const recorder = new AutomationRecorder({ getContext: () => ctx, serializeState: () => ({ id: 'p' }) });
+
+    assert.equal(recorder.start(), true);
+    assert.equal(oscBridge.wantsLocalChanges(), true);
+
+    ctx.currentTime = 1 + 100 / 48000;
+    oscBridge.send('osc/1/frequency', 5);
+    ctx.currentTime = 1 + 400 / 48000;
+    oscBridge.send('audio/osc1/Out1', 'WHITE');
+    oscBridge.send('osc/1/frequency', 6.5);
+
+    const recording = recorder.stop();
+    assert.equal(recorder.isRecording, false);
+    assert.equal(oscBridge.wantsLocalChanges(), false);
+
+    assert.equal(recording.startFrame, 48000);
+    assert.equal(recording.sampleRate, 48000);
+    assert.equal(recording.events, 3);
+    assert.deepEqual(recording.state, { id: 'p' });
+    assert.deepEqual(recording.params, ['osc/1/frequency', 'audio/osc1/Out1 ["WHITE"]']);
+    assert.deepEqual(decodeAutomationLane(recording.data, recording.startFrame), [
+      { frame: 48100, id: 0, value: 5, ramp: false },
+      { frame: 48400, id: 1, value: 0, ramp: false },
+      { frame: 48400, id: 0, value: 6.5, ramp: false }
+    ]);
+  });
+
+  it('graba OSC entrante con la dirección sin prefijo', () => {
+    const ctx = createContext();
+    const recorder = new AutomationRecorder({ getContext: () => ctx });
+    recorder.start();
+    oscBridge._tap('/SynthiGME/keyboard/upper/noteOn', [60, 100], 'osc');
+    const recording = recorder.stop();
+    assert.deepEqual(recording.params, ['keyboard/upper/noteOn [60,100]']);
+  });
+
+  it('no graba sin AudioContext', () => {
+    const recorder = new AutomationRecorder({ getContext: () => null });
+    assert.equal(recorder.start(), false);
+    assert.equal(recorder.stop(), null);
+  });
+
+  it('clave y mensaje son inversos', () => {
+    for (const args of [[2.5], ['WHITE'], [60, 100], [0]]) {
+      const { key, value } = automationParamKey('a/b', args);
+      assert.deepEqual(automationMessage(key, value), { address: 'a/b', args });
+    }
+  });
+
+  it('reproduce sobre el patch inicial cada evento al llegar a su frame', async () => {
+    mock.timers.enable({ apis: ['setInterval'] });
+    const ctx = createContext();
+    const applied = [];
+    const recorder = new AutomationRecorder({
+      getContext: () => ctx,
+      serializeState: () => ({ id: 'inicio' }),
+      applyState: (state) => { applied.push(state); }
+    });
+
+    recorder.start();
+    ctx.currentTime = 1 + 480 / 48000;
+    oscBridge.send('osc/1/frequency', 3);
+    ctx.currentTime = 1 + 960 / 48000;
+    oscBridge.send('audio/osc1/Out1', 'WHITE');
+    const recording = recorder.stop();
+
+    const received = [];
+    oscBridge.on('osc/1/frequency', (value) => received.push(['freq', value]));
+    oscBridge.on('audio/osc1/Out1', (value) => received.push(['pin', value]));
+    let ended = 0;
+    recorder.onPlaybackEnd = () => { ended++; };
+
+    ctx.currentTime = 10;
+    assert.equal(await recorder.play(recording), true);
+    assert.deepEqual(applied, [{ id: 'inicio' }]);
+    assert.deepEqual(received, []);
+
+    ctx.currentTime = 10 + 480 / 48000;
+    mock.timers.tick(PLAYBACK_TICK_MS);
+    assert.deepEqual(received, [['freq', 3]]);
+
+    ctx.currentTime = 10 + 1000 / 48000;
+    mock.timers.tick(PLAYBACK_TICK_MS);
+    assert.deepEqual(received, [['freq', 3], ['pin', 'WHITE']]);
+    assert.equal(ended, 1);
+    assert.equal(recorder.isPlaying, false);
+  });
+
+  it('los manejadores de sincronización no descartan eventos seguidos', async () => {
+    const values = [];
+    const knob = { setValue: (v) => values.push(v) };
+    oscillatorOSCSync.init({
+      _oscillatorUIs: { 'panel3-osc-1': { knobs: [knob, knob, knob, knob, knob, knob, knob] } },
+      _updatePanelOscFreq: () => {}
+    });
+
+    oscBridge.dispatchLocal('osc/1/frequency', [4]);
+    oscBridge.dispatchLocal('osc/1/frequency', [5]);
+    assert.deepEqual(values, [4, 5]);
+    assert.equal(oscBridge.dispatchingLocal, false);
+
+    oscillatorOSCSync.destroy();
+    await new Promise(resolve => setTimeout(resolve, 20));
+  });
+});
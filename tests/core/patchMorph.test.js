@@ -0,0 +1,162 @@
+/**
+ * Tests para core/patchMorph.js — Morphing de patch con el procesador nativo
+ *
+ * Simula window.nativeBridgeAPI (el addon) y un AudioContext mínimo.
+ *
+ * Verifica:
+ * - Sin el procesador "morph" registrado, create() devuelve null
+ * - Canales del bridge: fuentes + CV de entrada, destinos + carriles de salida
+ * - Snapshots: tripletes aplanados a setData("a"/"b") y parámetros a "params.*"
+ * - setMorph inmediato (setParam) y programado (scheduleParam en frames)
+ * - matrixStateToTriplets convierte un MatrixState serializado
+ */
+
+import { describe, it, beforeEach, afterEach } from 'node:test';
+import assert from 'node:assert/strict';
+
+import {
+  PatchMorph,
+  matrixStateToTriplets,
+  flattenTriplets
+} from '../../src/assets/js/core/patchMorph.js';
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MOCKS
+// ═══════════════════════════════════════════════════════════════════════════
+
+function createNativeApi(types = ['passthrough', 'gain', 'morph']) {
+  const api = {
+    calls: [],
+    created: null,
+    isAvailable: () => true,
+    listProcessors: () => types,
+    create(type, sab, config) {
+      api.created = { type, sab, config };
+      return { success: true, id: 7 };
+    },
+    setParam(id, name, value) {
+      api.calls.push({ fn: 'setParam', id, name, value });
+      return true;
+    },
+    scheduleParam(id, name, value, frame) {
+      api.calls.push({ fn: 'scheduleParam', id, name, value, frame });
+      return true;
+    },
+    setData(id, name, data) {
+      api.calls.push({ fn: 'setData', id, name, data: Array.from(data) });
+      return true;
+    },
+    getStats: () => null,
+    destroy(id) {
+      api.calls.push({ fn: 'destroy', id });
+    }
+  };
+  return api;
+}
+
+class MockWorkletNode {
+  constructor(ctx, name, options) {
+    this.name = name;
+    this.options = options;
+    this.port = { postMessage: () => {} };
+  }
+  disconnect() {}
+}
+
+function createContext() {
+  return {
+    sampleRate: 48000,
+    audioWorklet: { addModule: async () => {} }
+  };
+}
+
+let api;
+
+beforeEach(() => {
+  api = createNativeApi();
+  globalThis.window = { nativeBridgeAPI: api };
+  globalThis.AudioWorkletNode = MockWorkletNode;
+});
+
+afterEach(() => {
+  delete globalThis.window;
+  delete globalThis.AudioWorkletNode;
+});
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+describe('PatchMorph — creación', () => {
+  it('devuelve null si el addon no registra "morph"', async () => {
+    globalThis.window.nativeBridgeAPI = createNativeApi(['passthrough']);
+    assert.equal(PatchMorph.isAvailable(), false);
+    assert.equal(await PatchMorph.create(createContext(), { sources: 2, destinations: 2 }), null);
+  });
+
+  it('reserva una entrada extra de CV y una salida por parámetro', async () => {
+    const morph = await PatchMorph.create(createContext(), { sources: 4, destinations: 3, params: 2 });
+    assert.ok(morph);
+    assert.equal(api.created.type, 'morph');
+    assert.equal(api.created.config.inputs, 5);
+    assert.equal(api.created.config.outputs, 5);
+    assert.equal(morph.cvInput, 4);
+    assert.equal(morph.paramOutput(1), 4);
+    assert.deepEqual(
+      api.calls.find(c => c.fn === 'setParam'),
+      { fn: 'setParam', id: 7, name: 'destinations', value: 3 }
+    );
+  });
+});
+
+describe('PatchMorph — snapshots y posición', () => {
+  let morph;
+
+  beforeEach(async () => {
+    morph = await PatchMorph.create(createContext(), { sources: 2, destinations: 2, params: 1 });
+    api.calls.length = 0;
+  });
+
+  it('setSnapshot envía la matriz aplanada y los parámetros', () => {
+    assert.equal(morph.setSnapshot('b', { connections: [[0, 1, 0.5], [1, 0, 1]], params: [0.25] }), true);
+    assert.deepEqual(api.calls, [
+      { fn: 'setData', id: 7, name: 'b', data: [0, 1, 0.5, 1, 0, 1] },
+      { fn: 'setData', id: 7, name: 'params.b', data: [0.25] }
+    ]);
+  });
+
+  it('setSnapshot rechaza un slot desconocido', () => {
+    assert.throws(() => morph.setSnapshot('c', {}), /Invalid morph slot/);
+  });
+
+  it('setMorph sin tiempo usa setParam y con tiempo programa el frame', () => {
+    morph.setMorph(0.5);
+    morph.setMorph(1, 2.5);
+    assert.deepEqual(api.calls, [
+      { fn: 'setParam', id: 7, name: 'morph', value: 0.5 },
+      { fn: 'scheduleParam', id: 7, name: 'morph', value: 1, frame: 120000 }
+    ]);
+  });
+
+  it('dispose destruye el bridge', () => {
+    morph.dispose();
+    assert.deepEqual(api.calls.at(-1), { fn: 'destroy', id: 7 });
+    assert.equal(morph.setMorph(1), false);
+  });
+});
+
+describe('matrixStateToTriplets', () => {
+  it('usa ganancia 1 por defecto y respeta gainFn', () => {
+    const state = { connections: [[0, 5], [3, 12, 'grey']] };
+    assert.deepEqual(matrixStateToTriplets(state), [[0, 5, 1], [3, 12, 1]]);
+    assert.deepEqual(
+      matrixStateToTriplets(state, (row, col, entry) => (entry[2] === 'grey' ? 0.1 : 1)),
+      [[0, 5, 1], [3, 12, 0.1]]
+    );
+    assert.deepEqual(matrixStateToTriplets(null), []);
+  });
+
+  it('flattenTriplets produce [row, col, gain, ...]', () => {
+    assert.deepEqual(Array.from(flattenTriplets([[1, 2, 0.5]])), [1, 2, 0.5]);
+  });
+});
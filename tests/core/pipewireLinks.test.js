@@ -0,0 +1,179 @@
+/**
+ * Tests para core/pipewireLinks.js — Restauración de enlaces PipeWire
+ *
+ * Simula window.pipewireLinksAPI (el LinkManager del addon).
+ *
+ * Verifica:
+ * - normalizeLinkRules descarta entradas inválidas y duplicadas
+ * - rulesFromLinks: lo capturado reemplaza reglas exactas (también con cero
+ *   enlaces), los comodines y el hardware ausente se conservan
+ * - startLinkManager arranca con las reglas guardadas
+ * - saveLinkRules persiste y aplica; captureLinkRules guarda el ruteo actual
+ * - Instalación: enrutar, salir (beforeunload) y arrancar en frío restaura
+ */
+
+import '../mocks/localStorage.mock.js';
+import { describe, it, beforeEach, afterEach } from 'node:test';
+import assert from 'node:assert/strict';
+
+import {
+  normalizeLinkRules,
+  rulesFromLinks,
+  loadLinkRules,
+  saveLinkRules,
+  startLinkManager,
+  captureLinkRules
+} from '../../src/assets/js/core/pipewireLinks.js';
+import { STORAGE_KEYS } from '../../src/assets/js/utils/constants.js';
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MOCKS
+// ═══════════════════════════════════════════════════════════════════════════
+
+const SYNTHI_PORTS = ['SynthiGME:Out_1', 'SynthiGME:Out_2'];
+const HW_PORTS = ['alsa_output.usb:playback_AUX0', 'alsa_output.usb:playback_AUX1'];
+
+function createWindow(api) {
+  const listeners = new Map();
+  return {
+    pipewireLinksAPI: api,
+    addEventListener(type, fn) {
+      if (!listeners.has(type)) listeners.set(type, []);
+      listeners.get(type).push(fn);
+    },
+    dispatch(type) {
+      (listeners.get(type) ?? []).forEach(fn => fn());
+    },
+    listeners
+  };
+}
+
+function createLinksApi(links = [], synthiPorts = SYNTHI_PORTS, hwPorts = HW_PORTS) {
+  const api = {
+    calls: [],
+    isAvailable: () => true,
+    start(rules) {
+      api.calls.push({ fn: 'start', rules });
+      return { success: true, rules: rules.length };
+    },
+    setRules(rules) {
+      api.calls.push({ fn: 'setRules', rules });
+      return rules.length;
+    },
+    snapshot(pattern) {
+      api.calls.push({ fn: 'snapshot', pattern });
+      return links;
+    },
+    ports(pattern) {
+      return pattern === '*' ? [...synthiPorts, ...hwPorts] : synthiPorts;
+    }
+  };
+  return api;
+}
+
+const OUT_1 = { output: 'SynthiGME:Out_1', input: 'alsa_output.usb:playback_AUX0' };
+const OUT_2 = { output: 'SynthiGME:Out_2', input: 'alsa_output.usb:playback_AUX1' };
+
+beforeEach(() => {
+  localStorage.clear();
+});
+
+afterEach(() => {
+  delete globalThis.window;
+});
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+describe('normalizeLinkRules / rulesFromLinks', () => {
+  it('descarta entradas sin "nodo:puerto" y duplicados', () => {
+    const rules = normalizeLinkRules([OUT_1, { output: 'SynthiGME', input: 'x:y' }, null, { ...OUT_1 }, OUT_2]);
+    assert.deepEqual(rules, [OUT_1, OUT_2]);
+    assert.deepEqual(normalizeLinkRules('nope'), []);
+  });
+
+  it('un enlace capturado reemplaza las reglas exactas del mismo puerto', () => {
+    const wildcard = { output: 'SynthiGME-Input:*', input: 'x:*' };
+    const moved = { output: 'SynthiGME:Out_1', input: 'alsa_output.usb:playback_AUX7' };
+    assert.deepEqual(rulesFromLinks([OUT_1, OUT_2, wildcard], [moved]), [OUT_2, wildcard, moved]);
+  });
+
+  it('un puerto capturado sin enlaces pierde sus reglas exactas', () => {
+    assert.deepEqual(rulesFromLinks([OUT_1, OUT_2], [OUT_2], SYNTHI_PORTS), [OUT_2]);
+    assert.deepEqual(rulesFromLinks([OUT_1, OUT_2], [], SYNTHI_PORTS), []);
+  });
+
+  it('conserva las reglas hacia hardware que no está en el grafo', () => {
+    const present = [...SYNTHI_PORTS, 'alsa_output.usb:playback_AUX1'];
+    assert.deepEqual(rulesFromLinks([OUT_1, OUT_2], [], SYNTHI_PORTS, present), [OUT_1]);
+  });
+});
+
+describe('LinkManager desde JS', () => {
+  it('sin pipewireLinksAPI no arranca ni captura', () => {
+    assert.equal(startLinkManager(), false);
+    assert.equal(captureLinkRules(), null);
+  });
+
+  it('startLinkManager arranca con las reglas guardadas', () => {
+    localStorage.setItem(STORAGE_KEYS.PIPEWIRE_LINK_RULES, JSON.stringify([OUT_1]));
+    const api = createLinksApi();
+    globalThis.window = createWindow(api);
+    assert.equal(startLinkManager(), true);
+    assert.deepEqual(api.calls, [{ fn: 'start', rules: [OUT_1] }]);
+  });
+
+  it('saveLinkRules persiste y aplica al manager', () => {
+    const api = createLinksApi();
+    globalThis.window = createWindow(api);
+    saveLinkRules([OUT_2, OUT_2]);
+    assert.deepEqual(loadLinkRules(), [OUT_2]);
+    assert.deepEqual(api.calls, [{ fn: 'setRules', rules: [OUT_2] }]);
+  });
+
+  it('captureLinkRules guarda los enlaces actuales de SynthiGME*', () => {
+    localStorage.setItem(STORAGE_KEYS.PIPEWIRE_LINK_RULES, JSON.stringify([OUT_1]));
+    globalThis.window = { pipewireLinksAPI: createLinksApi([OUT_2]) };
+    assert.deepEqual(captureLinkRules(), [OUT_2]);
+    assert.equal(window.pipewireLinksAPI.calls[0].pattern, 'SynthiGME*');
+    assert.deepEqual(loadLinkRules(), [OUT_2]);
+  });
+
+  it('captureLinkRules persiste también un ruteo vacío', () => {
+    localStorage.setItem(STORAGE_KEYS.PIPEWIRE_LINK_RULES, JSON.stringify([OUT_1, OUT_2]));
+    globalThis.window = { pipewireLinksAPI: createLinksApi([]) };
+    assert.deepEqual(captureLinkRules(), []);
+    assert.deepEqual(loadLinkRules(), []);
+  });
+
+  it('captureLinkRules sin puertos SynthiGME no sobrescribe lo guardado', () => {
+    localStorage.setItem(STORAGE_KEYS.PIPEWIRE_LINK_RULES, JSON.stringify([OUT_1]));
+    globalThis.window = { pipewireLinksAPI: createLinksApi([], []) };
+    assert.equal(captureLinkRules(), null);
+    assert.deepEqual(loadLinkRules(), [OUT_1]);
+  });
+
+  it('enrutar, salir y arrancar en frío restaura el ruteo', () => {
+    // Primera sesión: sin reglas; el usuario enruta Out_1 en qpwgraph y sale
+    const session = createLinksApi();
+    globalThis.window = createWindow(session);
+    assert.equal(startLinkManager(), true);
+    startLinkManager();
+    assert.equal(window.listeners.get('beforeunload').length, 1);
+    session.snapshot = () => [OUT_1];
+    window.dispatch('beforeunload');
+    assert.deepEqual(loadLinkRules(), [OUT_1]);
+
+    // Arranque en frío: el manager recibe el ruteo guardado
+    const cold = createLinksApi();
+    globalThis.window = createWindow(cold);
+    startLinkManager();
+    assert.deepEqual(cold.calls, [{ fn: 'start', rules: [OUT_1] }]);
+  });
+
+  it('ignora JSON corrupto en localStorage', () => {
+    localStorage.setItem(STORAGE_KEYS.PIPEWIRE_LINK_RULES, '{roto');
+    assert.deepEqual(loadLinkRules(), []);
+  });
+});
@@ -0,0 +1,107 @@
+/**
+ * Tests para core/pluginBridge.js — Puente con el plugin LV2 synthigme-bridge
+ *
+ * Simula window.pluginBridgeAPI (el PluginBridge del addon).
+ *
+ * Verifica:
+ * - El puente es opcional: sin preferencia guardada no se abre
+ * - startPluginBridge pasa frecuencia, cebado y latencia de la app
+ * - Desactivar la preferencia cierra el puente
+ * - estimatePipelineFrames suma prebuffer y baseLatency del contexto
+ */
+
+import '../mocks/localStorage.mock.js';
+import { describe, it, beforeEach, afterEach } from 'node:test';
+import assert from 'node:assert/strict';
+
+import {
+  PLUGIN_BRIDGE_LATENCY_FRAMES,
+  isPluginBridgeEnabled,
+  setPluginBridgeEnabled,
+  estimatePipelineFrames,
+  startPluginBridge,
+  stopPluginBridge
+} from '../../src/assets/js/core/pluginBridge.js';
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MOCKS
+// ═══════════════════════════════════════════════════════════════════════════
+
+function createBridgeApi({ success = true } = {}) {
+  const api = {
+    calls: [],
+    isAvailable: () => true,
+    start(config) {
+      api.calls.push({ fn: 'start', config });
+      return success ? { success: true } : { success: false, error: 'shm' };
+    },
+    stop() {
+      api.calls.push({ fn: 'stop' });
+    }
+  };
+  return api;
+}
+
+beforeEach(() => {
+  localStorage.clear();
+});
+
+afterEach(() => {
+  delete globalThis.window;
+});
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+describe('PluginBridge desde JS', () => {
+  it('desactivado por defecto: no abre el puente', () => {
+    const api = createBridgeApi();
+    globalThis.window = { pluginBridgeAPI: api };
+    assert.equal(isPluginBridgeEnabled(), false);
+    assert.equal(startPluginBridge({ sampleRate: 48000 }), false);
+    assert.deepEqual(api.calls, []);
+  });
+
+  it('sin pluginBridgeAPI no abre ni falla', () => {
+    setPluginBridgeEnabled(true);
+    assert.equal(startPluginBridge(), false);
+    assert.doesNotThrow(() => stopPluginBridge());
+  });
+
+  it('habilitado: abre con la frecuencia, el cebado y la latencia de la app', () => {
+    const api = createBridgeApi();
+    globalThis.window = { pluginBridgeAPI: api };
+    setPluginBridgeEnabled(true);
+    assert.equal(startPluginBridge({ sampleRate: 44100, pipelineFrames: 2100 }), true);
+    assert.deepEqual(api.calls, [{
+      fn: 'start',
+      config: { sampleRate: 44100, latencyFrames: PLUGIN_BRIDGE_LATENCY_FRAMES, pipelineFrames: 2100 }
+    }]);
+  });
+
+  it('devuelve false si el addon no puede crear la memoria compartida', () => {
+    globalThis.window = { pluginBridgeAPI: createBridgeApi({ success: false }) };
+    setPluginBridgeEnabled(true);
+    assert.equal(startPluginBridge(), false);
+  });
+
+  it('desactivar la preferencia cierra el puente', () => {
+    const api = createBridgeApi();
+    globalThis.window = { pluginBridgeAPI: api };
+    setPluginBridgeEnabled(true);
+    setPluginBridgeEnabled(false);
+    assert.equal(isPluginBridgeEnabled(), false);
+    assert.deepEqual(api.calls, [{ fn: 'stop' }]);
+  });
+});
+
+describe('estimatePipelineFrames', () => {
+  it('suma prebuffer nativo y baseLatency del AudioContext', () => {
+    assert.equal(estimatePipelineFrames({ sampleRate: 48000, baseLatency: 0.01 }, 2048), 2528);
+  });
+
+  it('sin contexto ni prebuffer es 0', () => {
+    assert.equal(estimatePipelineFrames(null), 0);
+  });
+});
@@ -111,6 +111,23 @@ describe('Lógica de latencia de audio', () => {
     });
   });
 
+  describe('Latencia en modo driver', () => {
+    // Replica la lógica de _updateTotalLatency con DRIVER_MODE_LATENCY_MS = 5
+    const calculateTotalLatency = (webAudioMs, multichannelMs, isMultichannel, driverMode) => {
+      const bufferMs = driverMode ? 5 : multichannelMs;
+      return webAudioMs + (isMultichannel ? bufferMs : 0);
+    };
+
+    it('en modo driver ignora la latencia multicanal configurada', () => {
+      assert.strictEqual(calculateTotalLatency(25, 85, true, true), 30);
+      assert.strictEqual(calculateTotalLatency(25, 170, true, true), 30);
+    });
+
+    it('sin multicanal el modo driver no suma nada', () => {
+      assert.strictEqual(calculateTotalLatency(25, 42, false, true), 25);
+    });
+  });
+
   describe('Clasificación de latencia por colores', () => {
     // Replica la lógica de clasificación
     const getLatencyClass = (totalMs) => {
@@ -293,6 +310,10 @@ describe('STORAGE_KEYS de latencia', () => {
       STORAGE_KEYS.AUDIO_LATENCY
     );
   });
+
+  it('AUDIO_DRIVER_MODE usa el prefijo correcto', () => {
+    assert.ok(STORAGE_KEYS.AUDIO_DRIVER_MODE.startsWith('synthigme-'));
+  });
 });
 // ═══════════════════════════════════════════════════════════════════════════
 // TESTS DE ROUTING DE SALIDA
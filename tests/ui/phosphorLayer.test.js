@@ -0,0 +1,346 @@
+/**
+ * Tests para ui/phosphorLayer.js — Capa de persistencia de fósforo (X-Y)
+ *
+ * Simula window.phosphorScopeAPI (el addon nativo) escribiendo frames en el
+ * mismo SharedArrayBuffer que publicaría PhosphorScope.
+ *
+ * Verifica:
+ * - Sin addon, create() devuelve null y el display sigue con canvas
+ * - Layout del SAB (cabecera de 8 Int32 + 2 frames RGBA)
+ * - blit() copia píxeles solo cuando cambia seq, y desde el frame front
+ * - OscilloscopeDisplay envía cada captura una sola vez y la compone en X-Y
+ * - La config del osciloscopio llega al nativo con valores en rango
+ * - Sin addon, o con el fósforo desactivado, X-Y vuelve al trazo con canvas
+ */
+
+import { describe, it, beforeEach, afterEach } from 'node:test';
+import assert from 'node:assert/strict';
+
+import { oscilloscopeConfig } from '../../src/assets/js/configs/index.js';
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MOCKS
+// ═══════════════════════════════════════════════════════════════════════════
+
+const HEADER_WORDS = 8;
+const SEQ = 0;
+const FRONT = 1;
+
+class MockContext2D {
+  constructor() {
+    this.putCount = 0;
+    this.drawCount = 0;
+    this.lineCount = 0;
+    this.lastImage = null;
+  }
+  createImageData(w, h) {
+    return { width: w, height: h, data: new Uint8ClampedArray(w * h * 4) };
+  }
+  putImageData(img) {
+    this.putCount++;
+    this.lastImage = img;
+  }
+  drawImage() {
+    this.drawCount++;
+  }
+  fillRect() {}
+  clearRect() {}
+  beginPath() {}
+  moveTo() {}
+  lineTo() {
+    this.lineCount++;
+  }
+  stroke() {}
+  arc() {}
+  fill() {}
+  fillText() {}
+  setLineDash() {}
+  save() {}
+  restore() {}
+}
+
+class MockCanvas {
+  constructor() {
+    this.width = 0;
+    this.height = 0;
+    this.style = {};
+    this._ctx = new MockContext2D();
+  }
+  getContext() {
+    return this._ctx;
+  }
+}
+
+/** Réplica del lado nativo: guarda el SAB y registra llamadas */
+function createNativeApi() {
+  const api = {
+    scopes: new Map(),
+    calls: [],
+    nextId: 1,
+    isAvailable: () => true,
+    create(width, height, sab, config) {
+      const id = api.nextId++;
+      api.scopes.set(id, { width, height, sab, config });
+      return { success: true, id };
+    },
+    submit(id, x, y, cx, cy, sx, sy) {
+      api.calls.push({ fn: 'submit', id, x, y, cx, cy, sx, sy });
+    },
+    clear(id) {
+      api.calls.push({ fn: 'clear', id });
+    },
+    setColor(id, r, g, b) {
+      api.calls.push({ fn: 'setColor', id, rgb: [r, g, b] });
+    },
+    setPersistence() {},
+    getStats: () => ({ running: true }),
+    destroy(id) {
+      api.scopes.delete(id);
+      api.calls.push({ fn: 'destroy', id });
+    },
+    /** Publica un frame relleno con `alpha` en el buffer trasero */
+    publish(id, alpha) {
+      const { width, height, sab } = api.scopes.get(id);
+      const header = new Int32Array(sab, 0, HEADER_WORDS);
+      const back = 1 - Atomics.load(header, FRONT);
+      const frameBytes = width * height * 4;
+      const frame = new Uint8Array(sab, HEADER_WORDS * 4 + back * frameBytes, frameBytes);
+      for (let p = 3; p < frameBytes; p += 4) frame[p] = alpha;
+      Atomics.store(header, FRONT, back);
+      Atomics.add(header, SEQ, 1);
+    }
+  };
+  return api;
+}
+
+let api;
+let PhosphorLayer;
+let parseHexColor;
+let phosphorBufferBytes;
+
+beforeEach(async () => {
+  api = createNativeApi();
+  globalThis.window = { devicePixelRatio: 1, phosphorScopeAPI: api };
+  globalThis.document = { createElement: () => new MockCanvas() };
+  ({ PhosphorLayer, parseHexColor, phosphorBufferBytes } =
+    await import('../../src/assets/js/ui/phosphorLayer.js'));
+});
+
+afterEach(() => {
+  delete globalThis.window;
+  delete globalThis.document;
+});
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+describe('PhosphorLayer — disponibilidad', () => {
+  it('create() devuelve null sin phosphorScopeAPI', () => {
+    delete globalThis.window.phosphorScopeAPI;
+    assert.equal(PhosphorLayer.isAvailable(), false);
+    assert.equal(PhosphorLayer.create(64, 48), null);
+  });
+
+  it('create() devuelve null si el nativo falla', () => {
+    api.create = () => ({ success: false, error: 'boom' });
+    const warn = console.warn;
+    console.warn = () => {};
+    try {
+      assert.equal(PhosphorLayer.create(64, 48), null);
+    } finally {
+      console.warn = warn;
+    }
+  });
+
+  it('reserva cabecera + dos frames RGBA y pasa el color como RGB', () => {
+    const layer = PhosphorLayer.create(64, 48, { color: '#ff8000', persistenceMs: 120 });
+    assert.ok(layer);
+    const scope = api.scopes.get(layer.id);
+    assert.equal(scope.sab.byteLength, 32 + 64 * 48 * 4 * 2);
+    assert.equal(phosphorBufferBytes(64, 48), scope.sab.byteLength);
+    assert.deepEqual(scope.config.color, [255, 128, 0]);
+    assert.equal(scope.config.persistenceMs, 120);
+  });
+});
+
+describe('PhosphorLayer — composición', () => {
+  it('blit() solo copia cuando el nativo publica un frame nuevo', () => {
+    const layer = PhosphorLayer.create(8, 4);
+    const target = new MockContext2D();
+
+    assert.equal(layer.blit(target), false);
+    assert.equal(layer._ctx.putCount, 0);
+    assert.equal(target.drawCount, 1);
+
+    api.publish(layer.id, 200);
+    assert.equal(layer.blit(target), true);
+    assert.equal(layer.blit(target), false);
+    assert.equal(layer._ctx.putCount, 1);
+    assert.equal(target.drawCount, 3);
+  });
+
+  it('copia el frame front (doble buffer)', () => {
+    const layer = PhosphorLayer.create(8, 4);
+    const target = new MockContext2D();
+
+    api.publish(layer.id, 10);
+    layer.blit(target);
+    assert.equal(layer._ctx.lastImage.data[3], 10);
+
+    api.publish(layer.id, 77);
+    layer.blit(target);
+    assert.equal(layer._ctx.lastImage.data[3], 77);
+  });
+
+  it('dispose() destruye el nativo y deja la capa inerte', () => {
+    const layer = PhosphorLayer.create(8, 4);
+    const id = layer.id;
+    layer.dispose();
+    assert.equal(api.scopes.has(id), false);
+    assert.equal(layer.blit(new MockContext2D()), false);
+    layer.submit(new Float32Array(4), new Float32Array(4), 0, 0, 1, 1);
+    assert.equal(api.calls.filter(c => c.fn === 'submit').length, 0);
+  });
+
+  it('parseHexColor acepta #rgb y #rrggbb', () => {
+    assert.deepEqual(parseHexColor('#0f0'), [0, 255, 0]);
+    assert.deepEqual(parseHexColor('#123456'), [0x12, 0x34, 0x56]);
+    assert.deepEqual(parseHexColor('rgb(1,2,3)'), [0, 255, 0]);
+  });
+});
+
+describe('OscilloscopeDisplay con fósforo', () => {
+  let OscilloscopeDisplay;
+
+  beforeEach(async () => {
+    ({ OscilloscopeDisplay } = await import('../../src/assets/js/ui/oscilloscopeDisplay.js'));
+  });
+
+  function makeDisplay(mode) {
+    const canvas = new MockCanvas();
+    canvas.width = 200;
+    canvas.height = 100;
+    return new OscilloscopeDisplay({
+      canvas,
+      mode,
+      centerOffsetX: 5,
+      phosphor: { enabled: true, persistenceMs: 60 }
+    });
+  }
+
+  const capture = () => ({
+    bufferX: new Float32Array([0, 0.5, 1]),
+    bufferY: new Float32Array([0, -0.5, 1]),
+    triggered: true
+  });
+
+  it('en X-Y envía la captura con el mapeo de _drawXY y compone el frame', () => {
+    const display = makeDisplay('xy');
+    assert.ok(display.phosphor);
+    display.draw(capture());
+
+    const submits = api.calls.filter(c => c.fn === 'submit');
+    assert.equal(submits.length, 1);
+    assert.deepEqual(
+      [submits[0].cx, submits[0].cy, submits[0].sx, submits[0].sy],
+      [105, 50, 100, 50]
+    );
+    assert.equal(display.ctx.drawCount, 1);
+  });
+
+  it('redibujar la misma captura no la reenvía', () => {
+    const display = makeDisplay('xy');
+    const data = capture();
+    display.draw(data);
+    display.setAmpScale(2);
+    display.refresh();
+    assert.equal(api.calls.filter(c => c.fn === 'submit').length, 1);
+    assert.equal(display.ctx.drawCount, 3);
+  });
+
+  it('en Y-T no usa el fósforo', () => {
+    const display = makeDisplay('yt');
+    display.draw(capture());
+    assert.equal(api.calls.filter(c => c.fn === 'submit').length, 0);
+    assert.equal(display.ctx.drawCount, 0);
+  });
+
+  it('cambio de modo y ausencia de señal apagan el fósforo; destroy lo libera', () => {
+    const display = makeDisplay('xy');
+    display.draw(capture());
+    display.setMode('yt');
+    display.draw({ noSignal: true });
+    assert.equal(api.calls.filter(c => c.fn === 'clear').length, 2);
+
+    const id = display.phosphor.id;
+    display.destroy();
+    assert.equal(api.scopes.has(id), false);
+    assert.equal(display.phosphor, null);
+  });
+});
+
+describe('OscilloscopeDisplay — config y fallback a canvas', () => {
+  let OscilloscopeDisplay;
+
+  beforeEach(async () => {
+    ({ OscilloscopeDisplay } = await import('../../src/assets/js/ui/oscilloscopeDisplay.js'));
+  });
+
+  function makeDisplay(phosphor) {
+    const canvas = new MockCanvas();
+    canvas.width = 200;
+    canvas.height = 100;
+    return new OscilloscopeDisplay({ canvas, mode: 'xy', phosphor });
+  }
+
+  const capture = () => ({
+    bufferX: new Float32Array([0, 0.5, 1, 0.5]),
+    bufferY: new Float32Array([0, -0.5, 1, 0.5]),
+    triggered: true
+  });
+
+  it('la config del osciloscopio tiene valores en el rango que acepta el nativo', () => {
+    const { phosphor } = oscilloscopeConfig.display;
+    assert.equal(typeof phosphor.enabled, 'boolean');
+    assert.ok(phosphor.persistenceMs >= 1 && phosphor.persistenceMs <= 10000);
+    assert.ok(phosphor.beamEnergy > 0);
+    assert.ok(phosphor.fps >= 1 && phosphor.fps <= 240);
+  });
+
+  it('pasa persistencia, energía y fps de la config al rasterizador nativo', () => {
+    const phosphor = { ...oscilloscopeConfig.display.phosphor, enabled: true };
+    const display = makeDisplay(phosphor);
+    const { config } = api.scopes.get(display.phosphor.id);
+    assert.equal(config.persistenceMs, phosphor.persistenceMs);
+    assert.equal(config.beamEnergy, phosphor.beamEnergy);
+    assert.equal(config.fps, phosphor.fps);
+  });
+
+  it('sin addon traza X-Y con canvas y no envía nada', () => {
+    delete globalThis.window.phosphorScopeAPI;
+    const display = makeDisplay({ enabled: true, persistenceMs: 60 });
+    assert.equal(display.phosphor, null);
+    display.draw(capture());
+    assert.ok(display.ctx.lineCount > 0);
+    assert.equal(display.ctx.drawCount, 0);
+    assert.equal(api.calls.filter(c => c.fn === 'submit').length, 0);
+  });
+
+  it('con el fósforo desactivado no crea capa nativa', () => {
+    const display = makeDisplay({ enabled: false, persistenceMs: 60 });
+    assert.equal(display.phosphor, null);
+    assert.equal(api.scopes.size, 0);
+    display.draw(capture());
+    assert.ok(display.ctx.lineCount > 0);
+  });
+
+  it('_drawXYPhosphor ignora capturas vacías sin enviar ni componer', () => {
+    const display = makeDisplay({ enabled: true, persistenceMs: 60 });
+    display._drawXYPhosphor({ bufferX: new Float32Array(0), bufferY: new Float32Array(0) });
+    display._drawXYPhosphor({ bufferX: null, bufferY: new Float32Array(4) });
+    assert.equal(api.calls.filter(c => c.fn === 'submit').length, 0);
+    assert.equal(display.ctx.drawCount, 0);
+    assert.equal(display.ctx.lineCount, 0);
+  });
+});
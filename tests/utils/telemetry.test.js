@@ -9,6 +9,7 @@
  * - Cola offline (save / load / clear)
  * - Flush (envía + limpia cola)
  * - init idempotente
+ * - Salud del audio nativo (audio_health) vía cola offline
  * - _testing.reset() limpia todo
  *
  * Fase 3 del plan de telemetría.
@@ -56,6 +57,9 @@ import {
   setEnabled,
   trackEvent,
   trackError,
+  trackAudioHealth,
+  sendAudioHealth,
+  buildAudioHealthData,
   flush,
   init,
   _testing
@@ -267,3 +271,124 @@ describe('telemetry — storage keys', () => {
     assert.equal(stored, p.id);
   });
 });
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Salud del audio nativo
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Snapshot con la forma que devuelve getAudioHealth() del addon */
+function healthSnapshot({ cycles = 1000, underflows = 2, inputCycles = 0 } = {}) {
+  const dir = (n) => ({
+    streams: 1,
+    cycles: n,
+    underflows,
+    overflows: 0,
+    catchUps: 1,
+    catchUpFrames: 480,
+    latencyOverruns: 3,
+    latencyMs: { p50: 42, p95: 44, p99: 60, max: 85 },
+    loadPct: { p50: 12, p95: 30, p99: 55, max: 101 },
+    quantum: { last: 256, min: 256, max: 1024 },
+    rate: 48000,
+    channels: 12,
+    format: 'F32',
+    prebufferMs: 42,
+    driverMode: false
+  });
+  return { output: dir(cycles), input: dir(inputCycles) };
+}
+
+describe('telemetry — salud del audio', () => {
+  const originalOnLine = navigator.onLine;
+
+  beforeEach(() => {
+    _testing.setEndpointUrl('https://telemetry.invalid/endpoint');
+    localStorage.setItem('synthigme-telemetry-enabled', 'true');
+    navigator.onLine = false;  // Todo va a la cola offline, sin red
+  });
+
+  after(() => {
+    navigator.onLine = originalOnLine;
+  });
+
+  it('buildAudioHealthData compacta percentiles y omite direcciones sin ciclos', () => {
+    const data = buildAudioHealthData(healthSnapshot());
+    assert.deepEqual(data.output.latencyMs, [42, 44, 60, 85]);
+    assert.deepEqual(data.output.loadPct, [12, 30, 55, 101]);
+    assert.deepEqual(data.output.quantum, [256, 256, 1024]);
+    assert.equal(data.output.format, 'F32');
+    assert.equal(data.output.catchUps, 1);
+    assert.equal(data.output.latencyOverruns, 3);
+    assert.equal(data.input, undefined);
+  });
+
+  it('buildAudioHealthData devuelve null sin addon o sin ciclos', () => {
+    assert.equal(buildAudioHealthData(null), null);
+    assert.equal(buildAudioHealthData(healthSnapshot({ cycles: 0 })), null);
+  });
+
+  it('trackAudioHealth guarda el informe pendiente y sendAudioHealth lo encola', () => {
+    assert.equal(trackAudioHealth(healthSnapshot({ inputCycles: 500 })), true);
+    assert.deepEqual(_testing.loadOfflineQueue(), []);
+    const pending = _testing.loadPendingAudioHealth();
+    assert.equal(pending.type, 'audio_health');
+    assert.equal(pending.data.output.underflows, 2);
+    assert.equal(pending.data.input.cycles, 500);
+    assert.equal(pending.data.output.prebufferMs, 42);
+
+    assert.equal(sendAudioHealth(), true);
+    assert.equal(_testing.loadPendingAudioHealth(), null);
+    const queued = _testing.loadOfflineQueue();
+    assert.equal(queued.length, 1);
+    assert.equal(queued[0].type, 'audio_health');
+    assert.equal(queued[0].data.input.cycles, 500);
+    assert.equal(sendAudioHealth(), false);
+  });
+
+  it('lee el snapshot de window.audioHealthAPI si no se le pasa', () => {
+    window.audioHealthAPI = { getSnapshot: () => healthSnapshot() };
+    try {
+      assert.equal(trackAudioHealth(), true);
+      assert.equal(_testing.loadPendingAudioHealth().data.output.cycles, 1000);
+    } finally {
+      delete window.audioHealthAPI;
+    }
+  });
+
+  it('cada informe sustituye al anterior: uno por sesión sin importar cuántas veces se oculte', () => {
+    assert.equal(trackAudioHealth(healthSnapshot({ cycles: 100 })), true);
+    assert.equal(trackAudioHealth(healthSnapshot({ cycles: 100 })), false);
+    for (let i = 2; i <= 10; i++) {
+      assert.equal(trackAudioHealth(healthSnapshot({ cycles: 100 * i })), true);
+    }
+    assert.equal(_testing.sessionEventCount, 0);
+    assert.equal(sendAudioHealth(), true);
+    const queued = _testing.loadOfflineQueue();
+    assert.equal(queued.length, 1);
+    assert.equal(queued[0].data.output.cycles, 1000);
+    assert.equal(_testing.sessionEventCount, 1);
+  });
+
+  it('un informe que no llegó a salir se envía en el siguiente arranque', () => {
+    trackAudioHealth(healthSnapshot({ cycles: 300 }));
+    // Sesión cortada sin salir: el siguiente init lo recupera
+    _testing.reset();
+    _testing.setEndpointUrl('https://telemetry.invalid/endpoint');
+    init();
+    const recovered = _testing.loadOfflineQueue().filter(e => e.type === 'audio_health');
+    assert.equal(recovered.length, 1);
+    assert.equal(recovered[0].data.output.cycles, 300);
+    assert.equal(recovered[0].data.recovered, true);
+    assert.equal(_testing.loadPendingAudioHealth(), null);
+    _testing.reset();
+  });
+
+  it('no guarda nada sin consentimiento y retirarlo borra el pendiente', () => {
+    assert.equal(trackAudioHealth(healthSnapshot()), true);
+    setEnabled(false);
+    assert.equal(_testing.loadPendingAudioHealth(), null);
+    assert.equal(trackAudioHealth(healthSnapshot({ cycles: 2000 })), false);
+    assert.equal(sendAudioHealth(), false);
+    assert.deepEqual(_testing.loadOfflineQueue(), []);
+  });
+});
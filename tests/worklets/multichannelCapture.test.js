@@ -6,6 +6,7 @@
  * - Cálculo de espacio disponible
  * - Detección de overflow
  * - Modo fallback con MessagePort
+ * - Formato empaquetado: descriptores con seq y currentFrame/currentTime
  * 
  * NOTA: No se puede instanciar AudioWorkletProcessor en Node.js,
  * pero podemos testear la lógica de buffer aislada.
@@ -316,3 +317,110 @@ describe('Operaciones Atómicas', () => {
     assert.strictEqual(Atomics.load(controlBuffer, 1), 50);
   });
 });
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FORMATO EMPAQUETADO (worklet real en entorno simulado)
+// ═══════════════════════════════════════════════════════════════════════════
+
+const PACKET_BLOCK = 128;
+
+function createWorkletEnvironment() {
+  globalThis.sampleRate = 48000;
+  globalThis.currentTime = 0;
+  globalThis.currentFrame = 0;
+
+  if (!globalThis.AudioWorkletProcessor) {
+    globalThis.AudioWorkletProcessor = class AudioWorkletProcessor {
+      constructor() {
+        this.port = { onmessage: null, postMessage: () => {} };
+      }
+    };
+  }
+
+  const registered = {};
+  globalThis.registerProcessor = (name, cls) => {
+    registered[name] = cls;
+  };
+  return registered;
+}
+
+/**
+ * Crea el worklet con un SAB del tamaño que reserva audioSetup.js
+ * (8 + audio, alineado a 8, + cabecera de 16 + slots × 32)
+ */
+function makePacketized(Processor, bufferFrames, channels, slots) {
+  const audioEnd = Math.ceil((8 + bufferFrames * channels * 4) / 8) * 8;
+  const sab = new SharedArrayBuffer(audioEnd + 16 + slots * 32);
+  const proc = new Processor({ processorOptions: { channels } });
+  proc.port.onmessage({ data: { type: 'init', sharedBuffer: sab, bufferFrames, packetSlots: slots } });
+  return {
+    proc,
+    control: new Int32Array(sab, 0, 2),
+    header: new Int32Array(sab, audioEnd, 4),
+    ints: new Int32Array(sab, audioEnd + 16, slots * 8),
+    floats: new Float64Array(sab, audioEnd + 16, slots * 4)
+  };
+}
+
+function captureBlock(channels) {
+  return [Array.from({ length: channels }, () => new Float32Array(PACKET_BLOCK))];
+}
+
+describe('Formato empaquetado — Import real', () => {
+  let Processor;
+
+  beforeEach(async () => {
+    const registered = createWorkletEnvironment();
+    await import(`../../src/assets/js/worklets/multichannelCapture.worklet.js?t=${Date.now()}`);
+    Processor = registered['multichannel-capture'];
+  });
+
+  it('publica un descriptor por bloque con seq, frames y tiempo del contexto', () => {
+    const { proc, control, header, ints, floats } = makePacketized(Processor, 1024, 2, 16);
+    for (let b = 0; b < 3; b++) {
+      globalThis.currentFrame = 5000 + b * PACKET_BLOCK;
+      globalThis.currentTime = globalThis.currentFrame / 48000;
+      proc.process(captureBlock(2), []);
+    }
+    assert.strictEqual(Atomics.load(header, 0), 3);
+    assert.strictEqual(Atomics.load(control, 0), 3 * PACKET_BLOCK);
+    for (let b = 0; b < 3; b++) {
+      assert.strictEqual(ints[b * 8], b);
+      assert.strictEqual(ints[b * 8 + 1], PACKET_BLOCK);
+      assert.strictEqual(floats[b * 4 + 2], 5000 + b * PACKET_BLOCK);
+      assert.strictEqual(floats[b * 4 + 3], (5000 + b * PACKET_BLOCK) / 48000);
+    }
+  });
+
+  it('un bloque descartado por overflow consume secuencia sin descriptor', () => {
+    // Ring de 256 frames: cabe un bloque (guarda de 1 frame), el segundo desborda
+    const { proc, control, header, ints } = makePacketized(Processor, 256, 2, 8);
+    proc.process(captureBlock(2), []);
+    proc.process(captureBlock(2), []);
+    assert.strictEqual(Atomics.load(header, 0), 1);
+    Atomics.store(control, 1, PACKET_BLOCK);  // el nativo lee el primero
+    proc.process(captureBlock(2), []);
+    assert.strictEqual(Atomics.load(header, 0), 2);
+    assert.strictEqual(ints[8], 2);  // seq 1 perdido
+  });
+
+  it('la tabla es circular sobre slots', () => {
+    const { proc, control, header, ints } = makePacketized(Processor, 1024, 1, 4);
+    for (let b = 0; b < 6; b++) {
+      proc.process(captureBlock(1), []);
+      Atomics.store(control, 1, Atomics.load(control, 0));
+    }
+    assert.strictEqual(Atomics.load(header, 0), 6);
+    assert.strictEqual(ints[0], 4);
+    assert.strictEqual(ints[8], 5);
+  });
+
+  it('sin packetSlots no reserva tabla (compatibilidad)', () => {
+    const sab = new SharedArrayBuffer(8 + 1024 * 2 * 4);
+    const proc = new Processor({ processorOptions: { channels: 2 } });
+    proc.port.onmessage({ data: { type: 'init', sharedBuffer: sab, bufferFrames: 1024 } });
+    proc.process(captureBlock(2), []);
+    assert.strictEqual(proc.packetSlots, 0);
+    assert.strictEqual(Atomics.load(new Int32Array(sab, 0, 2), 0), PACKET_BLOCK);
+  });
+});
@@ -0,0 +1,261 @@
+/**
+ * Tests para nativeBridge.worklet.js — Puente AudioWorklet ↔ procesador nativo
+ *
+ * Importa el worklet real en un entorno simulado y reproduce en JS el lado
+ * nativo (ProcessorBridge::processBlock) sobre el mismo SharedArrayBuffer.
+ *
+ * Verifica:
+ * - Layout del SAB (cabecera de 8 Int32 + rings de entrada y salida)
+ * - Cebado con silencio hasta latencyFrames
+ * - Retardo fijo exacto cuando el nativo llega a tiempo
+ * - Underruns: silencio, contador en el SAB y descarte de frames atrasados
+ *   (el retardo no crece tras un retraso del hilo nativo)
+ * - Origen de frames (palabra 7) para los eventos programados
+ */
+
+import { describe, test, beforeEach } from 'node:test';
+import assert from 'node:assert';
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONSTANTES (deben coincidir con processor_bridge.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+const SAMPLE_RATE = 48000;
+const BLOCK = 128;
+const HEADER_WORDS = 8;
+const IN_WRITE = 0;
+const IN_READ = 1;
+const OUT_WRITE = 2;
+const OUT_READ = 3;
+const LATENCY = 4;
+const UNDERRUNS = 5;
+const BLOCKS = 6;
+const ORIGIN = 7;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ENTORNO SIMULADO
+// ═══════════════════════════════════════════════════════════════════════════
+
+function createWorkletEnvironment() {
+  globalThis.sampleRate = SAMPLE_RATE;
+  globalThis.currentTime = 0;
+  globalThis.currentFrame = 0;
+
+  if (!globalThis.AudioWorkletProcessor) {
+    globalThis.AudioWorkletProcessor = class AudioWorkletProcessor {
+      constructor() {
+        this.port = {
+          onmessage: null,
+          postMessage: () => {}
+        };
+      }
+    };
+  }
+
+  const registered = {};
+  globalThis.registerProcessor = (name, cls) => {
+    registered[name] = cls;
+  };
+
+  return registered;
+}
+
+/**
+ * Réplica JS de ProcessorBridge::processBlock con un procesador de ganancia.
+ * Procesa todos los bloques completos disponibles.
+ */
+function createNativeSide(sab, ringFrames, inCh, outCh, gain = 1) {
+  const header = new Int32Array(sab, 0, HEADER_WORDS);
+  const inRing = new Float32Array(sab, HEADER_WORDS * 4, ringFrames * inCh);
+  const outRing = new Float32Array(sab, HEADER_WORDS * 4 + ringFrames * inCh * 4, ringFrames * outCh);
+  const dist = (from, to) => (to >= from ? to - from : ringFrames - from + to);
+
+  return function run() {
+    let blocks = 0;
+    for (;;) {
+      let inRead = Atomics.load(header, IN_READ);
+      if (dist(inRead, Atomics.load(header, IN_WRITE)) < BLOCK) break;
+      const outRead = Atomics.load(header, OUT_READ);
+      let outWrite = Atomics.load(header, OUT_WRITE);
+      const space = ringFrames - 1 - dist(outRead, outWrite);
+      for (let i = 0; i < BLOCK; i++) {
+        for (let ch = 0; ch < outCh; ch++) {
+          const v = ch < inCh ? inRing[inRead * inCh + ch] * gain : 0;
+          if (space >= BLOCK) outRing[outWrite * outCh + ch] = v;
+        }
+        inRead = (inRead + 1) % ringFrames;
+        if (space >= BLOCK) outWrite = (outWrite + 1) % ringFrames;
+      }
+      Atomics.store(header, IN_READ, inRead);
+      Atomics.store(header, OUT_WRITE, outWrite);
+      Atomics.add(header, BLOCKS, 1);
+      blocks++;
+    }
+    return blocks;
+  };
+}
+
+function makeProcessor(Processor, { inputs = 1, outputs = 1, latencyFrames = 256, ringFrames = 1024 } = {}) {
+  const proc = new Processor({ processorOptions: { inputs, outputs, latencyFrames } });
+  const sab = new SharedArrayBuffer(HEADER_WORDS * 4 + ringFrames * (inputs + outputs) * 4);
+  proc.port.onmessage({ data: { type: 'init', sharedBuffer: sab, ringFrames } });
+  return { proc, sab, header: new Int32Array(sab, 0, HEADER_WORDS), ringFrames };
+}
+
+/** Bloque de entrada con una rampa que codifica el índice absoluto de frame */
+function rampBlock(blockIndex, channels = 1) {
+  const chans = [];
+  for (let ch = 0; ch < channels; ch++) {
+    const data = new Float32Array(BLOCK);
+    for (let i = 0; i < BLOCK; i++) data[i] = blockIndex * BLOCK + i + 1 + ch * 0.5;
+    chans.push(data);
+  }
+  return [chans];
+}
+
+function emptyOutputs(channels = 1) {
+  return [Array.from({ length: channels }, () => new Float32Array(BLOCK))];
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+describe('Native Bridge Worklet — Import real', () => {
+  let NativeBridgeProcessor;
+
+  beforeEach(async () => {
+    const registered = createWorkletEnvironment();
+    await import(`../../src/assets/js/worklets/nativeBridge.worklet.js?t=${Date.now()}`);
+    NativeBridgeProcessor = registered['native-bridge'];
+  });
+
+  test('registra el procesador como "native-bridge"', () => {
+    assert.ok(NativeBridgeProcessor);
+  });
+
+  test('emite silencio antes de recibir el SAB', () => {
+    const proc = new NativeBridgeProcessor({ processorOptions: { inputs: 1, outputs: 1 } });
+    const outputs = emptyOutputs();
+    outputs[0][0].fill(1);
+    assert.strictEqual(proc.process(rampBlock(0), outputs), true);
+    assert.ok(outputs[0][0].every(v => v === 0));
+  });
+
+  test('init publica latencyFrames en la cabecera', () => {
+    const { header } = makeProcessor(NativeBridgeProcessor, { latencyFrames: 384 });
+    assert.strictEqual(Atomics.load(header, LATENCY), 384);
+    assert.strictEqual(Atomics.load(header, UNDERRUNS), 0);
+  });
+
+  test('process() retorna false tras stop', () => {
+    const { proc } = makeProcessor(NativeBridgeProcessor);
+    proc.port.onmessage({ data: { type: 'stop' } });
+    assert.strictEqual(proc.process(rampBlock(0), emptyOutputs()), false);
+  });
+
+  test('escribe la entrada intercalada en el ring de entrada', () => {
+    const { proc, sab, header, ringFrames } = makeProcessor(NativeBridgeProcessor, { inputs: 2, outputs: 2 });
+    proc.process(rampBlock(0, 2), emptyOutputs(2));
+    const inRing = new Float32Array(sab, HEADER_WORDS * 4, ringFrames * 2);
+    assert.strictEqual(Atomics.load(header, IN_WRITE), BLOCK);
+    assert.strictEqual(inRing[0], 1);
+    assert.strictEqual(inRing[1], 1.5);
+    assert.strictEqual(inRing[2], 2);
+  });
+
+  test('retardo fijo exacto de latencyFrames con el nativo a tiempo', () => {
+    const latencyFrames = 256;
+    const { proc, sab, header, ringFrames } = makeProcessor(NativeBridgeProcessor, { latencyFrames });
+    const native = createNativeSide(sab, ringFrames, 1, 1, 0.5);
+
+    const produced = [];
+    for (let b = 0; b < 20; b++) {
+      const outputs = emptyOutputs();
+      proc.process(rampBlock(b), outputs);
+      native();
+      produced.push(...outputs[0][0]);
+    }
+
+    // La salida es la entrada × 0.5 desplazada exactamente latencyFrames
+    for (let n = 0; n < produced.length; n++) {
+      const expected = n < latencyFrames ? 0 : (n - latencyFrames + 1) * 0.5;
+      assert.strictEqual(produced[n], expected, `frame ${n}`);
+    }
+    assert.strictEqual(Atomics.load(header, UNDERRUNS), 0);
+    assert.strictEqual(Atomics.load(header, BLOCKS), 20);
+  });
+
+  test('un retraso del nativo cuenta underruns y no aumenta el retardo', () => {
+    const latencyFrames = 256;
+    const { proc, sab, header, ringFrames } = makeProcessor(NativeBridgeProcessor, { latencyFrames });
+    const native = createNativeSide(sab, ringFrames, 1, 1);
+
+    const produced = [];
+    for (let b = 0; b < 30; b++) {
+      const outputs = emptyOutputs();
+      proc.process(rampBlock(b), outputs);
+      // El hilo nativo se bloquea durante los bloques 5..9
+      if (b < 5 || b > 9) native();
+      produced.push(...outputs[0][0]);
+    }
+
+    const underruns = Atomics.load(header, UNDERRUNS);
+    assert.ok(underruns > 0, 'debe contar underruns');
+
+    // Tras recuperarse, el retardo vuelve a ser exactamente latencyFrames
+    const tail = produced.slice(-5 * BLOCK);
+    const tailStart = produced.length - tail.length;
+    for (let i = 0; i < tail.length; i++) {
+      assert.strictEqual(tail[i], tailStart + i - latencyFrames + 1, `frame ${tailStart + i}`);
+    }
+  });
+
+  test('origin + frames consumidos da el frame del AudioContext del bloque', () => {
+    const { proc, header } = makeProcessor(NativeBridgeProcessor);
+    globalThis.currentFrame = 1000 * BLOCK;
+    proc.process(rampBlock(0), emptyOutputs());
+    globalThis.currentFrame += BLOCK;
+    proc.process(rampBlock(1), emptyOutputs());
+    // El nativo ha consumido 1 bloque: el siguiente empezó en 1001 × BLOCK
+    assert.strictEqual(Atomics.load(header, ORIGIN) + BLOCK, 1001 * BLOCK);
+  });
+
+  test('un overflow de entrada corrige origin en el siguiente bloque enviado', () => {
+    const ringFrames = 512;
+    const { proc, header } = makeProcessor(NativeBridgeProcessor, { ringFrames });
+    // Sin nativo: caben 3 bloques, el 4.º se pierde
+    for (let b = 0; b < 4; b++) {
+      globalThis.currentFrame = b * BLOCK;
+      proc.process(rampBlock(b), emptyOutputs());
+    }
+    assert.strictEqual(Atomics.load(header, ORIGIN), 0);
+
+    // El nativo consume todo y el bloque 4 llega tras el hueco del 3
+    Atomics.store(header, IN_READ, Atomics.load(header, IN_WRITE));
+    globalThis.currentFrame = 4 * BLOCK;
+    proc.process(rampBlock(4), emptyOutputs());
+    assert.strictEqual(Atomics.load(header, ORIGIN) + 3 * BLOCK, 4 * BLOCK);
+  });
+
+  test('origin se calcula módulo 2^32', () => {
+    const { proc, header } = makeProcessor(NativeBridgeProcessor);
+    globalThis.currentFrame = 2 ** 32 + 5 * BLOCK;
+    proc.process(rampBlock(0), emptyOutputs());
+    assert.strictEqual(Atomics.load(header, ORIGIN), 5 * BLOCK);
+  });
+
+  test('canales de salida extra del nodo quedan en silencio', () => {
+    const { proc, sab, ringFrames } = makeProcessor(NativeBridgeProcessor, { latencyFrames: 128 });
+    const native = createNativeSide(sab, ringFrames, 1, 1);
+    let outputs;
+    for (let b = 0; b < 4; b++) {
+      outputs = emptyOutputs(2);
+      outputs[0][1].fill(1);
+      proc.process(rampBlock(b), outputs);
+      native();
+    }
+    assert.ok(outputs[0][0].some(v => v !== 0));
+    assert.ok(outputs[0][1].every(v => v === 0));
+  });
+});